@@ -0,0 +1,150 @@
+// Measures the cost of a burst of orders that arrive together, such as at the open, of 1,000 up
+// to 100,000 orders within 20 ticks of the mid on both sides, so most of them cross.
+//
+// Two ways of handling the burst are timed, each on a fresh book:
+//   continuous - each order is matched on arrival and what it leaves added to the book, sweeping
+//                the levels it crosses one order at a time
+//   auction    - each order is added during a call without matching, then the book is uncrossed
+//                once at the price that executes the most
+
+#include <asset_class.h>
+#include <fill.h>
+#include <market_side.h>
+#include <matcher.h>
+#include <order.h>
+#include <order_book.h>
+#include <ticks.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace solstice;
+
+constexpr int RUNS = 5;
+
+std::vector<matching::OrderPtr> generateBurst(int orders)
+{
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> offsetDist(-20, 20);
+    std::uniform_int_distribution<int> qntyDist(1, 20);
+    std::bernoulli_distribution sideDist(0.5);
+
+    const Ticks mid = toTicks(100.0, Equity::AAPL);
+
+    std::vector<matching::OrderPtr> burst;
+    burst.reserve(orders);
+
+    for (int uid = 1; uid <= orders; uid++)
+    {
+        burst.push_back(*Order::create(uid, Equity::AAPL,
+                                       fromTicks(mid + offsetDist(gen), Equity::AAPL),
+                                       qntyDist(gen),
+                                       sideDist(gen) ? MarketSide::Bid : MarketSide::Ask));
+    }
+
+    return burst;
+}
+
+struct Run
+{
+    double ns;
+    size_t fills;
+    int64_t qnty;
+};
+
+Run continuous(const std::vector<matching::OrderPtr>& burst)
+{
+    auto orderBook = std::make_shared<matching::OrderBook>();
+    orderBook->initialiseUnderlying(Equity::AAPL);
+    matching::Matcher matcher(orderBook);
+
+    std::vector<matching::Fill> fills;
+    Run run{};
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (const auto& order : burst)
+    {
+        fills.clear();
+        matcher.matchOrder(order, fills);
+
+        if (order->outstandingQnty() > 0)
+        {
+            orderBook->addOrderToBook(order);
+        }
+
+        run.fills += fills.size();
+        for (const auto& fill : fills)
+        {
+            run.qnty += fill.qnty;
+        }
+    }
+
+    const auto end = std::chrono::steady_clock::now();
+    run.ns = std::chrono::duration<double, std::nano>(end - start).count();
+    return run;
+}
+
+Run auction(const std::vector<matching::OrderPtr>& burst)
+{
+    auto orderBook = std::make_shared<matching::OrderBook>();
+    orderBook->initialiseUnderlying(Equity::AAPL);
+
+    std::vector<matching::Fill> fills;
+    Run run{};
+
+    const auto start = std::chrono::steady_clock::now();
+
+    orderBook->startAuction(Equity::AAPL);
+    for (const auto& order : burst)
+    {
+        orderBook->addOrderToBook(order);
+    }
+    auto result = orderBook->uncross(Equity::AAPL, fills);
+
+    const auto end = std::chrono::steady_clock::now();
+    run.ns = std::chrono::duration<double, std::nano>(end - start).count();
+    run.fills = fills.size();
+    run.qnty = result ? (*result).qnty : 0;
+    return run;
+}
+
+// the median of RUNS runs, each on orders generated afresh as matching changes them
+template <typename Func>
+Run median(int orders, Func&& func)
+{
+    std::vector<Run> runs;
+    for (int i = 0; i < RUNS; i++)
+    {
+        runs.push_back(func(generateBurst(orders)));
+    }
+    std::ranges::sort(runs, {}, &Run::ns);
+    return runs[RUNS / 2];
+}
+
+int main()
+{
+    std::cout << std::setw(10) << "Orders" << std::setw(12) << "Workload" << std::setw(10)
+              << "Fills" << std::setw(12) << "Qnty" << std::setw(12) << "ns/order"
+              << "\n";
+
+    for (int orders : {1'000, 10'000, 100'000})
+    {
+        for (bool call : {false, true})
+        {
+            const Run run = call ? median(orders, auction) : median(orders, continuous);
+
+            std::cout << std::setw(10) << orders << std::setw(12)
+                      << (call ? "auction" : "continuous") << std::setw(10) << run.fills
+                      << std::setw(12) << run.qnty << std::fixed << std::setprecision(1)
+                      << std::setw(12) << run.ns / orders << "\n";
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,106 @@
+// Measures how a book's memory holds up over a long run whose prices keep moving, as in infinite
+// mode: the mid drifts up a tick every 100 orders with a random walk on top, so the book keeps
+// opening levels it will never see again.
+//
+// Orders are placed around the mid and matched, and each resting order is cancelled once 10,000
+// newer ones have arrived, so the orders resting stay bounded and only the levels can grow. Levels
+// held, the book's own estimate of its memory, peak RSS and time per order are reported at each
+// checkpoint.
+
+#include <asset_class.h>
+#include <fill.h>
+#include <market_side.h>
+#include <matcher.h>
+#include <order.h>
+#include <order_book.h>
+#include <ticks.h>
+
+#include <sys/resource.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace solstice;
+
+constexpr int ORDERS = 5'000'000;
+constexpr int CHECKPOINT = 1'000'000;
+constexpr int RESTING_ORDERS = 10'000;
+constexpr int DRIFT_INTERVAL = 100;
+
+double peakRssMb()
+{
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / 1024.0;
+}
+
+int main()
+{
+    auto orderBook = std::make_shared<matching::OrderBook>();
+    orderBook->initialiseUnderlying(Equity::AAPL);
+
+    matching::Matcher matcher(orderBook);
+    std::vector<matching::Fill> fills;
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> offsetDist(-50, 50);
+    std::uniform_int_distribution<int> walkDist(-1, 1);
+    std::uniform_int_distribution<int> qntyDist(1, 20);
+    std::bernoulli_distribution sideDist(0.5);
+
+    Ticks mid = toTicks(100.0, Equity::AAPL);
+
+    std::cout << std::setw(10) << "Orders" << std::setw(14) << "Levels held" << std::setw(16)
+              << "Book (KB)" << std::setw(16) << "Peak RSS (MB)" << std::setw(12) << "ns/order"
+              << "\n";
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int uid = 1; uid <= ORDERS; uid++)
+    {
+        if (uid % DRIFT_INTERVAL == 0)
+        {
+            mid += 1 + walkDist(gen);
+        }
+
+        const bool bid = sideDist(gen);
+        auto order = *Order::create(
+            uid, Equity::AAPL, fromTicks(mid + offsetDist(gen), Equity::AAPL), qntyDist(gen),
+            bid ? MarketSide::Bid : MarketSide::Ask);
+
+        fills.clear();
+        matcher.matchOrder(order, fills);
+
+        if (order->outstandingQnty() > 0)
+        {
+            orderBook->addOrderToBook(order);
+        }
+
+        if (uid > RESTING_ORDERS && orderBook->hasOrder(Equity::AAPL, uid - RESTING_ORDERS))
+        {
+            orderBook->cancelOrder(Equity::AAPL, uid - RESTING_ORDERS);
+        }
+
+        if (uid % CHECKPOINT == 0)
+        {
+            const auto end = std::chrono::steady_clock::now();
+            const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+
+            const auto& book = orderBook->getActiveOrders(Equity::AAPL)->get();
+            const size_t levels = book.bids.size() + book.asks.size();
+            const matching::BookMemory memory = orderBook->bookMemory(Equity::AAPL);
+
+            std::cout << std::setw(10) << uid << std::setw(14) << levels << std::setw(16)
+                      << memory.bytes / 1024 << std::fixed << std::setprecision(1)
+                      << std::setw(16) << peakRssMb() << std::setw(12) << ns / CHECKPOINT << "\n";
+
+            start = std::chrono::steady_clock::now();
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,135 @@
+// Measures the cost of reading the top five levels of each side of a book with their quantity and
+// order count, as each book broadcast does, on books of 1,000 up to 1,000,000 resting orders.
+//
+// Two ways of getting it are timed:
+//   walk   - summing every resting order into its level and keeping the best five, which is what a
+//            consumer has to do without aggregates kept by the book
+//   depth  - reading the aggregates the book keeps per level as orders rest, fill and leave
+
+#include <asset_class.h>
+#include <market_side.h>
+#include <order.h>
+#include <order_book.h>
+#include <ticks.h>
+
+#include <array>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+
+using namespace solstice;
+
+constexpr size_t DEPTH = 5;
+constexpr int READS = 200;
+
+std::shared_ptr<matching::OrderBook> buildBook(int orders)
+{
+    auto orderBook = std::make_shared<matching::OrderBook>();
+    orderBook->initialiseUnderlying(Equity::AAPL);
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> offsetDist(1, 500);
+    std::uniform_int_distribution<int> qntyDist(1, 20);
+    std::bernoulli_distribution sideDist(0.5);
+
+    const Ticks mid = toTicks(100.0, Equity::AAPL);
+
+    // bids rest below the mid and asks above it, so nothing crosses
+    for (int uid = 1; uid <= orders; uid++)
+    {
+        const bool bid = sideDist(gen);
+        const Ticks price = bid ? mid - offsetDist(gen) : mid + offsetDist(gen);
+        orderBook->addOrderToBook(*Order::create(uid, Equity::AAPL,
+                                                 fromTicks(price, Equity::AAPL), qntyDist(gen),
+                                                 bid ? MarketSide::Bid : MarketSide::Ask));
+    }
+
+    return orderBook;
+}
+
+int64_t walk(const matching::OrderBook& orderBook)
+{
+    std::map<Ticks, int64_t> bids;
+    std::map<Ticks, int64_t> asks;
+
+    orderBook.forEachRestingOrder(Equity::AAPL,
+                                  [&](const matching::OrderPtr& order)
+                                  {
+                                      auto& side =
+                                          order->marketSide() == MarketSide::Bid ? bids : asks;
+                                      side[order->priceTicks()] += order->outstandingQnty();
+                                  });
+
+    int64_t total = 0;
+    size_t taken = 0;
+    for (auto it = bids.rbegin(); it != bids.rend() && taken < DEPTH; ++it, ++taken)
+    {
+        total += it->second;
+    }
+    taken = 0;
+    for (auto it = asks.begin(); it != asks.end() && taken < DEPTH; ++it, ++taken)
+    {
+        total += it->second;
+    }
+    return total;
+}
+
+int64_t depth(const matching::OrderBook& orderBook)
+{
+    std::array<matching::DepthLevel, DEPTH> levels;
+
+    int64_t total = 0;
+    for (MarketSide side : {MarketSide::Bid, MarketSide::Ask})
+    {
+        const size_t count = orderBook.depth(Equity::AAPL, side, levels);
+        for (size_t i = 0; i < count; i++)
+        {
+            total += levels[i].qnty;
+        }
+    }
+    return total;
+}
+
+template <typename Func>
+double timeReads(Func&& func, int64_t& total)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < READS; i++)
+    {
+        total = func();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / READS;
+}
+
+int main()
+{
+    std::cout << std::setw(10) << "Orders" << std::setw(16) << "walk (ns)" << std::setw(16)
+              << "depth (ns)" << std::setw(14) << "Top-5 qnty"
+              << "\n";
+
+    for (int orders : {1'000, 10'000, 100'000, 1'000'000})
+    {
+        auto orderBook = buildBook(orders);
+
+        int64_t walked = 0;
+        int64_t read = 0;
+        const double walkNs = timeReads([&] { return walk(*orderBook); }, walked);
+        const double depthNs = timeReads([&] { return depth(*orderBook); }, read);
+
+        if (walked != read)
+        {
+            std::cout << "depth disagrees with the walk: " << read << " vs " << walked << "\n";
+            return -1;
+        }
+
+        std::cout << std::setw(10) << orders << std::fixed << std::setprecision(0)
+                  << std::setw(16) << walkNs << std::setw(16) << depthNs << std::setw(14) << read
+                  << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,167 @@
+// Measures what the event log costs while matching and how long startup takes to recover a book
+// from it. Runs the 10 ticker equity config from the v0.2.0 entry in BENCHMARK_HISTORY.md in
+// batches of ORDERS_PER_RUN until the logs hold at least TARGET_EVENTS, each run recovering the
+// runs before it, then one more batch taking a snapshot every SNAPSHOT_INTERVAL_MS. Finally times
+// startups that generate nothing, recovering from the logs alone and from the last snapshot.
+
+#include <asset_class.h>
+#include <broadcaster.h>
+#include <config.h>
+#include <event_log.h>
+#include <log_level.h>
+#include <orchestrator.h>
+
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+
+using namespace solstice;
+
+constexpr int ORDERS_PER_RUN = 2'000'000;
+constexpr uint64_t TARGET_EVENTS = 10'000'000;
+constexpr int UNDERLYINGS = 10;
+constexpr int SNAPSHOT_INTERVAL_MS = 1000;
+
+namespace
+{
+
+void removeLogs(const String& prefix)
+{
+    for (size_t i = 0; std::filesystem::remove(eventLogPath(prefix, i)); i++)
+    {
+    }
+}
+
+uint64_t loggedEvents(const String& prefix)
+{
+    uint64_t events = 0;
+    if (auto logs = EventLog::loadAll(prefix))
+    {
+        for (const auto& log : *logs)
+        {
+            events += log.events().size();
+        }
+    }
+    return events;
+}
+
+void printRow(const String& name, uint64_t events, double ms)
+{
+    std::cout << std::left << std::setw(32) << name << std::right << std::setw(14) << events
+              << std::fixed << std::setprecision(0) << std::setw(12) << ms << "\n";
+}
+
+}  // namespace
+
+int main()
+{
+    auto config = Config::instance();
+    if (!config)
+    {
+        std::cout << config.error();
+        return -1;
+    }
+
+    const String prefix =
+        (std::filesystem::temp_directory_path() / "solstice_event_log_benchmark").string();
+    const String snapshotPath = prefix + ".snapshot";
+    removeLogs(prefix);
+    std::filesystem::remove(snapshotPath);
+
+    (*config).assetClass(AssetClass::Equity);
+    (*config).ordersToGenerate(ORDERS_PER_RUN);
+    (*config).underlyingPoolCount(UNDERLYINGS);
+    (*config).logLevel(LogLevel::ERROR);
+    (*config).matchingThreads(1);
+
+    std::optional<broadcaster::Broadcaster> broadcaster;
+
+    auto timed = [&](const Config& runConfig) -> std::optional<double>
+    {
+        const auto start = std::chrono::steady_clock::now();
+        auto result = matching::Orchestrator::start(runConfig, broadcaster);
+        const auto end = std::chrono::steady_clock::now();
+
+        if (!result)
+        {
+            std::cout << result.error();
+            return std::nullopt;
+        }
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    };
+
+    std::cout << std::left << std::setw(32) << "Run" << std::right << std::setw(14) << "Events"
+              << std::setw(12) << "Time (ms)"
+              << "\n";
+
+    auto unlogged = timed(*config);
+    if (!unlogged)
+    {
+        return -1;
+    }
+    printRow("generate, no log", 0, *unlogged);
+
+    Config logged = *config;
+    logged.eventLogPath(prefix);
+
+    uint64_t events = 0;
+    for (int run = 1; events < TARGET_EVENTS; run++)
+    {
+        auto ms = timed(logged);
+        if (!ms)
+        {
+            return -1;
+        }
+
+        const uint64_t before = events;
+        events = loggedEvents(prefix);
+        printRow("generate + log, run " + std::to_string(run), events - before, *ms);
+    }
+
+    Config snapshotted = logged;
+    snapshotted.snapshotPath(snapshotPath);
+    snapshotted.snapshotInterval(SNAPSHOT_INTERVAL_MS);
+
+    const uint64_t before = events;
+    auto snapshotRun = timed(snapshotted);
+    if (!snapshotRun)
+    {
+        return -1;
+    }
+    events = loggedEvents(prefix);
+    printRow("generate + log + snapshots", events - before, *snapshotRun);
+
+    Config startup = *config;
+    startup.ordersToGenerate(0);
+
+    auto empty = timed(startup);
+    const auto loadStart = std::chrono::steady_clock::now();
+    const uint64_t loaded = loggedEvents(prefix);
+    const auto loadEnd = std::chrono::steady_clock::now();
+
+    startup.eventLogPath(prefix);
+    auto recovered = timed(startup);
+
+    // the snapshot run's last snapshot was taken as it ended, so no events follow it
+    Config warmStartup = startup;
+    warmStartup.snapshotPath(snapshotPath);
+    auto warm = timed(warmStartup);
+
+    if (!empty || !recovered || !warm)
+    {
+        return -1;
+    }
+
+    printRow("startup, no log", 0, *empty);
+    printRow("map + scan logs", loaded,
+             std::chrono::duration<double, std::milli>(loadEnd - loadStart).count());
+    printRow("startup, recover book", loaded, *recovered);
+    printRow("startup, load snapshot", 0, *warm);
+
+    removeLogs(prefix);
+    std::filesystem::remove(snapshotPath);
+    return 0;
+}
@@ -0,0 +1,145 @@
+// Measures the cost of orders that must not rest: immediate or cancel orders that take what they
+// can and drop the rest, and fill or kill orders that trade completely or not at all.
+//
+// Each step rests a passive order within 10 ticks of the mid, then sends an aggressive order up to
+// 5 ticks through it, so the book keeps its depth. Three workloads run the same steps:
+//   rest/cancel - the aggressor is added to the book, matched and its remainder cancelled, which is
+//                 all an immediate order could do before the book knew about time in force
+//   ioc         - the aggressor is immediate or cancel, matched without entering the book
+//   fok         - the aggressor is fill or kill, checked against the levels' quantities first
+
+#include <asset_class.h>
+#include <fill.h>
+#include <market_side.h>
+#include <matcher.h>
+#include <order.h>
+#include <order_book.h>
+#include <ticks.h>
+#include <time_in_force.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace solstice;
+
+constexpr int STEPS = 1'000'000;
+constexpr int WARM_UP_ORDERS = 10'000;
+
+struct Step
+{
+    matching::OrderPtr passive;
+    matching::OrderPtr aggressive;
+};
+
+std::vector<Step> generateSteps(TimeInForce timeInForce)
+{
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> passiveDist(1, 10);
+    std::uniform_int_distribution<int> throughDist(0, 5);
+    std::uniform_int_distribution<int> qntyDist(1, 20);
+    std::uniform_int_distribution<int> aggressiveQntyDist(10, 60);
+    std::bernoulli_distribution sideDist(0.5);
+
+    const Ticks mid = toTicks(100.0, Equity::AAPL);
+
+    std::vector<Step> steps;
+    steps.reserve(STEPS + WARM_UP_ORDERS);
+
+    for (int i = 0; i < STEPS + WARM_UP_ORDERS; i++)
+    {
+        const int uid = 2 * i + 1;
+
+        const bool bid = sideDist(gen);
+        const Ticks passivePrice = bid ? mid - passiveDist(gen) : mid + passiveDist(gen);
+        auto passive = *Order::create(uid, Equity::AAPL, fromTicks(passivePrice, Equity::AAPL),
+                                      qntyDist(gen), bid ? MarketSide::Bid : MarketSide::Ask);
+
+        // the warm up only rests passive orders
+        if (i < WARM_UP_ORDERS)
+        {
+            steps.push_back({passive, nullptr});
+            continue;
+        }
+
+        const bool aggressiveBid = sideDist(gen);
+        const Ticks aggressivePrice =
+            aggressiveBid ? mid + throughDist(gen) : mid - throughDist(gen);
+        auto aggressive = *Order::create(
+            uid + 1, Equity::AAPL, fromTicks(aggressivePrice, Equity::AAPL),
+            aggressiveQntyDist(gen), aggressiveBid ? MarketSide::Bid : MarketSide::Ask);
+        aggressive->timeInForce(timeInForce);
+
+        steps.push_back({passive, aggressive});
+    }
+
+    return steps;
+}
+
+void run(const char* workload, TimeInForce timeInForce, bool restThenCancel)
+{
+    const auto steps = generateSteps(timeInForce);
+
+    auto orderBook = std::make_shared<matching::OrderBook>();
+    orderBook->initialiseUnderlying(Equity::AAPL);
+    matching::Matcher matcher(orderBook);
+
+    std::vector<matching::Fill> fills;
+    size_t fillCount = 0;
+    size_t filled = 0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < steps.size(); i++)
+    {
+        if (i == WARM_UP_ORDERS)
+        {
+            start = std::chrono::steady_clock::now();
+        }
+
+        orderBook->addOrderToBook(steps[i].passive);
+
+        const matching::OrderPtr& aggressive = steps[i].aggressive;
+        if (!aggressive)
+        {
+            continue;
+        }
+
+        if (restThenCancel)
+        {
+            orderBook->addOrderToBook(aggressive);
+        }
+
+        fills.clear();
+        filled += matcher.matchOrder(aggressive, fills).has_value();
+        fillCount += fills.size();
+
+        if (restThenCancel && aggressive->outstandingQnty() > 0)
+        {
+            (void)orderBook->cancelOrder(Equity::AAPL, aggressive->uid());
+        }
+    }
+
+    const auto end = std::chrono::steady_clock::now();
+    const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+
+    std::cout << std::left << std::setw(14) << workload << std::right << std::setw(10) << fillCount
+              << std::setw(12) << filled << std::fixed << std::setprecision(1) << std::setw(14)
+              << ns / STEPS << "\n";
+}
+
+int main()
+{
+    std::cout << std::left << std::setw(14) << "Workload" << std::right << std::setw(10) << "Fills"
+              << std::setw(12) << "Filled" << std::setw(14) << "ns/step"
+              << "\n";
+
+    run("rest/cancel", TimeInForce::GoodTillCancel, true);
+    run("ioc", TimeInForce::ImmediateOrCancel, false);
+    run("fok", TimeInForce::FillOrKill, false);
+
+    return 0;
+}
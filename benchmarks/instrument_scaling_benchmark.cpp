@@ -0,0 +1,109 @@
+// Measures how throughput and memory scale with the number of instruments traded, loading a
+// generated definitions file of 10 up to 10,000 equities and drawing the pool from all of them.
+//
+// Uses the 100,000 order config from the v0.2.0 entry in BENCHMARK_HISTORY.md otherwise. Each size
+// runs in its own process, as the universe and pools are process wide and peak RSS only grows.
+
+#include <asset_class.h>
+#include <broadcaster.h>
+#include <config.h>
+#include <log_level.h>
+#include <orchestrator.h>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+
+using namespace solstice;
+
+constexpr int ORDERS = 100'000;
+
+String writeDefinitions(int symbols)
+{
+    const String path =
+        (std::filesystem::temp_directory_path() / std::format("solstice_instruments_{}.csv", symbols))
+            .string();
+
+    std::ofstream file(path);
+    file << "symbol,asset_class,tick_size,underlying,strike,expiry,option_type\n";
+    for (int i = 0; i < symbols; i++)
+    {
+        file << std::format("SYM{:05},Equity,0.01,,,,\n", i);
+    }
+    return path;
+}
+
+int run(Config config, int symbols)
+{
+    config.instrumentsPath(writeDefinitions(symbols));
+    config.underlyingPoolCount(symbols);
+
+    std::optional<broadcaster::Broadcaster> broadcaster;
+
+    const auto start = std::chrono::steady_clock::now();
+    auto result = matching::Orchestrator::start(config, broadcaster);
+    const auto end = std::chrono::steady_clock::now();
+
+    std::filesystem::remove(config.instrumentsPath());
+
+    if (!result)
+    {
+        std::cout << result.error();
+        return -1;
+    }
+
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+
+    const double ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    std::cout << std::setw(10) << symbols << std::fixed << std::setprecision(0) << std::setw(12)
+              << ms << std::setw(16) << ORDERS / (ms / 1000.0) << std::setprecision(1)
+              << std::setw(16) << usage.ru_maxrss / 1024.0 << "\n";
+    return 0;
+}
+
+int main()
+{
+    auto config = Config::instance();
+    if (!config)
+    {
+        std::cout << config.error();
+        return -1;
+    }
+
+    (*config).assetClass(AssetClass::Equity);
+    (*config).ordersToGenerate(ORDERS);
+    (*config).logLevel(LogLevel::ERROR);
+
+    std::cout << std::setw(10) << "Symbols" << std::setw(12) << "Time (ms)" << std::setw(16)
+              << "Orders/sec" << std::setw(16) << "Peak RSS (MB)"
+              << "\n"
+              << std::flush;
+
+    for (int symbols : {10, 100, 1'000, 10'000})
+    {
+        const pid_t pid = fork();
+        if (pid == 0)
+        {
+            std::exit(run(*config, symbols));
+        }
+
+        int status = 0;
+        waitpid(pid, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        {
+            return -1;
+        }
+    }
+
+    return 0;
+}
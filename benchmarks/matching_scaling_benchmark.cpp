@@ -0,0 +1,96 @@
+// Measures how the orchestrator scales with the number of matching threads, comparing the shared
+// queue (every worker locks the underlying it matches) against sharded matching (each underlying
+// is owned by one worker and matched without locks).
+//
+// Uses the 10 ticker, 100,000 order config from the v0.2.0 entry in BENCHMARK_HISTORY.md, running
+// each mode with 1 up to one thread per hardware thread. A final sweep keeps one matching thread
+// per hardware thread and varies the number of generator threads, to show how ingress scales once
+// pricing is spread across cores.
+
+#include <asset_class.h>
+#include <broadcaster.h>
+#include <config.h>
+#include <log_level.h>
+#include <orchestrator.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <thread>
+
+using namespace solstice;
+
+constexpr int ORDERS = 100'000;
+constexpr int UNDERLYINGS = 10;
+
+int main()
+{
+    auto config = Config::instance();
+    if (!config)
+    {
+        std::cout << config.error();
+        return -1;
+    }
+
+    (*config).assetClass(AssetClass::Equity);
+    (*config).ordersToGenerate(ORDERS);
+    (*config).underlyingPoolCount(UNDERLYINGS);
+    (*config).logLevel(LogLevel::ERROR);
+
+    const int maxThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::cout << std::left << std::setw(10) << "Mode" << std::right << std::setw(10) << "Threads"
+              << std::setw(12) << "Generators" << std::setw(12) << "Time (ms)" << std::setw(16)
+              << "Orders/sec"
+              << "\n";
+
+    auto run = [&](bool sharded, int threads, int generators)
+    {
+        (*config).shardedMatching(sharded);
+        (*config).matchingThreads(threads);
+        (*config).generatorThreads(generators);
+
+        std::optional<broadcaster::Broadcaster> broadcaster;
+
+        const auto start = std::chrono::steady_clock::now();
+        auto result = matching::Orchestrator::start(*config, broadcaster);
+        const auto end = std::chrono::steady_clock::now();
+
+        if (!result)
+        {
+            std::cout << result.error();
+            return false;
+        }
+
+        const double ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+        std::cout << std::left << std::setw(10) << (sharded ? "sharded" : "shared") << std::right
+                  << std::setw(10) << threads << std::setw(12) << generators << std::fixed
+                  << std::setprecision(0) << std::setw(12) << ms << std::setw(16)
+                  << ORDERS / (ms / 1000.0) << "\n";
+        return true;
+    };
+
+    for (bool sharded : {false, true})
+    {
+        for (int threads = 1; threads <= maxThreads; threads++)
+        {
+            if (!run(sharded, threads, 1))
+            {
+                return -1;
+            }
+        }
+    }
+
+    for (int generators = 2; generators <= maxThreads; generators++)
+    {
+        if (!run(true, maxThreads, generators))
+        {
+            return -1;
+        }
+    }
+
+    return 0;
+}
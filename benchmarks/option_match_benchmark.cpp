@@ -0,0 +1,105 @@
+// Measures the cost per order of matching options, where every lookup of an order's book has to
+// read its strike, expiry and type, and every fill logged prints them.
+//
+// Orders are created up front so only the book and matcher are timed. Two workloads are run:
+//   match      - each order is matched and what it leaves added to the book, as the orchestrator
+//                does
+//   match/log  - as above, also formatting the fills of every order that traded
+
+#include <asset_class.h>
+#include <fill.h>
+#include <market_side.h>
+#include <matcher.h>
+#include <option_type.h>
+#include <options.h>
+#include <order.h>
+#include <order_book.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace solstice;
+
+constexpr int ORDERS = 500'000;
+constexpr int SERIES = 8;
+
+std::vector<matching::OrderPtr> generateOrders()
+{
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> seriesDist(0, SERIES - 1);
+    std::uniform_int_distribution<int> centsDist(450, 550);
+    std::uniform_int_distribution<int> qntyDist(1, 20);
+    std::bernoulli_distribution sideDist(0.5);
+
+    std::vector<matching::OrderPtr> orders;
+    orders.reserve(ORDERS);
+
+    for (int i = 0; i < ORDERS; i++)
+    {
+        const int series = seriesDist(gen);
+        auto order = OptionOrder::create(i, Option::AAPL_JUN26_C, centsDist(gen) / 100.0,
+                                         qntyDist(gen),
+                                         sideDist(gen) ? MarketSide::Bid : MarketSide::Ask,
+                                         140.0 + 5.0 * (series % 4),
+                                         series < 4 ? OptionType::Call : OptionType::Put, 0.5);
+        orders.push_back(*order);
+    }
+
+    return orders;
+}
+
+void run(const char* workload, const std::vector<matching::OrderPtr>& orders, bool log)
+{
+    auto orderBook = std::make_shared<matching::OrderBook>();
+    orderBook->initialiseUnderlying(Option::AAPL_JUN26_C);
+    matching::Matcher matcher(orderBook);
+
+    std::vector<matching::Fill> fills;
+    size_t fillCount = 0;
+    size_t logged = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (const auto& order : orders)
+    {
+        fills.clear();
+        matcher.matchOrder(order, fills);
+
+        if (order->outstandingQnty() > 0)
+        {
+            orderBook->addOrderToBook(order);
+        }
+        fillCount += fills.size();
+
+        if (log && !fills.empty())
+        {
+            logged += matcher.formatFills(order, fills).size();
+        }
+    }
+
+    const auto end = std::chrono::steady_clock::now();
+    const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+
+    std::cout << std::left << std::setw(12) << workload << std::right << std::setw(10) << fillCount
+              << std::fixed << std::setprecision(1) << std::setw(14) << ns / ORDERS
+              << std::setw(14) << ns / fillCount << std::setw(14) << logged / 1024 << "\n";
+}
+
+int main()
+{
+    const auto orders = generateOrders();
+
+    std::cout << std::left << std::setw(12) << "Workload" << std::right << std::setw(10) << "Fills"
+              << std::setw(14) << "ns/order" << std::setw(14) << "ns/fill" << std::setw(14)
+              << "Logged (KB)"
+              << "\n";
+
+    run("match", orders, false);
+    run("match/log", generateOrders(), true);
+
+    return 0;
+}
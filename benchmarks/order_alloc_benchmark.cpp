@@ -0,0 +1,181 @@
+// Compares heap allocations and throughput of pooled orders against plain new + shared_ptr.
+//
+// Two workloads are run for each allocation path:
+//   create/release - orders are created and dropped with a bounded number alive at once,
+//                    isolating the cost of the order records themselves
+//   create/match   - orders are created, matched and what they leave added to a book, as the
+//                    orchestrator does
+
+#include <asset_class.h>
+#include <fill.h>
+#include <market_side.h>
+#include <matcher.h>
+#include <order.h>
+#include <order_book.h>
+#include <order_pool.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+std::atomic<size_t> g_allocations{0};
+
+}  // namespace
+
+void* operator new(size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size);
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
+using namespace solstice;
+
+constexpr int ORDERS = 1'000'000;
+constexpr size_t LIVE_ORDERS = 1024;
+constexpr int UNDERLYINGS = 10;
+
+struct Result
+{
+    double allocationsPerOrder;
+    double ordersPerSecond;
+};
+
+struct OrderParams
+{
+    Equity underlying;
+    double price;
+    int qnty;
+    MarketSide side;
+};
+
+std::vector<OrderParams> generateParams()
+{
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> underlyingDist(0, UNDERLYINGS - 1);
+    std::uniform_int_distribution<int> centsDist(900, 1000);
+    std::uniform_int_distribution<int> qntyDist(1, 20);
+    std::bernoulli_distribution sideDist(0.5);
+
+    std::vector<OrderParams> params;
+    params.reserve(ORDERS);
+
+    for (int i = 0; i < ORDERS; i++)
+    {
+        params.push_back({underlyingsPool<Equity>()[underlyingDist(gen)], centsDist(gen) / 100.0,
+                          qntyDist(gen), sideDist(gen) ? MarketSide::Bid : MarketSide::Ask});
+    }
+
+    return params;
+}
+
+template <typename Func>
+Result measure(Func&& func)
+{
+    const size_t allocationsBefore = g_allocations.load();
+    const auto start = std::chrono::steady_clock::now();
+
+    func();
+
+    const auto end = std::chrono::steady_clock::now();
+    const size_t allocations = g_allocations.load() - allocationsBefore;
+    const double seconds = std::chrono::duration<double>(end - start).count();
+
+    return {static_cast<double>(allocations) / ORDERS, ORDERS / seconds};
+}
+
+Result createRelease(const std::vector<OrderParams>& params)
+{
+    std::vector<matching::OrderPtr> live(LIVE_ORDERS);
+
+    return measure(
+        [&]
+        {
+            for (int i = 0; i < ORDERS; i++)
+            {
+                const auto& p = params[i];
+                live[i % LIVE_ORDERS] = *Order::create(i, p.underlying, p.price, p.qnty, p.side);
+            }
+        });
+}
+
+Result createMatch(const std::vector<OrderParams>& params)
+{
+    auto orderBook = std::make_shared<matching::OrderBook>();
+    orderBook->initialiseBookAtUnderlyings<Equity>();
+
+    matching::Matcher matcher(orderBook);
+    std::vector<matching::Fill> fills;
+
+    return measure(
+        [&]
+        {
+            for (int i = 0; i < ORDERS; i++)
+            {
+                const auto& p = params[i];
+                auto order = *Order::create(i, p.underlying, p.price, p.qnty, p.side);
+
+                fills.clear();
+                matcher.matchOrder(order, fills);
+
+                if (order->outstandingQnty() > 0)
+                {
+                    orderBook->addOrderToBook(order);
+                }
+            }
+        });
+}
+
+void report(const char* workload, const char* path, const Result& result)
+{
+    std::cout << std::left << std::setw(16) << workload << std::setw(10) << path << std::right
+              << std::fixed << std::setprecision(2) << std::setw(14)
+              << result.allocationsPerOrder << std::setprecision(0) << std::setw(16)
+              << result.ordersPerSecond << "\n";
+}
+
+int main()
+{
+    setUnderlyingsPool(UNDERLYINGS, ALL_EQUITIES);
+    const auto params = generateParams();
+
+    std::cout << std::left << std::setw(16) << "Workload" << std::setw(10) << "Path" << std::right
+              << std::setw(14) << "Allocs/order" << std::setw(16) << "Orders/sec"
+              << "\n";
+
+    for (bool pooled : {false, true})
+    {
+        OrderPool::enabled(pooled);
+        report("create/release", pooled ? "pooled" : "heap", createRelease(params));
+    }
+
+    for (bool pooled : {false, true})
+    {
+        OrderPool::enabled(pooled);
+        report("create/match", pooled ? "pooled" : "heap", createMatch(params));
+    }
+
+    return 0;
+}
@@ -0,0 +1,99 @@
+// Separates matching cost from generation cost. Records the 10 ticker, 100,000 order config from
+// the v0.2.0 entry in BENCHMARK_HISTORY.md to a journal once, then times generating and matching
+// live against replaying the identical order flow, single threaded and per shard.
+
+#include <asset_class.h>
+#include <broadcaster.h>
+#include <config.h>
+#include <log_level.h>
+#include <orchestrator.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <thread>
+
+using namespace solstice;
+
+constexpr int ORDERS = 100'000;
+constexpr int UNDERLYINGS = 10;
+constexpr uint64_t SEED = 42;
+
+int main()
+{
+    auto config = Config::instance();
+    if (!config)
+    {
+        std::cout << config.error();
+        return -1;
+    }
+
+    const auto journal = std::filesystem::temp_directory_path() / "solstice_replay_benchmark";
+
+    (*config).assetClass(AssetClass::Equity);
+    (*config).ordersToGenerate(ORDERS);
+    (*config).underlyingPoolCount(UNDERLYINGS);
+    (*config).logLevel(LogLevel::ERROR);
+    (*config).randomSeed(SEED);
+    (*config).matchingThreads(1);
+
+    std::cout << std::left << std::setw(24) << "Run" << std::right << std::setw(12) << "Time (ms)"
+              << std::setw(16) << "Orders/sec"
+              << "\n";
+
+    auto run = [&](const char* name, Config runConfig)
+    {
+        std::optional<broadcaster::Broadcaster> broadcaster;
+
+        const auto start = std::chrono::steady_clock::now();
+        auto result = matching::Orchestrator::start(runConfig, broadcaster);
+        const auto end = std::chrono::steady_clock::now();
+
+        if (!result)
+        {
+            std::cout << result.error();
+            return false;
+        }
+
+        const double ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+        std::cout << std::left << std::setw(24) << name << std::right << std::fixed
+                  << std::setprecision(0) << std::setw(12) << ms << std::setw(16)
+                  << ORDERS / (ms / 1000.0) << "\n";
+        return true;
+    };
+
+    Config record = *config;
+    record.journalPath(journal.string());
+    if (!run("generate + record", record) || !run("generate", *config))
+    {
+        return -1;
+    }
+
+    Config replay = *config;
+    replay.replayPath(journal.string());
+
+    replay.shardedMatching(false);
+    if (!run("replay single thread", replay))
+    {
+        return -1;
+    }
+
+    replay.shardedMatching(true);
+    const int maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (int threads = 1; threads <= maxThreads; threads++)
+    {
+        replay.matchingThreads(threads);
+        const String name = "replay " + std::to_string(threads) + " shard(s)";
+        if (!run(name.c_str(), replay))
+        {
+            return -1;
+        }
+    }
+
+    std::filesystem::remove(journal);
+    return 0;
+}
@@ -3,10 +3,33 @@
 
 #include <expected>
 #include <string>
+#include <utility>
+#include <variant>
 
 namespace resolution
 {
 
+// Error made of an enum code plus optional context, only turned into a string when message() is
+// called. Building one never allocates, so it suits failures that are common on hot paths and
+// usually discarded unread. message() calls describe(code, context), found by ADL alongside Code.
+template <typename Code, typename Context = std::monostate>
+class CodedError
+{
+   public:
+    CodedError(Code code, Context context = {}) : m_code(code), m_context(std::move(context)) {}
+
+    Code code() const { return m_code; }
+    const Context& context() const { return m_context; }
+
+    std::string message() const { return describe(m_code, m_context); }
+
+    bool operator==(Code code) const { return m_code == code; }
+
+   private:
+    Code m_code;
+    Context m_context;
+};
+
 template <typename T, typename E = std::string>
 class Resolution
 {
@@ -80,6 +103,16 @@ auto err(E error)
     return std::unexpected(std::string(std::move(error)));
 }
 
+// counterpart to err for Resolutions carrying a CodedError
+template <typename Code, typename Context = std::monostate>
+auto fail(Code code, Context context = {})
+{
+    return std::unexpected(CodedError<Code, Context>(code, std::move(context)));
+}
+
+template <typename T, typename Code, typename Context = std::monostate>
+using CodedResolution = Resolution<T, CodedError<Code, Context>>;
+
 }  // namespace resolution
 
 #endif  // RESOLUTION_H
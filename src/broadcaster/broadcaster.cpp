@@ -2,6 +2,7 @@
 #include <broadcaster.h>
 #include <config.h>
 #include <order.h>
+#include <ticks.h>
 #include <transaction.h>
 #include <types.h>
 
@@ -9,6 +10,8 @@
 #include <chrono>
 #include <cstdint>
 #include <iostream>
+#include <span>
+#include <vector>
 
 namespace solstice::broadcaster
 {
@@ -21,6 +24,18 @@ int64_t timePointToNanos(const TimePoint& tp)
     return std::chrono::duration_cast<std::chrono::nanoseconds>(tp.time_since_epoch()).count();
 }
 
+json depthToJson(const Underlying& underlying, std::span<const matching::DepthLevel> levels)
+{
+    json side = json::array();
+    for (const auto& level : levels)
+    {
+        side.push_back({{"price", fromTicks(level.price, underlying)},
+                        {"quantity", level.qnty},
+                        {"orders", level.orders}});
+    }
+    return side;
+}
+
 }  // namespace
 
 // ===================================================================
@@ -295,14 +310,16 @@ void Broadcaster::broadcastWorker()
     }
 }
 
-void Broadcaster::broadcastTrade(const matching::OrderPtr& order)
+void Broadcaster::broadcastTrade(const matching::Transaction& transaction)
 {
     json msg = {{"type", "trade"},
-                {"transaction_id", order->uid()},
-                {"symbol", to_string(order->underlying())},
-                {"price", order->price()},
-                {"quantity", order->qnty()},
-                {"timestamp", timePointToNanos(*order->timeOrderFulfilled())}};
+                {"transaction_id", transaction.sequence()},
+                {"symbol", to_string(transaction.underlying())},
+                {"price", transaction.price()},
+                {"quantity", transaction.qnty()},
+                {"bid_uid", transaction.bidUid()},
+                {"ask_uid", transaction.askUid()},
+                {"timestamp", timePointToNanos(timeNow())}};
 
     broadcast(msg.dump());
 }
@@ -312,56 +329,30 @@ void Broadcaster::broadcastBook(const Underlying& underlying,
 {
     int count = d_orderCounter.fetch_add(1, std::memory_order_relaxed);
 
-    int broadcastInterval = (*Config::instance()).broadcastInterval();
-    if (count % broadcastInterval != 0)
+    auto config = Config::instance();
+    if (count % (*config).broadcastInterval() != 0)
     {
         return;
     }
 
-    auto activeOrdersOpt = orderBook->getActiveOrders(underlying);
-    if (!activeOrdersOpt)
-    {
-        return;
-    }
+    // each level carries its own quantity and order count, so only the levels sent are read
+    thread_local std::vector<matching::DepthLevel> bids;
+    thread_local std::vector<matching::DepthLevel> asks;
 
-    const auto& activeOrders = activeOrdersOpt->get();
-
-    // Get highest bid (last element in map since it's sorted ascending)
-    std::optional<double> bestBid;
-    for (auto it = activeOrders.bids.rbegin(); it != activeOrders.bids.rend(); ++it)
-    {
-        int totalQnty = 0;
-        for (const auto& o : it->second)
-        {
-            totalQnty += o->outstandingQnty();
-        }
-        if (totalQnty > 0)
-        {
-            bestBid = it->first;
-            break;
-        }
-    }
+    bids.resize(std::max(1, (*config).broadcastDepth()));
+    asks.resize(bids.size());
+    bids.resize(orderBook->depth(underlying, MarketSide::Bid, bids));
+    asks.resize(orderBook->depth(underlying, MarketSide::Ask, asks));
 
-    // Get lowest ask (first element in map since it's sorted ascending)
-    std::optional<double> bestAsk;
-    for (const auto& [price, orders] : activeOrders.asks)
-    {
-        int totalQnty = 0;
-        for (const auto& o : orders)
-        {
-            totalQnty += o->outstandingQnty();
-        }
-        if (totalQnty > 0)
-        {
-            bestAsk = price;
-            break;
-        }
-    }
+    auto best = [&underlying](const std::vector<matching::DepthLevel>& levels)
+    { return levels.empty() ? json(nullptr) : json(fromTicks(levels.front().price, underlying)); };
 
     json msg = {{"type", "book"},
                 {"symbol", to_string(underlying)},
-                {"best_bid", bestBid.has_value() ? json(bestBid.value()) : json(nullptr)},
-                {"best_ask", bestAsk.has_value() ? json(bestAsk.value()) : json(nullptr)},
+                {"best_bid", best(bids)},
+                {"best_ask", best(asks)},
+                {"bids", depthToJson(underlying, bids)},
+                {"asks", depthToJson(underlying, asks)},
                 {"timestamp", timePointToNanos(timeNow())}};
 
     std::unique_lock<std::mutex> lock(d_queueMutex, std::try_to_lock);
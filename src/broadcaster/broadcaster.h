@@ -44,7 +44,7 @@ class Broadcaster
     Broadcaster(const Broadcaster&) = delete;
     Broadcaster& operator=(const Broadcaster&) = delete;
 
-    void broadcastTrade(const ::solstice::matching::OrderPtr& order);
+    void broadcastTrade(const ::solstice::matching::Transaction& transaction);
     void broadcastBook(const Underlying& underlying,
                        const std::shared_ptr<::solstice::matching::OrderBook>& orderBook);
 
@@ -0,0 +1,274 @@
+#include <book_event_type.h>
+#include <event_log.h>
+#include <fill.h>
+#include <mapped_file.h>
+#include <order.h>
+#include <order_journal.h>
+#include <types.h>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <span>
+#include <variant>
+#include <vector>
+
+namespace solstice
+{
+
+BookEvent BookEvent::accepted(const Order& order)
+{
+    BookEvent event{};
+
+    event.type = static_cast<uint8_t>(BookEventType::Accept);
+    event.price = order.priceTicks();
+    event.order = JournalRecord::fromOrder(order);
+
+    return event;
+}
+
+BookEvent BookEvent::filled(const Order& incomingOrder, const matching::Fill& fill)
+{
+    return filled(incomingOrder.underlying(), incomingOrder.marketSide(), fill);
+}
+
+BookEvent BookEvent::filled(const Underlying& underlying, MarketSide incomingSide,
+                            const matching::Fill& fill)
+{
+    BookEvent event{};
+
+    event.type = static_cast<uint8_t>(BookEventType::Fill);
+    event.restingUid = fill.restingUid;
+    event.price = fill.price;
+
+    // only what recovery needs to find both orders, so no option details
+    event.order.uid = fill.incomingUid;
+    event.order.assetClass = static_cast<uint8_t>(underlying.index());
+    event.order.underlying =
+        std::visit([](auto ticker) { return static_cast<uint32_t>(ticker); }, underlying);
+    event.order.marketSide = static_cast<uint8_t>(incomingSide);
+    event.order.qnty = fill.qnty;
+
+    return event;
+}
+
+BookEvent BookEvent::cancelled(const Order& order)
+{
+    BookEvent event = accepted(order);
+    event.type = static_cast<uint8_t>(BookEventType::Cancel);
+    return event;
+}
+
+BookEvent BookEvent::auctionStarted(const Underlying& underlying)
+{
+    BookEvent event{};
+
+    event.type = static_cast<uint8_t>(BookEventType::AuctionStart);
+    event.order.assetClass = static_cast<uint8_t>(underlying.index());
+    event.order.underlying =
+        std::visit([](auto ticker) { return static_cast<uint32_t>(ticker); }, underlying);
+
+    return event;
+}
+
+BookEvent BookEvent::uncrossed(const Underlying& underlying)
+{
+    BookEvent event = auctionStarted(underlying);
+    event.type = static_cast<uint8_t>(BookEventType::Uncross);
+    return event;
+}
+
+BookEventType BookEvent::eventType() const { return static_cast<BookEventType>(type); }
+
+String eventLogPath(const String& prefix, size_t index)
+{
+    return std::format("{}.{}", prefix, index);
+}
+
+EventLog::EventLog(MappedFile file, std::span<const BookEvent> events)
+    : d_file(std::move(file)), d_events(events)
+{
+}
+
+Resolution<EventLog> EventLog::load(const String& path)
+{
+    auto file = MappedFile::openReadOnly(path);
+    if (!file)
+    {
+        return resolution::err(file.error());
+    }
+
+    EventLogHeader header;
+    if ((*file).size() < sizeof(header))
+    {
+        return resolution::err(std::format("Event log {} is missing its header\n", path));
+    }
+
+    std::memcpy(&header, (*file).data(), sizeof(header));
+    if (header.magic != EventLogHeader::MAGIC || header.version != EventLogHeader::VERSION ||
+        header.recordSize != sizeof(BookEvent))
+    {
+        return resolution::err(std::format("{} is not a version {} event log\n", path,
+                                           EventLogHeader::VERSION));
+    }
+
+    std::span<const BookEvent> slots(
+        reinterpret_cast<const BookEvent*>((*file).data() + sizeof(header)),
+        ((*file).size() - sizeof(header)) / sizeof(BookEvent));
+
+    size_t count = 0;
+    uint64_t previous = 0;
+    while (count < slots.size() && slots[count].sequence > previous)
+    {
+        previous = slots[count].sequence;
+        count++;
+    }
+
+    return EventLog(std::move(*file), slots.first(count));
+}
+
+Resolution<std::vector<EventLog>> EventLog::loadAll(const String& prefix)
+{
+    std::vector<EventLog> logs;
+
+    for (size_t i = 0; std::filesystem::exists(eventLogPath(prefix, i)); i++)
+    {
+        auto log = load(eventLogPath(prefix, i));
+        if (!log)
+        {
+            return resolution::err(log.error());
+        }
+        logs.push_back(std::move(*log));
+    }
+
+    return logs;
+}
+
+std::span<const BookEvent> EventLog::events() const { return d_events; }
+
+EventLogWriter::EventLogWriter(MappedFile file, uint64_t size, size_t flushInterval)
+    : d_file(std::move(file)), d_size(size), d_flushed(size), d_flushInterval(flushInterval)
+{
+}
+
+EventLogWriter::~EventLogWriter() { (void)close(); }
+
+Resolution<std::unique_ptr<EventLogWriter>> EventLogWriter::open(const String& path,
+                                                                 size_t flushInterval)
+{
+    // events already in the log are kept, and anything after them left by a crash is cleared
+    uint64_t existing = 0;
+    const size_t fileSize = std::filesystem::exists(path) ? std::filesystem::file_size(path) : 0;
+    if (fileSize > 0)
+    {
+        auto log = EventLog::load(path);
+        if (!log)
+        {
+            return resolution::err(log.error());
+        }
+        existing = (*log).events().size();
+    }
+
+    const size_t capacity = std::max<size_t>(INITIAL_CAPACITY, existing * 2);
+
+    auto file =
+        MappedFile::openWritable(path, sizeof(EventLogHeader) + capacity * sizeof(BookEvent));
+    if (!file)
+    {
+        return resolution::err(file.error());
+    }
+
+    const EventLogHeader header;
+    std::memcpy((*file).data(), &header, sizeof(header));
+
+    // past the old end of the file the mapping is already zero
+    const size_t written = sizeof(header) + existing * sizeof(BookEvent);
+    if (fileSize > written)
+    {
+        std::memset((*file).data() + written, 0, fileSize - written);
+    }
+
+    return std::unique_ptr<EventLogWriter>(
+        new EventLogWriter(std::move(*file), existing, flushInterval));
+}
+
+void EventLogWriter::append(std::span<const BookEvent> events)
+{
+    for (const auto& event : events)
+    {
+        if (d_size == capacity())
+        {
+            grow();
+        }
+
+        if (d_failed)
+        {
+            return;
+        }
+
+        this->events()[d_size++] = event;
+    }
+
+    if (d_flushInterval > 0 && d_size - d_flushed >= d_flushInterval)
+    {
+        flush();
+    }
+}
+
+void EventLogWriter::flush()
+{
+    d_file.flushAsync(offsetOf(d_flushed), offsetOf(d_size) - offsetOf(d_flushed));
+    d_flushed = d_size;
+}
+
+Resolution<std::monostate> EventLogWriter::close()
+{
+    if (d_closed)
+    {
+        return std::monostate{};
+    }
+    d_closed = true;
+
+    auto closed = d_file.close(offsetOf(d_size));
+    if (!closed)
+    {
+        return closed;
+    }
+
+    if (d_failed)
+    {
+        return resolution::err("Event log ran out of space, later events were not logged\n");
+    }
+    return std::monostate{};
+}
+
+uint64_t EventLogWriter::size() const { return d_size; }
+
+BookEvent* EventLogWriter::events()
+{
+    return reinterpret_cast<BookEvent*>(d_file.data() + sizeof(EventLogHeader));
+}
+
+size_t EventLogWriter::capacity() const
+{
+    return d_file.data() ? (d_file.size() - sizeof(EventLogHeader)) / sizeof(BookEvent) : 0;
+}
+
+size_t EventLogWriter::offsetOf(uint64_t event) const
+{
+    return sizeof(EventLogHeader) + event * sizeof(BookEvent);
+}
+
+void EventLogWriter::grow()
+{
+    const size_t doubled = std::max<size_t>(INITIAL_CAPACITY, capacity() * 2);
+
+    if (!d_file.resize(offsetOf(doubled)))
+    {
+        d_failed = true;
+    }
+}
+
+}  // namespace solstice
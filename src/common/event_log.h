@@ -0,0 +1,130 @@
+#ifndef EVENT_LOG_H
+#define EVENT_LOG_H
+
+#include <asset_class.h>
+#include <book_event_type.h>
+#include <fill.h>
+#include <mapped_file.h>
+#include <market_side.h>
+#include <order.h>
+#include <order_journal.h>
+#include <ticks.h>
+#include <types.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace solstice
+{
+
+// One change to the book, in the fixed binary layout it has in the event log. Sequence numbers
+// are shared by every log of a run, so the logs merge back into the order the events happened in
+struct BookEvent
+{
+    uint64_t sequence;
+    uint8_t type;  // a BookEventType
+    uint8_t reserved[3];
+    int32_t restingUid;  // fills only
+    Ticks price;         // the order's limit price, or the price a fill traded at
+    // the accepted or cancelled order. For a fill, the incoming order's uid and instrument with the
+    // quantity traded, and for an auction event just the instrument
+    JournalRecord order;
+
+    static BookEvent accepted(const Order& order);
+    static BookEvent filled(const Order& incomingOrder, const matching::Fill& fill);
+    // as above for a fill with no order at hand, such as one traded when an auction uncrossed
+    static BookEvent filled(const Underlying& underlying, MarketSide incomingSide,
+                            const matching::Fill& fill);
+    static BookEvent cancelled(const Order& order);
+    static BookEvent auctionStarted(const Underlying& underlying);
+    static BookEvent uncrossed(const Underlying& underlying);
+
+    BookEventType eventType() const;
+};
+
+static_assert(sizeof(BookEvent) == 64, "event log layout is part of the file format");
+
+struct EventLogHeader
+{
+    static constexpr uint64_t MAGIC = 0x4c4157454c4f53;  // "SOLEWAL"
+    static constexpr uint32_t VERSION = 2;
+
+    uint64_t magic = MAGIC;
+    uint32_t version = VERSION;
+    uint32_t recordSize = sizeof(BookEvent);
+    uint8_t reserved[48] = {};  // keeps every event on its own cache line
+};
+
+static_assert(sizeof(EventLogHeader) == sizeof(BookEvent));
+
+// the path of the index'th log of a run logging to prefix
+String eventLogPath(const String& prefix, size_t index);
+
+// A log file mapped read only. Events are checked as they are found: the log ends at the first
+// slot that was never written, or whose sequence doesn't follow on, as a crash can leave either
+class EventLog
+{
+   public:
+    static Resolution<EventLog> load(const String& path);
+
+    // every log of a run logging to prefix, in index order
+    static Resolution<std::vector<EventLog>> loadAll(const String& prefix);
+
+    std::span<const BookEvent> events() const;
+
+   private:
+    EventLog(MappedFile file, std::span<const BookEvent> events);
+
+    MappedFile d_file;
+    std::span<const BookEvent> d_events;
+};
+
+// Appends events to a memory mapped log, continuing after any events already in it. Appending is
+// a copy into the mapping, with writeback to disk scheduled every flushInterval events but never
+// waited for, so matching doesn't stall on the disk. Not thread safe, each writer is meant to be
+// owned by a single matching thread.
+class EventLogWriter
+{
+   public:
+    static Resolution<std::unique_ptr<EventLogWriter>> open(const String& path,
+                                                             size_t flushInterval);
+
+    ~EventLogWriter();
+
+    void append(std::span<const BookEvent> events);
+
+    // schedules writeback of everything appended since the last flush
+    void flush();
+
+    // waits for every appended event to reach the disk and trims the file to the events written
+    Resolution<std::monostate> close();
+
+    // events in the log, including those found when it was opened
+    uint64_t size() const;
+
+   private:
+    // events the mapping grows by once it fills up, doubling from there
+    static constexpr size_t INITIAL_CAPACITY = 16384;
+
+    EventLogWriter(MappedFile file, uint64_t size, size_t flushInterval);
+
+    BookEvent* events();
+    size_t capacity() const;
+    size_t offsetOf(uint64_t event) const;
+
+    void grow();
+
+    MappedFile d_file;
+    uint64_t d_size;
+    uint64_t d_flushed;
+    size_t d_flushInterval;
+    bool d_failed = false;
+    bool d_closed = false;
+};
+
+}  // namespace solstice
+
+#endif  // EVENT_LOG_H
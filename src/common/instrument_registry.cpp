@@ -0,0 +1,40 @@
+#include <instrument_registry.h>
+
+namespace solstice
+{
+
+InstrumentId InstrumentRegistry::add(const Underlying& underlying)
+{
+    auto& ids = d_idOfValue[underlying.index()];
+    const size_t value = valueOf(underlying);
+    if (value >= ids.size())
+    {
+        ids.resize(value + 1, NULL_INSTRUMENT);
+    }
+
+    InstrumentId& id = ids[value];
+    if (id == NULL_INSTRUMENT)
+    {
+        id = static_cast<InstrumentId>(d_underlyings.size());
+        d_underlyings.push_back(underlying);
+    }
+    return id;
+}
+
+bool InstrumentRegistry::contains(const Underlying& underlying) const
+{
+    return find(underlying).has_value();
+}
+
+const Underlying& InstrumentRegistry::underlying(InstrumentId id) const
+{
+    return d_underlyings.at(id);
+}
+
+std::span<const Underlying> InstrumentRegistry::instruments() const { return d_underlyings; }
+
+size_t InstrumentRegistry::size() const { return d_underlyings.size(); }
+
+bool InstrumentRegistry::empty() const { return d_underlyings.empty(); }
+
+}  // namespace solstice
@@ -0,0 +1,70 @@
+#ifndef INSTRUMENT_REGISTRY_H
+#define INSTRUMENT_REGISTRY_H
+
+#include <asset_class.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <variant>
+#include <vector>
+
+namespace solstice
+{
+
+using InstrumentId = uint32_t;
+
+constexpr InstrumentId NULL_INSTRUMENT = std::numeric_limits<InstrumentId>::max();
+
+// Numbers each tradable instrument densely from 0 in the order it is added, so anything kept per
+// instrument can be a vector indexed by its id rather than a map keyed by the Underlying variant.
+// Looking an instrument up is a bounds check and an array read and never hashes. Adding one is
+// setup work and is not safe alongside threads looking instruments up.
+class InstrumentRegistry
+{
+   public:
+    // the instrument's id, numbering it next if it has none yet
+    InstrumentId add(const Underlying& underlying);
+
+    std::optional<InstrumentId> find(const Underlying& underlying) const;
+    bool contains(const Underlying& underlying) const;
+
+    const Underlying& underlying(InstrumentId id) const;
+
+    // every instrument added so far, indexed by id
+    std::span<const Underlying> instruments() const;
+
+    size_t size() const;
+    bool empty() const;
+
+   private:
+    static size_t valueOf(const Underlying& underlying);
+
+    // ids indexed by the Equity, Future or Option value, grown as the instruments are added since
+    // a loaded universe can hold any number of each
+    std::array<std::vector<InstrumentId>, std::variant_size_v<Underlying>> d_idOfValue;
+    std::vector<Underlying> d_underlyings;
+};
+
+inline size_t InstrumentRegistry::valueOf(const Underlying& underlying)
+{
+    return std::visit([](auto asset) { return static_cast<size_t>(asset); }, underlying);
+}
+
+inline std::optional<InstrumentId> InstrumentRegistry::find(const Underlying& underlying) const
+{
+    const auto& ids = d_idOfValue[underlying.index()];
+    const size_t value = valueOf(underlying);
+    if (value >= ids.size() || ids[value] == NULL_INSTRUMENT)
+    {
+        return std::nullopt;
+    }
+    return ids[value];
+}
+
+}  // namespace solstice
+
+#endif  // INSTRUMENT_REGISTRY_H
@@ -0,0 +1,227 @@
+#include <mapped_file.h>
+#include <types.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <format>
+#include <utility>
+
+namespace solstice
+{
+
+namespace
+{
+
+String systemError(const char* action, const String& path)
+{
+    return std::format("Could not {} {}: {}\n", action, path, std::strerror(errno));
+}
+
+size_t pageSize()
+{
+    static const size_t size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return size;
+}
+
+}  // namespace
+
+MappedFile::MappedFile(String path, int fd, std::byte* data, size_t size, bool writable)
+    : d_path(std::move(path)), d_fd(fd), d_data(data), d_size(size), d_writable(writable)
+{
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : d_path(std::move(other.d_path)),
+      d_fd(std::exchange(other.d_fd, -1)),
+      d_data(std::exchange(other.d_data, nullptr)),
+      d_size(std::exchange(other.d_size, 0)),
+      d_writable(other.d_writable)
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        unmap();
+        if (d_fd != -1)
+        {
+            ::close(d_fd);
+        }
+
+        d_path = std::move(other.d_path);
+        d_fd = std::exchange(other.d_fd, -1);
+        d_data = std::exchange(other.d_data, nullptr);
+        d_size = std::exchange(other.d_size, 0);
+        d_writable = other.d_writable;
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile()
+{
+    unmap();
+    if (d_fd != -1)
+    {
+        ::close(d_fd);
+    }
+}
+
+Resolution<MappedFile> MappedFile::openReadOnly(const String& path)
+{
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+    {
+        return resolution::err(systemError("open", path));
+    }
+
+    struct stat status;
+    if (::fstat(fd, &status) == -1)
+    {
+        auto error = systemError("stat", path);
+        ::close(fd);
+        return resolution::err(error);
+    }
+
+    MappedFile file(path, fd, nullptr, 0, false);
+
+    auto mapped = file.map(static_cast<size_t>(status.st_size));
+    if (!mapped)
+    {
+        return resolution::err(mapped.error());
+    }
+
+    return file;
+}
+
+Resolution<MappedFile> MappedFile::openWritable(const String& path, size_t size)
+{
+    const int fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd == -1)
+    {
+        return resolution::err(systemError("open", path));
+    }
+
+    struct stat status;
+    if (::fstat(fd, &status) == -1)
+    {
+        auto error = systemError("stat", path);
+        ::close(fd);
+        return resolution::err(error);
+    }
+
+    MappedFile file(path, fd, nullptr, 0, true);
+
+    auto mapped = file.map(std::max(size, static_cast<size_t>(status.st_size)));
+    if (!mapped)
+    {
+        return resolution::err(mapped.error());
+    }
+
+    return file;
+}
+
+std::byte* MappedFile::data() { return d_data; }
+
+const std::byte* MappedFile::data() const { return d_data; }
+
+size_t MappedFile::size() const { return d_size; }
+
+Resolution<std::monostate> MappedFile::resize(size_t size)
+{
+    unmap();
+    return map(size);
+}
+
+void MappedFile::flushAsync(size_t offset, size_t length)
+{
+    if (!d_data || length == 0)
+    {
+        return;
+    }
+
+    // msync needs a page aligned start
+    const size_t start = offset - offset % pageSize();
+    ::msync(d_data + start, offset + length - start, MS_ASYNC);
+}
+
+Resolution<std::monostate> MappedFile::sync()
+{
+    if (d_data && ::msync(d_data, d_size, MS_SYNC) == -1)
+    {
+        return resolution::err(systemError("sync", d_path));
+    }
+    return std::monostate{};
+}
+
+Resolution<std::monostate> MappedFile::close(size_t size)
+{
+    auto synced = sync();
+    unmap();
+
+    if (d_fd == -1)
+    {
+        return synced;
+    }
+
+    const bool truncated = ::ftruncate(d_fd, static_cast<off_t>(size)) == 0;
+    auto error = truncated ? String{} : systemError("truncate", d_path);
+
+    ::close(d_fd);
+    d_fd = -1;
+
+    if (!synced)
+    {
+        return synced;
+    }
+    if (!truncated)
+    {
+        return resolution::err(error);
+    }
+    return std::monostate{};
+}
+
+Resolution<std::monostate> MappedFile::map(size_t size)
+{
+    if (d_writable && ::ftruncate(d_fd, static_cast<off_t>(size)) == -1)
+    {
+        return resolution::err(systemError("grow", d_path));
+    }
+
+    if (size == 0)
+    {
+        // mmap rejects empty mappings, and there is nothing to read anyway
+        return std::monostate{};
+    }
+
+    const int protection = d_writable ? PROT_READ | PROT_WRITE : PROT_READ;
+
+    void* data = ::mmap(nullptr, size, protection, MAP_SHARED, d_fd, 0);
+    if (data == MAP_FAILED)
+    {
+        return resolution::err(systemError("map", d_path));
+    }
+
+    d_data = static_cast<std::byte*>(data);
+    d_size = size;
+    return std::monostate{};
+}
+
+void MappedFile::unmap()
+{
+    if (d_data)
+    {
+        ::munmap(d_data, d_size);
+    }
+
+    d_data = nullptr;
+    d_size = 0;
+}
+
+}  // namespace solstice
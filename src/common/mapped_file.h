@@ -0,0 +1,58 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <types.h>
+
+#include <cstddef>
+
+namespace solstice
+{
+
+// A file mapped into memory with mmap, shared with the page cache so writes through data() reach
+// the file without a system call. Unmapped, and closed, on destruction.
+class MappedFile
+{
+   public:
+    static Resolution<MappedFile> openReadOnly(const String& path);
+    // creates the file if it is missing and grows it to at least size bytes
+    static Resolution<MappedFile> openWritable(const String& path, size_t size);
+
+    MappedFile() = default;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    std::byte* data();
+    const std::byte* data() const;
+    size_t size() const;
+
+    // remaps a writable file at a new size, invalidating pointers into the old mapping
+    Resolution<std::monostate> resize(size_t size);
+
+    // schedules the pages covering [offset, offset + length) to be written back without waiting
+    void flushAsync(size_t offset, size_t length);
+    // writes back every dirty page, returning once they have reached the file
+    Resolution<std::monostate> sync();
+
+    // unmaps a writable file and cuts it down to size bytes
+    Resolution<std::monostate> close(size_t size);
+
+   private:
+    MappedFile(String path, int fd, std::byte* data, size_t size, bool writable);
+
+    Resolution<std::monostate> map(size_t size);
+    void unmap();
+
+    String d_path;
+    int d_fd = -1;
+    std::byte* d_data = nullptr;
+    size_t d_size = 0;
+    bool d_writable = false;
+};
+
+}  // namespace solstice
+
+#endif  // MAPPED_FILE_H
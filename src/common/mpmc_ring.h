@@ -0,0 +1,159 @@
+#ifndef MPMC_RING_H
+#define MPMC_RING_H
+
+#include <spsc_ring.h>
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace solstice
+{
+
+// Bounded lock-free ring for any number of producers and consumers. Capacity is rounded up to a
+// power of two. Every slot carries a sequence number recording whether it is ready to be written
+// or read for the current lap of the ring, so threads claim a position with one CAS and never wait
+// on each other's locks.
+template <typename T>
+class MpmcRing
+{
+   public:
+    explicit MpmcRing(size_t capacity)
+        : d_capacity(std::bit_ceil(capacity < 2 ? size_t{2} : capacity)),
+          d_mask(d_capacity - 1),
+          d_slots(std::make_unique<Slot[]>(d_capacity))
+    {
+        for (size_t i = 0; i < d_capacity; i++)
+        {
+            d_slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcRing(const MpmcRing&) = delete;
+    MpmcRing& operator=(const MpmcRing&) = delete;
+
+    bool tryPush(T&& value)
+    {
+        size_t pos = d_enqueuePos.load(std::memory_order_relaxed);
+        Slot* slot;
+
+        while (true)
+        {
+            slot = &d_slots[pos & d_mask];
+            const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+
+            if (diff == 0)
+            {
+                if (d_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                // slot still holds a value from the previous lap
+                return false;
+            }
+            else
+            {
+                pos = d_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->value = std::move(value);
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPush(const T& value)
+    {
+        T copy = value;
+        return tryPush(std::move(copy));
+    }
+
+    bool tryPop(T& out) { return popBatch(&out, 1) == 1; }
+
+    // Claims up to maxCount consecutive ready values with a single CAS, so a consumer draining a
+    // busy ring synchronises once per batch rather than once per value
+    size_t popBatch(T* out, size_t maxCount)
+    {
+        size_t pos = d_dequeuePos.load(std::memory_order_relaxed);
+        size_t count;
+
+        while (true)
+        {
+            count = 0;
+            while (count < maxCount)
+            {
+                const size_t sequence =
+                    d_slots[(pos + count) & d_mask].sequence.load(std::memory_order_acquire);
+                if (sequence != pos + count + 1)
+                {
+                    break;
+                }
+                count++;
+            }
+
+            if (count == 0)
+            {
+                const size_t head = d_slots[pos & d_mask].sequence.load(std::memory_order_acquire);
+                if (static_cast<intptr_t>(head) - static_cast<intptr_t>(pos + 1) < 0)
+                {
+                    // nothing has been written at the head yet
+                    return 0;
+                }
+
+                // another consumer took the head, retry from its new position
+                pos = d_dequeuePos.load(std::memory_order_relaxed);
+                continue;
+            }
+
+            if (d_dequeuePos.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+
+        for (size_t i = 0; i < count; i++)
+        {
+            Slot& slot = d_slots[(pos + i) & d_mask];
+            out[i] = std::move(slot.value);
+            slot.sequence.store(pos + i + d_capacity, std::memory_order_release);
+        }
+
+        return count;
+    }
+
+    // approximate when called while other threads are active
+    size_t size() const
+    {
+        const size_t enqueued = d_enqueuePos.load(std::memory_order_acquire);
+        const size_t dequeued = d_dequeuePos.load(std::memory_order_acquire);
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+
+    bool empty() const { return size() == 0; }
+    size_t capacity() const { return d_capacity; }
+
+   private:
+    struct Slot
+    {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    const size_t d_capacity;
+    const size_t d_mask;
+    std::unique_ptr<Slot[]> d_slots;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> d_enqueuePos{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> d_dequeuePos{0};
+};
+
+}  // namespace solstice
+
+#endif  // MPMC_RING_H
@@ -1,9 +1,12 @@
 #include <asset_class.h>
 #include <greeks.h>
+#include <instrument_universe.h>
 #include <market_side.h>
 #include <options.h>
 #include <order.h>
+#include <order_pool.h>
 #include <pricer.h>
+#include <ticks.h>
 #include <time_point.h>
 #include <types.h>
 
@@ -14,46 +17,31 @@ namespace solstice
 
 Resolution<Equity> extractUnderlyingEquity(Option optionTicker)
 {
-    String optionString = to_string(optionTicker);
-
-    size_t firstUnderscore = optionString.find('_');
-    if (firstUnderscore == String::npos)
-    {
-        return resolution::err("Underlying option ticker is in an incorrect format.");
-    }
-
-    String equitySymbol = optionString.substr(0, firstUnderscore);
-
-    for (size_t i = 0; i < static_cast<size_t>(Equity::COUNT); ++i)
+    const InstrumentDefinition& definition = instrumentDefinition(optionTicker);
+    if (!definition.underlyingEquity)
     {
-        if (EQ_STR[i] == equitySymbol)
-        {
-            return static_cast<Equity>(i);
-        }
+        return resolution::err(
+            std::format("Underlying: {} of {} not found in list of equities.",
+                        definition.underlying, definition.symbol));
     }
 
-    return resolution::err(
-        std::format("Extracted ticker: {} not found in list of equities.", equitySymbol));
+    return *definition.underlyingEquity;
 }
 
 OptionOrder::OptionOrder(int uid, Option optionTicker, Equity underlyingEquity, double price,
-                         int qnty, MarketSide marketSide, TimePoint timeOrderPlaced, double strike,
-                         OptionType optionType, double expiry)
-    : Order(uid, optionTicker, price, qnty, marketSide, timeOrderPlaced),
-      d_underlyingEquity(underlyingEquity),
-      d_strike(strike),
-      d_optionType(optionType),
-      d_expiry(expiry)
+                         int qnty, MarketSide marketSide, double strike, OptionType optionType,
+                         double expiry)
+    : Order(uid, optionTicker, price, qnty, marketSide)
 {
+    d_optionTerms = {underlyingEquity, optionType, strike, expiry};
 }
 
-Resolution<std::shared_ptr<OptionOrder>> OptionOrder::create(
-    int uid, Option optionTicker, double price, int qnty, MarketSide marketSide,
-    TimePoint timeOrderPlaced, double strike, OptionType optionType, double expiry)
+Resolution<std::shared_ptr<OptionOrder>> OptionOrder::create(int uid, Option optionTicker,
+                                                             double price, int qnty,
+                                                             MarketSide marketSide, double strike,
+                                                             OptionType optionType, double expiry)
 {
-    TimePoint d_timeOrderPlaced = timeNow();
-
-    auto isOrderValid = validateOrderAttributes(price, qnty, timeOrderPlaced);
+    auto isOrderValid = validateOrderAttributes(price, qnty);
     if (!isOrderValid)
     {
         return resolution::err(isOrderValid.error());
@@ -65,11 +53,15 @@ Resolution<std::shared_ptr<OptionOrder>> OptionOrder::create(
         return resolution::err(underlyingEquity.error());
     }
 
-    auto optionOrder = std::shared_ptr<OptionOrder>(
-        new (std::nothrow) OptionOrder{uid, optionTicker, *underlyingEquity, price, qnty,
-                                       marketSide, timeOrderPlaced, strike, optionType, expiry});
+    if (!OrderPool::enabled())
+    {
+        return std::shared_ptr<OptionOrder>(
+            new (std::nothrow) OptionOrder{uid, optionTicker, *underlyingEquity, price, qnty,
+                                           marketSide, strike, optionType, expiry});
+    }
 
-    return optionOrder;
+    return allocatePooled<OptionOrder>(uid, optionTicker, *underlyingEquity, price, qnty,
+                                       marketSide, strike, optionType, expiry);
 }
 
 Resolution<std::shared_ptr<OptionOrder>> OptionOrder::createWithPricer(
@@ -78,15 +70,17 @@ Resolution<std::shared_ptr<OptionOrder>> OptionOrder::createWithPricer(
     auto optionData = pricer->computeOptionData(optionTicker);
     const double theoreticalPrice = pricer->computeBlackScholes(optionData);
 
-    // calculate actual market price, theoretical price as input
-    const double marketPrice =
-        pricer->calculateMarketPrice(optionData, theoreticalPrice, optionData.marketSide());
+    // calculate actual market price, theoretical price as input, snapped to the tick grid
+    const double marketPrice = fromTicks(
+        toTicks(pricer->calculateMarketPrice(optionData, theoreticalPrice, optionData.marketSide()),
+                optionTicker),
+        optionTicker);
 
     // qnty is calculated from price, so compute last
     optionData.qnty(pricer->calculateQnty(optionTicker, optionData.marketSide(), marketPrice));
 
     const auto opt = OptionOrder::create(uid, optionTicker, marketPrice, optionData.qnty(),
-                                         optionData.marketSide(), timeNow(), optionData.strike(),
+                                         optionData.marketSide(), optionData.strike(),
                                          optionData.optionType(), optionData.expiry());
     if (!opt)
     {
@@ -112,7 +106,7 @@ Resolution<std::shared_ptr<OptionOrder>> OptionOrder::createWithRandomValues(Con
 
     auto opt =
         OptionOrder::create(uid, optionTicker, optionPrice, (*data).qnty(), (*data).marketSide(),
-                            timeNow(), (*data).strike(), (*data).optionType(), (*data).expiry());
+                            (*data).strike(), (*data).optionType(), (*data).expiry());
     if (!opt)
     {
         return resolution::err(opt.error());
@@ -134,10 +128,10 @@ void OptionOrder::setGreeks(pricing::Greeks& greeks)
 
 // getters
 
-Equity OptionOrder::underlyingEquity() const { return d_underlyingEquity; }
-double OptionOrder::strike() const { return d_strike; }
-OptionType OptionOrder::optionType() const { return d_optionType; }
-double OptionOrder::expiry() const { return d_expiry; }
+Equity OptionOrder::underlyingEquity() const { return d_optionTerms.underlyingEquity; }
+double OptionOrder::strike() const { return d_optionTerms.strike; }
+OptionType OptionOrder::optionType() const { return d_optionTerms.optionType; }
+double OptionOrder::expiry() const { return d_optionTerms.expiry; }
 double OptionOrder::delta() const { return d_delta; }
 double OptionOrder::gamma() const { return d_gamma; }
 double OptionOrder::theta() const { return d_theta; }
@@ -147,11 +141,11 @@ double OptionOrder::vega() const { return d_vega; }
 
 void OptionOrder::underlyingEquity(Equity underlyingEquity)
 {
-    d_underlyingEquity = underlyingEquity;
+    d_optionTerms.underlyingEquity = underlyingEquity;
 }
-void OptionOrder::strike(double strike) { d_strike = strike; }
-void OptionOrder::optionType(OptionType optionType) { d_optionType = optionType; }
-void OptionOrder::expiry(double expiry) { d_expiry = expiry; }
+void OptionOrder::strike(double strike) { d_optionTerms.strike = strike; }
+void OptionOrder::optionType(OptionType optionType) { d_optionTerms.optionType = optionType; }
+void OptionOrder::expiry(double expiry) { d_optionTerms.expiry = expiry; }
 void OptionOrder::delta(double delta) { d_delta = delta; }
 void OptionOrder::gamma(double gamma) { d_gamma = gamma; }
 void OptionOrder::theta(double theta) { d_theta = theta; }
@@ -18,8 +18,7 @@ class OptionOrder : public Order
    public:
     static Resolution<std::shared_ptr<OptionOrder>> create(int uid, Option optionTicker,
                                                            double price, int qnty,
-                                                           MarketSide marketSide,
-                                                           TimePoint timeOrderPlaced, double strike,
+                                                           MarketSide marketSide, double strike,
                                                            OptionType optionType, double expiry);
 
     static Resolution<std::shared_ptr<OptionOrder>> createWithPricer(
@@ -46,23 +45,22 @@ class OptionOrder : public Order
     void theta(double theta);
     void vega(double vega);
 
-   private:
+   protected:
     OptionOrder(int uid, Option optionTicker, Equity underlyingEquity, double price, int qnty,
-                MarketSide marketSide, TimePoint timeOrderPlaced, double strike,
-                OptionType optionType, double expiry);
+                MarketSide marketSide, double strike, OptionType optionType, double expiry);
 
+   private:
     void setGreeks(pricing::Greeks& greeks);
 
-    Equity d_underlyingEquity;
-    double d_strike;
-    OptionType d_optionType;
-    double d_expiry;
+    // the greeks are only read by pricing and strategies, so aren't kept in OptionTerms
     double d_delta;
     double d_gamma;
     double d_theta;
     double d_vega;
 };
 
+static_assert(std::is_trivially_copyable_v<OptionOrder>);
+
 }  // namespace solstice
 
 #endif  // OPTIONS_H
@@ -2,7 +2,9 @@
 #include <get_random.h>
 #include <market_side.h>
 #include <order.h>
+#include <order_pool.h>
 #include <pricer.h>
+#include <ticks.h>
 #include <types.h>
 
 #include <format>
@@ -13,14 +15,12 @@
 namespace solstice
 {
 
-Order::Order(int uid, Underlying underlying, double price, int qnty, MarketSide marketSide,
-             TimePoint timeOrderPlaced)
+Order::Order(int uid, Underlying underlying, double price, int qnty, MarketSide marketSide)
     : d_uid(uid),
       d_underlying(underlying),
-      d_price(price),
+      d_price(toTicks(price, underlying)),
       d_qnty(qnty),
-      d_marketSide(marketSide),
-      d_timeOrderPlaced(timeOrderPlaced)
+      d_marketSide(marketSide)
 {
     d_matched = false;
     d_outstandingQnty = qnty;
@@ -30,18 +30,25 @@ Order::Order(int uid, Underlying underlying, double price, int qnty, MarketSide
 Resolution<std::shared_ptr<Order>> Order::create(int uid, Underlying underlying, double price,
                                                  int qnty, MarketSide marketSide)
 {
-    TimePoint timeOrderPlaced = timeNow();
-
-    auto isOrderValid = validateOrderAttributes(price, qnty, timeOrderPlaced);
+    auto isOrderValid = validateOrderAttributes(price, qnty);
     if (!isOrderValid)
     {
         return resolution::err(isOrderValid.error());
     }
 
-    auto order = std::shared_ptr<Order>(
-        new (std::nothrow) Order{uid, underlying, price, qnty, marketSide, timeOrderPlaced});
+    // an option's terms are only set by OptionOrder, so every option must be created by it
+    if (std::holds_alternative<Option>(underlying))
+    {
+        return resolution::err("Option orders must be created with OptionOrder::create\n");
+    }
 
-    return order;
+    if (!OrderPool::enabled())
+    {
+        return std::shared_ptr<Order>(
+            new (std::nothrow) Order{uid, underlying, price, qnty, marketSide});
+    }
+
+    return allocatePooled<Order>(uid, underlying, price, qnty, marketSide);
 }
 
 Resolution<std::shared_ptr<Order>> Order::createWithPricer(std::shared_ptr<pricing::Pricer> pricer,
@@ -80,11 +87,15 @@ double Order::price() const
     // d_price becomes irrelevant once an order is matched
     if (matched())
     {
-        return d_matchedPrice;
+        return matchedPrice();
     }
-    return d_price;
+    return fromTicks(d_price, d_underlying);
 }
 
+// limit price on the tick grid - unlike price(), this does not change on match so the book can
+// always find the level the order rests at
+Ticks Order::priceTicks() const { return d_price; }
+
 int Order::qnty() const { return d_qnty; }
 
 int Order::outstandingQnty() const { return d_outstandingQnty; }
@@ -102,29 +113,51 @@ String Order::marketSideString() const
     return d_marketSide == solstice::MarketSide::Bid ? "Bid" : "Ask";
 }
 
-TimePoint Order::timeOrderPlaced() const { return d_timeOrderPlaced; }
+PriceType Order::priceType() const { return d_priceType; }
+
+TimeInForce Order::timeInForce() const { return d_timeInForce; }
+
+bool Order::canRest() const
+{
+    return d_priceType == PriceType::Limit && d_timeInForce == TimeInForce::GoodTillCancel;
+}
+
+bool Order::tradesAt(Ticks price) const
+{
+    if (d_priceType == PriceType::Market)
+    {
+        return true;
+    }
+    return d_marketSide == MarketSide::Bid ? price <= d_price : price >= d_price;
+}
 
 bool Order::matched() const { return d_matched; }
 
-double Order::matchedPrice() const { return d_matchedPrice; }
+double Order::matchedPrice() const { return fromTicks(d_matchedPrice, d_underlying); }
+
+Ticks Order::matchedPriceTicks() const { return d_matchedPrice; }
+
+const OptionTerms& Order::optionTerms() const { return d_optionTerms; }
+
+uint64_t Order::bookSequence() const { return d_bookSequence; }
+
+Cycles Order::cyclesSubmitted() const { return d_cyclesSubmitted; }
 
 // setters
 
-void Order::price(double newPrice) { d_price = newPrice; }
+void Order::price(double newPrice) { d_price = toTicks(newPrice, d_underlying); }
+
+void Order::priceType(PriceType type) { d_priceType = type; }
+
+void Order::timeInForce(TimeInForce timeInForce) { d_timeInForce = timeInForce; }
 
 void Order::matched(bool isFulfilled) { d_matched = isFulfilled; }
 
-void Order::matchedPrice(double matchedPrice) { d_matchedPrice = matchedPrice; }
+void Order::matchedPriceTicks(Ticks matchedPrice) { d_matchedPrice = matchedPrice; }
 
-Resolution<TimePoint> Order::timeOrderFulfilled() const
-{
-    // Cannot return time of fulfillment if fulfillment hasn't yet occured
-    if (!d_matched)
-    {
-        return resolution::err("Order has not been fulfilled yet\n");
-    }
-    return d_timeOrderFulfilled;
-}
+void Order::bookSequence(uint64_t sequence) { d_bookSequence = sequence; }
+
+void Order::cyclesSubmitted(Cycles cycles) { d_cyclesSubmitted = cycles; }
 
 Resolution<std::monostate> Order::validatePrice(const double price)
 {
@@ -146,8 +179,7 @@ Resolution<std::monostate> Order::validateQnty(const int qnty)
     return std::monostate{};
 }
 
-Resolution<std::monostate> Order::validateOrderAttributes(double price, int qnty,
-                                                          TimePoint& timeOrderPlaced)
+Resolution<std::monostate> Order::validateOrderAttributes(double price, int qnty)
 {
     auto validPrice = Order::validatePrice(price);
     auto validQnty = Order::validateQnty(qnty);
@@ -3,13 +3,18 @@
 
 #include <asset_class.h>
 #include <config.h>
+#include <cycle_clock.h>
 #include <market_side.h>
-#include <time_point.h>
+#include <option_type.h>
+#include <price_type.h>
+#include <ticks.h>
+#include <time_in_force.h>
 #include <types.h>
 
-#include <ctime>
+#include <cstdint>
 #include <memory>
 #include <resolution.hpp>
+#include <type_traits>
 #include <variant>
 
 namespace solstice::pricing
@@ -20,11 +25,21 @@ class Pricer;
 namespace solstice
 {
 
+// What an option order adds to the fields every order has, held inline in every order so the book,
+// matcher and journal read it straight from the record. Only set when the asset class is Option
+struct OptionTerms
+{
+    Equity underlyingEquity{};
+    OptionType optionType = OptionType::Call;
+    double strike = 0.0;
+    double expiry = 0.0;
+};
+
+// Orders are plain records tagged by their underlying's asset class, with no virtual functions,
+// so the matching core never dispatches through a vtable or downcasts to reach an option's terms
 class Order
 {
    public:
-    virtual ~Order() = default;
-
     static Resolution<std::shared_ptr<Order>> create(int uid, Underlying underlying, double price,
                                                      int qnty, MarketSide marketSide);
 
@@ -38,42 +53,65 @@ class Order
     Underlying underlying() const;
     AssetClass assetClass() const;
     double price() const;
+    Ticks priceTicks() const;
     int qnty() const;
     int outstandingQnty() const;
     MarketSide marketSide() const;
     String marketSideString() const;
-    TimePoint timeOrderPlaced() const;
-    Resolution<TimePoint> timeOrderFulfilled() const;
+    // Limit and GoodTillCancel unless set before the order is handed to the engine
+    PriceType priceType() const;
+    TimeInForce timeInForce() const;
+    // whether what the order doesn't fill on arrival rests in the book, which only a good till
+    // cancel limit order does
+    bool canRest() const;
+    // whether the order trades against a resting order at price. A market order trades at any
+    bool tradesAt(Ticks price) const;
+    // stamped by the book as the order is added to it, one above the last order added to the
+    // same underlying, so resting orders are in time priority by sequence. 0 until then
+    uint64_t bookSequence() const;
+    // when the order was handed to the matching workers, only stamped while latency is measured
+    Cycles cyclesSubmitted() const;
     int outstandingQnty(int newQnty);
     bool matched() const;
     double matchedPrice() const;
+    Ticks matchedPriceTicks() const;
+    // zeroed unless assetClass() is Option
+    const OptionTerms& optionTerms() const;
 
     void price(double newPrice);
+    void priceType(PriceType type);
+    void timeInForce(TimeInForce timeInForce);
     void matched(bool isFulfilled);
-    void matchedPrice(double matchedPrice);
+    void matchedPriceTicks(Ticks matchedPrice);
+    void bookSequence(uint64_t sequence);
+    void cyclesSubmitted(Cycles cycles);
 
    protected:
-    Order(int uid, Underlying underlying, double price, int qnty, MarketSide marketSide,
-          TimePoint timeOrderPlaced);
+    Order(int uid, Underlying underlying, double price, int qnty, MarketSide marketSide);
 
     static Resolution<std::monostate> validatePrice(const double price);
     static Resolution<std::monostate> validateQnty(const int qnty);
-    static Resolution<std::monostate> validateOrderAttributes(double price, int qnty,
-                                                              TimePoint& timeOrderPlaced);
+    static Resolution<std::monostate> validateOrderAttributes(double price, int qnty);
 
     int d_uid;
     Underlying d_underlying;
     size_t d_assetClass;
-    double d_price;
+    Ticks d_price;
     int d_qnty;
     int d_outstandingQnty;
     MarketSide d_marketSide;
-    TimePoint d_timeOrderPlaced;
-    TimePoint d_timeOrderFulfilled;
+    PriceType d_priceType = PriceType::Limit;
+    TimeInForce d_timeInForce = TimeInForce::GoodTillCancel;
+    uint64_t d_bookSequence = 0;
+    Cycles d_cyclesSubmitted = 0;
     bool d_matched;
-    double d_matchedPrice;
+    Ticks d_matchedPrice;
+    OptionTerms d_optionTerms{};
 };
 
+static_assert(!std::is_polymorphic_v<Order>);
+static_assert(std::is_trivially_copyable_v<Order>);
+
 std::ostream& operator<<(std::ostream& os, const Order& order);
 
 }  // namespace solstice
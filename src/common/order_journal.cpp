@@ -0,0 +1,187 @@
+#include <asset_class.h>
+#include <instrument_universe.h>
+#include <market_side.h>
+#include <option_type.h>
+#include <options.h>
+#include <order.h>
+#include <order_journal.h>
+#include <time_point.h>
+#include <types.h>
+
+#include <cstdint>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <variant>
+#include <vector>
+
+namespace solstice
+{
+
+JournalRecord JournalRecord::fromOrder(const Order& order)
+{
+    JournalRecord record{};
+
+    record.uid = order.uid();
+    record.assetClass = static_cast<uint8_t>(order.assetClass());
+    record.underlying = std::visit([](auto underlying) { return static_cast<uint32_t>(underlying); },
+                                   order.underlying());
+    record.marketSide = static_cast<uint8_t>(order.marketSide());
+    record.qnty = order.qnty();
+    record.price = order.price();
+
+    if (order.assetClass() == AssetClass::Option)
+    {
+        const OptionTerms& terms = order.optionTerms();
+        record.optionType = static_cast<uint8_t>(terms.optionType);
+        record.strike = terms.strike;
+        record.expiry = terms.expiry;
+    }
+
+    return record;
+}
+
+Underlying JournalRecord::toUnderlying() const
+{
+    switch (static_cast<AssetClass>(assetClass))
+    {
+        case AssetClass::Future:
+            return static_cast<Future>(underlying);
+        case AssetClass::Option:
+            return static_cast<Option>(underlying);
+        default:
+            return static_cast<Equity>(underlying);
+    }
+}
+
+Resolution<std::shared_ptr<Order>> JournalRecord::toOrder() const
+{
+    const auto side = static_cast<MarketSide>(marketSide);
+
+    // recorded under a universe with more instruments than this one
+    if (!instrumentDefined(toUnderlying()))
+    {
+        return resolution::err(
+            std::format("Order {} is for instrument {}, which is not defined\n", uid, underlying));
+    }
+
+    if (static_cast<AssetClass>(assetClass) != AssetClass::Option)
+    {
+        return Order::create(uid, toUnderlying(), price, qnty, side);
+    }
+
+    auto option = OptionOrder::create(uid, static_cast<Option>(underlying), price, qnty, side,
+                                      strike, static_cast<OptionType>(optionType), expiry);
+    if (!option)
+    {
+        return resolution::err(option.error());
+    }
+
+    return std::shared_ptr<Order>(*option);
+}
+
+Resolution<OrderJournal> OrderJournal::load(const String& path)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file)
+    {
+        return resolution::err(std::format("Could not open journal {}\n", path));
+    }
+
+    const auto size = static_cast<size_t>(file.tellg());
+    file.seekg(0);
+
+    OrderJournal journal;
+    if (size < sizeof(JournalHeader) ||
+        !file.read(reinterpret_cast<char*>(&journal.header), sizeof(JournalHeader)))
+    {
+        return resolution::err(std::format("Journal {} is missing its header\n", path));
+    }
+
+    if (journal.header.magic != JournalHeader::MAGIC ||
+        journal.header.version != JournalHeader::VERSION ||
+        journal.header.recordSize != sizeof(JournalRecord))
+    {
+        return resolution::err(std::format("{} is not a version {} order journal\n", path,
+                                           JournalHeader::VERSION));
+    }
+
+    // a record cut short by a crash while writing is dropped
+    journal.records.resize((size - sizeof(JournalHeader)) / sizeof(JournalRecord));
+    file.read(reinterpret_cast<char*>(journal.records.data()),
+              journal.records.size() * sizeof(JournalRecord));
+
+    if (!file)
+    {
+        return resolution::err(std::format("Could not read journal {}\n", path));
+    }
+
+    return journal;
+}
+
+OrderJournalWriter::OrderJournalWriter(std::ofstream file) : d_file(std::move(file))
+{
+    d_buffer.reserve(BUFFERED_RECORDS);
+}
+
+OrderJournalWriter::~OrderJournalWriter() { flush(); }
+
+Resolution<std::unique_ptr<OrderJournalWriter>> OrderJournalWriter::open(const String& path,
+                                                                         uint64_t randomSeed)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        return resolution::err(std::format("Could not create journal {}\n", path));
+    }
+
+    JournalHeader header;
+    header.randomSeed = randomSeed;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    return std::unique_ptr<OrderJournalWriter>(new OrderJournalWriter(std::move(file)));
+}
+
+void OrderJournalWriter::append(std::span<const std::shared_ptr<Order>> orders)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+
+    for (const auto& order : orders)
+    {
+        d_buffer.push_back(JournalRecord::fromOrder(*order));
+    }
+
+    if (d_buffer.size() >= BUFFERED_RECORDS)
+    {
+        writeBuffer();
+    }
+}
+
+Resolution<std::monostate> OrderJournalWriter::flush()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+
+    writeBuffer();
+    d_file.flush();
+
+    if (!d_file)
+    {
+        return resolution::err("Failed to write order journal\n");
+    }
+    return std::monostate{};
+}
+
+uint64_t OrderJournalWriter::recorded() const { return d_recorded; }
+
+void OrderJournalWriter::writeBuffer()
+{
+    d_file.write(reinterpret_cast<const char*>(d_buffer.data()),
+                 d_buffer.size() * sizeof(JournalRecord));
+
+    d_recorded += d_buffer.size();
+    d_buffer.clear();
+}
+
+}  // namespace solstice
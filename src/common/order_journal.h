@@ -0,0 +1,95 @@
+#ifndef ORDER_JOURNAL_H
+#define ORDER_JOURNAL_H
+
+#include <asset_class.h>
+#include <order.h>
+#include <types.h>
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace solstice
+{
+
+// One generated order, in the fixed binary layout it has on disk. Greeks are not kept as they play
+// no part in matching
+struct JournalRecord
+{
+    int32_t uid;
+    uint8_t assetClass;
+    uint8_t marketSide;
+    uint8_t optionType;  // options only
+    uint8_t reserved;
+    int32_t qnty;
+    uint32_t underlying;  // the Equity, Future or Option value in the instrument universe
+    double price;
+    double strike;  // options only
+    double expiry;  // options only
+
+    static JournalRecord fromOrder(const Order& order);
+
+    Underlying toUnderlying() const;
+    Resolution<std::shared_ptr<Order>> toOrder() const;
+};
+
+static_assert(sizeof(JournalRecord) == 40, "journal layout is part of the file format");
+
+struct JournalHeader
+{
+    static constexpr uint64_t MAGIC = 0x4c4e524a4c4f53;  // "SOLJRNL"
+    static constexpr uint32_t VERSION = 2;
+
+    uint64_t magic = MAGIC;
+    uint32_t version = VERSION;
+    uint32_t recordSize = sizeof(JournalRecord);
+    uint64_t randomSeed = 0;  // master seed of the run that was recorded
+};
+
+// A recorded order flow, read back in full
+struct OrderJournal
+{
+    JournalHeader header;
+    std::vector<JournalRecord> records;
+
+    static Resolution<OrderJournal> load(const String& path);
+};
+
+// Appends generated orders to a journal file. Safe to share between generator threads: records
+// are buffered under a lock and written out in blocks, so orders for any one underlying appear in
+// the order they were generated
+class OrderJournalWriter
+{
+   public:
+    static Resolution<std::unique_ptr<OrderJournalWriter>> open(const String& path,
+                                                                uint64_t randomSeed);
+
+    ~OrderJournalWriter();
+
+    void append(std::span<const std::shared_ptr<Order>> orders);
+
+    // writes out any buffered records, returning an error if the file could not be written
+    Resolution<std::monostate> flush();
+
+    uint64_t recorded() const;
+
+   private:
+    // records buffered before a write to the file
+    static constexpr size_t BUFFERED_RECORDS = 4096;
+
+    explicit OrderJournalWriter(std::ofstream file);
+
+    void writeBuffer();
+
+    std::mutex d_mutex;
+    std::ofstream d_file;
+    std::vector<JournalRecord> d_buffer;
+    uint64_t d_recorded = 0;
+};
+
+}  // namespace solstice
+
+#endif  // ORDER_JOURNAL_H
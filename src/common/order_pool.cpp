@@ -0,0 +1,126 @@
+#include <order_pool.h>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace solstice
+{
+
+namespace
+{
+
+std::atomic<bool> g_poolEnabled{true};
+
+// pools left behind by threads that have exited, waiting to be adopted
+std::mutex& orphanedPoolsMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::vector<OrderPool*>& orphanedPools()
+{
+    static std::vector<OrderPool*> pools;
+    return pools;
+}
+
+}  // namespace
+
+struct LocalOrderPool
+{
+    OrderPool* pool;
+
+    LocalOrderPool()
+    {
+        std::lock_guard<std::mutex> lock(orphanedPoolsMutex());
+
+        if (orphanedPools().empty())
+        {
+            pool = new OrderPool();
+        }
+        else
+        {
+            pool = orphanedPools().back();
+            orphanedPools().pop_back();
+        }
+
+        pool->d_owner.store(std::this_thread::get_id(), std::memory_order_relaxed);
+    }
+
+    ~LocalOrderPool()
+    {
+        pool->d_owner.store(std::thread::id(), std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> lock(orphanedPoolsMutex());
+        orphanedPools().push_back(pool);
+    }
+};
+
+OrderPool& OrderPool::local()
+{
+    thread_local LocalOrderPool localPool;
+    return *localPool.pool;
+}
+
+bool OrderPool::enabled() { return g_poolEnabled.load(std::memory_order_relaxed); }
+
+void OrderPool::enabled(bool enabled) { g_poolEnabled.store(enabled, std::memory_order_relaxed); }
+
+void* OrderPool::allocate()
+{
+    if (!d_localFree)
+    {
+        // reclaim everything released by other threads in one go
+        d_localFree = d_remoteFree.exchange(nullptr, std::memory_order_acquire);
+    }
+
+    if (d_localFree)
+    {
+        FreeSlot* slot = d_localFree;
+        d_localFree = slot->next;
+        return slot;
+    }
+
+    if (d_bumpNext == d_bumpEnd)
+    {
+        addSlab();
+    }
+
+    void* slot = d_bumpNext;
+    d_bumpNext += ORDER_SLOT_SIZE;
+    return slot;
+}
+
+void OrderPool::deallocate(void* slot)
+{
+    auto* freed = static_cast<FreeSlot*>(slot);
+
+    if (d_owner.load(std::memory_order_relaxed) == std::this_thread::get_id())
+    {
+        freed->next = d_localFree;
+        d_localFree = freed;
+        return;
+    }
+
+    freed->next = d_remoteFree.load(std::memory_order_relaxed);
+    while (!d_remoteFree.compare_exchange_weak(freed->next, freed, std::memory_order_release,
+                                               std::memory_order_relaxed))
+    {
+    }
+}
+
+size_t OrderPool::slabCount() const { return d_slabs.size(); }
+
+void OrderPool::addSlab()
+{
+    auto& slab = d_slabs.emplace_back(new std::byte[ORDER_SLOT_SIZE * ORDER_SLOTS_PER_SLAB]);
+
+    d_bumpNext = slab.get();
+    d_bumpEnd = slab.get() + ORDER_SLOT_SIZE * ORDER_SLOTS_PER_SLAB;
+}
+
+}  // namespace solstice
@@ -0,0 +1,125 @@
+#ifndef ORDER_POOL_H
+#define ORDER_POOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace solstice
+{
+
+// large enough for an OptionOrder plus the shared_ptr control block allocated alongside it
+constexpr size_t ORDER_SLOT_SIZE = 256;
+constexpr size_t ORDER_SLOTS_PER_SLAB = 4096;
+
+// Fixed-size slab allocator for order records. Each thread that creates orders gets its own pool,
+// so allocation never takes a lock. Orders are often released on a different thread to the one
+// that created them (a worker filling the order, or the broadcaster dropping its copy). Those frees
+// are pushed onto a lock-free list that the owning thread reclaims in one exchange once its local
+// free list runs dry. Pools are never destroyed: when a thread exits its pool is handed to the next
+// thread that needs one, so orders outliving their creating thread can still be released into it.
+class OrderPool
+{
+   public:
+    static OrderPool& local();
+
+    // when disabled, orders are created with plain new and shared_ptr instead of the pool
+    static bool enabled();
+    static void enabled(bool enabled);
+
+    void* allocate();
+    void deallocate(void* slot);
+
+    size_t slabCount() const;
+
+   private:
+    struct FreeSlot
+    {
+        FreeSlot* next;
+    };
+
+    OrderPool() = default;
+
+    void addSlab();
+
+    std::atomic<std::thread::id> d_owner;
+
+    FreeSlot* d_localFree = nullptr;
+    std::atomic<FreeSlot*> d_remoteFree{nullptr};
+
+    std::byte* d_bumpNext = nullptr;
+    std::byte* d_bumpEnd = nullptr;
+
+    std::vector<std::unique_ptr<std::byte[]>> d_slabs;
+
+    friend struct LocalOrderPool;
+};
+
+// std allocator over an OrderPool, used with std::allocate_shared so the order and its control
+// block share a single slot
+template <typename T>
+class OrderPoolAllocator
+{
+   public:
+    using value_type = T;
+
+    explicit OrderPoolAllocator(OrderPool& pool) : d_pool(&pool) {}
+
+    template <typename U>
+    OrderPoolAllocator(const OrderPoolAllocator<U>& other) : d_pool(other.pool())
+    {
+    }
+
+    T* allocate(size_t n)
+    {
+        static_assert(sizeof(T) <= ORDER_SLOT_SIZE, "order record does not fit in a pool slot");
+        static_assert(alignof(T) <= alignof(std::max_align_t));
+
+        return n == 1 ? static_cast<T*>(d_pool->allocate()) : std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T* ptr, size_t n)
+    {
+        if (n == 1)
+        {
+            d_pool->deallocate(ptr);
+            return;
+        }
+        std::allocator<T>{}.deallocate(ptr, n);
+    }
+
+    OrderPool* pool() const { return d_pool; }
+
+    template <typename U>
+    bool operator==(const OrderPoolAllocator<U>& other) const
+    {
+        return d_pool == other.pool();
+    }
+
+   private:
+    OrderPool* d_pool;
+};
+
+// order constructors are protected, this exposes them to allocate_shared
+template <typename T>
+struct PooledRecord final : T
+{
+    template <typename... Args>
+    explicit PooledRecord(Args&&... args) : T(std::forward<Args>(args)...)
+    {
+    }
+};
+
+template <typename T, typename... Args>
+std::shared_ptr<T> allocatePooled(Args&&... args)
+{
+    return std::allocate_shared<PooledRecord<T>>(
+        OrderPoolAllocator<PooledRecord<T>>(OrderPool::local()), std::forward<Args>(args)...);
+}
+
+}  // namespace solstice
+
+#endif  // ORDER_POOL_H
@@ -0,0 +1,51 @@
+#include <ring_waiter.h>
+#include <wait_strategy.h>
+
+#include <atomic>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace solstice
+{
+
+RingWaiter::RingWaiter(WaitStrategy strategy) : d_strategy(strategy) {}
+
+void RingWaiter::notify()
+{
+    if (d_strategy != WaitStrategy::Blocking)
+    {
+        return;
+    }
+
+    // pairs with the fence in sleepUnless: either the waiter sees the progress just
+    // made, or this sees the waiter and wakes it
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (d_sleepers.load(std::memory_order_relaxed) > 0)
+    {
+        notifyAll();
+    }
+}
+
+void RingWaiter::notifyAll()
+{
+    d_epoch.fetch_add(1, std::memory_order_release);
+    d_epoch.notify_all();
+}
+
+WaitStrategy RingWaiter::strategy() const { return d_strategy; }
+
+void RingWaiter::pause()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+void RingWaiter::yield() { std::this_thread::yield(); }
+
+}  // namespace solstice
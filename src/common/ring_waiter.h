@@ -0,0 +1,80 @@
+#ifndef RING_WAITER_H
+#define RING_WAITER_H
+
+#include <wait_strategy.h>
+
+#include <atomic>
+#include <cstdint>
+
+namespace solstice
+{
+
+// Waits for a condition on a ring buffer (data to consume, or space to produce into) using the
+// configured WaitStrategy. Under Blocking, waiters sleep on an atomic and are only woken when a
+// notify finds someone asleep, so the thread making progress pays a fence rather than a syscall
+// on every push or pop.
+class RingWaiter
+{
+   public:
+    explicit RingWaiter(WaitStrategy strategy = WaitStrategy::Blocking);
+
+    template <typename Ready>
+    void waitUntil(Ready&& ready)
+    {
+        for (uint32_t attempt = 0; !ready(); attempt++)
+        {
+            if (d_strategy == WaitStrategy::BusySpin || attempt < SPIN_ATTEMPTS)
+            {
+                pause();
+            }
+            else if (d_strategy == WaitStrategy::SpinThenYield || attempt < YIELD_ATTEMPTS)
+            {
+                yield();
+            }
+            else
+            {
+                sleepUnless(ready);
+            }
+        }
+    }
+
+    // call after making the condition true for a waiter
+    void notify();
+
+    // wakes every sleeping waiter regardless, used on shutdown
+    void notifyAll();
+
+    WaitStrategy strategy() const;
+
+   private:
+    static constexpr uint32_t SPIN_ATTEMPTS = 64;
+    static constexpr uint32_t YIELD_ATTEMPTS = 128;
+
+    static void pause();
+    static void yield();
+
+    template <typename Ready>
+    void sleepUnless(Ready& ready)
+    {
+        // read the epoch before announcing ourselves, so a notify between the check below and the
+        // wait moves it on and the wait returns straight away
+        const uint32_t epoch = d_epoch.load(std::memory_order_acquire);
+        d_sleepers.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (!ready())
+        {
+            d_epoch.wait(epoch, std::memory_order_acquire);
+        }
+
+        d_sleepers.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    const WaitStrategy d_strategy;
+    std::atomic<uint32_t> d_epoch{0};
+    std::atomic<uint32_t> d_sleepers{0};
+};
+
+}  // namespace solstice
+
+#endif  // RING_WAITER_H
@@ -0,0 +1,97 @@
+#ifndef SEQ_LOCKED_H
+#define SEQ_LOCKED_H
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace solstice
+{
+
+// Holds a trivially copyable value behind a sequence lock. Readers never block: they copy the
+// value and retry if a writer was active while they copied, so many threads can take consistent
+// snapshots while another updates it. Writers are serialised by marking the sequence odd for the
+// duration of the update, so updates should be short.
+template <typename T>
+class SeqLocked
+{
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLocked values are copied byte-wise");
+
+   public:
+    template <typename... Args>
+    explicit SeqLocked(Args&&... args) : d_value(std::forward<Args>(args)...)
+    {
+    }
+
+    SeqLocked(const SeqLocked&) = delete;
+    SeqLocked& operator=(const SeqLocked&) = delete;
+
+    // a consistent copy of the value as of the last completed write
+    T read() const
+    {
+        std::array<std::byte, sizeof(T)> bytes;
+        uint64_t before;
+
+        do
+        {
+            before = d_sequence.load(std::memory_order_acquire);
+            std::memcpy(bytes.data(), &d_value, sizeof(T));
+            std::atomic_thread_fence(std::memory_order_acquire);
+        } while ((before & 1) != 0 || before != d_sequence.load(std::memory_order_relaxed));
+
+        return std::bit_cast<T>(bytes);
+    }
+
+    // runs func on the value with exclusive access, returning whatever func returns
+    template <typename Func>
+    decltype(auto) write(Func&& func)
+    {
+        struct Release
+        {
+            std::atomic<uint64_t>& sequence;
+            uint64_t acquired;
+            ~Release() { sequence.store(acquired + 2, std::memory_order_release); }
+        };
+
+        Release release{d_sequence, acquire()};
+        return std::forward<Func>(func)(d_value);
+    }
+
+    // no synchronisation, only for setup or when no other thread can touch the value
+    T& value() { return d_value; }
+
+   private:
+    // spins until the sequence is even and this writer has made it odd, returning the even value
+    uint64_t acquire()
+    {
+        uint64_t sequence = d_sequence.load(std::memory_order_relaxed);
+
+        while ((sequence & 1) != 0 ||
+               !d_sequence.compare_exchange_weak(sequence, sequence + 1, std::memory_order_acquire,
+                                                 std::memory_order_relaxed))
+        {
+            if ((sequence & 1) != 0)
+            {
+                std::this_thread::yield();
+                sequence = d_sequence.load(std::memory_order_relaxed);
+            }
+        }
+
+        // keeps the writes to d_value from becoming visible before the odd sequence
+        std::atomic_thread_fence(std::memory_order_release);
+        return sequence;
+    }
+
+    std::atomic<uint64_t> d_sequence{0};
+    T d_value;
+};
+
+}  // namespace solstice
+
+#endif  // SEQ_LOCKED_H
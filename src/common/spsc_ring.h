@@ -0,0 +1,110 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace solstice
+{
+
+// keeps the producer and consumer indices of a ring on separate cache lines
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+// Bounded lock-free ring for exactly one producer thread and one consumer thread. Capacity is
+// rounded up to a power of two. Each side keeps a cached copy of the other side's index and only
+// reloads the shared atomic when the cached value says the ring looks full or empty, so in the
+// steady state a push or pop touches no cache line owned by the other thread.
+template <typename T>
+class SpscRing
+{
+   public:
+    explicit SpscRing(size_t capacity)
+        : d_slots(std::bit_ceil(capacity < 2 ? size_t{2} : capacity)),
+          d_mask(d_slots.size() - 1)
+    {
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // producer only
+    bool tryPush(T&& value)
+    {
+        const size_t tail = d_tail.load(std::memory_order_relaxed);
+
+        if (tail - d_cachedHead == d_slots.size())
+        {
+            d_cachedHead = d_head.load(std::memory_order_acquire);
+            if (tail - d_cachedHead == d_slots.size())
+            {
+                return false;
+            }
+        }
+
+        d_slots[tail & d_mask] = std::move(value);
+        d_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPush(const T& value)
+    {
+        T copy = value;
+        return tryPush(std::move(copy));
+    }
+
+    // consumer only
+    bool tryPop(T& out) { return popBatch(&out, 1) == 1; }
+
+    // consumer only. Moves up to maxCount values into out and publishes the freed slots to the
+    // producer with a single store
+    size_t popBatch(T* out, size_t maxCount)
+    {
+        const size_t head = d_head.load(std::memory_order_relaxed);
+
+        if (d_cachedTail == head)
+        {
+            d_cachedTail = d_tail.load(std::memory_order_acquire);
+            if (d_cachedTail == head)
+            {
+                return 0;
+            }
+        }
+
+        const size_t count = std::min(maxCount, d_cachedTail - head);
+        for (size_t i = 0; i < count; i++)
+        {
+            // moving out leaves the slot empty, so the ring never keeps a popped value alive
+            out[i] = std::move(d_slots[(head + i) & d_mask]);
+        }
+
+        d_head.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    // approximate when called while the other side is active
+    size_t size() const
+    {
+        return d_tail.load(std::memory_order_acquire) - d_head.load(std::memory_order_acquire);
+    }
+
+    bool empty() const { return size() == 0; }
+    size_t capacity() const { return d_slots.size(); }
+
+   private:
+    std::vector<T> d_slots;
+    const size_t d_mask;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> d_head{0};
+    size_t d_cachedTail = 0;  // consumer's last view of d_tail
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> d_tail{0};
+    size_t d_cachedHead = 0;  // producer's last view of d_head
+};
+
+}  // namespace solstice
+
+#endif  // SPSC_RING_H
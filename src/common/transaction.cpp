@@ -1,36 +1,36 @@
-#include <time_point.h>
+#include <asset_class.h>
+#include <ticks.h>
 #include <transaction.h>
 #include <types.h>
 
 namespace solstice::matching
 {
 
-Transaction::Transaction(OrderPtr bid, OrderPtr ask, double price, int qnty)
-    : d_uid(Random::getRandomUid()),
-      d_timeExecuted(timeNow()),
-      d_bidUid(bid->uid()),
-      d_askUid(ask->uid()),
+Transaction::Transaction(const Underlying& underlying, uint64_t sequence, Ticks price, int qnty,
+                         int bidUid, int askUid)
+    : d_sequence(sequence),
+      d_bidUid(bidUid),
+      d_askUid(askUid),
+      d_underlying(underlying),
       d_price(price),
-      d_qnty(qnty),
-      d_underlying(bid->underlying())
+      d_qnty(qnty)
 {
 }
 
-const String& Transaction::uid() const { return d_uid; }
+uint64_t Transaction::sequence() const { return d_sequence; }
 int Transaction::bidUid() const { return d_bidUid; }
 int Transaction::askUid() const { return d_askUid; }
 const Underlying& Transaction::underlying() const { return d_underlying; }
-double Transaction::price() const { return d_price; }
+Ticks Transaction::priceTicks() const { return d_price; }
+double Transaction::price() const { return fromTicks(d_price, d_underlying); }
 int Transaction::qnty() const { return d_qnty; }
-const TimePoint& Transaction::timeExecuted() const { return d_timeExecuted; }
 
 std::ostream& operator<<(std::ostream& os, const Transaction& transaction)
 {
-    os << "Transaction UID: " << transaction.uid() << " | Bid order UID: " << transaction.bidUid()
+    os << "Transaction: " << transaction.sequence() << " | Bid order UID: " << transaction.bidUid()
        << " | Ask order UID: " << transaction.askUid()
        << " | Ticker: " << to_string(transaction.underlying())
-       << " | Price: " << transaction.price() << " | Quantity: " << transaction.qnty()
-       << " | Time executed: " << transaction.timeExecuted();
+       << " | Price: " << transaction.price() << " | Quantity: " << transaction.qnty();
 
     return os;
 }
@@ -1,43 +1,39 @@
 #ifndef TRANSACTION_H
 #define TRANSACTION_H
 
-#include <get_random.h>
-#include <order.h>
-#include <time_point.h>
+#include <asset_class.h>
+#include <ticks.h>
 #include <types.h>
 
-#include <memory>
+#include <cstdint>
 #include <ostream>
 
 namespace solstice::matching
 {
-using OrderPtr = std::shared_ptr<Order>;
-
-class OrderBook;
 
+// One trade read back from an underlying's TradeTape
 struct Transaction
 {
-    friend class OrderBook;
-
    public:
-    const String& uid() const;
+    Transaction(const Underlying& underlying, uint64_t sequence, Ticks price, int qnty, int bidUid,
+                int askUid);
+
+    // numbers every trade in the book in the order it was matched
+    uint64_t sequence() const;
     int bidUid() const;
     int askUid() const;
     const Underlying& underlying() const;
+    Ticks priceTicks() const;
     double price() const;
     int qnty() const;
-    const TimePoint& timeExecuted() const;
 
    private:
-    Transaction(OrderPtr bid, OrderPtr ask, double price, int qnty);
-
-    String d_uid;
+    uint64_t d_sequence;
     int d_bidUid;
     int d_askUid;
     Underlying d_underlying;
-    double d_price;
+    Ticks d_price;
     int d_qnty;
-    TimePoint d_timeExecuted;
 };
 
 std::ostream& operator<<(std::ostream& os, const Transaction& transaction);
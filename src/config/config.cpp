@@ -25,6 +25,7 @@ LogLevel Config::logLevel() const { return d_logLevel; }
 AssetClass Config::assetClass() const { return d_assetClass; }
 int Config::ordersToGenerate() const { return d_ordersToGenerate; }
 int Config::underlyingPoolCount() const { return d_underlyingPoolCount; }
+const String& Config::instrumentsPath() const { return d_instrumentsPath; }
 int Config::minQnty() const { return d_minQnty; }
 int Config::maxQnty() const { return d_maxQnty; }
 double Config::minPrice() const { return d_minPrice; }
@@ -34,11 +35,31 @@ int Config::maxExpiryDays() const { return d_maxExpiryDays; }
 bool Config::usePricer() const { return d_usePricer; }
 bool Config::enableBroadcaster() const { return d_enableBroadcaster; }
 int Config::broadcastInterval() const { return d_broadcastInterval; }
+int Config::broadcastDepth() const { return d_broadcastDepth; }
+BookBackend Config::bookBackend() const { return d_bookBackend; }
+bool Config::usePooledOrders() const { return d_usePooledOrders; }
+bool Config::shardedMatching() const { return d_shardedMatching; }
+int Config::matchingThreads() const { return d_matchingThreads; }
+int Config::queueCapacity() const { return d_queueCapacity; }
+WaitStrategy Config::waitStrategy() const { return d_waitStrategy; }
+int Config::queueHighWaterMark() const { return d_queueHighWaterMark; }
+BackpressurePolicy Config::backpressurePolicy() const { return d_backpressurePolicy; }
+int Config::statsInterval() const { return d_statsInterval; }
+bool Config::measureLatency() const { return d_measureLatency; }
+int Config::generatorThreads() const { return d_generatorThreads; }
+uint64_t Config::randomSeed() const { return d_randomSeed; }
+const String& Config::journalPath() const { return d_journalPath; }
+const String& Config::replayPath() const { return d_replayPath; }
+const String& Config::eventLogPath() const { return d_eventLogPath; }
+int Config::eventLogFlushInterval() const { return d_eventLogFlushInterval; }
+const String& Config::snapshotPath() const { return d_snapshotPath; }
+int Config::snapshotInterval() const { return d_snapshotInterval; }
 
 void Config::logLevel(LogLevel level) { d_logLevel = level; }
 void Config::assetClass(AssetClass assetClass) { d_assetClass = assetClass; }
 void Config::ordersToGenerate(int count) { d_ordersToGenerate = count; }
 void Config::underlyingPoolCount(int count) { d_underlyingPoolCount = count; }
+void Config::instrumentsPath(const String& path) { d_instrumentsPath = path; }
 void Config::minQnty(int qnty) { d_minQnty = qnty; }
 void Config::maxQnty(int qnty) { d_maxQnty = qnty; }
 void Config::minPrice(double price) { d_minPrice = price; }
@@ -48,6 +69,28 @@ void Config::maxExpiryDays(int days) { d_maxExpiryDays = days; }
 void Config::usePricer(bool usePricer) { d_usePricer = usePricer; }
 void Config::enableBroadcaster(bool enableBroadcaster) { d_enableBroadcaster = enableBroadcaster; }
 void Config::broadcastInterval(int broadcastInterval) { d_broadcastInterval = broadcastInterval; }
+void Config::broadcastDepth(int levels) { d_broadcastDepth = levels; }
+void Config::bookBackend(BookBackend bookBackend) { d_bookBackend = bookBackend; }
+void Config::usePooledOrders(bool usePooledOrders) { d_usePooledOrders = usePooledOrders; }
+void Config::shardedMatching(bool shardedMatching) { d_shardedMatching = shardedMatching; }
+void Config::matchingThreads(int count) { d_matchingThreads = count; }
+void Config::queueCapacity(int capacity) { d_queueCapacity = capacity; }
+void Config::waitStrategy(WaitStrategy waitStrategy) { d_waitStrategy = waitStrategy; }
+void Config::queueHighWaterMark(int highWaterMark) { d_queueHighWaterMark = highWaterMark; }
+void Config::backpressurePolicy(BackpressurePolicy backpressurePolicy)
+{
+    d_backpressurePolicy = backpressurePolicy;
+}
+void Config::statsInterval(int statsInterval) { d_statsInterval = statsInterval; }
+void Config::measureLatency(bool measureLatency) { d_measureLatency = measureLatency; }
+void Config::generatorThreads(int count) { d_generatorThreads = count; }
+void Config::randomSeed(uint64_t seed) { d_randomSeed = seed; }
+void Config::journalPath(const String& path) { d_journalPath = path; }
+void Config::replayPath(const String& path) { d_replayPath = path; }
+void Config::eventLogPath(const String& path) { d_eventLogPath = path; }
+void Config::eventLogFlushInterval(int events) { d_eventLogFlushInterval = events; }
+void Config::snapshotPath(const String& path) { d_snapshotPath = path; }
+void Config::snapshotInterval(int snapshotInterval) { d_snapshotInterval = snapshotInterval; }
 
 int Config::initialBalance() const { return d_initialBalance; }
 
@@ -55,7 +98,12 @@ Resolution<std::monostate> Config::checkConfig(Config& config)
 {
     auto values = {double(config.ordersToGenerate()), double(config.minQnty()),
                    double(config.maxQnty()),          double(config.minPrice()),
-                   double(config.maxPrice()),         double(config.underlyingPoolCount())};
+                   double(config.maxPrice()),         double(config.underlyingPoolCount()),
+                   double(config.matchingThreads()),  double(config.queueCapacity()),
+                   double(config.queueHighWaterMark()),
+                   double(config.statsInterval()),    double(config.generatorThreads()),
+                   double(config.eventLogFlushInterval()),
+                   double(config.snapshotInterval())};
 
     if (config.ordersToGenerate() == -1)
     {
@@ -2,11 +2,15 @@
 #define CONFIG_H
 
 #include <asset_class.h>
+#include <backpressure_policy.h>
+#include <book_backend.h>
 #include <log_level.h>
 #include <strategy.h>
+#include <wait_strategy.h>
 #include <types.h>
 
 #include <resolution.hpp>
+#include <cstdint>
 #include <variant>
 
 namespace solstice
@@ -25,6 +29,7 @@ struct Config
     AssetClass assetClass() const;
     int ordersToGenerate() const;
     int underlyingPoolCount() const;
+    const String& instrumentsPath() const;
     int minQnty() const;
     int maxQnty() const;
     double minPrice() const;
@@ -34,11 +39,31 @@ struct Config
     bool usePricer() const;
     bool enableBroadcaster() const;
     int broadcastInterval() const;
+    int broadcastDepth() const;
+    BookBackend bookBackend() const;
+    bool usePooledOrders() const;
+    bool shardedMatching() const;
+    int matchingThreads() const;
+    int queueCapacity() const;
+    WaitStrategy waitStrategy() const;
+    int queueHighWaterMark() const;
+    BackpressurePolicy backpressurePolicy() const;
+    int statsInterval() const;
+    bool measureLatency() const;
+    int generatorThreads() const;
+    uint64_t randomSeed() const;
+    const String& journalPath() const;
+    const String& replayPath() const;
+    const String& eventLogPath() const;
+    int eventLogFlushInterval() const;
+    const String& snapshotPath() const;
+    int snapshotInterval() const;
 
     void logLevel(LogLevel level);
     void assetClass(AssetClass assetClass);
     void ordersToGenerate(int count);
     void underlyingPoolCount(int count);
+    void instrumentsPath(const String& path);
     void minQnty(int qnty);
     void maxQnty(int qnty);
     void minPrice(double price);
@@ -48,6 +73,25 @@ struct Config
     void usePricer(bool usePricer);
     void enableBroadcaster(bool enableBroadcaster);
     void broadcastInterval(int broadcastInterval);
+    void broadcastDepth(int levels);
+    void bookBackend(BookBackend bookBackend);
+    void usePooledOrders(bool usePooledOrders);
+    void shardedMatching(bool shardedMatching);
+    void matchingThreads(int count);
+    void queueCapacity(int capacity);
+    void waitStrategy(WaitStrategy waitStrategy);
+    void queueHighWaterMark(int highWaterMark);
+    void backpressurePolicy(BackpressurePolicy backpressurePolicy);
+    void statsInterval(int statsInterval);
+    void measureLatency(bool measureLatency);
+    void generatorThreads(int count);
+    void randomSeed(uint64_t seed);
+    void journalPath(const String& path);
+    void replayPath(const String& path);
+    void eventLogPath(const String& path);
+    void eventLogFlushInterval(int events);
+    void snapshotPath(const String& path);
+    void snapshotInterval(int snapshotInterval);
 
     // ===================================================================
     // Backtesting
@@ -83,6 +127,10 @@ struct Config
     // how many variations of underlying asset class to use in sim (e.g. AAPL, MSFT etc)
     int d_underlyingPoolCount = 10;
 
+    // load the instruments to trade from this definitions file (see instrument_universe.h) and
+    // draw the pools from them -- leave empty to trade the built-in tickers
+    String d_instrumentsPath;
+
     // minimum quantity for randomly generated orders (only applicable if d_usePricer = false)
     int d_minQnty = 1;
 
@@ -112,6 +160,85 @@ struct Config
     // broadcast 1 order per x that come in. Higher interval value results in faster broadcasting
     int d_broadcastInterval = 10;
 
+    // price levels per side included in each book broadcast, with their quantity and order count
+    int d_broadcastDepth = 5;
+
+    // price level storage for the book: Tree (std::map per side) or Ladder (flat tick-indexed
+    // array with a bitmap for best price lookup)
+    BookBackend d_bookBackend = BookBackend::Tree;
+
+    // allocate orders from per-thread slab pools rather than individually on the heap
+    bool d_usePooledOrders = true;
+
+    // give each underlying a single owning worker with its own queue, so books are matched without
+    // locks and orders for one underlying are always processed in the order they were generated.
+    // When false, all workers pull from one shared queue and lock the underlying being matched
+    bool d_shardedMatching = true;
+
+    // number of worker threads matching orders -- set to 0 to use one per hardware thread
+    int d_matchingThreads = 0;
+
+    // number of orders each worker queue can hold before the producer has to wait, rounded up to a
+    // power of two
+    int d_queueCapacity = 65536;
+
+    // how idle workers wait for orders, and the producer for space: BusySpin (lowest latency, burns
+    // a core per thread), SpinThenYield, or Blocking (sleeps after a short spin)
+    WaitStrategy d_waitStrategy = WaitStrategy::Blocking;
+
+    // queue depth at which the producer applies backpressure -- set to 0 to use the full queue
+    // capacity. Keeps the backlog, and so the latency of the orders in it, bounded when generation
+    // outpaces matching
+    int d_queueHighWaterMark = 0;
+
+    // at the high-water mark, either Block the producer until workers catch up or Shed (drop) the
+    // order so generation continues at the offered load
+    BackpressurePolicy d_backpressurePolicy = BackpressurePolicy::Block;
+
+    // print queue depth, time blocked and shed orders every x milliseconds while orders are being
+    // generated -- set to 0 to disable
+    int d_statsInterval = 1000;
+
+    // time each order from being handed to the workers until it has been matched, using the CPU's
+    // time stamp counter, and print the mean and worst case when the run ends
+    bool d_measureLatency = false;
+
+    // number of threads generating orders, each pricing its own partition of the underlyings and
+    // feeding the worker queues directly -- set to 0 to use one per hardware thread. Capped at the
+    // number of shards when sharded matching is on, so every shard queue keeps a single producer
+    int d_generatorThreads = 1;
+
+    // master seed for every thread's random stream. Generators and shard workers are each bound
+    // to their own stream, so a fixed seed replays the same draws on every run -- set to 0 to seed
+    // from std::random_device
+    uint64_t d_randomSeed = 0;
+
+    // record every generated order to this binary journal -- leave empty to disable
+    String d_journalPath;
+
+    // replay the orders in this journal instead of generating new ones, matching them on one
+    // thread, or per shard when sharded matching is on -- leave empty to generate as normal
+    String d_replayPath;
+
+    // write every accept, fill and cancel to memory mapped logs at this path, one per matching
+    // thread with the thread's number appended. Logs left by an earlier run are replayed into the
+    // book at startup and then appended to -- leave empty to disable
+    String d_eventLogPath;
+
+    // events each matching thread logs between scheduling writeback of its log to disk -- set to 0
+    // to only write back when the run ends
+    int d_eventLogFlushInterval = 4096;
+
+    // write a snapshot of every resting order and the price data to this file when a run ends,
+    // and load it at startup so only events logged after it need replaying -- leave empty to
+    // disable
+    String d_snapshotPath;
+
+    // also snapshot every x milliseconds while orders are being matched, copying each shard's
+    // books between its batches rather than stopping matching -- set to 0 to only snapshot when
+    // the run ends
+    int d_snapshotInterval = 0;
+
     // ===================================================================
     // Backtesting
     // ===================================================================
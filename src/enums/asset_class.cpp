@@ -1,8 +1,8 @@
 #include <asset_class.h>
+#include <random_stream.h>
 #include <types.h>
 
 #include <ostream>
-#include <random>
 
 namespace solstice
 {
@@ -18,11 +18,8 @@ std::ostream& operator<<(std::ostream& os, AssetClass assetClass)
 
 AssetClass randomAssetClass()
 {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_int_distribution<int> dist(0, static_cast<int>(AssetClass::COUNT) - 1);
-
-    return static_cast<AssetClass>(dist(gen));
+    return static_cast<AssetClass>(
+        RandomStream::local().uniformInt(0, static_cast<int>(AssetClass::COUNT) - 1));
 }
 
 Resolution<Underlying> getUnderlying(AssetClass assetClass)
@@ -1,6 +1,7 @@
 #ifndef ASSET_CLASS_H
 #define ASSET_CLASS_H
 
+#include <random_stream.h>
 #include <types.h>
 
 #include <algorithm>
@@ -8,7 +9,8 @@
 #include <cstdint>
 #include <expected>
 #include <ostream>
-#include <random>
+#include <span>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -46,7 +48,10 @@ inline std::ostream& operator<<(std::ostream& os, const AssetClass& assetClass)
 // Enum: Equity
 // ===================================================================
 
-enum class Equity : uint8_t
+// The named tickers below are the built-in universe. Instruments loaded from a definitions file
+// (see instrument_universe.h) take the values after COUNT, so a ticker is any value of its type
+// that the universe defines, not just a named one
+enum class Equity : uint32_t
 {
     AAPL,
     MSFT,
@@ -69,7 +74,7 @@ constexpr std::array<Equity, static_cast<size_t>(Equity::COUNT)> ALL_EQUITIES =
 // Enum: Future
 // ===================================================================
 
-enum class Future : uint8_t
+enum class Future : uint32_t
 {
     AAPL_MAR26,
     AAPL_JUN26,
@@ -130,7 +135,7 @@ constexpr std::array<Future, static_cast<size_t>(Future::COUNT)> ALL_FUTURES = {
 // Enum: Option
 // ===================================================================
 
-enum class Option : uint8_t
+enum class Option : uint32_t
 {
     // AAPL Calls
     AAPL_MAR26_C,
@@ -265,17 +270,10 @@ Resolution<Underlying> getUnderlying(AssetClass assetClass);
 // Templates
 // ===================================================================
 
-template <typename T>
-const char* to_string(T type)
-{
-    int underlying = static_cast<size_t>(type);
-
-    if (std::is_same_v<T, Future>) return FTR_STR[underlying];
-
-    if (std::is_same_v<T, Equity>) return EQ_STR[underlying];
-
-    if (std::is_same_v<T, Option>) return OPT_STR[underlying];
-}
+// the ticker's symbol in the instrument universe
+const char* to_string(Equity eq);
+const char* to_string(Future fut);
+const char* to_string(Option opt);
 
 template <typename T>
 const Resolution<T> randomUnderlying()
@@ -286,11 +284,7 @@ const Resolution<T> randomUnderlying()
         return resolution::err("Underlying pool is empty");
     }
 
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dist(0, pool.size() - 1);
-
-    return pool[dist(gen)];
+    return pool[RandomStream::local().uniformInt(0, static_cast<int64_t>(pool.size()) - 1)];
 }
 
 template <typename... Types>
@@ -343,8 +337,8 @@ inline const std::vector<T>& underlyingsPool()
     return d_underlyingsPool<T>;
 }
 
-template <typename T, std::size_t N>
-inline void setUnderlyingsPool(int poolSize, const std::array<T, N>& fullSet)
+template <typename T>
+inline void setUnderlyingsPool(int poolSize, std::span<const T> fullSet)
 {
     if (underlyingsPoolInitialised<T>()) return;
 
@@ -353,15 +347,24 @@ inline void setUnderlyingsPool(int poolSize, const std::array<T, N>& fullSet)
 
     if (poolSize > 0 && poolSize < static_cast<int>(pool.size()))
     {
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
-        std::shuffle(pool.begin(), pool.end(), gen);
+        // Fisher-Yates rather than std::shuffle, whose order differs between standard libraries
+        auto& engine = RandomStream::local();
+        for (size_t i = pool.size() - 1; i > 0; i--)
+        {
+            std::swap(pool[i], pool[engine.uniformInt(0, static_cast<int64_t>(i))]);
+        }
         pool.resize(poolSize);
     }
 
     setUnderlyingsPoolInitialised<T>(true);
 }
 
+template <typename T, std::size_t N>
+inline void setUnderlyingsPool(int poolSize, const std::array<T, N>& fullSet)
+{
+    setUnderlyingsPool(poolSize, std::span<const T>(fullSet));
+}
+
 }  // namespace solstice
 
 #endif  // ASSET_CLASS_H
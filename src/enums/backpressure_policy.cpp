@@ -0,0 +1,17 @@
+#include <backpressure_policy.h>
+
+#include <ostream>
+
+namespace solstice
+{
+
+std::ostream& operator<<(std::ostream& os, const BackpressurePolicy& backpressurePolicy)
+{
+    if (backpressurePolicy == BackpressurePolicy::Block)
+        os << "Block";
+    else
+        os << "Shed";
+
+    return os;
+}
+}  // namespace solstice
@@ -0,0 +1,21 @@
+#ifndef BACKPRESSURE_POLICY_H
+#define BACKPRESSURE_POLICY_H
+
+#include <cstdint>
+#include <ostream>
+
+namespace solstice
+{
+
+// what the producer does with an order when the queue it is routed to is at its high-water mark
+enum class BackpressurePolicy : uint8_t
+{
+    Block,
+    Shed
+};
+
+std::ostream& operator<<(std::ostream& os, const BackpressurePolicy& backpressurePolicy);
+
+}  // namespace solstice
+
+#endif  // BACKPRESSURE_POLICY_H
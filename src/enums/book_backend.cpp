@@ -0,0 +1,17 @@
+#include <book_backend.h>
+
+#include <ostream>
+
+namespace solstice
+{
+
+std::ostream& operator<<(std::ostream& os, const BookBackend& bookBackend)
+{
+    if (bookBackend == BookBackend::Tree)
+        os << "Tree";
+    else
+        os << "Ladder";
+
+    return os;
+}
+}  // namespace solstice
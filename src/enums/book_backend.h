@@ -0,0 +1,20 @@
+#ifndef BOOK_BACKEND_H
+#define BOOK_BACKEND_H
+
+#include <cstdint>
+#include <ostream>
+
+namespace solstice
+{
+
+enum class BookBackend : uint8_t
+{
+    Tree,
+    Ladder
+};
+
+std::ostream& operator<<(std::ostream& os, const BookBackend& bookBackend);
+
+}  // namespace solstice
+
+#endif  // BOOK_BACKEND_H
@@ -0,0 +1,23 @@
+#include <book_event_type.h>
+
+#include <ostream>
+
+namespace solstice
+{
+
+std::ostream& operator<<(std::ostream& os, const BookEventType& bookEventType)
+{
+    if (bookEventType == BookEventType::Accept)
+        os << "Accept";
+    else if (bookEventType == BookEventType::Fill)
+        os << "Fill";
+    else if (bookEventType == BookEventType::Cancel)
+        os << "Cancel";
+    else if (bookEventType == BookEventType::AuctionStart)
+        os << "AuctionStart";
+    else
+        os << "Uncross";
+
+    return os;
+}
+}  // namespace solstice
@@ -0,0 +1,25 @@
+#ifndef BOOK_EVENT_TYPE_H
+#define BOOK_EVENT_TYPE_H
+
+#include <cstdint>
+#include <ostream>
+
+namespace solstice
+{
+
+// what happened to the book in an event log record
+enum class BookEventType : uint8_t
+{
+    Accept,
+    Fill,
+    Cancel,
+    // an underlying's call auction starting and uncrossing, its trades logged as fills before it
+    AuctionStart,
+    Uncross
+};
+
+std::ostream& operator<<(std::ostream& os, const BookEventType& bookEventType);
+
+}  // namespace solstice
+
+#endif  // BOOK_EVENT_TYPE_H
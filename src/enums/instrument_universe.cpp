@@ -0,0 +1,540 @@
+#include <asset_class.h>
+#include <instrument_universe.h>
+#include <option_type.h>
+#include <ticks.h>
+#include <types.h>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+namespace solstice
+{
+
+namespace
+{
+
+struct Universe
+{
+    // indexed by the Equity, Future or Option value
+    std::vector<InstrumentDefinition> equities;
+    std::vector<InstrumentDefinition> futures;
+    std::vector<InstrumentDefinition> options;
+
+    std::vector<Equity> tradableEquities;
+    std::vector<Future> tradableFutures;
+    std::vector<Option> tradableOptions;
+
+    std::unordered_map<String, Underlying> bySymbol;
+};
+
+constexpr std::array<std::string_view, 12> MONTHS = {"JAN", "FEB", "MAR", "APR", "MAY", "JUN",
+                                                     "JUL", "AUG", "SEP", "OCT", "NOV", "DEC"};
+
+int monthOf(std::string_view month)
+{
+    for (size_t i = 0; i < MONTHS.size(); i++)
+    {
+        if (MONTHS[i] == month)
+        {
+            return static_cast<int>(i) + 1;
+        }
+    }
+    return 0;
+}
+
+// built-in futures and options are named UNDERLYING_MMMYY, with _C or _P after an option's expiry
+InstrumentDefinition builtInDefinition(std::string_view symbol, AssetClass assetClass)
+{
+    InstrumentDefinition definition;
+    definition.symbol = String(symbol);
+    definition.assetClass = assetClass;
+
+    if (assetClass == AssetClass::Equity)
+    {
+        definition.tickSize = EQUITY_TICK_SIZE;
+        return definition;
+    }
+    definition.tickSize = assetClass == AssetClass::Future ? FUTURE_TICK_SIZE : OPTION_TICK_SIZE;
+
+    const std::string_view expiry =
+        symbol.substr(symbol.find('_') + 1, assetClass == AssetClass::Option ? 5 : String::npos);
+
+    definition.underlying = String(symbol.substr(0, symbol.find('_')));
+    definition.expiryMonth = monthOf(expiry.substr(0, 3));
+    definition.expiryYear = 2000 + std::stoi(String(expiry.substr(3, 2)));
+    return definition;
+}
+
+template <typename T>
+std::vector<InstrumentDefinition>& definitionsOf(Universe& universe)
+{
+    if constexpr (std::is_same_v<T, Equity>)
+    {
+        return universe.equities;
+    }
+    else if constexpr (std::is_same_v<T, Future>)
+    {
+        return universe.futures;
+    }
+    else
+    {
+        return universe.options;
+    }
+}
+
+template <typename T>
+std::vector<T>& tradableOf(Universe& universe)
+{
+    if constexpr (std::is_same_v<T, Equity>)
+    {
+        return universe.tradableEquities;
+    }
+    else if constexpr (std::is_same_v<T, Future>)
+    {
+        return universe.tradableFutures;
+    }
+    else
+    {
+        return universe.tradableOptions;
+    }
+}
+
+// adds the instrument, or redefines the one of the same asset class with its symbol
+template <typename T>
+Resolution<T> define(Universe& universe, const InstrumentDefinition& definition)
+{
+    auto& definitions = definitionsOf<T>(universe);
+
+    auto [it, inserted] =
+        universe.bySymbol.try_emplace(definition.symbol, static_cast<T>(definitions.size()));
+    if (!inserted && !std::holds_alternative<T>(it->second))
+    {
+        return resolution::err(std::format("Symbol {} is already defined as another asset class",
+                                           definition.symbol));
+    }
+
+    const T ticker = std::get<T>(it->second);
+    if (inserted)
+    {
+        definitions.push_back(definition);
+    }
+    else
+    {
+        definitions[static_cast<size_t>(ticker)] = definition;
+    }
+    return ticker;
+}
+
+// defines the instrument and makes it tradable
+template <typename T>
+Resolution<std::monostate> defineTradable(Universe& universe,
+                                          const InstrumentDefinition& definition)
+{
+    auto ticker = define<T>(universe, definition);
+    if (!ticker)
+    {
+        return resolution::err(ticker.error());
+    }
+
+    tradableOf<T>(universe).push_back(*ticker);
+    return std::monostate{};
+}
+
+// sets underlyingEquity from the underlying's symbol
+Resolution<std::monostate> resolveUnderlying(Universe& universe, InstrumentDefinition& definition)
+{
+    auto it = universe.bySymbol.find(definition.underlying);
+    if (it == universe.bySymbol.end() || !std::holds_alternative<Equity>(it->second))
+    {
+        return resolution::err(std::format("Underlying {} of {} is not a defined equity",
+                                           definition.underlying, definition.symbol));
+    }
+
+    definition.underlyingEquity = std::get<Equity>(it->second);
+    return std::monostate{};
+}
+
+Resolution<std::monostate> validate(const InstrumentDefinition& definition)
+{
+    if (definition.symbol.empty())
+    {
+        return resolution::err("Instrument has no symbol");
+    }
+
+    // prices are held in whole ticks, so a tick must divide 1 exactly
+    const double ticksPerUnit = 1.0 / definition.tickSize;
+    if (!(definition.tickSize > 0.0) || std::abs(ticksPerUnit - std::round(ticksPerUnit)) > 1e-6)
+    {
+        return resolution::err(std::format("Tick size {} of {} does not divide 1",
+                                           definition.tickSize, definition.symbol));
+    }
+
+    if (definition.assetClass == AssetClass::Equity)
+    {
+        return std::monostate{};
+    }
+
+    if (definition.expiryMonth < 1 || definition.expiryMonth > 12)
+    {
+        return resolution::err(std::format("{} has no expiry", definition.symbol));
+    }
+
+    if (definition.assetClass == AssetClass::Option &&
+        (!(definition.strike > 0.0) || !definition.optionType))
+    {
+        return resolution::err(
+            std::format("Option {} needs a strike and option type", definition.symbol));
+    }
+
+    return std::monostate{};
+}
+
+Universe builtInUniverse()
+{
+    Universe universe;
+
+    for (Equity eq : ALL_EQUITIES)
+    {
+        universe.equities.push_back(
+            builtInDefinition(EQ_STR[static_cast<size_t>(eq)], AssetClass::Equity));
+        universe.bySymbol.emplace(universe.equities.back().symbol, eq);
+    }
+    for (Future fut : ALL_FUTURES)
+    {
+        universe.futures.push_back(
+            builtInDefinition(FTR_STR[static_cast<size_t>(fut)], AssetClass::Future));
+        universe.bySymbol.emplace(universe.futures.back().symbol, fut);
+    }
+    for (Option opt : ALL_OPTIONS)
+    {
+        universe.options.push_back(
+            builtInDefinition(OPT_STR[static_cast<size_t>(opt)], AssetClass::Option));
+        universe.bySymbol.emplace(universe.options.back().symbol, opt);
+    }
+
+    for (auto* definitions : {&universe.futures, &universe.options})
+    {
+        for (auto& definition : *definitions)
+        {
+            // every built-in is written on a built-in equity
+            (void)resolveUnderlying(universe, definition);
+        }
+    }
+
+    universe.tradableEquities.assign(ALL_EQUITIES.begin(), ALL_EQUITIES.end());
+    universe.tradableFutures.assign(ALL_FUTURES.begin(), ALL_FUTURES.end());
+    universe.tradableOptions.assign(ALL_OPTIONS.begin(), ALL_OPTIONS.end());
+
+    return universe;
+}
+
+Universe& universe()
+{
+    static Universe instance = builtInUniverse();
+    return instance;
+}
+
+std::string_view trim(std::string_view text)
+{
+    const size_t first = text.find_first_not_of(" \t\r");
+    if (first == std::string_view::npos)
+    {
+        return {};
+    }
+    return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+}
+
+template <typename T>
+bool parseNumber(std::string_view text, T& value)
+{
+    auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return ec == std::errc{} && end == text.data() + text.size();
+}
+
+Resolution<InstrumentDefinition> parseLine(std::string_view line)
+{
+    std::array<std::string_view, 7> fields{};
+    size_t count = 0;
+    while (count < fields.size())
+    {
+        const size_t comma = line.find(',');
+        fields[count++] = trim(line.substr(0, comma));
+        if (comma == std::string_view::npos)
+        {
+            break;
+        }
+        line.remove_prefix(comma + 1);
+    }
+
+    const auto [symbol, assetClass, tickSize, underlying, strike, expiry, optionType] = fields;
+
+    InstrumentDefinition definition;
+    definition.symbol = String(symbol);
+
+    auto assetClassIt = std::ranges::find(ASSET_CLASS_STR, assetClass);
+    if (assetClassIt == ASSET_CLASS_STR.end())
+    {
+        return resolution::err(std::format("Unknown asset class '{}'", assetClass));
+    }
+    definition.assetClass =
+        static_cast<AssetClass>(std::distance(ASSET_CLASS_STR.begin(), assetClassIt));
+
+    if (!tickSize.empty() && !parseNumber(tickSize, definition.tickSize))
+    {
+        return resolution::err(std::format("Tick size '{}' is not a number", tickSize));
+    }
+
+    definition.underlying = String(underlying);
+
+    if (!strike.empty() && !parseNumber(strike, definition.strike))
+    {
+        return resolution::err(std::format("Strike '{}' is not a number", strike));
+    }
+
+    if (!expiry.empty())
+    {
+        if (expiry.size() < 7 || expiry[4] != '-' ||
+            !parseNumber(expiry.substr(0, 4), definition.expiryYear) ||
+            !parseNumber(expiry.substr(5, 2), definition.expiryMonth))
+        {
+            return resolution::err(std::format("Expiry '{}' is not YYYY-MM", expiry));
+        }
+    }
+
+    if (optionType == "Call")
+    {
+        definition.optionType = OptionType::Call;
+    }
+    else if (optionType == "Put")
+    {
+        definition.optionType = OptionType::Put;
+    }
+    else if (!optionType.empty())
+    {
+        return resolution::err(std::format("Option type '{}' is not Call or Put", optionType));
+    }
+
+    return definition;
+}
+
+}  // namespace
+
+Resolution<std::vector<InstrumentDefinition>> parseInstruments(const String& path)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        return resolution::err(std::format("Could not open instruments file {}", path));
+    }
+
+    std::vector<InstrumentDefinition> definitions;
+    String line;
+    bool header = true;
+
+    for (size_t lineNumber = 1; std::getline(file, line); lineNumber++)
+    {
+        const std::string_view text = trim(line);
+        if (text.empty() || text.front() == '#')
+        {
+            continue;
+        }
+
+        if (header)
+        {
+            if (!text.starts_with("symbol"))
+            {
+                return resolution::err(std::format("{}:{}: expected a header line", path,
+                                                   lineNumber));
+            }
+            header = false;
+            continue;
+        }
+
+        auto definition = parseLine(text);
+        if (!definition)
+        {
+            return resolution::err(std::format("{}:{}: {}", path, lineNumber, definition.error()));
+        }
+        definitions.push_back(std::move(*definition));
+    }
+
+    return definitions;
+}
+
+Resolution<std::monostate> addInstruments(std::span<const InstrumentDefinition> definitions)
+{
+    // built up on a copy, so definitions that fail leave the universe as it was
+    Universe updated = universe();
+    updated.tradableEquities.clear();
+    updated.tradableFutures.clear();
+    updated.tradableOptions.clear();
+
+    std::unordered_set<String> symbols;
+
+    // equities first, so futures and options can be written on equities anywhere in the file
+    for (const bool equities : {true, false})
+    {
+        for (InstrumentDefinition definition : definitions)
+        {
+            if ((definition.assetClass == AssetClass::Equity) != equities)
+            {
+                continue;
+            }
+
+            if (!equities)
+            {
+                auto resolved = resolveUnderlying(updated, definition);
+                if (!resolved)
+                {
+                    return resolution::err(resolved.error());
+                }
+            }
+
+            auto valid = validate(definition);
+            if (!valid)
+            {
+                return resolution::err(valid.error());
+            }
+
+            if (!symbols.insert(definition.symbol).second)
+            {
+                return resolution::err(
+                    std::format("Symbol {} is defined more than once", definition.symbol));
+            }
+
+            Resolution<std::monostate> added = std::monostate{};
+            switch (definition.assetClass)
+            {
+                case AssetClass::Equity:
+                    added = defineTradable<Equity>(updated, definition);
+                    break;
+                case AssetClass::Future:
+                    added = defineTradable<Future>(updated, definition);
+                    break;
+                case AssetClass::Option:
+                    added = defineTradable<Option>(updated, definition);
+                    break;
+                case AssetClass::COUNT:
+                    break;
+            }
+
+            if (!added)
+            {
+                return resolution::err(added.error());
+            }
+        }
+    }
+
+    universe() = std::move(updated);
+    return std::monostate{};
+}
+
+Resolution<std::monostate> loadInstruments(const String& path)
+{
+    auto definitions = parseInstruments(path);
+    if (!definitions)
+    {
+        return resolution::err(definitions.error());
+    }
+
+    return addInstruments(*definitions);
+}
+
+void resetInstruments() { universe() = builtInUniverse(); }
+
+const InstrumentDefinition& instrumentDefinition(Equity eq)
+{
+    return universe().equities[static_cast<size_t>(eq)];
+}
+
+const InstrumentDefinition& instrumentDefinition(Future fut)
+{
+    return universe().futures[static_cast<size_t>(fut)];
+}
+
+const InstrumentDefinition& instrumentDefinition(Option opt)
+{
+    return universe().options[static_cast<size_t>(opt)];
+}
+
+const InstrumentDefinition& instrumentDefinition(const Underlying& underlying)
+{
+    return std::visit([](auto asset) -> const InstrumentDefinition&
+                      { return instrumentDefinition(asset); },
+                      underlying);
+}
+
+template <>
+size_t instrumentCount<Equity>()
+{
+    return universe().equities.size();
+}
+
+template <>
+size_t instrumentCount<Future>()
+{
+    return universe().futures.size();
+}
+
+template <>
+size_t instrumentCount<Option>()
+{
+    return universe().options.size();
+}
+
+template <>
+std::span<const Equity> tradableUnderlyings<Equity>()
+{
+    return universe().tradableEquities;
+}
+
+template <>
+std::span<const Future> tradableUnderlyings<Future>()
+{
+    return universe().tradableFutures;
+}
+
+template <>
+std::span<const Option> tradableUnderlyings<Option>()
+{
+    return universe().tradableOptions;
+}
+
+std::optional<Underlying> findInstrument(std::string_view symbol)
+{
+    auto it = universe().bySymbol.find(String(symbol));
+    if (it == universe().bySymbol.end())
+    {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+bool instrumentDefined(const Underlying& underlying)
+{
+    return std::visit(
+        [](auto asset)
+        {
+            using T = decltype(asset);
+            return static_cast<size_t>(asset) < definitionsOf<T>(universe()).size();
+        },
+        underlying);
+}
+
+const char* to_string(Equity eq) { return instrumentDefinition(eq).symbol.c_str(); }
+
+const char* to_string(Future fut) { return instrumentDefinition(fut).symbol.c_str(); }
+
+const char* to_string(Option opt) { return instrumentDefinition(opt).symbol.c_str(); }
+
+}  // namespace solstice
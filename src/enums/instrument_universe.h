@@ -0,0 +1,103 @@
+#ifndef INSTRUMENT_UNIVERSE_H
+#define INSTRUMENT_UNIVERSE_H
+
+#include <asset_class.h>
+#include <option_type.h>
+#include <types.h>
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+namespace solstice
+{
+
+constexpr double DEFAULT_TICK_SIZE = 0.01;
+
+// One tradable instrument
+struct InstrumentDefinition
+{
+    String symbol;
+    AssetClass assetClass = AssetClass::Equity;
+    double tickSize = DEFAULT_TICK_SIZE;
+
+    // futures and options only. underlying is the symbol of the equity, which addInstruments
+    // looks up to set underlyingEquity
+    String underlying;
+    std::optional<Equity> underlyingEquity;
+    int expiryYear = 0;
+    int expiryMonth = 0;  // 1 to 12
+
+    // options only. A built-in option leaves both to the pricer, which picks them per order
+    double strike = 0.0;
+    std::optional<OptionType> optionType;
+};
+
+// Definitions files have a header line then one instrument per line:
+//
+//   symbol,asset_class,tick_size,underlying,strike,expiry,option_type
+//   ACME,Equity,0.01,,,,
+//   ACME_MAR27,Future,0.25,ACME,,2027-03,
+//   ACME_MAR27_150_C,Option,0.05,ACME,150,2027-03,Call
+//
+// Blank lines and lines starting with # are skipped. The underlying is the symbol of an equity
+// defined in the same file or built in, and expiry is YYYY-MM with an optional -DD that is ignored.
+Resolution<std::vector<InstrumentDefinition>> parseInstruments(const String& path);
+
+// Adds the definitions to the universe, each after the instruments already in it, unless one of
+// the same asset class has its symbol, in which case that one is redefined and keeps its value.
+// The definitions become the tradable instruments pools are drawn from. Only for setup, as
+// nothing here is synchronised
+Resolution<std::monostate> addInstruments(std::span<const InstrumentDefinition> definitions);
+
+// parses the file then adds its instruments
+Resolution<std::monostate> loadInstruments(const String& path);
+
+// back to the built-in instruments alone
+void resetInstruments();
+
+const InstrumentDefinition& instrumentDefinition(Equity eq);
+const InstrumentDefinition& instrumentDefinition(Future fut);
+const InstrumentDefinition& instrumentDefinition(Option opt);
+const InstrumentDefinition& instrumentDefinition(const Underlying& underlying);
+
+// how many instruments of the type the universe defines, so every value below it is valid
+template <typename T>
+size_t instrumentCount();
+
+template <>
+size_t instrumentCount<Equity>();
+template <>
+size_t instrumentCount<Future>();
+template <>
+size_t instrumentCount<Option>();
+
+// the instruments of the last file loaded, or all the built-in ones if none has been
+template <typename T>
+std::span<const T> tradableUnderlyings();
+
+template <>
+std::span<const Equity> tradableUnderlyings<Equity>();
+template <>
+std::span<const Future> tradableUnderlyings<Future>();
+template <>
+std::span<const Option> tradableUnderlyings<Option>();
+
+std::optional<Underlying> findInstrument(std::string_view symbol);
+
+// whether the universe defines the underlying's value, e.g. one read back from a file
+bool instrumentDefined(const Underlying& underlying);
+
+// draws the pool from the tradable instruments of the type
+template <typename T>
+inline void setUnderlyingsPool(int poolSize)
+{
+    setUnderlyingsPool(poolSize, tradableUnderlyings<T>());
+}
+
+}  // namespace solstice
+
+#endif  // INSTRUMENT_UNIVERSE_H
@@ -0,0 +1,75 @@
+#include <asset_class.h>
+#include <match_error.h>
+
+#include <format>
+#include <ostream>
+#include <string>
+
+namespace solstice
+{
+
+std::string describe(MatchError error, const Underlying& underlying)
+{
+    switch (error)
+    {
+        case MatchError::NoBook:
+            return std::format("No book available for ticker {}\n", to_string(underlying));
+        case MatchError::NoOrdersAtPrice:
+            return std::format("No prices at ticker {} on opposite order side\n",
+                               to_string(underlying));
+        case MatchError::NoBidOrders:
+            return std::format("No bid orders found for ticker {}\n", to_string(underlying));
+        case MatchError::NoAskOrders:
+            return std::format("No ask orders found for ticker {}\n", to_string(underlying));
+        case MatchError::NoBidsWithinPrice:
+            return "No matching bid orders higher than or equal to ask price\n";
+        case MatchError::NoAsksWithinPrice:
+            return "No matching ask orders lower than or equal to bid price\n";
+        case MatchError::SelfMatch:
+            return "Orders cannot match themselves\n";
+        case MatchError::InsufficientOrders:
+            return "Insufficient orders available to fulfill incoming order\n";
+        case MatchError::OutOfPriceRange:
+            return "All other orders out of price range\n";
+        case MatchError::InsufficientLiquidity:
+            return "Not enough quantity within price to fill the order completely\n";
+        case MatchError::InAuction:
+            return std::format("Ticker {} is in a call auction until it uncrosses\n",
+                               to_string(underlying));
+    }
+
+    return "Unknown match error\n";
+}
+
+std::ostream& operator<<(std::ostream& os, const MatchError& error)
+{
+    switch (error)
+    {
+        case MatchError::NoBook:
+            return os << "NoBook";
+        case MatchError::NoOrdersAtPrice:
+            return os << "NoOrdersAtPrice";
+        case MatchError::NoBidOrders:
+            return os << "NoBidOrders";
+        case MatchError::NoAskOrders:
+            return os << "NoAskOrders";
+        case MatchError::NoBidsWithinPrice:
+            return os << "NoBidsWithinPrice";
+        case MatchError::NoAsksWithinPrice:
+            return os << "NoAsksWithinPrice";
+        case MatchError::SelfMatch:
+            return os << "SelfMatch";
+        case MatchError::InsufficientOrders:
+            return os << "InsufficientOrders";
+        case MatchError::OutOfPriceRange:
+            return os << "OutOfPriceRange";
+        case MatchError::InsufficientLiquidity:
+            return os << "InsufficientLiquidity";
+        case MatchError::InAuction:
+            return os << "InAuction";
+    }
+
+    return os << "Unknown";
+}
+
+}  // namespace solstice
@@ -0,0 +1,40 @@
+#ifndef MATCH_ERROR_H
+#define MATCH_ERROR_H
+
+#include <asset_class.h>
+
+#include <cstdint>
+#include <ostream>
+#include <resolution.hpp>
+#include <string>
+
+namespace solstice
+{
+
+// reasons an order can fail to match or be found in the book. These are the normal outcome for
+// most incoming orders, so they are reported as codes and only formatted when logged.
+enum class MatchError : uint8_t
+{
+    NoBook,
+    NoOrdersAtPrice,
+    NoBidOrders,
+    NoAskOrders,
+    NoBidsWithinPrice,
+    NoAsksWithinPrice,
+    SelfMatch,
+    InsufficientOrders,
+    OutOfPriceRange,
+    InsufficientLiquidity,
+    InAuction
+};
+
+std::string describe(MatchError error, const Underlying& underlying);
+
+std::ostream& operator<<(std::ostream& os, const MatchError& error);
+
+template <typename T>
+using MatchResolution = resolution::CodedResolution<T, MatchError, Underlying>;
+
+}  // namespace solstice
+
+#endif  // MATCH_ERROR_H
@@ -0,0 +1,17 @@
+#include <price_type.h>
+
+#include <ostream>
+
+namespace solstice
+{
+
+std::ostream& operator<<(std::ostream& os, const PriceType& priceType)
+{
+    if (priceType == PriceType::Limit)
+        os << "Limit";
+    else
+        os << "Market";
+
+    return os;
+}
+}  // namespace solstice
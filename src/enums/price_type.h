@@ -0,0 +1,22 @@
+#ifndef PRICE_TYPE_H
+#define PRICE_TYPE_H
+
+#include <cstdint>
+#include <ostream>
+
+namespace solstice
+{
+
+// whether an order only trades at its price or better, or at any price the book offers. A market
+// order never rests, as it has no price to rest at
+enum class PriceType : uint8_t
+{
+    Limit,
+    Market
+};
+
+std::ostream& operator<<(std::ostream& os, const PriceType& priceType);
+
+}  // namespace solstice
+
+#endif  // PRICE_TYPE_H
@@ -0,0 +1,23 @@
+#include <time_in_force.h>
+
+#include <ostream>
+
+namespace solstice
+{
+
+std::ostream& operator<<(std::ostream& os, const TimeInForce& timeInForce)
+{
+    switch (timeInForce)
+    {
+        case TimeInForce::GoodTillCancel:
+            return os << "GoodTillCancel";
+        case TimeInForce::ImmediateOrCancel:
+            return os << "ImmediateOrCancel";
+        case TimeInForce::FillOrKill:
+            return os << "FillOrKill";
+    }
+
+    return os << "Unknown";
+}
+
+}  // namespace solstice
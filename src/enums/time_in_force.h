@@ -0,0 +1,23 @@
+#ifndef TIME_IN_FORCE_H
+#define TIME_IN_FORCE_H
+
+#include <cstdint>
+#include <ostream>
+
+namespace solstice
+{
+
+// how long an order stays open after it is matched: resting until filled or cancelled, cancelling
+// whatever the first sweep didn't fill, or filling completely on arrival or not at all
+enum class TimeInForce : uint8_t
+{
+    GoodTillCancel,
+    ImmediateOrCancel,
+    FillOrKill
+};
+
+std::ostream& operator<<(std::ostream& os, const TimeInForce& timeInForce);
+
+}  // namespace solstice
+
+#endif  // TIME_IN_FORCE_H
@@ -0,0 +1,23 @@
+#include <wait_strategy.h>
+
+#include <ostream>
+
+namespace solstice
+{
+
+std::ostream& operator<<(std::ostream& os, const WaitStrategy& waitStrategy)
+{
+    switch (waitStrategy)
+    {
+        case WaitStrategy::BusySpin:
+            return os << "BusySpin";
+        case WaitStrategy::SpinThenYield:
+            return os << "SpinThenYield";
+        case WaitStrategy::Blocking:
+            return os << "Blocking";
+    }
+
+    return os << "Unknown";
+}
+
+}  // namespace solstice
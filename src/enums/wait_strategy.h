@@ -0,0 +1,22 @@
+#ifndef WAIT_STRATEGY_H
+#define WAIT_STRATEGY_H
+
+#include <cstdint>
+#include <ostream>
+
+namespace solstice
+{
+
+// how a thread waits on a ring buffer that is empty (consumer) or full (producer)
+enum class WaitStrategy : uint8_t
+{
+    BusySpin,
+    SpinThenYield,
+    Blocking
+};
+
+std::ostream& operator<<(std::ostream& os, const WaitStrategy& waitStrategy);
+
+}  // namespace solstice
+
+#endif  // WAIT_STRATEGY_H
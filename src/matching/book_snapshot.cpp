@@ -0,0 +1,335 @@
+#include <book_snapshot.h>
+#include <equity_price_data.h>
+#include <future_price_data.h>
+#include <mapped_file.h>
+#include <option_price_data.h>
+#include <order.h>
+#include <order_book.h>
+#include <order_journal.h>
+#include <types.h>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <mutex>
+#include <span>
+#include <system_error>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace solstice::matching
+{
+
+namespace
+{
+
+// byte offset of each section, and of the end of the file
+struct Layout
+{
+    size_t books;
+    size_t orders;
+    size_t equities;
+    size_t futures;
+    size_t options;
+    size_t end;
+};
+
+Layout layoutOf(const BookSnapshotHeader& header)
+{
+    Layout layout{};
+
+    layout.books = sizeof(BookSnapshotHeader);
+    layout.orders = layout.books + header.books * sizeof(SnapshotBook);
+    layout.equities = layout.orders + header.orders * sizeof(SnapshotOrder);
+    layout.futures = layout.equities + header.equities * sizeof(pricing::EquityPriceData);
+    layout.options = layout.futures + header.futures * sizeof(pricing::FuturePriceData);
+    layout.end = layout.options + header.options * sizeof(pricing::OptionPriceData);
+
+    return layout;
+}
+
+template <typename T>
+void copySection(std::byte* file, size_t offset, const std::vector<T>& values)
+{
+    if (!values.empty())
+    {
+        std::memcpy(file + offset, values.data(), values.size() * sizeof(T));
+    }
+}
+
+}  // namespace
+
+Underlying SnapshotBook::toUnderlying() const
+{
+    JournalRecord record{};
+    record.assetClass = assetClass;
+    record.underlying = underlying;
+    return record.toUnderlying();
+}
+
+void BookSnapshotWriter::addBook(const OrderBook& book, const Underlying& underlying,
+                                 uint64_t sequence)
+{
+    // copied out before taking the lock, so books added from other threads don't wait on this one
+    std::vector<SnapshotOrder> orders;
+    int lastUid = -1;
+
+    if (auto activeOrders = book.getActiveOrders(underlying))
+    {
+        orders.reserve(activeOrders->get().orderIndex.size());
+    }
+
+    book.forEachRestingOrder(underlying,
+                             [&](const OrderPtr& order)
+                             {
+                                 SnapshotOrder record{};
+                                 record.order = JournalRecord::fromOrder(*order);
+                                 record.outstandingQnty = order->outstandingQnty();
+
+                                 orders.push_back(record);
+                                 lastUid = std::max(lastUid, order->uid());
+                             });
+
+    SnapshotBook entry{};
+    entry.sequence = sequence;
+    entry.orderCount = orders.size();
+    entry.assetClass = static_cast<uint8_t>(underlying.index());
+    entry.inAuction = book.inAuction(underlying);
+    entry.underlying =
+        std::visit([](auto asset) { return static_cast<uint32_t>(asset); }, underlying);
+
+    std::lock_guard<std::mutex> lock(d_mutex);
+
+    entry.firstOrder = d_orders.size();
+    d_books.push_back(entry);
+    d_orders.insert(d_orders.end(), orders.begin(), orders.end());
+    d_lastUid = std::max<int64_t>(d_lastUid, lastUid);
+}
+
+void BookSnapshotWriter::addPriceData(const OrderBook& book)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+
+    book.forEachPriceData(
+        [this](const auto& shared)
+        {
+            auto data = shared.read();
+
+            using T = decltype(data);
+            if constexpr (std::is_same_v<T, pricing::EquityPriceData>)
+            {
+                d_equities.push_back(data);
+            }
+            else if constexpr (std::is_same_v<T, pricing::FuturePriceData>)
+            {
+                d_futures.push_back(data);
+            }
+            else
+            {
+                d_options.push_back(data);
+            }
+        });
+}
+
+Resolution<std::monostate> BookSnapshotWriter::write(const String& path, int64_t lastUid)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+
+    BookSnapshotHeader header;
+    header.books = d_books.size();
+    header.orders = d_orders.size();
+    header.equities = d_equities.size();
+    header.futures = d_futures.size();
+    header.options = d_options.size();
+    header.lastUid = std::max(lastUid, d_lastUid);
+
+    if (!d_books.empty())
+    {
+        header.sequence = std::ranges::min(d_books, {}, &SnapshotBook::sequence).sequence;
+        header.lastSequence = std::ranges::max(d_books, {}, &SnapshotBook::sequence).sequence;
+    }
+
+    const Layout layout = layoutOf(header);
+    const String partPath = path + ".part";
+
+    // a part written by an earlier attempt could be longer than this snapshot
+    std::error_code ignored;
+    std::filesystem::remove(partPath, ignored);
+
+    auto file = MappedFile::openWritable(partPath, layout.end);
+    if (!file)
+    {
+        return resolution::err(file.error());
+    }
+
+    std::memcpy((*file).data(), &header, sizeof(header));
+    copySection((*file).data(), layout.books, d_books);
+    copySection((*file).data(), layout.orders, d_orders);
+    copySection((*file).data(), layout.equities, d_equities);
+    copySection((*file).data(), layout.futures, d_futures);
+    copySection((*file).data(), layout.options, d_options);
+
+    auto closed = (*file).close(layout.end);
+    if (!closed)
+    {
+        return closed;
+    }
+
+    std::error_code renameError;
+    std::filesystem::rename(partPath, path, renameError);
+    if (renameError)
+    {
+        return resolution::err(
+            std::format("Could not replace snapshot {}: {}\n", path, renameError.message()));
+    }
+
+    return std::monostate{};
+}
+
+size_t BookSnapshotWriter::books() const { return d_books.size(); }
+
+size_t BookSnapshotWriter::orders() const { return d_orders.size(); }
+
+BookSnapshot::BookSnapshot(MappedFile file, const BookSnapshotHeader& header)
+    : d_file(std::move(file)), d_header(header)
+{
+}
+
+Resolution<BookSnapshot> BookSnapshot::load(const String& path)
+{
+    auto file = MappedFile::openReadOnly(path);
+    if (!file)
+    {
+        return resolution::err(file.error());
+    }
+
+    BookSnapshotHeader header;
+    if ((*file).size() < sizeof(header))
+    {
+        return resolution::err(std::format("Snapshot {} is missing its header\n", path));
+    }
+
+    std::memcpy(&header, (*file).data(), sizeof(header));
+
+    const BookSnapshotHeader expected;
+    if (header.magic != expected.magic || header.version != expected.version ||
+        header.orderSize != expected.orderSize ||
+        header.equityDataSize != expected.equityDataSize ||
+        header.futureDataSize != expected.futureDataSize ||
+        header.optionDataSize != expected.optionDataSize)
+    {
+        return resolution::err(std::format("{} is not a version {} snapshot from this build\n",
+                                           path, BookSnapshotHeader::VERSION));
+    }
+
+    // written in one go and renamed into place, so anything but the exact size is not a snapshot
+    if ((*file).size() != layoutOf(header).end)
+    {
+        return resolution::err(std::format("Snapshot {} is {} bytes, its header describes {}\n",
+                                           path, (*file).size(), layoutOf(header).end));
+    }
+
+    BookSnapshot snapshot(std::move(*file), header);
+
+    for (const SnapshotBook& book : snapshot.books())
+    {
+        if (book.firstOrder > header.orders || book.orderCount > header.orders - book.firstOrder)
+        {
+            return resolution::err(
+                std::format("Snapshot {} has a book past the end of its orders\n", path));
+        }
+    }
+
+    return snapshot;
+}
+
+template <typename T>
+std::span<const T> BookSnapshot::section(size_t offset, size_t count) const
+{
+    if (count == 0)
+    {
+        return {};
+    }
+    return {reinterpret_cast<const T*>(d_file.data() + offset), count};
+}
+
+const BookSnapshotHeader& BookSnapshot::header() const { return d_header; }
+
+std::span<const SnapshotBook> BookSnapshot::books() const
+{
+    return section<SnapshotBook>(layoutOf(d_header).books, d_header.books);
+}
+
+std::span<const SnapshotOrder> BookSnapshot::orders() const
+{
+    return section<SnapshotOrder>(layoutOf(d_header).orders, d_header.orders);
+}
+
+std::span<const SnapshotOrder> BookSnapshot::orders(const SnapshotBook& book) const
+{
+    return orders().subspan(book.firstOrder, book.orderCount);
+}
+
+std::span<const pricing::EquityPriceData> BookSnapshot::equityData() const
+{
+    return section<pricing::EquityPriceData>(layoutOf(d_header).equities, d_header.equities);
+}
+
+std::span<const pricing::FuturePriceData> BookSnapshot::futureData() const
+{
+    return section<pricing::FuturePriceData>(layoutOf(d_header).futures, d_header.futures);
+}
+
+std::span<const pricing::OptionPriceData> BookSnapshot::optionData() const
+{
+    return section<pricing::OptionPriceData>(layoutOf(d_header).options, d_header.options);
+}
+
+Resolution<std::monostate> BookSnapshot::restore(OrderBook& book) const
+{
+    for (const SnapshotBook& entry : books())
+    {
+        book.initialiseUnderlying(entry.toUnderlying());
+
+        for (const SnapshotOrder& record : orders(entry))
+        {
+            auto order = record.order.toOrder();
+            if (!order)
+            {
+                return resolution::err(order.error());
+            }
+
+            (*order)->outstandingQnty(record.outstandingQnty);
+
+            auto added = book.addOrderToBook(*order);
+            if (!added)
+            {
+                return resolution::err(added.error().message());
+            }
+        }
+
+        if (entry.inAuction)
+        {
+            (void)book.startAuction(entry.toUnderlying());
+        }
+    }
+
+    for (const auto& data : equityData())
+    {
+        book.restorePriceData(data);
+    }
+    for (const auto& data : futureData())
+    {
+        book.restorePriceData(data);
+    }
+    for (const auto& data : optionData())
+    {
+        book.restorePriceData(data);
+    }
+
+    return std::monostate{};
+}
+
+}  // namespace solstice::matching
@@ -0,0 +1,135 @@
+#ifndef BOOK_SNAPSHOT_H
+#define BOOK_SNAPSHOT_H
+
+#include <equity_price_data.h>
+#include <future_price_data.h>
+#include <mapped_file.h>
+#include <option_price_data.h>
+#include <order_book.h>
+#include <order_journal.h>
+#include <types.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace solstice::matching
+{
+
+// One resting order, in the fixed layout it has in a snapshot
+struct SnapshotOrder
+{
+    JournalRecord order;
+    int32_t outstandingQnty;
+    int32_t reserved;
+};
+
+static_assert(sizeof(SnapshotOrder) == 48, "snapshot layout is part of the file format");
+
+// One underlying's book. Its resting orders follow on from firstOrder a price level at a time,
+// each level in time priority, so adding them back in turn restores every order's priority
+struct SnapshotBook
+{
+    uint64_t sequence;  // the book reflects every logged event for the underlying up to this one
+    uint64_t firstOrder;
+    uint64_t orderCount;
+    uint8_t assetClass;
+    uint8_t inAuction;  // taken from a spare byte, so earlier snapshots load as not in one
+    uint8_t reserved[2];
+    uint32_t underlying;  // the Equity, Future or Option value in the instrument universe
+
+    Underlying toUnderlying() const;
+};
+
+static_assert(sizeof(SnapshotBook) == 32, "snapshot layout is part of the file format");
+
+// followed by the books, their orders, then the equity, future and option price data
+struct BookSnapshotHeader
+{
+    static constexpr uint64_t MAGIC = 0x50414e534c4f53;  // "SOLSNAP"
+    static constexpr uint32_t VERSION = 2;
+
+    uint64_t magic = MAGIC;
+    uint32_t version = VERSION;
+    // price data is stored as the structs themselves, so only loads into a build laying them out
+    // the same way
+    uint16_t orderSize = sizeof(SnapshotOrder);
+    uint16_t equityDataSize = sizeof(pricing::EquityPriceData);
+    uint16_t futureDataSize = sizeof(pricing::FuturePriceData);
+    uint16_t optionDataSize = sizeof(pricing::OptionPriceData);
+    uint32_t reserved = 0;
+
+    uint64_t sequence = 0;      // lowest book sequence, no logged event up to it needs replaying
+    uint64_t lastSequence = 0;  // highest book sequence
+    int64_t lastUid = -1;       // highest uid handed out when the snapshot was taken
+
+    uint64_t books = 0;
+    uint64_t orders = 0;
+    uint64_t equities = 0;
+    uint64_t futures = 0;
+    uint64_t options = 0;
+};
+
+// Collects a snapshot a book at a time. Books can be added from several threads at once, each
+// while it has the book's underlying to itself, so no thread ever has to stop every book together
+class BookSnapshotWriter
+{
+   public:
+    // copies the underlying's resting orders, sequence being the last event logged for it
+    void addBook(const OrderBook& book, const Underlying& underlying, uint64_t sequence);
+
+    // copies the price data of every underlying, safe while it is being updated
+    void addPriceData(const OrderBook& book);
+
+    // writes to a temporary file renamed over path once complete, so a crash part way through
+    // leaves the previous snapshot in place
+    Resolution<std::monostate> write(const String& path, int64_t lastUid);
+
+    size_t books() const;
+    size_t orders() const;
+
+   private:
+    std::mutex d_mutex;
+    std::vector<SnapshotBook> d_books;
+    std::vector<SnapshotOrder> d_orders;
+    int64_t d_lastUid = -1;
+
+    std::vector<pricing::EquityPriceData> d_equities;
+    std::vector<pricing::FuturePriceData> d_futures;
+    std::vector<pricing::OptionPriceData> d_options;
+};
+
+// A snapshot file mapped read only, with every section read in place rather than parsed
+class BookSnapshot
+{
+   public:
+    static Resolution<BookSnapshot> load(const String& path);
+
+    const BookSnapshotHeader& header() const;
+    std::span<const SnapshotBook> books() const;
+    std::span<const SnapshotOrder> orders() const;
+    std::span<const SnapshotOrder> orders(const SnapshotBook& book) const;
+
+    std::span<const pricing::EquityPriceData> equityData() const;
+    std::span<const pricing::FuturePriceData> futureData() const;
+    std::span<const pricing::OptionPriceData> optionData() const;
+
+    // rests every order back in book and overwrites its price data. The book should hold no
+    // orders for the snapshot's underlyings beforehand
+    Resolution<std::monostate> restore(OrderBook& book) const;
+
+   private:
+    BookSnapshot(MappedFile file, const BookSnapshotHeader& header);
+
+    template <typename T>
+    std::span<const T> section(size_t offset, size_t count) const;
+
+    MappedFile d_file;
+    BookSnapshotHeader d_header;
+};
+
+}  // namespace solstice::matching
+
+#endif  // BOOK_SNAPSHOT_H
@@ -0,0 +1,25 @@
+#ifndef FILL_H
+#define FILL_H
+
+#include <ticks.h>
+
+namespace solstice::matching
+{
+
+// one execution between an incoming order and a resting order, recorded by the matcher as it
+// sweeps the book. Remaining quantities are captured at the time of the fill so the sweep can be
+// reported after the fact without holding on to the orders.
+struct Fill
+{
+    int incomingUid;
+    int restingUid;
+    Ticks price;
+    int qnty;
+    int incomingRemainingQnty;
+    int restingQnty;
+    int restingRemainingQnty;
+};
+
+}  // namespace solstice::matching
+
+#endif  // FILL_H
@@ -1,107 +1,80 @@
 #include <market_side.h>
+#include <match_error.h>
 #include <matcher.h>
 #include <option_type.h>
 #include <options.h>
+#include <fill.h>
 #include <order.h>
 #include <order_book.h>
+#include <order_queue.h>
+#include <ticks.h>
+#include <time_in_force.h>
 #include <types.h>
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
+#include <span>
 #include <sstream>
+#include <vector>
 
 namespace solstice::matching
 {
 
-String formatOptionDetailsForLogging(OrderPtr order)
+String formatOptionDetailsForLogging(const OrderPtr& order)
 {
     if (order->assetClass() != AssetClass::Option)
     {
         return "";
     }
 
-    auto optionOrder = std::dynamic_pointer_cast<OptionOrder>(order);
-    if (!optionOrder)
-    {
-        return "";
-    }
+    const OptionTerms& terms = order->optionTerms();
 
     std::ostringstream oss;
-    oss << " | Strike: $" << optionOrder->strike()
-        << " | Type: " << (optionOrder->optionType() == OptionType::Call ? "Call" : "Put")
-        << " | Expiry: " << optionOrder->expiry() << "y";
+    oss << " | Strike: $" << terms.strike
+        << " | Type: " << (terms.optionType == OptionType::Call ? "Call" : "Put")
+        << " | Expiry: " << terms.expiry << "y";
     return oss.str();
 }
 
-bool Matcher::withinPriceRange(double price, OrderPtr order) const
+bool Matcher::withinPriceRange(Ticks price, const OrderPtr& order) const
 {
-    if (order->marketSide() == MarketSide::Bid)
-    {
-        return price > order->price() ? false : true;
-    }
-    return price < order->price() ? false : true;
+    return order->tradesAt(price);
 }
 
-double Matcher::getDealPrice(OrderPtr firstOrder, OrderPtr secondOrder) const
+String Matcher::formatFill(const OrderPtr& incomingOrder, const Fill& fill) const
 {
-    if (firstOrder->price() == secondOrder->price())
-    {
-        // doesn't matter which price is returned as they are equal
-        return firstOrder->price();
-    }
-
-    OrderPtr bid = firstOrder->marketSide() == MarketSide::Bid ? firstOrder : secondOrder;
-    OrderPtr ask = firstOrder == bid ? secondOrder : firstOrder;
-
-    // always return price of resting order
-    if (ask->timeOrderPlaced() > bid->timeOrderPlaced())
-    {
-        return ask->price();
-    }
-
-    if (bid->timeOrderPlaced() > ask->timeOrderPlaced())
-    {
-        return bid->price();
-    }
-
-    // tiebreaker - uid as this is based on position in book
-    return bid->uid() > ask->uid() ? ask->price() : bid->price();
-}
-
-String Matcher::matchSuccessOutput(OrderPtr incomingOrder, OrderPtr matchedOrder,
-                                   double matchedPrice) const
-{
-    const double dealPrice = getDealPrice(incomingOrder, matchedOrder);
+    // resting orders are always for the same instrument as the incoming order, on the other side
+    const String restingSide = incomingOrder->marketSide() == MarketSide::Bid ? "Ask" : "Bid";
+    const String optionDetails = formatOptionDetailsForLogging(incomingOrder);
 
     std::ostringstream oss;
 
     // Incoming order
-    oss << "Order: " << incomingOrder->uid() << " | Asset class: " << incomingOrder->assetClass()
+    oss << "Order: " << fill.incomingUid << " | Asset class: " << incomingOrder->assetClass()
         << " | Status: Matched"
-        << " | Matched with: " << matchedOrder->uid()
+        << " | Matched with: " << fill.restingUid
         << " | Side: " << incomingOrder->marketSideString()
         << " | Ticker: " << to_string(incomingOrder->underlying()) << " | Price: $"
-        << incomingOrder->price() << " | Qnty: " << incomingOrder->qnty()
-        << " | Remaining Qnty: " << incomingOrder->outstandingQnty()
-        << formatOptionDetailsForLogging(incomingOrder);
+        << fromTicks(incomingOrder->priceTicks(), incomingOrder->underlying())
+        << " | Qnty: " << incomingOrder->qnty()
+        << " | Remaining Qnty: " << fill.incomingRemainingQnty << optionDetails;
 
-    if (incomingOrder->outstandingQnty() == 0)
+    if (fill.incomingRemainingQnty == 0)
     {
         oss << " [FULFILLED]";
     }
     oss << "\n";
 
     // Matched order
-    oss << "Order: " << matchedOrder->uid() << " | Asset class: " << incomingOrder->assetClass()
+    oss << "Order: " << fill.restingUid << " | Asset class: " << incomingOrder->assetClass()
         << " | Status: Matched"
-        << " | Matched with: " << incomingOrder->uid()
-        << " | Side: " << matchedOrder->marketSideString()
-        << " | Ticker: " << to_string(matchedOrder->underlying()) << " | Price: $"
-        << matchedOrder->price() << " | Qnty: " << matchedOrder->qnty()
-        << " | Remaining Qnty: " << matchedOrder->outstandingQnty()
-        << formatOptionDetailsForLogging(matchedOrder);
-
-    if (matchedOrder->outstandingQnty() == 0)
+        << " | Matched with: " << fill.incomingUid << " | Side: " << restingSide
+        << " | Ticker: " << to_string(incomingOrder->underlying()) << " | Price: $"
+        << fromTicks(fill.price, incomingOrder->underlying()) << " | Qnty: " << fill.restingQnty
+        << " | Remaining Qnty: " << fill.restingRemainingQnty << optionDetails;
+
+    if (fill.restingRemainingQnty == 0)
     {
         oss << " [FULFILLED]";
     }
@@ -110,143 +83,114 @@ String Matcher::matchSuccessOutput(OrderPtr incomingOrder, OrderPtr matchedOrder
     return oss.str();
 }
 
-bool Matcher::canMatchOptions(OrderPtr incomingOrder, OrderPtr candidateOrder) const
+String Matcher::formatFills(const OrderPtr& incomingOrder, std::span<const Fill> fills) const
 {
-    if (incomingOrder->assetClass() != AssetClass::Option)
-    {
-        return true;
-    }
-
-    auto incomingOption = std::dynamic_pointer_cast<OptionOrder>(incomingOrder);
-    auto candidateOption = std::dynamic_pointer_cast<OptionOrder>(candidateOrder);
-
-    if (!incomingOption || !candidateOption)
+    String output;
+    for (const Fill& fill : fills)
     {
-        return false;
+        output += formatFill(incomingOrder, fill);
     }
-
-    // Check if strike, underlying equity, expiry, and option type match
-    return incomingOption->strike() == candidateOption->strike() &&
-           incomingOption->underlyingEquity() == candidateOption->underlyingEquity() &&
-           incomingOption->expiry() == candidateOption->expiry() &&
-           incomingOption->optionType() == candidateOption->optionType();
+    return output;
 }
 
-Resolution<String> Matcher::matchOrder(OrderPtr incomingOrder, double orderMatchingPrice) const
+// an option only ever meets orders for its own series, as each series has its own book
+MatchResolution<std::monostate> Matcher::matchOrder(const OrderPtr& incomingOrder,
+                                                    std::vector<Fill>& fills) const
 {
-    double bestPrice = orderMatchingPrice;
-
-    if (orderMatchingPrice == -1)
+    // during a call orders only rest, and trade when the book uncrosses
+    if (d_orderBook->inAuction(incomingOrder->underlying()))
     {
-        auto bestPriceAvailable = d_orderBook->getBestPrice(incomingOrder);
-        if (!bestPriceAvailable)
-        {
-            return resolution::err(bestPriceAvailable.error());
-        }
-
-        bestPrice = *bestPriceAvailable;
+        return resolution::fail(MatchError::InAuction, incomingOrder->underlying());
     }
 
-    std::map<double, std::deque<OrderPtr>>& priceLevelMap =
-        d_orderBook->oppositeMarketSidePriceLevelMap(incomingOrder);
-
-    auto it = priceLevelMap.find(bestPrice);
-    if (it == priceLevelMap.end())
+    // checked against the levels' quantities up front, so a kill never reaches a resting order
+    if (incomingOrder->timeInForce() == TimeInForce::FillOrKill &&
+        !d_orderBook->canFill(*incomingOrder))
     {
-        return resolution::err("Insufficient orders available to fulfill incoming order\n");
+        return resolution::fail(MatchError::InsufficientLiquidity, incomingOrder->underlying());
     }
 
-    auto ordersResult = d_orderBook->getPriceLevelOppositeOrders(incomingOrder, bestPrice);
-
-    if (!ordersResult)
+    auto bestPriceAvailable = d_orderBook->getBestPrice(incomingOrder);
+    if (!bestPriceAvailable)
     {
-        return resolution::err(ordersResult.error());
+        return std::unexpected(bestPriceAvailable.error());
     }
 
-    std::deque<OrderPtr>& ordersAtBestPrice = *ordersResult;
-    OrderPtr bestOrder = ordersAtBestPrice.at(0);
+    Ticks levelPrice = *bestPriceAvailable;
 
-    if (ordersAtBestPrice.size() == 1 && bestOrder->uid() == incomingOrder->uid())
+    while (true)
     {
-        return resolution::err("Orders cannot match themselves\n");
-    }
+        auto ordersResult = d_orderBook->getPriceLevelOppositeOrders(incomingOrder, levelPrice);
+        if (!ordersResult)
+        {
+            return std::unexpected(ordersResult.error());
+        }
 
-    // For options, check if strike, underlying, expiry, and option type match
-    if (!canMatchOptions(incomingOrder, bestOrder))
-    {
-        return resolution::err(
-            "Option orders must have matching strike, underlying equity, expiry, and option "
-            "type\n");
-    }
-    if (bestOrder->outstandingQnty() < incomingOrder->outstandingQnty())
-    {
-        double transactionQnty = bestOrder->outstandingQnty();
-        incomingOrder->outstandingQnty(incomingOrder->outstandingQnty() - transactionQnty);
-        bestOrder->outstandingQnty(0);
+        OrderQueue& ordersAtLevel = *ordersResult;
 
-        const String partialMatchResult = matchSuccessOutput(incomingOrder, bestOrder, bestPrice);
+        bool levelExhausted = false;
+        while (!levelExhausted)
+        {
+            // copied as the book releases its reference once the order is filled
+            OrderPtr restingOrder = ordersAtLevel.front();
+            // the book takes the level out once its last order is filled, so it isn't read after
+            levelExhausted = ordersAtLevel.size() == 1;
 
-        d_orderBook->markOrderAsFulfilled(bestOrder, bestPrice);
+            const int transactionQnty =
+                std::min(restingOrder->outstandingQnty(), incomingOrder->outstandingQnty());
 
-        if (!ordersAtBestPrice.empty())
-        {
-            auto result = matchOrder(incomingOrder, bestPrice);
-            if (result.has_value())
-            {
-                return partialMatchResult + *result;
-            }
-            return result;
-        }
-        else
-        {
-            auto nextIt = std::next(it);
-            if (nextIt == priceLevelMap.end())
-            {
-                return resolution::err("Insufficient orders available to fulfill incoming order\n");
-            }
+            restingOrder->outstandingQnty(restingOrder->outstandingQnty() - transactionQnty);
+            incomingOrder->outstandingQnty(incomingOrder->outstandingQnty() - transactionQnty);
+
+            ordersAtLevel.reduceQnty(transactionQnty);
 
-            const double nextBestPrice = nextIt->first;
+            fills.push_back(Fill{incomingOrder->uid(), restingOrder->uid(), levelPrice,
+                                 transactionQnty, incomingOrder->outstandingQnty(),
+                                 restingOrder->qnty(), restingOrder->outstandingQnty()});
+            d_orderBook->recordTrade(incomingOrder, fills.back());
 
-            if (!withinPriceRange(nextBestPrice, incomingOrder))
+            if (restingOrder->outstandingQnty() == 0)
             {
-                return resolution::err("All other orders out of price range\n");
+                d_orderBook->markOrderAsFulfilled(restingOrder, levelPrice);
             }
 
-            auto result = matchOrder(incomingOrder, nextBestPrice);
-            if (result.has_value())
+            // never in the book, so there is nothing to take out
+            if (incomingOrder->outstandingQnty() == 0)
             {
-                return partialMatchResult + *result;
+                incomingOrder->matched(true);
+                incomingOrder->matchedPriceTicks(levelPrice);
+                return std::monostate{};
             }
-            return result;
         }
-    }
-    else if (bestOrder->outstandingQnty() == incomingOrder->outstandingQnty())
-    {
-        bestOrder->outstandingQnty(0);
-        incomingOrder->outstandingQnty(0);
 
-        const String& finalMatchResult = matchSuccessOutput(incomingOrder, bestOrder, bestPrice);
+        // level is exhausted and has been dropped from the book, so the best price is now the
+        // next level along regardless of backend
+        auto nextBestPriceAvailable = d_orderBook->getBestPrice(incomingOrder);
+        if (!nextBestPriceAvailable)
+        {
+            return resolution::fail(MatchError::InsufficientOrders, incomingOrder->underlying());
+        }
 
-        d_orderBook->markOrderAsFulfilled(bestOrder, bestPrice);
-        d_orderBook->markOrderAsFulfilled(incomingOrder, bestPrice);
+        if (!withinPriceRange(*nextBestPriceAvailable, incomingOrder))
+        {
+            return resolution::fail(MatchError::OutOfPriceRange, incomingOrder->underlying());
+        }
 
-        return finalMatchResult;
+        levelPrice = *nextBestPriceAvailable;
     }
-    else if (bestOrder->outstandingQnty() > incomingOrder->outstandingQnty())
-    {
-        double transactionQnty = incomingOrder->outstandingQnty();
-
-        bestOrder->outstandingQnty(bestOrder->outstandingQnty() - transactionQnty);
-        incomingOrder->outstandingQnty(0);
-
-        const String& finalMatchResult = matchSuccessOutput(incomingOrder, bestOrder, bestPrice);
+}
 
-        d_orderBook->markOrderAsFulfilled(incomingOrder, bestPrice);
+MatchResolution<std::vector<Fill>> Matcher::matchOrder(const OrderPtr& incomingOrder) const
+{
+    std::vector<Fill> fills;
 
-        return finalMatchResult;
+    auto matched = matchOrder(incomingOrder, fills);
+    if (!matched)
+    {
+        return std::unexpected(matched.error());
     }
 
-    return resolution::err("An error occured when fetching order quantity\n");
+    return fills;
 }
 
 Matcher::Matcher(std::shared_ptr<OrderBook> orderBook) : d_orderBook(orderBook) {}
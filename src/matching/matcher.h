@@ -1,12 +1,17 @@
 #ifndef MATCH_H
 #define MATCH_H
 
+#include <fill.h>
+#include <match_error.h>
 #include <order.h>
 #include <order_book.h>
+#include <ticks.h>
 #include <types.h>
 
 #include <memory>
 #include <resolution.hpp>
+#include <span>
+#include <vector>
 
 namespace solstice::matching
 {
@@ -22,16 +27,23 @@ class Matcher
    public:
     Matcher(std::shared_ptr<OrderBook> orderBook);
 
-    Resolution<String> matchOrder(OrderPtr order, double orderMatchingPrice = -1) const;
+    // sweeps the opposite side of the book best level first, appending a Fill for every resting
+    // order traded against. Succeeds once the order is completely filled; on failure any fills made
+    // before the sweep stopped are still appended. A fill or kill order that the opposite side
+    // can't fill completely fails with InsufficientLiquidity before trading, and any order fails
+    // with InAuction while its book is in a call auction. The order must not be resting: it is
+    // matched on arrival, and adding whatever it leaves unfilled is the caller's.
+    MatchResolution<std::monostate> matchOrder(const OrderPtr& order,
+                                               std::vector<Fill>& fills) const;
+    MatchResolution<std::vector<Fill>> matchOrder(const OrderPtr& order) const;
+
+    String formatFills(const OrderPtr& incomingOrder, std::span<const Fill> fills) const;
 
     const std::shared_ptr<OrderBook>& orderBook() const;
 
    private:
-    bool withinPriceRange(double price, OrderPtr order) const;
-    double getDealPrice(OrderPtr firstOrder, OrderPtr secondOrder) const;
-    String matchSuccessOutput(OrderPtr incomingOrder, OrderPtr matchedOrder,
-                              double matchedPrice) const;
-    bool canMatchOptions(OrderPtr incomingOrder, OrderPtr candidateOrder) const;
+    bool withinPriceRange(Ticks price, const OrderPtr& order) const;
+    String formatFill(const OrderPtr& incomingOrder, const Fill& fill) const;
 
     std::shared_ptr<OrderBook> d_orderBook;
 };
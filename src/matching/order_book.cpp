@@ -1,33 +1,328 @@
 #include <asset_class.h>
+#include <book_backend.h>
+#include <book_event_type.h>
+#include <event_log.h>
 #include <equity_price_data.h>
+#include <fill.h>
 #include <future_price_data.h>
 #include <market_side.h>
 #include <matcher.h>
 #include <option_price_data.h>
+#include <options.h>
 #include <order.h>
 #include <order_book.h>
-#include <transaction.h>
+#include <order_queue.h>
+#include <price_ladder.h>
+#include <seq_locked.h>
+#include <ticks.h>
+#include <trade_tape.h>
 #include <truncate.h>
 #include <types.h>
+#include <uid_index.h>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <cstddef>
-#include <deque>
+#include <cstdlib>
+#include <format>
 #include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <variant>
 
 namespace solstice::matching
 {
 
-pricing::EquityPriceData& OrderBook::getPriceData(Equity eq) { return d_equityDataMap.at(eq); }
+OrderBook::OrderBook(BookBackend backend) : d_backend(backend) {}
 
-pricing::FuturePriceData& OrderBook::getPriceData(Future fut) { return d_futureDataMap.at(fut); }
+BookBackend OrderBook::backend() const { return d_backend; }
 
-pricing::OptionPriceData& OrderBook::getPriceData(Option opt) { return d_optionDataMap.at(opt); }
+const InstrumentRegistry& OrderBook::instruments() const { return d_instruments; }
+
+OptionSeries OptionSeries::of(const Order& order)
+{
+    const OptionTerms& terms = order.optionTerms();
+    return of(std::get<Option>(order.underlying()), terms.strike, terms.expiry, terms.optionType);
+}
+
+OptionSeries OptionSeries::of(Option option, double strike, double expiry, OptionType optionType)
+{
+    return {toTicks(strike, option), static_cast<int32_t>(std::lround(expiry * 12)), optionType};
+}
+
+std::vector<OptionChain::SeriesBook>::const_iterator OptionChain::position(
+    const OptionSeries& series) const
+{
+    return std::ranges::lower_bound(d_series, series, {}, &SeriesBook::first);
+}
+
+ActiveOrders* OptionChain::find(const OptionSeries& series)
+{
+    auto it = position(series);
+    if (it == d_series.end() || it->first != series)
+    {
+        return nullptr;
+    }
+    return &d_books[it->second];
+}
+
+const ActiveOrders* OptionChain::find(const OptionSeries& series) const
+{
+    auto it = position(series);
+    if (it == d_series.end() || it->first != series)
+    {
+        return nullptr;
+    }
+    return &d_books[it->second];
+}
+
+ActiveOrders& OptionChain::open(const OptionSeries& series)
+{
+    auto it = position(series);
+    if (it != d_series.end() && it->first == series)
+    {
+        return d_books[it->second];
+    }
+
+    while (!d_emptyBooks.empty())
+    {
+        const uint32_t book = d_emptyBooks.back();
+        d_emptyBooks.pop_back();
+        d_bookEmptied[book] = false;
+        if (!d_books[book].orderIndex.empty())
+        {
+            // its series took orders again since, and will queue it once more when it next empties
+            continue;
+        }
+
+        d_series.erase(position(d_seriesOfBook[book]));
+        d_books[book] = ActiveOrders{};
+        d_seriesOfBook[book] = series;
+        d_series.emplace(position(series), series, book);
+        return d_books[book];
+    }
+
+    const auto book = static_cast<uint32_t>(d_books.size());
+    d_series.emplace(it, series, book);
+    d_seriesOfBook.push_back(series);
+    d_bookEmptied.push_back(false);
+    return d_books.emplace_back();
+}
+
+ActiveOrders* OptionChain::findResting(int uid)
+{
+    auto it = d_bookOfOrder.find(uid);
+    return it == d_bookOfOrder.end() ? nullptr : &d_books[it->second];
+}
+
+const ActiveOrders* OptionChain::findResting(int uid) const
+{
+    auto it = d_bookOfOrder.find(uid);
+    return it == d_bookOfOrder.end() ? nullptr : &d_books[it->second];
+}
+
+void OptionChain::rested(int uid, const OptionSeries& series)
+{
+    d_bookOfOrder[uid] = position(series)->second;
+}
+
+void OptionChain::removed(int uid)
+{
+    auto it = d_bookOfOrder.find(uid);
+    if (it == d_bookOfOrder.end())
+    {
+        return;
+    }
+    const uint32_t book = it->second;
+    d_bookOfOrder.erase(it);
+
+    // only queued, not reset, as the book may still be being matched or uncrossed
+    if (d_books[book].orderIndex.empty() && !d_bookEmptied[book])
+    {
+        d_bookEmptied[book] = true;
+        d_emptyBooks.push_back(book);
+    }
+}
+
+size_t OptionChain::size() const { return d_series.size(); }
+
+InstrumentId OrderBook::openInstrument(const Underlying& underlying)
+{
+    const InstrumentId id = d_instruments.add(underlying);
+    if (id == d_activeOrders.size())
+    {
+        d_activeOrders.emplace_back();
+        d_optionChains.push_back(std::holds_alternative<Option>(underlying)
+                                     ? std::make_unique<OptionChain>()
+                                     : nullptr);
+        d_tradeTapes.push_back(std::make_unique<TradeTape>(underlying));
+        d_equityData.emplace_back();
+        d_futureData.emplace_back();
+        d_optionData.emplace_back();
+    }
+    return id;
+}
+
+ActiveOrders* OrderBook::findBook(const Underlying& underlying)
+{
+    auto id = d_instruments.find(underlying);
+    return id ? &d_activeOrders[*id] : nullptr;
+}
+
+const ActiveOrders* OrderBook::findBook(const Underlying& underlying) const
+{
+    auto id = d_instruments.find(underlying);
+    return id ? &d_activeOrders[*id] : nullptr;
+}
+
+ActiveOrders* OrderBook::findBook(const Order& order)
+{
+    auto id = d_instruments.find(order.underlying());
+    if (!id)
+    {
+        return nullptr;
+    }
+
+    if (order.assetClass() != AssetClass::Option)
+    {
+        return &d_activeOrders[*id];
+    }
+    return d_optionChains[*id]->find(OptionSeries::of(order));
+}
+
+const ActiveOrders* OrderBook::findBook(const Order& order) const
+{
+    auto id = d_instruments.find(order.underlying());
+    if (!id)
+    {
+        return nullptr;
+    }
+
+    if (order.assetClass() != AssetClass::Option)
+    {
+        return &d_activeOrders[*id];
+    }
+    return d_optionChains[*id]->find(OptionSeries::of(order));
+}
+
+ActiveOrders* OrderBook::openBook(const Order& order)
+{
+    auto id = d_instruments.find(order.underlying());
+    if (!id)
+    {
+        return nullptr;
+    }
+
+    if (order.assetClass() != AssetClass::Option)
+    {
+        return &d_activeOrders[*id];
+    }
+    return &d_optionChains[*id]->open(OptionSeries::of(order));
+}
+
+ActiveOrders& OrderBook::bookOf(const Order& order)
+{
+    ActiveOrders* book = findBook(order);
+    if (!book)
+    {
+        throw std::out_of_range(
+            std::format("No book available for ticker {}", to_string(order.underlying())));
+    }
+    return *book;
+}
+
+ActiveOrders* OrderBook::findRestingBook(const Underlying& underlying, int uid)
+{
+    auto id = d_instruments.find(underlying);
+    if (!id)
+    {
+        return nullptr;
+    }
+
+    if (const auto& chain = d_optionChains[*id])
+    {
+        return chain->findResting(uid);
+    }
+
+    ActiveOrders& book = d_activeOrders[*id];
+    return book.orderIndex.contains(uid) ? &book : nullptr;
+}
+
+const ActiveOrders* OrderBook::findRestingBook(const Underlying& underlying, int uid) const
+{
+    auto id = d_instruments.find(underlying);
+    if (!id)
+    {
+        return nullptr;
+    }
+
+    if (const auto& chain = d_optionChains[*id])
+    {
+        return chain->findResting(uid);
+    }
+
+    const ActiveOrders& book = d_activeOrders[*id];
+    return book.orderIndex.contains(uid) ? &book : nullptr;
+}
+
+template <typename Data>
+SeqLocked<Data>& OrderBook::priceDataOf(PriceDataSlots<Data>& slots, const Underlying& underlying)
+{
+    auto id = d_instruments.find(underlying);
+    if (!id || !slots[*id])
+    {
+        throw std::out_of_range(std::format("No price data for ticker {}", to_string(underlying)));
+    }
+    return *slots[*id];
+}
+
+template <typename Data, typename Ticker>
+SeqLocked<Data>& OrderBook::addPriceData(PriceDataSlots<Data>& slots, Ticker ticker)
+{
+    auto& data = slots[openInstrument(ticker)];
+    if (!data)
+    {
+        data = std::make_unique<SeqLocked<Data>>(ticker);
+    }
+    return *data;
+}
+
+pricing::EquityPriceData& OrderBook::getPriceData(Equity eq)
+{
+    return priceDataOf(d_equityData, eq).value();
+}
+
+pricing::FuturePriceData& OrderBook::getPriceData(Future fut)
+{
+    return priceDataOf(d_futureData, fut).value();
+}
+
+pricing::OptionPriceData& OrderBook::getPriceData(Option opt)
+{
+    return priceDataOf(d_optionData, opt).value();
+}
+
+SeqLocked<pricing::EquityPriceData>& OrderBook::sharedPriceData(Equity eq)
+{
+    return priceDataOf(d_equityData, eq);
+}
+
+SeqLocked<pricing::FuturePriceData>& OrderBook::sharedPriceData(Future fut)
+{
+    return priceDataOf(d_futureData, fut);
+}
+
+SeqLocked<pricing::OptionPriceData>& OrderBook::sharedPriceData(Option opt)
+{
+    return priceDataOf(d_optionData, opt);
+}
 
 void OrderBook::addEquitiesToDataMap()
 {
     for (const auto& underlying : underlyingsPool<Equity>())
     {
-        d_equityDataMap.emplace(underlying, pricing::EquityPriceData(underlying));
+        addPriceData(d_equityData, underlying);
     }
 }
 
@@ -35,7 +330,7 @@ void OrderBook::addFuturesToDataMap()
 {
     for (const auto& underlying : underlyingsPool<Future>())
     {
-        d_futureDataMap.emplace(underlying, pricing::FuturePriceData(underlying));
+        addPriceData(d_futureData, underlying);
     }
 }
 
@@ -43,62 +338,178 @@ void OrderBook::addOptionsToDataMap()
 {
     for (const auto& underlying : underlyingsPool<Option>())
     {
-        d_optionDataMap.emplace(underlying, pricing::OptionPriceData(underlying));
+        addPriceData(d_optionData, underlying);
+    }
+}
+
+void OrderBook::initialiseUnderlying(const Underlying& underlying)
+{
+    std::visit(
+        [this](auto asset)
+        {
+            using T = decltype(asset);
+            if constexpr (std::is_same_v<T, Equity>)
+            {
+                addPriceData(d_equityData, asset);
+            }
+            else if constexpr (std::is_same_v<T, Future>)
+            {
+                addPriceData(d_futureData, asset);
+            }
+            else
+            {
+                addPriceData(d_optionData, asset);
+            }
+        },
+        underlying);
+}
+
+void OrderBook::restorePriceData(const pricing::EquityPriceData& data)
+{
+    addPriceData(d_equityData, data.underlying())
+        .write([&data](pricing::EquityPriceData& value) { value = data; });
+}
+
+void OrderBook::restorePriceData(const pricing::FuturePriceData& data)
+{
+    addPriceData(d_futureData, data.underlying())
+        .write([&data](pricing::FuturePriceData& value) { value = data; });
+}
+
+void OrderBook::restorePriceData(const pricing::OptionPriceData& data)
+{
+    addPriceData(d_optionData, data.underlying())
+        .write([&data](pricing::OptionPriceData& value) { value = data; });
+}
+
+std::optional<std::reference_wrapper<const TradeTape>> OrderBook::tradeTape(
+    const Underlying& underlying) const
+{
+    auto id = d_instruments.find(underlying);
+    if (!id)
+    {
+        return std::nullopt;
     }
+    return std::cref(*d_tradeTapes[*id]);
 }
 
-const std::vector<Transaction>& OrderBook::transactions() const { return d_transactions; }
+void OrderBook::recordTrade(const OrderPtr& incomingOrder, const Fill& fill)
+{
+    const bool incomingBid = incomingOrder->marketSide() == MarketSide::Bid;
+    const int bidUid = incomingBid ? fill.incomingUid : fill.restingUid;
+    const int askUid = incomingBid ? fill.restingUid : fill.incomingUid;
+
+    TradeTape& tape = *d_tradeTapes[*d_instruments.find(incomingOrder->underlying())];
+    tape.append(d_nextTradeSequence.fetch_add(1, std::memory_order_relaxed), fill.price,
+                fill.qnty, bidUid, askUid);
+}
 
-std::optional<std::reference_wrapper<std::deque<OrderPtr>>> OrderBook::getOrdersDequeAtPrice(
-    OrderPtr order)
+std::optional<std::reference_wrapper<OrderQueue>> OrderBook::getOrdersQueueAtPrice(
+    const OrderPtr& order)
 {
-    auto it = d_activeOrders.find(order->underlying());
-    if (it == d_activeOrders.end())
+    ActiveOrders* book = findBook(*order);
+    if (!book)
     {
         return std::nullopt;
     }
 
-    ActiveOrders& book = d_activeOrders.at(order->underlying());
+    if (d_backend == BookBackend::Ladder)
+    {
+        auto* orders = ladderOf(*book, order->marketSide()).findLevel(order->priceTicks());
+        if (!orders)
+        {
+            return std::nullopt;
+        }
+        return std::ref(*orders);
+    }
+
+    PriceLevelMap& levels = sameMarketSidePriceLevelMap(order);
 
-    return (order->marketSide() == MarketSide::Bid) ? book.bids.at(order->price())
-                                                    : book.asks.at(order->price());
+    auto levelIt = levels.find(order->priceTicks());
+    if (levelIt == levels.end())
+    {
+        return std::nullopt;
+    }
+    return std::ref(levelIt->second);
 }
 
-std::deque<OrderPtr>& OrderBook::getOrdersDequeAtPrice(OrderPtr order, int priceToMatch)
+OrderQueue& OrderBook::getOrdersQueueAtPrice(const OrderPtr& order, Ticks priceToMatch)
 {
-    auto& book = d_activeOrders.at(order->underlying());
+    auto& book = bookOf(*order);
+
+    if (d_backend == BookBackend::Ladder)
+    {
+        return ladderOf(book, order->marketSide()).level(priceToMatch);
+    }
 
     return (order->marketSide() == MarketSide::Bid) ? book.bids.at(priceToMatch)
                                                     : book.asks.at(priceToMatch);
 }
 
-std::deque<OrderPtr>& OrderBook::ordersDequeAtPrice(OrderPtr order)
+OrderQueue& OrderBook::ordersQueueAtPrice(const OrderPtr& order)
+{
+    auto& book = bookOf(*order);
+
+    if (d_backend == BookBackend::Ladder)
+    {
+        return ladderOf(book, order->marketSide()).level(order->priceTicks());
+    }
+
+    return openLevel(book, order->marketSide() == MarketSide::Bid ? book.bids : book.asks,
+                     order->priceTicks());
+}
+
+OrderQueue& OrderBook::openLevel(ActiveOrders& book, PriceLevelMap& levels, Ticks price)
 {
-    auto& book = d_activeOrders[order->underlying()];
+    auto levelIt = levels.lower_bound(price);
+    if (levelIt != levels.end() && levelIt->first == price)
+    {
+        return levelIt->second;
+    }
+
+    if (book.spareLevels.empty())
+    {
+        return levels.try_emplace(levelIt, price)->second;
+    }
+
+    // a spare's queue was empty when its level was taken out of the book
+    auto node = std::move(book.spareLevels.back());
+    book.spareLevels.pop_back();
 
-    return (order->marketSide() == MarketSide::Bid) ? book.bids[order->price()]
-                                                    : book.asks[order->price()];
+    node.key() = price;
+    return levels.insert(levelIt, std::move(node))->second;
 }
 
-Resolution<std::reference_wrapper<std::deque<OrderPtr>>> OrderBook::getPriceLevelOppositeOrders(
-    OrderPtr order, double priceToUse)
+MatchResolution<std::reference_wrapper<OrderQueue>> OrderBook::getPriceLevelOppositeOrders(
+    const OrderPtr& order, Ticks priceToUse)
 {
-    auto it = d_activeOrders.find(order->underlying());
-    if (it == d_activeOrders.end())
+    ActiveOrders* activeOrders = findBook(*order);
+    if (!activeOrders)
     {
-        return resolution::err(std::format("No orders at ticker {} on opposite order side\n",
-                                           to_string(order->underlying())));
+        return resolution::fail(MatchError::NoBook, order->underlying());
     }
 
-    ActiveOrders& book = d_activeOrders.at(order->underlying());
+    ActiveOrders& book = *activeOrders;
+
+    if (d_backend == BookBackend::Ladder)
+    {
+        PriceLadder& ladder =
+            order->marketSide() == MarketSide::Bid ? book.askLadder : book.bidLadder;
+
+        auto* orders = ladder.findLevel(priceToUse);
+        if (!orders || orders->empty())
+        {
+            return resolution::fail(MatchError::NoOrdersAtPrice, order->underlying());
+        }
+        return std::ref(*orders);
+    }
 
     if (order->marketSide() == MarketSide::Bid)
     {
         auto priceIt = book.asks.find(priceToUse);
         if (priceIt == book.asks.end() || priceIt->second.empty())
         {
-            return resolution::err(std::format("No prices at ticker {} on opposite order side\n",
-                                               to_string(order->underlying())));
+            return resolution::fail(MatchError::NoOrdersAtPrice, order->underlying());
         }
         return std::ref(priceIt->second);
     }
@@ -107,91 +518,149 @@ Resolution<std::reference_wrapper<std::deque<OrderPtr>>> OrderBook::getPriceLeve
         auto priceIt = book.bids.find(priceToUse);
         if (priceIt == book.bids.end() || priceIt->second.empty())
         {
-            return resolution::err(std::format("No prices at ticker {} on opposite order side\n",
-                                               to_string(order->underlying())));
+            return resolution::fail(MatchError::NoOrdersAtPrice, order->underlying());
         }
         return std::ref(priceIt->second);
     }
 }
 
-std::map<double, std::deque<OrderPtr>>& OrderBook::sameMarketSidePriceLevelMap(OrderPtr order)
+PriceLevelMap& OrderBook::sameMarketSidePriceLevelMap(const OrderPtr& order)
 {
-    auto& book = d_activeOrders.at(order->underlying());
+    auto& book = bookOf(*order);
 
     return (order->marketSide() == MarketSide::Bid) ? book.bids : book.asks;
 }
 
-std::map<double, std::deque<OrderPtr>>& OrderBook::oppositeMarketSidePriceLevelMap(OrderPtr order)
+PriceLevelMap& OrderBook::oppositeMarketSidePriceLevelMap(const OrderPtr& order)
 {
-    auto& book = d_activeOrders.at(order->underlying());
+    auto& book = bookOf(*order);
 
     return (order->marketSide() == MarketSide::Bid) ? book.asks : book.bids;
 }
 
-Resolution<std::reference_wrapper<BidPricesAtPriceLevel>> OrderBook::getBidPricesAtPriceLevel(
-    OrderPtr order)
+PriceLadder& OrderBook::ladderOf(ActiveOrders& book, MarketSide side)
 {
-    auto it = d_activeOrders.find(order->underlying());
-    if (it == d_activeOrders.end())
+    return side == MarketSide::Bid ? book.bidLadder : book.askLadder;
+}
+
+MatchResolution<std::reference_wrapper<PriceLadder>> OrderBook::sameMarketSideLadder(
+    const OrderPtr& order)
+{
+    ActiveOrders* book = findBook(*order);
+    if (!book)
     {
-        return resolution::err(
-            std::format("No bid prices available for ticker {}\n", to_string(order->underlying())));
+        return resolution::fail(MatchError::NoBook, order->underlying());
     }
 
-    return std::ref(it->second.bidPrices);
+    return std::ref(ladderOf(*book, order->marketSide()));
 }
 
-std::set<double, std::greater<double>>& OrderBook::setBidPricesAtPriceLevel(OrderPtr order)
+MatchResolution<std::reference_wrapper<PriceLadder>> OrderBook::oppositeMarketSideLadder(
+    const OrderPtr& order)
 {
-    auto& bidsSet = d_activeOrders[order->underlying()].bidPrices;
+    ActiveOrders* book = findBook(*order);
+    if (!book)
+    {
+        return resolution::fail(MatchError::NoBook, order->underlying());
+    }
+
+    return std::ref(ladderOf(*book, order->marketSide() == MarketSide::Bid ? MarketSide::Ask
+                                                                           : MarketSide::Bid));
+}
+
+MatchResolution<std::reference_wrapper<BidPricesAtPriceLevel>> OrderBook::getBidPricesAtPriceLevel(
+    const OrderPtr& order)
+{
+    ActiveOrders* book = findBook(*order);
+    if (!book)
+    {
+        return resolution::fail(MatchError::NoBook, order->underlying());
+    }
+
+    return std::ref(book->bidPrices);
+}
+
+BidPricesAtPriceLevel& OrderBook::setBidPricesAtPriceLevel(const OrderPtr& order)
+{
+    auto& bidsSet = bookOf(*order).bidPrices;
 
     return bidsSet;
 }
 
-Resolution<std::reference_wrapper<askPricesAtPriceLevel>> OrderBook::getaskPricesAtPriceLevel(
-    OrderPtr order)
+MatchResolution<std::reference_wrapper<askPricesAtPriceLevel>> OrderBook::getaskPricesAtPriceLevel(
+    const OrderPtr& order)
 {
-    auto it = d_activeOrders.find(order->underlying());
-    if (it == d_activeOrders.end())
+    ActiveOrders* book = findBook(*order);
+    if (!book)
     {
-        return resolution::err(
-            std::format("No ask prices available for ticker {}\n", to_string(order->underlying())));
+        return resolution::fail(MatchError::NoBook, order->underlying());
     }
 
-    return std::ref(it->second.askPrices);
+    return std::ref(book->askPrices);
 }
 
-std::set<double, std::less<double>>& OrderBook::setAskPricesAtPriceLevel(OrderPtr order)
+askPricesAtPriceLevel& OrderBook::setAskPricesAtPriceLevel(const OrderPtr& order)
 {
-    auto& asksSet = d_activeOrders[order->underlying()].askPrices;
+    auto& asksSet = bookOf(*order).askPrices;
 
     return asksSet;
 }
 
-const Resolution<double> OrderBook::getBestPrice(OrderPtr orderToMatch)
+const MatchResolution<Ticks> OrderBook::getBestLadderPrice(const OrderPtr& orderToMatch)
+{
+    // the first order of a series, or for an underlying never initialised, has no book to match
+    auto ladder = oppositeMarketSideLadder(orderToMatch);
+    if (!ladder)
+    {
+        return std::unexpected(ladder.error());
+    }
+
+    auto bestPrice = (*ladder).get().best();
+    if (!bestPrice)
+    {
+        return resolution::fail(orderToMatch->marketSide() == MarketSide::Bid
+                                    ? MatchError::NoAskOrders
+                                    : MatchError::NoBidOrders,
+                                orderToMatch->underlying());
+    }
+
+    if (!orderToMatch->tradesAt(*bestPrice))
+    {
+        return resolution::fail(orderToMatch->marketSide() == MarketSide::Bid
+                                    ? MatchError::NoAsksWithinPrice
+                                    : MatchError::NoBidsWithinPrice,
+                                orderToMatch->underlying());
+    }
+
+    return *bestPrice;
+}
+
+const MatchResolution<Ticks> OrderBook::getBestPrice(const OrderPtr& orderToMatch)
 {
+    if (d_backend == BookBackend::Ladder)
+    {
+        return getBestLadderPrice(orderToMatch);
+    }
+
     if (orderToMatch->marketSide() == MarketSide::Bid)
     {
         auto askPricesSet = getaskPricesAtPriceLevel(orderToMatch);
         if (!askPricesSet)
         {
-            return resolution::err(askPricesSet.error());
+            return std::unexpected(askPricesSet.error());
         }
 
         auto& askPrices = (*askPricesSet).get();
 
         if (askPrices.size() == 0)
         {
-            return resolution::err(std::format("No ask orders found for ticker {}\n",
-                                               to_string(orderToMatch->underlying())));
+            return resolution::fail(MatchError::NoAskOrders, orderToMatch->underlying());
         }
 
-        double lowestaskPrice = *askPrices.begin();
-        if (lowestaskPrice > orderToMatch->price())
+        Ticks lowestaskPrice = *askPrices.begin();
+        if (!orderToMatch->tradesAt(lowestaskPrice))
         {
-            return resolution::err(
-                "No matching ask orders lower than or equal to bid "
-                "price\n");
+            return resolution::fail(MatchError::NoAsksWithinPrice, orderToMatch->underlying());
         }
 
         return lowestaskPrice;
@@ -201,92 +670,808 @@ const Resolution<double> OrderBook::getBestPrice(OrderPtr orderToMatch)
         auto bidPricesSet = getBidPricesAtPriceLevel(orderToMatch);
         if (!bidPricesSet)
         {
-            return resolution::err(bidPricesSet.error());
+            return std::unexpected(bidPricesSet.error());
         }
 
         auto& bidPrices = (*bidPricesSet).get();
 
         if (bidPrices.size() == 0)
         {
-            return resolution::err(std::format("No bid orders found for ticker {}\n",
-                                               to_string(orderToMatch->underlying())));
+            return resolution::fail(MatchError::NoBidOrders, orderToMatch->underlying());
         }
 
         // find highest bid price at or below target price
-        double highestBidPrice = *bidPrices.begin();
-        if (highestBidPrice < orderToMatch->price())
+        Ticks highestBidPrice = *bidPrices.begin();
+        if (!orderToMatch->tradesAt(highestBidPrice))
         {
-            return resolution::err(
-                "No matching bid orders lower than or equal to bid "
-                "price\n");
+            return resolution::fail(MatchError::NoBidsWithinPrice, orderToMatch->underlying());
         }
 
         return highestBidPrice;
     }
 }
 
-void OrderBook::addOrderToBook(OrderPtr order)
+std::optional<Ticks> OrderBook::topOfBook(const Underlying& underlying, MarketSide side) const
 {
-    // add price to price lookup map
-    if (order->marketSide() == MarketSide::Bid)
+    return bestOf(findBook(underlying), side);
+}
+
+std::optional<Ticks> OrderBook::topOfBook(Option option, const OptionSeries& series,
+                                          MarketSide side) const
+{
+    auto id = d_instruments.find(option);
+    return bestOf(id ? d_optionChains[*id]->find(series) : nullptr, side);
+}
+
+std::optional<Ticks> OrderBook::bestOf(const ActiveOrders* activeOrders, MarketSide side) const
+{
+    if (!activeOrders)
     {
-        setBidPricesAtPriceLevel(order).insert(order->price());
+        return std::nullopt;
     }
-    else
+
+    const ActiveOrders& book = *activeOrders;
+
+    if (d_backend == BookBackend::Ladder)
     {
-        setAskPricesAtPriceLevel(order).insert(order->price());
+        return side == MarketSide::Bid ? book.bidLadder.best() : book.askLadder.best();
     }
 
-    // add order to map of active orders safely
-    ordersDequeAtPrice(order).push_back(order);
+    if (side == MarketSide::Bid)
+    {
+        return book.bidPrices.empty() ? std::nullopt : std::optional(*book.bidPrices.begin());
+    }
+    return book.askPrices.empty() ? std::nullopt : std::optional(*book.askPrices.begin());
 }
 
-void OrderBook::removeOrderFromBook(OrderPtr orderToRemove)
+size_t OrderBook::depth(const Underlying& underlying, MarketSide side,
+                        std::span<DepthLevel> levels) const
 {
-    auto& priceDeque = ordersDequeAtPrice(orderToRemove);
-    for (size_t i = 0; i < priceDeque.size(); i++)
-    {
-        if (orderToRemove->uid() == priceDeque[i]->uid())
-        {
-            priceDeque.erase(priceDeque.begin() + i);
-            break;
-        }
-    }
+    return depthOf(findBook(underlying), side, levels);
 }
 
-std::optional<std::reference_wrapper<const ActiveOrders>> OrderBook::getActiveOrders(
-    const Underlying& underlying) const
+size_t OrderBook::depth(Option option, const OptionSeries& series, MarketSide side,
+                        std::span<DepthLevel> levels) const
 {
-    auto it = d_activeOrders.find(underlying);
-    if (it == d_activeOrders.end())
-    {
-        return std::nullopt;
-    }
-    return std::cref(it->second);
+    auto id = d_instruments.find(option);
+    return depthOf(id ? d_optionChains[*id]->find(series) : nullptr, side, levels);
 }
 
-void OrderBook::markOrderAsFulfilled(OrderPtr completedOrder, double matchedPrice)
+size_t OrderBook::depthOf(const ActiveOrders* activeOrders, MarketSide side,
+                          std::span<DepthLevel> levels) const
 {
-    completedOrder->matched(true);
-    // match price may not be equal to initial order price
-    completedOrder->matchedPrice(matchedPrice);
+    if (!activeOrders)
+    {
+        return 0;
+    }
 
-    removeOrderFromBook(completedOrder);
+    const ActiveOrders& book = *activeOrders;
 
-    // only remove from prices set if it's the last order left at
-    // that price
-    auto dequeOptional = getOrdersDequeAtPrice(completedOrder);
-    if (dequeOptional && dequeOptional->get().empty())
+    size_t count = 0;
+    auto addLevel = [&levels, &count](Ticks price, const OrderQueue& queue)
     {
-        if (completedOrder->marketSide() == MarketSide::Bid)
+        if (!queue.empty() && count < levels.size())
         {
-            setBidPricesAtPriceLevel(completedOrder).erase(completedOrder->price());
+            levels[count++] = {price, queue.qnty(), queue.size()};
         }
-        else
+    };
+
+    if (d_backend == BookBackend::Ladder)
+    {
+        const PriceLadder& ladder = side == MarketSide::Bid ? book.bidLadder : book.askLadder;
+        ladder.forEachLevel(levels.size(), addLevel);
+        return count;
+    }
+
+    // emptied levels are taken out of the map, so the first levels from the best end are the depth
+    auto addLevels = [&levels, &count, &addLevel](auto levelIt, auto end)
+    {
+        for (; levelIt != end && count < levels.size(); ++levelIt)
         {
-            setAskPricesAtPriceLevel(completedOrder).erase(completedOrder->price());
+            addLevel(levelIt->first, levelIt->second);
         }
-    }
+    };
+
+    if (side == MarketSide::Bid)
+    {
+        addLevels(book.bids.rbegin(), book.bids.rend());
+    }
+    else
+    {
+        addLevels(book.asks.begin(), book.asks.end());
+    }
+    return count;
+}
+
+bool OrderBook::canFill(const Order& order) const
+{
+    const ActiveOrders* activeOrders = findBook(order);
+    if (!activeOrders)
+    {
+        return false;
+    }
+
+    const ActiveOrders& book = *activeOrders;
+    const int64_t needed = order.outstandingQnty();
+
+    // levels are visited best first, so the first the order won't trade at ends the walk
+    int64_t available = 0;
+    auto addLevel = [&order, &available, needed](Ticks price, const OrderQueue& queue)
+    {
+        if (!order.tradesAt(price))
+        {
+            return false;
+        }
+        available += queue.qnty();
+        return available < needed;
+    };
+
+    const bool bid = order.marketSide() == MarketSide::Bid;
+
+    if (d_backend == BookBackend::Ladder)
+    {
+        (bid ? book.askLadder : book.bidLadder).forEachLevelWhile(addLevel);
+        return available >= needed;
+    }
+
+    auto addLevels = [&addLevel](auto levelIt, auto end)
+    {
+        while (levelIt != end && addLevel(levelIt->first, levelIt->second))
+        {
+            ++levelIt;
+        }
+    };
+
+    if (bid)
+    {
+        addLevels(book.asks.begin(), book.asks.end());
+    }
+    else
+    {
+        addLevels(book.bids.rbegin(), book.bids.rend());
+    }
+    return available >= needed;
+}
+
+MatchResolution<std::monostate> OrderBook::startAuction(const Underlying& underlying)
+{
+    ActiveOrders* book = findBook(underlying);
+    if (!book)
+    {
+        return resolution::fail(MatchError::NoBook, underlying);
+    }
+
+    book->inAuction = true;
+    return std::monostate{};
+}
+
+bool OrderBook::inAuction(const Underlying& underlying) const
+{
+    const ActiveOrders* book = findBook(underlying);
+    return book && book->inAuction;
+}
+
+MatchResolution<AuctionResult> OrderBook::uncross(const Underlying& underlying,
+                                                  std::vector<Fill>& fills)
+{
+    auto id = d_instruments.find(underlying);
+    if (!id)
+    {
+        return resolution::fail(MatchError::NoBook, underlying);
+    }
+
+    d_activeOrders[*id].inAuction = false;
+
+    if (const auto& chain = d_optionChains[*id])
+    {
+        AuctionResult result;
+        chain->forEachSeries([this, &fills, &result](const OptionSeries&, ActiveOrders& book)
+                             { result.qnty += uncrossBook(book, fills).qnty; });
+        return result;
+    }
+
+    return uncrossBook(d_activeOrders[*id], fills);
+}
+
+AuctionResult OrderBook::uncrossBook(ActiveOrders& book, std::vector<Fill>& fills)
+{
+    AuctionResult result;
+    result.price = equilibriumPrice(book);
+    if (!result.price)
+    {
+        return result;
+    }
+
+    const Ticks price = *result.price;
+
+    // every bid at or above the price trades against every ask at or below it, in time priority
+    // within each level, until one side runs out
+    while (true)
+    {
+        auto [bidPrice, bidLevel] = bestLevel(book, MarketSide::Bid);
+        auto [askPrice, askLevel] = bestLevel(book, MarketSide::Ask);
+        if (!bidLevel || !askLevel || bidPrice < price || askPrice > price)
+        {
+            return result;
+        }
+
+        // copied as the book releases its references once the orders are filled
+        OrderPtr bid = bidLevel->front();
+        OrderPtr ask = askLevel->front();
+
+        const int transactionQnty = std::min(bid->outstandingQnty(), ask->outstandingQnty());
+
+        bid->outstandingQnty(bid->outstandingQnty() - transactionQnty);
+        ask->outstandingQnty(ask->outstandingQnty() - transactionQnty);
+
+        bidLevel->reduceQnty(transactionQnty);
+        askLevel->reduceQnty(transactionQnty);
+
+        fills.push_back(Fill{bid->uid(), ask->uid(), price, transactionQnty,
+                             bid->outstandingQnty(), ask->qnty(), ask->outstandingQnty()});
+        recordTrade(bid, fills.back());
+        result.qnty += transactionQnty;
+
+        for (const OrderPtr& order : {bid, ask})
+        {
+            if (order->outstandingQnty() == 0)
+            {
+                markOrderAsFulfilled(order, price);
+            }
+        }
+    }
+}
+
+std::optional<Ticks> OrderBook::equilibriumPrice(const ActiveOrders& book) const
+{
+    const auto bestBid = bestOf(&book, MarketSide::Bid);
+    const auto bestAsk = bestOf(&book, MarketSide::Ask);
+    if (!bestBid || !bestAsk || *bestBid < *bestAsk)
+    {
+        return std::nullopt;
+    }
+
+    // only levels between the best ask and the best bid can trade, so the rest aren't read
+    thread_local std::vector<DepthLevel> bids;
+    thread_local std::vector<DepthLevel> asks;
+    bids.clear();
+    asks.clear();
+    crossedLevels(book, MarketSide::Bid, *bestAsk, bids);
+    crossedLevels(book, MarketSide::Ask, *bestBid, asks);
+
+    // one pass up the candidate prices, bids from their worst and asks from their best. Demand at
+    // a price is the bids at or above it and supply the asks at or below it, so supply takes in a
+    // level's asks before the price is scored and demand drops its bids after
+    int64_t demand = 0;
+    for (const DepthLevel& level : bids)
+    {
+        demand += level.qnty;
+    }
+    int64_t supply = 0;
+
+    int64_t bestVolume = -1;
+    int64_t bestImbalance = 0;
+    Ticks low = 0;
+    Ticks high = 0;
+    bool buySurplus = false;
+    bool sellSurplus = false;
+
+    auto bidIt = bids.rbegin();
+    auto askIt = asks.begin();
+    while (bidIt != bids.rend() || askIt != asks.end())
+    {
+        const Ticks price = askIt == asks.end()   ? bidIt->price
+                            : bidIt == bids.rend() ? askIt->price
+                                                   : std::min(bidIt->price, askIt->price);
+
+        if (askIt != asks.end() && askIt->price == price)
+        {
+            supply += (askIt++)->qnty;
+        }
+
+        const int64_t volume = std::min(demand, supply);
+        const int64_t imbalance = std::abs(demand - supply);
+
+        // the most quantity executed, then the least left unexecuted at the price
+        if (volume > bestVolume || (volume == bestVolume && imbalance < bestImbalance))
+        {
+            bestVolume = volume;
+            bestImbalance = imbalance;
+            low = price;
+            high = price;
+            buySurplus = demand > supply;
+            sellSurplus = supply > demand;
+        }
+        else if (volume == bestVolume && imbalance == bestImbalance)
+        {
+            high = price;
+            buySurplus = buySurplus && demand > supply;
+            sellSurplus = sellSurplus && supply > demand;
+        }
+
+        if (bidIt != bids.rend() && bidIt->price == price)
+        {
+            demand -= (bidIt++)->qnty;
+        }
+    }
+
+    // among prices that execute as much, unexecuted buying pushes the price up and selling down.
+    // Any price between two of them executes as much, as neither side can shrink in between
+    if (buySurplus)
+    {
+        return high;
+    }
+    if (sellSurplus)
+    {
+        return low;
+    }
+    return low + (high - low) / 2;
+}
+
+void OrderBook::crossedLevels(const ActiveOrders& book, MarketSide side, Ticks limit,
+                              std::vector<DepthLevel>& levels) const
+{
+    const bool bid = side == MarketSide::Bid;
+
+    auto addLevel = [&levels, limit, bid](Ticks price, const OrderQueue& queue)
+    {
+        if (bid ? price < limit : price > limit)
+        {
+            return false;
+        }
+        levels.push_back({price, queue.qnty(), queue.size()});
+        return true;
+    };
+
+    if (d_backend == BookBackend::Ladder)
+    {
+        (bid ? book.bidLadder : book.askLadder).forEachLevelWhile(addLevel);
+        return;
+    }
+
+    auto addLevels = [&addLevel](auto levelIt, auto end)
+    {
+        while (levelIt != end && addLevel(levelIt->first, levelIt->second))
+        {
+            ++levelIt;
+        }
+    };
+
+    if (bid)
+    {
+        addLevels(book.bids.rbegin(), book.bids.rend());
+    }
+    else
+    {
+        addLevels(book.asks.begin(), book.asks.end());
+    }
+}
+
+std::pair<Ticks, OrderQueue*> OrderBook::bestLevel(ActiveOrders& book, MarketSide side)
+{
+    const bool bid = side == MarketSide::Bid;
+
+    if (d_backend == BookBackend::Ladder)
+    {
+        PriceLadder& ladder = bid ? book.bidLadder : book.askLadder;
+        const auto best = ladder.best();
+        if (!best)
+        {
+            return {0, nullptr};
+        }
+        return {*best, ladder.findLevel(*best)};
+    }
+
+    // emptied levels are taken out of the map, so its ends are the best levels
+    PriceLevelMap& levels = bid ? book.bids : book.asks;
+    if (levels.empty())
+    {
+        return {0, nullptr};
+    }
+    auto& [price, queue] = bid ? *levels.rbegin() : *levels.begin();
+    return {price, &queue};
+}
+
+MatchResolution<std::monostate> OrderBook::addOrderToBook(const OrderPtr& order)
+{
+    ActiveOrders* activeOrders = openBook(*order);
+    if (!activeOrders)
+    {
+        return resolution::fail(MatchError::NoBook, order->underlying());
+    }
+
+    ActiveOrders& book = *activeOrders;
+
+    auto [indexIt, inserted] = book.orderIndex.try_emplace(order->uid(), NULL_NODE);
+    if (!inserted)
+    {
+        // already resting
+        return std::monostate{};
+    }
+
+    order->bookSequence(book.nextSequence++);
+
+    if (order->assetClass() == AssetClass::Option)
+    {
+        d_optionChains[*d_instruments.find(order->underlying())]->rested(
+            order->uid(), OptionSeries::of(*order));
+    }
+
+    const NodeHandle handle = book.nodePool.acquire(order);
+    indexIt->second = handle;
+    d_ordersByUid.add(order->uid(), *d_instruments.find(order->underlying()), handle);
+
+    if (d_backend == BookBackend::Ladder)
+    {
+        ladderOf(book, order->marketSide()).addOrder(book.nodePool, handle);
+        return std::monostate{};
+    }
+
+    // add price to price lookup map
+    if (order->marketSide() == MarketSide::Bid)
+    {
+        setBidPricesAtPriceLevel(order).insert(order->priceTicks());
+    }
+    else
+    {
+        setAskPricesAtPriceLevel(order).insert(order->priceTicks());
+    }
+
+    // add order to map of active orders safely
+    ordersQueueAtPrice(order).push_back(book.nodePool, handle);
+    return std::monostate{};
+}
+
+void OrderBook::removeOrderFromBook(OrderPtr orderToRemove)
+{
+    ActiveOrders* book = findBook(*orderToRemove);
+    if (!book)
+    {
+        return;
+    }
+
+    auto& orderIndex = book->orderIndex;
+
+    auto indexIt = orderIndex.find(orderToRemove->uid());
+    if (indexIt == orderIndex.end())
+    {
+        // not resting, e.g. an incoming order that was filled before it was added
+        return;
+    }
+
+    // found rather than opened, as a level is only ever in the book while orders rest at it
+    OrderQueue* priceQueue = findLevel(*book, *orderToRemove);
+    if (priceQueue)
+    {
+        priceQueue->erase(indexIt->second);
+    }
+
+    book->nodePool.release(indexIt->second);
+    orderIndex.erase(indexIt);
+
+    const InstrumentId id = *d_instruments.find(orderToRemove->underlying());
+    d_ordersByUid.remove(orderToRemove->uid(), id);
+
+    if (orderToRemove->assetClass() == AssetClass::Option)
+    {
+        d_optionChains[id]->removed(orderToRemove->uid());
+    }
+}
+
+std::optional<std::reference_wrapper<const ActiveOrders>> OrderBook::getActiveOrders(
+    const Underlying& underlying) const
+{
+    const ActiveOrders* book = findBook(underlying);
+    if (!book)
+    {
+        return std::nullopt;
+    }
+    return std::cref(*book);
+}
+
+std::optional<std::reference_wrapper<const ActiveOrders>> OrderBook::getActiveOrders(
+    const Order& order) const
+{
+    const ActiveOrders* book = findBook(order);
+    if (!book)
+    {
+        return std::nullopt;
+    }
+    return std::cref(*book);
+}
+
+std::optional<std::reference_wrapper<const OptionChain>> OrderBook::optionChain(
+    Option option) const
+{
+    auto id = d_instruments.find(option);
+    if (!id)
+    {
+        return std::nullopt;
+    }
+    return std::cref(*d_optionChains[*id]);
+}
+
+void OrderBook::markOrderAsFulfilled(OrderPtr completedOrder, Ticks matchedPrice)
+{
+    completedOrder->matched(true);
+    // match price may not be equal to initial order price
+    completedOrder->matchedPriceTicks(matchedPrice);
+
+    removeOrderFromBook(completedOrder);
+    releasePriceLevelIfEmpty(completedOrder);
+}
+
+void OrderBook::releasePriceLevelIfEmpty(OrderPtr order)
+{
+    ActiveOrders* book = findBook(*order);
+    if (!book)
+    {
+        return;
+    }
+
+    if (d_backend == BookBackend::Ladder)
+    {
+        ladderOf(*book, order->marketSide()).releaseLevelIfEmpty(order->priceTicks());
+        return;
+    }
+
+    const bool bid = order->marketSide() == MarketSide::Bid;
+    PriceLevelMap& levels = bid ? book->bids : book->asks;
+
+    // only remove the level if it's the last order left at that price
+    auto levelIt = levels.find(order->priceTicks());
+    if (levelIt == levels.end() || !levelIt->second.empty())
+    {
+        return;
+    }
+
+    if (bid)
+    {
+        book->bidPrices.erase(order->priceTicks());
+    }
+    else
+    {
+        book->askPrices.erase(order->priceTicks());
+    }
+
+    auto node = levels.extract(levelIt);
+    if (book->spareLevels.size() < MAX_SPARE_LEVELS)
+    {
+        book->spareLevels.push_back(std::move(node));
+    }
+}
+
+BookMemory& BookMemory::operator+=(const BookMemory& other)
+{
+    levels += other.levels;
+    spareLevels += other.spareLevels;
+    nodes += other.nodes;
+    bytes += other.bytes;
+    return *this;
+}
+
+BookMemory OrderBook::bookMemory(const Underlying& underlying) const
+{
+    auto id = d_instruments.find(underlying);
+    if (!id)
+    {
+        return {};
+    }
+
+    BookMemory memory = memoryOf(d_activeOrders[*id]);
+
+    if (const auto& chain = d_optionChains[*id])
+    {
+        chain->forEachSeries([this, &memory](const OptionSeries&, const ActiveOrders& book)
+                             { memory += memoryOf(book); });
+    }
+    return memory;
+}
+
+BookMemory OrderBook::memoryOf(const ActiveOrders& book) const
+{
+    // a tree node holds its colour and three links ahead of the value, and a hash node one link
+    constexpr size_t TREE_NODE_OVERHEAD = 4 * sizeof(void*);
+    constexpr size_t LEVEL_BYTES = sizeof(PriceLevelMap::value_type) + TREE_NODE_OVERHEAD;
+    constexpr size_t PRICE_BYTES = sizeof(Ticks) + TREE_NODE_OVERHEAD;
+    constexpr size_t INDEX_BYTES = sizeof(std::pair<const int, NodeHandle>) + sizeof(void*);
+
+    BookMemory memory;
+    memory.nodes = book.nodePool.capacity();
+    memory.bytes = sizeof(ActiveOrders) + memory.nodes * sizeof(OrderNode) +
+                   (memory.nodes - book.nodePool.size()) * sizeof(NodeHandle) +
+                   book.orderIndex.size() * INDEX_BYTES +
+                   book.orderIndex.bucket_count() * sizeof(void*);
+
+    if (d_backend == BookBackend::Ladder)
+    {
+        memory.levels = book.bidLadder.capacity() + book.askLadder.capacity() +
+                        book.bidLadder.overflowLevels() + book.askLadder.overflowLevels();
+        memory.bytes += book.bidLadder.bytes() + book.askLadder.bytes();
+        return memory;
+    }
+
+    memory.levels = book.bids.size() + book.asks.size();
+    memory.spareLevels = book.spareLevels.size();
+    memory.bytes += (memory.levels + memory.spareLevels) * LEVEL_BYTES +
+                    (book.bidPrices.size() + book.askPrices.size()) * PRICE_BYTES +
+                    book.spareLevels.capacity() * sizeof(PriceLevelMap::node_type);
+    return memory;
+}
+
+bool OrderBook::hasOrder(const Underlying& underlying, int uid) const
+{
+    return findRestingBook(underlying, uid) != nullptr;
+}
+
+OrderQueue* OrderBook::findLevel(ActiveOrders& book, const Order& order)
+{
+    const bool bid = order.marketSide() == MarketSide::Bid;
+
+    if (d_backend == BookBackend::Ladder)
+    {
+        PriceLadder& ladder = bid ? book.bidLadder : book.askLadder;
+        return ladder.findLevel(order.priceTicks());
+    }
+
+    PriceLevelMap& levels = bid ? book.bids : book.asks;
+
+    auto levelIt = levels.find(order.priceTicks());
+    return levelIt == levels.end() ? nullptr : &levelIt->second;
+}
+
+Resolution<OrderPtr> OrderBook::cancelOrder(const Underlying& underlying, int uid)
+{
+    if (!d_instruments.contains(underlying))
+    {
+        return resolution::err(
+            std::format("No book available for ticker {}\n", to_string(underlying)));
+    }
+
+    ActiveOrders* book = findRestingBook(underlying, uid);
+    if (!book)
+    {
+        return resolution::err(std::format("Order {} is not resting in the book for ticker {}\n",
+                                           uid, to_string(underlying)));
+    }
+
+    return cancelResting(*book, book->orderIndex.find(uid)->second);
+}
+
+Resolution<OrderPtr> OrderBook::cancelOrder(int uid)
+{
+    auto location = d_ordersByUid.find(uid);
+    if (!location)
+    {
+        return resolution::err(std::format("Order {} is not resting in the book\n", uid));
+    }
+
+    const std::unique_ptr<OptionChain>& chain = d_optionChains[location->instrument];
+    ActiveOrders& book = chain ? *chain->findResting(uid) : d_activeOrders[location->instrument];
+    return cancelResting(book, location->handle);
+}
+
+std::optional<Underlying> OrderBook::underlyingOf(int uid) const
+{
+    auto location = d_ordersByUid.find(uid);
+    if (!location)
+    {
+        return std::nullopt;
+    }
+    return d_instruments.underlying(location->instrument);
+}
+
+OrderPtr OrderBook::cancelResting(ActiveOrders& book, NodeHandle handle)
+{
+    // take a reference before the node holding the order is released
+    OrderPtr cancelledOrder = book.nodePool[handle].order;
+
+    removeOrderFromBook(cancelledOrder);
+    releasePriceLevelIfEmpty(cancelledOrder);
+
+    return cancelledOrder;
+}
+
+Resolution<std::monostate> OrderBook::applyEvent(const BookEvent& event)
+{
+    const Underlying underlying = event.order.toUnderlying();
+
+    switch (event.eventType())
+    {
+        case BookEventType::Accept:
+        {
+            auto order = event.order.toOrder();
+            if (!order)
+            {
+                return resolution::err(order.error());
+            }
+
+            // replaying is setup, so the underlying is opened if the log is the first to see it
+            openInstrument(underlying);
+            auto added = addOrderToBook(*order);
+            if (!added)
+            {
+                return resolution::err(added.error().message());
+            }
+            return std::monostate{};
+        }
+        case BookEventType::Fill:
+        {
+            if (!d_instruments.contains(underlying))
+            {
+                return resolution::err(std::format("Fill {} is for ticker {} which has no book\n",
+                                                   event.sequence, to_string(underlying)));
+            }
+
+            // an option's fill is found in the book of the series its incoming order rests in
+            ActiveOrders* book = findRestingBook(underlying, event.order.uid);
+            if (!book)
+            {
+                return resolution::err(std::format(
+                    "Fill {} is against order {} which is not resting\n", event.sequence,
+                    event.order.uid));
+            }
+
+            // both orders are found before either is touched, so a bad event changes nothing
+            std::array<OrderPtr, 2> orders;
+            for (size_t i = 0; i < orders.size(); i++)
+            {
+                const int uid = i == 0 ? event.order.uid : event.restingUid;
+
+                auto indexIt = book->orderIndex.find(uid);
+                if (indexIt == book->orderIndex.end())
+                {
+                    return resolution::err(std::format(
+                        "Fill {} is against order {} which is not resting\n", event.sequence, uid));
+                }
+                orders[i] = book->nodePool[indexIt->second].order;
+            }
+
+            for (const OrderPtr& order : orders)
+            {
+                order->outstandingQnty(order->outstandingQnty() - event.order.qnty);
+                findLevel(*book, *order)->reduceQnty(event.order.qnty);
+
+                if (order->outstandingQnty() == 0)
+                {
+                    markOrderAsFulfilled(order, event.price);
+                }
+            }
+            return std::monostate{};
+        }
+        case BookEventType::Cancel:
+        {
+            auto cancelled = cancelOrder(underlying, event.order.uid);
+            if (!cancelled)
+            {
+                return resolution::err(cancelled.error());
+            }
+            return std::monostate{};
+        }
+        case BookEventType::AuctionStart:
+        {
+            openInstrument(underlying);
+            (void)startAuction(underlying);
+            return std::monostate{};
+        }
+        case BookEventType::Uncross:
+        {
+            // the trades it made are replayed from the fills logged before it, so it only ends
+            // the call
+            auto id = d_instruments.find(underlying);
+            if (!id)
+            {
+                return resolution::err(
+                    std::format("Uncross {} is for ticker {} which has no book\n", event.sequence,
+                                to_string(underlying)));
+            }
+            d_activeOrders[*id].inAuction = false;
+            return std::monostate{};
+        }
+    }
+
+    return resolution::err(std::format("Event {} has unknown type {}\n", event.sequence,
+                                       static_cast<int>(event.type)));
 }
 
 }  // namespace solstice::matching
@@ -2,20 +2,38 @@
 #define ORDERBOOK_H
 
 #include <asset_class.h>
+#include <book_backend.h>
+#include <event_log.h>
 #include <equity_price_data.h>
+#include <fill.h>
 #include <future_price_data.h>
+#include <instrument_registry.h>
 #include <market_side.h>
+#include <match_error.h>
 #include <option_price_data.h>
+#include <option_type.h>
+#include <options.h>
 #include <order.h>
-#include <transaction.h>
+#include <order_queue.h>
+#include <price_ladder.h>
+#include <seq_locked.h>
+#include <ticks.h>
+#include <trade_tape.h>
 #include <types.h>
+#include <uid_index.h>
 
+#include <atomic>
+#include <cstdint>
 #include <deque>
 #include <functional>
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
+#include <span>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace solstice::pricing
 {
@@ -28,18 +46,150 @@ namespace solstice::matching
 {
 
 using OrderPtr = std::shared_ptr<Order>;
-using PriceLevelMap = std::map<double, std::deque<OrderPtr>>;
+using PriceLevelMap = std::map<Ticks, OrderQueue>;
 
-using BidPricesAtPriceLevel = std::set<double, std::greater<double>>;
-using askPricesAtPriceLevel = std::set<double, std::less<double>>;
+using BidPricesAtPriceLevel = std::set<Ticks, std::greater<Ticks>>;
+using askPricesAtPriceLevel = std::set<Ticks, std::less<Ticks>>;
+
+// emptied levels a book keeps for reuse, past which they are freed
+constexpr size_t MAX_SPARE_LEVELS = 64;
 
 struct ActiveOrders
 {
+    // a price is only in bids or asks while orders rest at it
     PriceLevelMap bids;
     PriceLevelMap asks;
 
     BidPricesAtPriceLevel bidPrices;
     askPricesAtPriceLevel askPrices;
+
+    // nodes of levels taken out of bids and asks as they emptied, reused for the next level opened
+    // on either side so a book whose prices keep moving doesn't allocate per level
+    std::vector<PriceLevelMap::node_type> spareLevels;
+
+    // only used by BookBackend::Ladder
+    PriceLadder bidLadder{MarketSide::Bid};
+    PriceLadder askLadder{MarketSide::Ask};
+
+    // owns the queue node of every resting order
+    OrderNodePool nodePool;
+    // uid -> handle of the order's node in nodePool
+    std::unordered_map<int, NodeHandle> orderIndex;
+
+    // stamped on the next order added, so time priority never depends on a clock
+    uint64_t nextSequence = 1;
+
+    // set while the instrument is in a call auction. For an Option ticker it is held here, on the
+    // ticker's own book, and covers every series
+    bool inAuction = false;
+};
+
+// A price level as seen from outside the book
+struct DepthLevel
+{
+    Ticks price;
+    int64_t qnty;
+    size_t orders;
+};
+
+// What uncrossing a call auction traded
+struct AuctionResult
+{
+    // the single price every fill traded at, unset if nothing crossed. For an Option ticker each
+    // series has its own price, which its fills carry, so this is left unset
+    std::optional<Ticks> price;
+    int64_t qnty = 0;
+};
+
+// Roughly what a book holds, estimated from the sizes of its containers without allocator overhead
+struct BookMemory
+{
+    // levels allocated, occupied or not. For the ladder backend every slot in the window counts,
+    // plus its overflow levels
+    size_t levels = 0;
+    size_t spareLevels = 0;
+    // order nodes allocated, resting or free
+    size_t nodes = 0;
+    size_t bytes = 0;
+
+    BookMemory& operator+=(const BookMemory& other);
+};
+
+// Everything two orders for the same Option ticker must agree on to trade. The ticker fixes the
+// underlying equity, so each strike, expiry and type of it is a series with its own book. Strikes
+// are held in the ticker's ticks and expiries in whole months, so terms that only differ past that
+// precision share a series rather than each opening a book
+struct OptionSeries
+{
+    Ticks strike;
+    int32_t expiryMonths;
+    OptionType optionType;
+
+    // the order must be for an Option ticker
+    static OptionSeries of(const Order& order);
+    // expiry is in years, as on an order's terms
+    static OptionSeries of(Option option, double strike, double expiry, OptionType optionType);
+
+    auto operator<=>(const OptionSeries&) const = default;
+};
+
+// The books of one Option ticker, one per series traded on it. Series are only opened when their
+// first order arrives, and are kept sorted in a flat vector that a lookup binary searches. A series
+// whose last order leaves keeps its book until another series is opened, which then takes it over,
+// so a chain holds at most as many books as it ever had series resting at once
+class OptionChain
+{
+   public:
+    ActiveOrders* find(const OptionSeries& series);
+    const ActiveOrders* find(const OptionSeries& series) const;
+    ActiveOrders& open(const OptionSeries& series);
+
+    // the book of the series the order is resting in, null if it isn't resting
+    ActiveOrders* findResting(int uid);
+    const ActiveOrders* findResting(int uid) const;
+    // kept up to date by the order book as orders are added to and removed from the series
+    void rested(int uid, const OptionSeries& series);
+    void removed(int uid);
+
+    size_t size() const;
+
+    // visits the book of every series held, in series order
+    template <typename Func>
+    void forEachSeries(Func&& func) const
+    {
+        for (const auto& [series, book] : d_series)
+        {
+            func(series, d_books[book]);
+        }
+    }
+
+    template <typename Func>
+    void forEachSeries(Func&& func)
+    {
+        for (const auto& [series, book] : d_series)
+        {
+            func(series, d_books[book]);
+        }
+    }
+
+   private:
+    // a series and the index of its book
+    using SeriesBook = std::pair<OptionSeries, uint32_t>;
+
+    // where the series is, or would be inserted
+    std::vector<SeriesBook>::const_iterator position(const OptionSeries& series) const;
+
+    // sorted by series
+    std::vector<SeriesBook> d_series;
+    // never moved by opening another series, as a book's queues point into its node pool
+    std::deque<ActiveOrders> d_books;
+    // the series each book is held by, and whether it is waiting in d_emptyBooks
+    std::vector<OptionSeries> d_seriesOfBook;
+    std::vector<bool> d_bookEmptied;
+    // books whose last order has left, taken over by the next series opened if still empty
+    std::vector<uint32_t> d_emptyBooks;
+    // uid -> index of the book each resting order is in
+    std::unordered_map<int, uint32_t> d_bookOfOrder;
 };
 
 class OrderBook
@@ -47,59 +197,289 @@ class OrderBook
     friend class Orchestrator;
 
    public:
+    explicit OrderBook(BookBackend backend = BookBackend::Tree);
+
+    BookBackend backend() const;
+
+    // every underlying the book has been opened for, numbering its book, tape and price data
+    const InstrumentRegistry& instruments() const;
+
+    // unsynchronised, only for setup or single threaded callers
     pricing::EquityPriceData& getPriceData(Equity eq);
     pricing::FuturePriceData& getPriceData(Future fut);
     pricing::OptionPriceData& getPriceData(Option opt);
 
+    // for callers that may run alongside other threads pricing or updating the same underlying
+    SeqLocked<pricing::EquityPriceData>& sharedPriceData(Equity eq);
+    SeqLocked<pricing::FuturePriceData>& sharedPriceData(Future fut);
+    SeqLocked<pricing::OptionPriceData>& sharedPriceData(Option opt);
+
     void addEquitiesToDataMap();
     void addFuturesToDataMap();
     void addOptionsToDataMap();
 
-    const std::vector<Transaction>& transactions() const;
-    const Resolution<double> getBestPrice(OrderPtr orderToMatch);
+    // every trade matched on the underlying so far, readable from any thread
+    std::optional<std::reference_wrapper<const TradeTape>> tradeTape(
+        const Underlying& underlying) const;
+    // appends a fill to the incoming order's tape under the next trade sequence. The underlying
+    // must have been initialised, and the caller must have exclusive access to it
+    void recordTrade(const OrderPtr& incomingOrder, const Fill& fill);
+
+    const MatchResolution<Ticks> getBestPrice(const OrderPtr& orderToMatch);
+    // options rest in the books of their series, so for an Option ticker see the overload below
+    std::optional<Ticks> topOfBook(const Underlying& underlying, MarketSide side) const;
+    std::optional<Ticks> topOfBook(Option option, const OptionSeries& series,
+                                   MarketSide side) const;
 
-    std::optional<std::reference_wrapper<std::deque<OrderPtr>>> getOrdersDequeAtPrice(
-        const OrderPtr order);
-    std::deque<OrderPtr>& getOrdersDequeAtPrice(OrderPtr order, int priceToMatch);
-    std::deque<OrderPtr>& ordersDequeAtPrice(OrderPtr order);
+    // fills levels with the best levels on a side, best first, returning how many there were.
+    // Reads only the levels returned, as each keeps its own quantity and order count. The caller
+    // must have exclusive access to the underlying
+    size_t depth(const Underlying& underlying, MarketSide side, std::span<DepthLevel> levels) const;
+    size_t depth(Option option, const OptionSeries& series, MarketSide side,
+                 std::span<DepthLevel> levels) const;
 
-    std::map<double, std::deque<OrderPtr>>& sameMarketSidePriceLevelMap(OrderPtr order);
-    std::map<double, std::deque<OrderPtr>>& oppositeMarketSidePriceLevelMap(OrderPtr order);
+    // puts the underlying's book in a call auction, failing with NoBook if it was never
+    // initialised. Orders rest without matching while it lasts, whether they cross or not. The
+    // caller must have exclusive access to the underlying
+    MatchResolution<std::monostate> startAuction(const Underlying& underlying);
+    bool inAuction(const Underlying& underlying) const;
+    // ends the underlying's call and trades every crossed order at the one price that executes
+    // the most quantity, appending a Fill for each trade. Each fill records the bid as the
+    // incoming order, as neither side was the aggressor. The caller must have exclusive access to
+    // the underlying
+    MatchResolution<AuctionResult> uncross(const Underlying& underlying, std::vector<Fill>& fills);
 
-    Resolution<std::reference_wrapper<std::deque<OrderPtr>>> getPriceLevelOppositeOrders(
-        OrderPtr order, double priceToUse);
+    // whether the opposite side holds enough quantity at prices the order trades at to fill it
+    // completely, summing the levels' quantities best first until it does. The caller must have
+    // exclusive access to the underlying
+    bool canFill(const Order& order) const;
 
-    void addOrderToBook(OrderPtr order);
+    std::optional<std::reference_wrapper<OrderQueue>> getOrdersQueueAtPrice(const OrderPtr& order);
+    OrderQueue& getOrdersQueueAtPrice(const OrderPtr& order, Ticks priceToMatch);
+    OrderQueue& ordersQueueAtPrice(const OrderPtr& order);
+
+    // tree backend only
+    PriceLevelMap& sameMarketSidePriceLevelMap(const OrderPtr& order);
+    PriceLevelMap& oppositeMarketSidePriceLevelMap(const OrderPtr& order);
+
+    // fail with NoBook rather than throw, as an order is matched before its series' book opens
+    MatchResolution<std::reference_wrapper<PriceLadder>> sameMarketSideLadder(
+        const OrderPtr& order);
+    MatchResolution<std::reference_wrapper<PriceLadder>> oppositeMarketSideLadder(
+        const OrderPtr& order);
+
+    MatchResolution<std::reference_wrapper<OrderQueue>> getPriceLevelOppositeOrders(
+        const OrderPtr& order, Ticks priceToUse);
+
+    // rests the order in its underlying's book, or its series' book for an option, opening the
+    // series if need be. Underlyings are only opened by setup, as that isn't safe alongside other
+    // threads, so an order for one never initialised fails with NoBook
+    MatchResolution<std::monostate> addOrderToBook(const OrderPtr& order);
     void removeOrderFromBook(OrderPtr orderToRemove);
-    void markOrderAsFulfilled(OrderPtr completedOrder, double matchedPrice);
+    void markOrderAsFulfilled(OrderPtr completedOrder, Ticks matchedPrice);
+
+    bool hasOrder(const Underlying& underlying, int uid) const;
+
+    // removes a resting order from the book, returning the order that was cancelled
+    Resolution<OrderPtr> cancelOrder(const Underlying& underlying, int uid);
+    // as above, for callers that only know the uid, found through the book-wide uid index
+    Resolution<OrderPtr> cancelOrder(int uid);
+    // the underlying an order with uid is resting for, unset if none is. Uids can repeat across
+    // underlyings, in which case any one of them
+    std::optional<Underlying> underlyingOf(int uid) const;
 
+    // the underlying's book, which for an Option ticker holds none of its orders
     std::optional<std::reference_wrapper<const ActiveOrders>> getActiveOrders(
         const Underlying& underlying) const;
+    // the book the order rests in or would rest in, which for an option is its series' book
+    std::optional<std::reference_wrapper<const ActiveOrders>> getActiveOrders(
+        const Order& order) const;
+
+    // the series traded on an Option ticker so far
+    std::optional<std::reference_wrapper<const OptionChain>> optionChain(Option option) const;
+
+    // what the underlying's book holds, summed over its series' books for an Option ticker. The
+    // caller must have exclusive access to the underlying
+    BookMemory bookMemory(const Underlying& underlying) const;
+
+    // applies one event from an event log. Replaying a run's events in sequence order leaves the
+    // resting orders, and which underlyings are in a call auction, as they were when the last
+    // event was logged
+    Resolution<std::monostate> applyEvent(const BookEvent& event);
+
+    // opens the book and price data for an underlying that may be outside the configured pool
+    void initialiseUnderlying(const Underlying& underlying);
+
+    // replaces an underlying's price data with a copy taken earlier, adding it if it is missing
+    void restorePriceData(const pricing::EquityPriceData& data);
+    void restorePriceData(const pricing::FuturePriceData& data);
+    void restorePriceData(const pricing::OptionPriceData& data);
+
+    // visits the underlying's resting orders a price level at a time, each level in time priority.
+    // The caller must have exclusive access to the underlying
+    template <typename Func>
+    void forEachRestingOrder(const Underlying& underlying, Func&& func) const
+    {
+        auto id = d_instruments.find(underlying);
+        if (!id)
+        {
+            return;
+        }
+
+        auto visitBook = [this, &func](const ActiveOrders& activeOrders)
+        {
+            auto visitLevel = [&func](Ticks, const OrderQueue& queue)
+            {
+                for (const OrderPtr& order : queue)
+                {
+                    func(order);
+                }
+            };
+
+            if (d_backend == BookBackend::Ladder)
+            {
+                activeOrders.bidLadder.forEachLevel(visitLevel);
+                activeOrders.askLadder.forEachLevel(visitLevel);
+                return;
+            }
+
+            for (const auto& levels : {&activeOrders.bids, &activeOrders.asks})
+            {
+                for (const auto& [price, queue] : *levels)
+                {
+                    visitLevel(price, queue);
+                }
+            }
+        };
+
+        if (const auto& chain = d_optionChains[*id])
+        {
+            chain->forEachSeries([&visitBook](const OptionSeries&, const ActiveOrders& book)
+                                 { visitBook(book); });
+            return;
+        }
+
+        visitBook(d_activeOrders[*id]);
+    }
+
+    // visits the shared price data of every underlying, safe alongside threads updating it
+    template <typename Func>
+    void forEachPriceData(Func&& func) const
+    {
+        auto visit = [&func](const auto& slots)
+        {
+            for (const auto& data : slots)
+            {
+                if (data)
+                {
+                    func(*data);
+                }
+            }
+        };
+
+        visit(d_equityData);
+        visit(d_futureData);
+        visit(d_optionData);
+    }
 
     template <typename T>
     void initialiseBookAtUnderlyings()
     {
         for (const auto& underlying : underlyingsPool<T>())
         {
-            d_activeOrders[underlying];
+            openInstrument(underlying);
         }
     }
 
    private:
-    Resolution<std::reference_wrapper<BidPricesAtPriceLevel>> getBidPricesAtPriceLevel(
-        OrderPtr order);
-    Resolution<std::reference_wrapper<askPricesAtPriceLevel>> getaskPricesAtPriceLevel(
-        OrderPtr order);
+    // indexed by InstrumentId, empty where the instrument has no data of that type
+    template <typename Data>
+    using PriceDataSlots = std::vector<std::unique_ptr<SeqLocked<Data>>>;
+
+    // the underlying's id, opening an empty book and tape for it if it has none yet. Setup only,
+    // as it grows the registry and the vectors indexed by it under threads reading them
+    InstrumentId openInstrument(const Underlying& underlying);
+
+    // null if the book has never been opened for the underlying
+    ActiveOrders* findBook(const Underlying& underlying);
+    const ActiveOrders* findBook(const Underlying& underlying) const;
+
+    // as above for the book an order trades in: its underlying's, or its series' for an option
+    ActiveOrders* findBook(const Order& order);
+    const ActiveOrders* findBook(const Order& order) const;
+    // as above, opening an option's series book if need be but never the underlying's
+    ActiveOrders* openBook(const Order& order);
+    // throws std::out_of_range if the order has no book, as looking it up in a map would
+    ActiveOrders& bookOf(const Order& order);
+    static PriceLadder& ladderOf(ActiveOrders& book, MarketSide side);
+
+    // the book the order with uid is resting in, null if it isn't resting
+    ActiveOrders* findRestingBook(const Underlying& underlying, int uid);
+    const ActiveOrders* findRestingBook(const Underlying& underlying, int uid) const;
+
+    // throws std::out_of_range if the underlying has no data, as looking it up in a map would
+    template <typename Data>
+    SeqLocked<Data>& priceDataOf(PriceDataSlots<Data>& slots, const Underlying& underlying);
+    // adds default data for the ticker if it has none, returning the ticker's data
+    template <typename Data, typename Ticker>
+    SeqLocked<Data>& addPriceData(PriceDataSlots<Data>& slots, Ticker ticker);
+
+    const MatchResolution<Ticks> getBestLadderPrice(const OrderPtr& orderToMatch);
+    std::optional<Ticks> bestOf(const ActiveOrders* activeOrders, MarketSide side) const;
+    size_t depthOf(const ActiveOrders* activeOrders, MarketSide side,
+                   std::span<DepthLevel> levels) const;
+
+    AuctionResult uncrossBook(ActiveOrders& book, std::vector<Fill>& fills);
+    // the price that executes the most of the crossed quantity, unset if the book doesn't cross
+    std::optional<Ticks> equilibriumPrice(const ActiveOrders& book) const;
+    // appends the side's levels that trade at limit, best first
+    void crossedLevels(const ActiveOrders& book, MarketSide side, Ticks limit,
+                       std::vector<DepthLevel>& levels) const;
+    // the best level on a side with its price, null once the side is empty
+    std::pair<Ticks, OrderQueue*> bestLevel(ActiveOrders& book, MarketSide side);
+
+    // the level at the order's price on its side of the book, whether or not the order rests there
+    OrderQueue* findLevel(ActiveOrders& book, const Order& order);
+
+    // drops the order's price from the book once no orders are left resting at it, keeping the
+    // level's node for reuse if the book has room for another spare
+    void releasePriceLevelIfEmpty(OrderPtr order);
+
+    // the level at price, opened from a spare node if the book has one
+    static OrderQueue& openLevel(ActiveOrders& book, PriceLevelMap& levels, Ticks price);
+
+    BookMemory memoryOf(const ActiveOrders& book) const;
+
+    MatchResolution<std::reference_wrapper<BidPricesAtPriceLevel>> getBidPricesAtPriceLevel(
+        const OrderPtr& order);
+    MatchResolution<std::reference_wrapper<askPricesAtPriceLevel>> getaskPricesAtPriceLevel(
+        const OrderPtr& order);
+
+    BidPricesAtPriceLevel& setBidPricesAtPriceLevel(const OrderPtr& order);
+    askPricesAtPriceLevel& setAskPricesAtPriceLevel(const OrderPtr& order);
+
+    // takes the resting order at handle out of book, returning it
+    OrderPtr cancelResting(ActiveOrders& book, NodeHandle handle);
+
+    BookBackend d_backend;
+
+    InstrumentRegistry d_instruments;
 
-    BidPricesAtPriceLevel& setBidPricesAtPriceLevel(OrderPtr order);
-    askPricesAtPriceLevel& setAskPricesAtPriceLevel(OrderPtr order);
+    // each indexed by InstrumentId, and never moved by opening another instrument: a book's
+    // queues point into its node pool, and tapes and price data are read by other threads
+    std::deque<ActiveOrders> d_activeOrders;
+    // null for every instrument but an Option ticker, whose orders rest in its chain's books
+    std::vector<std::unique_ptr<OptionChain>> d_optionChains;
+    std::vector<std::unique_ptr<TradeTape>> d_tradeTapes;
+    std::atomic<uint64_t> d_nextTradeSequence{1};
 
-    std::unordered_map<Underlying, ActiveOrders> d_activeOrders;
-    std::vector<Transaction> d_transactions;
+    // every resting order by uid. An option's node is in the book of the series it rests in,
+    // which its chain finds from the uid
+    UidIndex d_ordersByUid;
 
-    std::unordered_map<Equity, pricing::EquityPriceData> d_equityDataMap;
-    std::unordered_map<Future, pricing::FuturePriceData> d_futureDataMap;
-    std::unordered_map<Option, pricing::OptionPriceData> d_optionDataMap;
+    PriceDataSlots<pricing::EquityPriceData> d_equityData;
+    PriceDataSlots<pricing::FuturePriceData> d_futureData;
+    PriceDataSlots<pricing::OptionPriceData> d_optionData;
 };
 }  // namespace solstice::matching
 
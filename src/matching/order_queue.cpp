@@ -0,0 +1,127 @@
+#include <order_queue.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace solstice::matching
+{
+
+NodeHandle OrderNodePool::acquire(OrderPtr order)
+{
+    if (!d_freeHandles.empty())
+    {
+        NodeHandle handle = d_freeHandles.back();
+        d_freeHandles.pop_back();
+
+        d_nodes[handle] = OrderNode{std::move(order)};
+        return handle;
+    }
+
+    d_nodes.push_back(OrderNode{std::move(order)});
+    return static_cast<NodeHandle>(d_nodes.size() - 1);
+}
+
+void OrderNodePool::release(NodeHandle handle)
+{
+    // drop the book's reference straight away so the order can be recycled
+    d_nodes[handle] = OrderNode{};
+    d_freeHandles.push_back(handle);
+}
+
+OrderNode& OrderNodePool::operator[](NodeHandle handle) { return d_nodes[handle]; }
+
+const OrderNode& OrderNodePool::operator[](NodeHandle handle) const { return d_nodes[handle]; }
+
+size_t OrderNodePool::size() const { return d_nodes.size() - d_freeHandles.size(); }
+
+size_t OrderNodePool::capacity() const { return d_nodes.size(); }
+
+OrderQueue::OrderQueue(OrderQueue&& other) noexcept
+    : d_pool(std::exchange(other.d_pool, nullptr)),
+      d_head(std::exchange(other.d_head, NULL_NODE)),
+      d_tail(std::exchange(other.d_tail, NULL_NODE)),
+      d_size(std::exchange(other.d_size, 0)),
+      d_qnty(std::exchange(other.d_qnty, 0))
+{
+}
+
+OrderQueue& OrderQueue::operator=(OrderQueue&& other) noexcept
+{
+    if (this != &other)
+    {
+        d_pool = std::exchange(other.d_pool, nullptr);
+        d_head = std::exchange(other.d_head, NULL_NODE);
+        d_tail = std::exchange(other.d_tail, NULL_NODE);
+        d_size = std::exchange(other.d_size, 0);
+        d_qnty = std::exchange(other.d_qnty, 0);
+    }
+    return *this;
+}
+
+void OrderQueue::push_back(OrderNodePool& pool, NodeHandle handle)
+{
+    d_pool = &pool;
+
+    OrderNode& node = pool[handle];
+    node.prev = d_tail;
+    node.next = NULL_NODE;
+
+    if (d_tail != NULL_NODE)
+    {
+        pool[d_tail].next = handle;
+    }
+    else
+    {
+        d_head = handle;
+    }
+
+    d_tail = handle;
+    d_size++;
+    d_qnty += node.order->outstandingQnty();
+}
+
+void OrderQueue::erase(NodeHandle handle)
+{
+    OrderNodePool& pool = *d_pool;
+    OrderNode& node = pool[handle];
+
+    if (node.prev != NULL_NODE)
+    {
+        pool[node.prev].next = node.next;
+    }
+    else
+    {
+        d_head = node.next;
+    }
+
+    if (node.next != NULL_NODE)
+    {
+        pool[node.next].prev = node.prev;
+    }
+    else
+    {
+        d_tail = node.prev;
+    }
+
+    node.prev = NULL_NODE;
+    node.next = NULL_NODE;
+    d_size--;
+    d_qnty -= node.order->outstandingQnty();
+}
+
+void OrderQueue::reduceQnty(int qnty) { d_qnty -= qnty; }
+
+const OrderPtr& OrderQueue::front() const { return (*d_pool)[d_head].order; }
+
+bool OrderQueue::empty() const { return d_size == 0; }
+
+size_t OrderQueue::size() const { return d_size; }
+
+int64_t OrderQueue::qnty() const { return d_qnty; }
+
+OrderQueue::Iterator OrderQueue::begin() const { return Iterator(d_pool, d_head); }
+
+OrderQueue::Iterator OrderQueue::end() const { return Iterator(d_pool, NULL_NODE); }
+
+}  // namespace solstice::matching
@@ -0,0 +1,129 @@
+#ifndef ORDER_QUEUE_H
+#define ORDER_QUEUE_H
+
+#include <order.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace solstice::matching
+{
+
+using OrderPtr = std::shared_ptr<Order>;
+
+// index of a node in an OrderNodePool
+using NodeHandle = uint32_t;
+
+constexpr NodeHandle NULL_NODE = std::numeric_limits<NodeHandle>::max();
+
+// links live alongside the order so a resting order can be unlinked from its level without
+// searching for it
+struct OrderNode
+{
+    OrderPtr order;
+    NodeHandle prev = NULL_NODE;
+    NodeHandle next = NULL_NODE;
+};
+
+// Contiguous storage for the nodes of one book, addressed by 32-bit handles rather than pointers
+// so nodes stay small and released slots are recycled before the storage grows.
+class OrderNodePool
+{
+   public:
+    NodeHandle acquire(OrderPtr order);
+    void release(NodeHandle handle);
+
+    OrderNode& operator[](NodeHandle handle);
+    const OrderNode& operator[](NodeHandle handle) const;
+
+    size_t size() const;
+    size_t capacity() const;
+
+   private:
+    std::vector<OrderNode> d_nodes;
+    std::vector<NodeHandle> d_freeHandles;
+};
+
+// FIFO of resting orders at a single price level. The queue does not own its nodes, they are
+// owned by the book's node pool and must outlive their membership of the queue. The outstanding
+// quantity of the level is kept as orders join and leave it, so any fill of an order while it is
+// in the queue must be passed to reduceQnty.
+class OrderQueue
+{
+   public:
+    class Iterator
+    {
+       public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = OrderPtr;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const OrderPtr*;
+        using reference = const OrderPtr&;
+
+        Iterator() = default;
+        Iterator(const OrderNodePool* pool, NodeHandle handle) : d_pool(pool), d_handle(handle)
+        {
+        }
+
+        reference operator*() const { return (*d_pool)[d_handle].order; }
+        pointer operator->() const { return &(*d_pool)[d_handle].order; }
+
+        Iterator& operator++()
+        {
+            d_handle = (*d_pool)[d_handle].next;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator prev = *this;
+            ++*this;
+            return prev;
+        }
+
+        bool operator==(const Iterator& other) const { return d_handle == other.d_handle; }
+
+       private:
+        const OrderNodePool* d_pool = nullptr;
+        NodeHandle d_handle = NULL_NODE;
+    };
+
+    OrderQueue() = default;
+
+    OrderQueue(const OrderQueue&) = delete;
+    OrderQueue& operator=(const OrderQueue&) = delete;
+
+    OrderQueue(OrderQueue&& other) noexcept;
+    OrderQueue& operator=(OrderQueue&& other) noexcept;
+
+    // every node pushed to a queue must come from the same pool
+    void push_back(OrderNodePool& pool, NodeHandle handle);
+    void erase(NodeHandle handle);
+    // one of the queue's orders has had qnty filled
+    void reduceQnty(int qnty);
+
+    const OrderPtr& front() const;
+
+    bool empty() const;
+    size_t size() const;
+    // outstanding quantity summed over the queue's orders
+    int64_t qnty() const;
+
+    Iterator begin() const;
+    Iterator end() const;
+
+   private:
+    OrderNodePool* d_pool = nullptr;
+    NodeHandle d_head = NULL_NODE;
+    NodeHandle d_tail = NULL_NODE;
+    uint32_t d_size = 0;
+    int64_t d_qnty = 0;
+};
+
+}  // namespace solstice::matching
+
+#endif  // ORDER_QUEUE_H
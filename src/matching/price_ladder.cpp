@@ -0,0 +1,393 @@
+#include <market_side.h>
+#include <order.h>
+#include <order_queue.h>
+#include <price_ladder.h>
+#include <ticks.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <vector>
+
+namespace solstice::matching
+{
+
+namespace
+{
+
+constexpr size_t BITS_PER_WORD = 64;
+
+size_t wordsFor(size_t bits) { return (bits + BITS_PER_WORD - 1) / BITS_PER_WORD; }
+
+// bits [0, bit] set
+uint64_t maskUpTo(size_t bit)
+{
+    return bit == BITS_PER_WORD - 1 ? ~0ULL : (1ULL << (bit + 1)) - 1;
+}
+
+// bits [bit, 63] set
+uint64_t maskFrom(size_t bit) { return ~0ULL << bit; }
+
+}  // namespace
+
+PriceLadder::PriceLadder(MarketSide side, size_t initialLevels, size_t maxLevels)
+    : d_side(side), d_initialLevels(initialLevels), d_maxLevels(maxLevels)
+{
+}
+
+OrderQueue& PriceLadder::level(Ticks price)
+{
+    if (OrderQueue* orders = findOverflow(price))
+    {
+        return *orders;
+    }
+
+    if (!inRange(price) && !recentre(price))
+    {
+        return d_overflow[price];
+    }
+
+    return d_levels[indexOf(price)];
+}
+
+OrderQueue* PriceLadder::findLevel(Ticks price)
+{
+    if (OrderQueue* orders = findOverflow(price))
+    {
+        return orders;
+    }
+
+    if (!inRange(price))
+    {
+        return nullptr;
+    }
+
+    return &d_levels[indexOf(price)];
+}
+
+const OrderQueue* PriceLadder::findLevel(Ticks price) const
+{
+    if (const OrderQueue* orders = findOverflow(price))
+    {
+        return orders;
+    }
+
+    if (!inRange(price))
+    {
+        return nullptr;
+    }
+
+    return &d_levels[indexOf(price)];
+}
+
+void PriceLadder::addOrder(OrderNodePool& pool, NodeHandle handle)
+{
+    const Ticks price = pool[handle].order->priceTicks();
+
+    level(price).push_back(pool, handle);
+    if (!findOverflow(price))
+    {
+        setOccupied(indexOf(price));
+    }
+}
+
+void PriceLadder::releaseLevelIfEmpty(Ticks price)
+{
+    if (!d_overflow.empty())
+    {
+        auto levelIt = d_overflow.find(price);
+        if (levelIt != d_overflow.end())
+        {
+            if (levelIt->second.empty())
+            {
+                d_overflow.erase(levelIt);
+            }
+            return;
+        }
+    }
+
+    auto* orders = findLevel(price);
+    if (orders && orders->empty())
+    {
+        clearOccupied(indexOf(price));
+    }
+}
+
+std::optional<Ticks> PriceLadder::best() const
+{
+    std::optional<Ticks> best;
+    if (auto idx = firstOccupied())
+    {
+        best = priceAt(*idx);
+    }
+
+    if (!d_overflow.empty())
+    {
+        const Ticks overflowBest =
+            d_side == MarketSide::Bid ? d_overflow.rbegin()->first : d_overflow.begin()->first;
+        if (!best || betterThan(overflowBest, *best))
+        {
+            best = overflowBest;
+        }
+    }
+
+    return best;
+}
+
+bool PriceLadder::empty() const { return d_occupied == 0 && d_overflow.empty(); }
+
+size_t PriceLadder::occupiedLevels() const { return d_occupied + d_overflow.size(); }
+
+size_t PriceLadder::capacity() const { return d_levels.size(); }
+
+size_t PriceLadder::overflowLevels() const { return d_overflow.size(); }
+
+Ticks PriceLadder::anchor() const { return d_anchor; }
+
+size_t PriceLadder::bytes() const
+{
+    // a tree node holds its colour and three links ahead of the value
+    constexpr size_t OVERFLOW_LEVEL_BYTES =
+        sizeof(std::map<Ticks, OrderQueue>::value_type) + 4 * sizeof(void*);
+
+    return d_levels.capacity() * sizeof(OrderQueue) +
+           (d_bitmap.capacity() + d_summary.capacity()) * sizeof(uint64_t) +
+           d_overflow.size() * OVERFLOW_LEVEL_BYTES;
+}
+
+bool PriceLadder::inRange(Ticks price) const
+{
+    return d_anchored && price >= d_anchor &&
+           price < d_anchor + static_cast<Ticks>(d_levels.size());
+}
+
+size_t PriceLadder::indexOf(Ticks price) const { return static_cast<size_t>(price - d_anchor); }
+
+Ticks PriceLadder::priceAt(size_t idx) const { return d_anchor + static_cast<Ticks>(idx); }
+
+bool PriceLadder::betterThan(Ticks price, Ticks other) const
+{
+    return d_side == MarketSide::Bid ? price > other : price < other;
+}
+
+OrderQueue* PriceLadder::findOverflow(Ticks price)
+{
+    if (d_overflow.empty())
+    {
+        return nullptr;
+    }
+
+    auto levelIt = d_overflow.find(price);
+    return levelIt == d_overflow.end() ? nullptr : &levelIt->second;
+}
+
+const OrderQueue* PriceLadder::findOverflow(Ticks price) const
+{
+    if (d_overflow.empty())
+    {
+        return nullptr;
+    }
+
+    auto levelIt = d_overflow.find(price);
+    return levelIt == d_overflow.end() ? nullptr : &levelIt->second;
+}
+
+void PriceLadder::setOccupied(size_t idx)
+{
+    uint64_t& word = d_bitmap[idx / BITS_PER_WORD];
+    const uint64_t bit = 1ULL << (idx % BITS_PER_WORD);
+
+    if (word & bit)
+    {
+        return;
+    }
+
+    word |= bit;
+    d_occupied++;
+
+    const size_t wordIdx = idx / BITS_PER_WORD;
+    d_summary[wordIdx / BITS_PER_WORD] |= 1ULL << (wordIdx % BITS_PER_WORD);
+}
+
+void PriceLadder::clearOccupied(size_t idx)
+{
+    uint64_t& word = d_bitmap[idx / BITS_PER_WORD];
+    const uint64_t bit = 1ULL << (idx % BITS_PER_WORD);
+
+    if (!(word & bit))
+    {
+        return;
+    }
+
+    word &= ~bit;
+    d_occupied--;
+
+    if (word == 0)
+    {
+        const size_t wordIdx = idx / BITS_PER_WORD;
+        d_summary[wordIdx / BITS_PER_WORD] &= ~(1ULL << (wordIdx % BITS_PER_WORD));
+    }
+}
+
+std::optional<size_t> PriceLadder::lowestOccupied(size_t from) const
+{
+    if (from >= d_levels.size())
+    {
+        return std::nullopt;
+    }
+
+    // check the remainder of the word containing from first
+    size_t wordIdx = from / BITS_PER_WORD;
+    uint64_t word = d_bitmap[wordIdx] & maskFrom(from % BITS_PER_WORD);
+    if (word)
+    {
+        return wordIdx * BITS_PER_WORD + std::countr_zero(word);
+    }
+
+    // then use the summary to skip straight to the next non-empty word
+    size_t nextWord = wordIdx + 1;
+    if (nextWord >= d_bitmap.size())
+    {
+        return std::nullopt;
+    }
+
+    size_t summaryIdx = nextWord / BITS_PER_WORD;
+    uint64_t summary = d_summary[summaryIdx] & maskFrom(nextWord % BITS_PER_WORD);
+
+    while (true)
+    {
+        if (summary)
+        {
+            size_t found = summaryIdx * BITS_PER_WORD + std::countr_zero(summary);
+            return found * BITS_PER_WORD + std::countr_zero(d_bitmap[found]);
+        }
+
+        if (++summaryIdx >= d_summary.size())
+        {
+            return std::nullopt;
+        }
+        summary = d_summary[summaryIdx];
+    }
+}
+
+std::optional<size_t> PriceLadder::highestOccupied(size_t before) const
+{
+    if (before == 0)
+    {
+        return std::nullopt;
+    }
+
+    size_t last = std::min(before, d_levels.size()) - 1;
+    size_t wordIdx = last / BITS_PER_WORD;
+    uint64_t word = d_bitmap[wordIdx] & maskUpTo(last % BITS_PER_WORD);
+    if (word)
+    {
+        return wordIdx * BITS_PER_WORD + (BITS_PER_WORD - 1 - std::countl_zero(word));
+    }
+
+    if (wordIdx == 0)
+    {
+        return std::nullopt;
+    }
+
+    size_t prevWord = wordIdx - 1;
+    size_t summaryIdx = prevWord / BITS_PER_WORD;
+    uint64_t summary = d_summary[summaryIdx] & maskUpTo(prevWord % BITS_PER_WORD);
+
+    while (true)
+    {
+        if (summary)
+        {
+            size_t found =
+                summaryIdx * BITS_PER_WORD + (BITS_PER_WORD - 1 - std::countl_zero(summary));
+            return found * BITS_PER_WORD +
+                   (BITS_PER_WORD - 1 - std::countl_zero(d_bitmap[found]));
+        }
+
+        if (summaryIdx == 0)
+        {
+            return std::nullopt;
+        }
+        summary = d_summary[--summaryIdx];
+    }
+}
+
+std::optional<size_t> PriceLadder::firstOccupied() const
+{
+    return d_side == MarketSide::Bid ? highestOccupied(d_levels.size()) : lowestOccupied(0);
+}
+
+std::optional<size_t> PriceLadder::nextOccupied(size_t idx) const
+{
+    return d_side == MarketSide::Bid ? highestOccupied(idx) : lowestOccupied(idx + 1);
+}
+
+bool PriceLadder::recentre(Ticks price)
+{
+    // nothing resting, so the window can simply be moved to sit around the new price, giving
+    // back whatever it grew by while orders rested across a wider range
+    if (d_occupied == 0)
+    {
+        if (d_levels.size() != d_initialLevels)
+        {
+            resize(d_initialLevels);
+        }
+
+        d_anchor = price - static_cast<Ticks>(d_levels.size()) / 2;
+        d_anchored = true;
+        return true;
+    }
+
+    // otherwise grow until both the resting levels and the new price fit, keeping headroom
+    // either side
+    const Ticks lowest = std::min(d_anchor, price);
+    const Ticks highest = std::max(d_anchor + static_cast<Ticks>(d_levels.size()) - 1, price);
+    const size_t span = static_cast<size_t>(highest - lowest + 1);
+    if (span > d_maxLevels)
+    {
+        return false;
+    }
+
+    size_t newSize = d_levels.size();
+    while (newSize < span)
+    {
+        newSize *= 2;
+    }
+
+    const Ticks newAnchor = lowest - static_cast<Ticks>((newSize - span) / 2);
+    const size_t shift = static_cast<size_t>(d_anchor - newAnchor);
+
+    std::vector<size_t> occupied;
+    occupied.reserve(d_occupied);
+    for (auto idx = lowestOccupied(0); idx; idx = lowestOccupied(*idx + 1))
+    {
+        occupied.push_back(*idx);
+    }
+
+    std::vector<OrderQueue> oldLevels = std::move(d_levels);
+
+    resize(newSize);
+    d_anchor = newAnchor;
+
+    for (size_t idx : occupied)
+    {
+        d_levels[idx + shift] = std::move(oldLevels[idx]);
+        setOccupied(idx + shift);
+    }
+    return true;
+}
+
+void PriceLadder::resize(size_t levels)
+{
+    // replaced rather than resized, so shrinking frees the old storage
+    d_levels = std::vector<OrderQueue>(levels);
+
+    d_bitmap = std::vector<uint64_t>(wordsFor(levels), 0);
+    d_summary = std::vector<uint64_t>(wordsFor(d_bitmap.size()), 0);
+    d_occupied = 0;
+}
+
+}  // namespace solstice::matching
@@ -0,0 +1,178 @@
+#ifndef PRICE_LADDER_H
+#define PRICE_LADDER_H
+
+#include <market_side.h>
+#include <order.h>
+#include <order_queue.h>
+#include <ticks.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace solstice::matching
+{
+
+// grows by doubling, so keep this a power of two
+constexpr size_t LADDER_INITIAL_LEVELS = 1024;
+// the most levels the window may grow to, also a power of two. Prices that would need a wider
+// window are kept in the overflow map instead
+constexpr size_t LADDER_MAX_LEVELS = 1 << 18;
+
+// One side of a book stored as a contiguous array of price levels, one slot per tick, starting at
+// d_anchor. A two-level bitmap (one bit per level, one summary bit per bitmap word) tracks which
+// levels hold orders, so the best level is found with a couple of bit scans instead of a tree walk.
+// Storage is only allocated once the first order arrives, and a ladder that grew goes back to its
+// initial size the next time it is recentred while empty. The window never grows past maxLevels,
+// so an order priced far from the rest rests in a sorted overflow map rather than sizing the array
+// to the distance.
+class PriceLadder
+{
+   public:
+    explicit PriceLadder(MarketSide side, size_t initialLevels = LADDER_INITIAL_LEVELS,
+                         size_t maxLevels = LADDER_MAX_LEVELS);
+
+    // returns the level at price, re-anchoring or growing the ladder if price is out of range, or
+    // an overflow level if the window can't grow to cover it
+    OrderQueue& level(Ticks price);
+
+    OrderQueue* findLevel(Ticks price);
+    const OrderQueue* findLevel(Ticks price) const;
+
+    void addOrder(OrderNodePool& pool, NodeHandle handle);
+
+    // clears the occupancy bit once the last order at price has gone
+    void releaseLevelIfEmpty(Ticks price);
+
+    // highest occupied price for bids, lowest for asks
+    std::optional<Ticks> best() const;
+
+    bool empty() const;
+    size_t occupiedLevels() const;
+    // levels in the window, occupied or not
+    size_t capacity() const;
+    size_t overflowLevels() const;
+    Ticks anchor() const;
+    // heap memory held by the levels, bitmaps and overflow map
+    size_t bytes() const;
+
+    // visits occupied levels from best to worst
+    template <typename Func>
+    void forEachLevel(Func&& func) const
+    {
+        forEachLevel(std::numeric_limits<size_t>::max(), std::forward<Func>(func));
+    }
+
+    // as above, stopping after the best count levels
+    template <typename Func>
+    void forEachLevel(size_t count, Func&& func) const
+    {
+        size_t visited = 0;
+        forEachLevelWhile(
+            [&](Ticks price, const OrderQueue& orders)
+            {
+                if (visited++ == count)
+                {
+                    return false;
+                }
+                func(price, orders);
+                return true;
+            });
+    }
+
+    // visits occupied levels best first for as long as func returns true
+    template <typename Func>
+    void forEachLevelWhile(Func&& func) const
+    {
+        auto idx = firstOccupied();
+        if (d_overflow.empty())
+        {
+            while (idx && func(priceAt(*idx), d_levels[*idx]))
+            {
+                idx = nextOccupied(*idx);
+            }
+            return;
+        }
+
+        // merge the window's levels with the overflow's, which lie either side of it or inside it
+        // at prices the window has since grown over
+        auto merge = [&](auto it, auto end)
+        {
+            while (idx || it != end)
+            {
+                if (idx && (it == end || betterThan(priceAt(*idx), it->first)))
+                {
+                    if (!func(priceAt(*idx), d_levels[*idx]))
+                    {
+                        return;
+                    }
+                    idx = nextOccupied(*idx);
+                }
+                else
+                {
+                    if (!func(it->first, it->second))
+                    {
+                        return;
+                    }
+                    ++it;
+                }
+            }
+        };
+
+        if (d_side == MarketSide::Bid)
+        {
+            merge(d_overflow.rbegin(), d_overflow.rend());
+        }
+        else
+        {
+            merge(d_overflow.begin(), d_overflow.end());
+        }
+    }
+
+   private:
+    bool inRange(Ticks price) const;
+    size_t indexOf(Ticks price) const;
+    Ticks priceAt(size_t idx) const;
+    bool betterThan(Ticks price, Ticks other) const;
+    OrderQueue* findOverflow(Ticks price);
+    const OrderQueue* findOverflow(Ticks price) const;
+
+    void setOccupied(size_t idx);
+    void clearOccupied(size_t idx);
+
+    // first occupied index >= from
+    std::optional<size_t> lowestOccupied(size_t from) const;
+    // last occupied index < before
+    std::optional<size_t> highestOccupied(size_t before) const;
+    // best occupied index, then the next worse one after idx
+    std::optional<size_t> firstOccupied() const;
+    std::optional<size_t> nextOccupied(size_t idx) const;
+
+    // returns false, leaving the window as it was, if covering price would grow it past
+    // d_maxLevels
+    bool recentre(Ticks price);
+    void resize(size_t levels);
+
+    MarketSide d_side;
+    size_t d_initialLevels;
+    size_t d_maxLevels;
+    Ticks d_anchor = 0;
+    bool d_anchored = false;
+    size_t d_occupied = 0;
+
+    std::vector<OrderQueue> d_levels;
+    std::vector<uint64_t> d_bitmap;
+    std::vector<uint64_t> d_summary;
+
+    // levels outside the window. A price found here stays here until its level is released, so a
+    // price never has a level in both
+    std::map<Ticks, OrderQueue> d_overflow;
+};
+
+}  // namespace solstice::matching
+
+#endif  // PRICE_LADDER_H
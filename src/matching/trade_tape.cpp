@@ -0,0 +1,135 @@
+#include <asset_class.h>
+#include <ticks.h>
+#include <trade_tape.h>
+#include <transaction.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace solstice::matching
+{
+
+TradeRange::TradeRange(const TradeTape& tape, size_t first, size_t last)
+    : d_tape(&tape), d_first(first), d_last(last)
+{
+}
+
+size_t TradeRange::size() const { return d_last - d_first; }
+
+bool TradeRange::empty() const { return d_first == d_last; }
+
+Transaction TradeRange::operator[](size_t index) const { return d_tape->at(d_first + index); }
+
+TradeTape::Segment::Segment(size_t capacity)
+    : sequence(std::make_unique_for_overwrite<uint64_t[]>(capacity)),
+      price(std::make_unique_for_overwrite<Ticks[]>(capacity)),
+      qnty(std::make_unique_for_overwrite<int[]>(capacity)),
+      bidUid(std::make_unique_for_overwrite<int[]>(capacity)),
+      askUid(std::make_unique_for_overwrite<int[]>(capacity))
+{
+}
+
+TradeTape::TradeTape(const Underlying& underlying) : d_underlying(underlying) {}
+
+const Underlying& TradeTape::underlying() const { return d_underlying; }
+
+size_t TradeTape::segmentCapacity(size_t segment) { return TRADE_TAPE_FIRST_SEGMENT << segment; }
+
+size_t TradeTape::segmentStart(size_t segment)
+{
+    return TRADE_TAPE_FIRST_SEGMENT * ((size_t{1} << segment) - 1);
+}
+
+std::pair<size_t, size_t> TradeTape::locate(size_t position)
+{
+    const size_t segment = std::bit_width(position / TRADE_TAPE_FIRST_SEGMENT + 1) - 1;
+    return {segment, position - segmentStart(segment)};
+}
+
+void TradeTape::append(uint64_t sequence, Ticks price, int qnty, int bidUid, int askUid)
+{
+    // only this thread writes d_size, so it can read its own last store relaxed
+    const size_t position = d_size.load(std::memory_order_relaxed);
+    const auto [segment, index] = locate(position);
+
+    if (index == 0)
+    {
+        d_segments[segment] = std::make_unique<Segment>(segmentCapacity(segment));
+    }
+
+    Segment& storage = *d_segments[segment];
+    storage.sequence[index] = sequence;
+    storage.price[index] = price;
+    storage.qnty[index] = qnty;
+    storage.bidUid[index] = bidUid;
+    storage.askUid[index] = askUid;
+
+    d_size.store(position + 1, std::memory_order_release);
+}
+
+size_t TradeTape::size() const { return d_size.load(std::memory_order_acquire); }
+
+bool TradeTape::empty() const { return size() == 0; }
+
+uint64_t TradeTape::sequenceAt(size_t position) const
+{
+    const auto [segment, index] = locate(position);
+    return d_segments[segment]->sequence[index];
+}
+
+Transaction TradeTape::at(size_t position) const
+{
+    const auto [segment, index] = locate(position);
+    const Segment& storage = *d_segments[segment];
+
+    return Transaction(d_underlying, storage.sequence[index], storage.price[index],
+                       storage.qnty[index], storage.bidUid[index], storage.askUid[index]);
+}
+
+std::optional<Transaction> TradeTape::lastTrade() const
+{
+    const size_t trades = size();
+    if (trades == 0)
+    {
+        return std::nullopt;
+    }
+    return at(trades - 1);
+}
+
+TradeRange TradeTape::all() const { return TradeRange(*this, 0, size()); }
+
+TradeRange TradeTape::last(size_t count) const
+{
+    const size_t trades = size();
+    return TradeRange(*this, trades - std::min(count, trades), trades);
+}
+
+TradeRange TradeTape::since(uint64_t sequence) const
+{
+    const size_t trades = size();
+
+    // sequences only rise along the tape, so binary search for the first one past sequence
+    size_t low = 0;
+    size_t high = trades;
+    while (low < high)
+    {
+        const size_t mid = low + (high - low) / 2;
+        if (sequenceAt(mid) <= sequence)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return TradeRange(*this, low, trades);
+}
+
+}  // namespace solstice::matching
@@ -0,0 +1,144 @@
+#ifndef TRADE_TAPE_H
+#define TRADE_TAPE_H
+
+#include <asset_class.h>
+#include <ticks.h>
+#include <transaction.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <utility>
+
+namespace solstice::matching
+{
+
+// the first segment of a tape holds this many trades and each one after it twice as many as the
+// one before, so keep it a power of two
+constexpr size_t TRADE_TAPE_FIRST_SEGMENT = 1024;
+
+// A run of consecutive trades, held a column at a time
+struct TradeColumns
+{
+    std::span<const uint64_t> sequence;
+    std::span<const Ticks> price;
+    std::span<const int> qnty;
+    std::span<const int> bidUid;
+    std::span<const int> askUid;
+
+    size_t size() const { return sequence.size(); }
+};
+
+class TradeTape;
+
+// A range of trades on a tape, read in place. Trades never move or change once appended, so a
+// range stays valid for as long as its tape does, whatever is appended after it was taken
+class TradeRange
+{
+   public:
+    TradeRange(const TradeTape& tape, size_t first, size_t last);
+
+    size_t size() const;
+    bool empty() const;
+
+    // oldest first
+    Transaction operator[](size_t index) const;
+
+    // visits the range a segment at a time, oldest first, each as one TradeColumns
+    template <typename Func>
+    void forEachColumns(Func&& func) const;
+
+   private:
+    const TradeTape* d_tape;
+    size_t d_first;
+    size_t d_last;
+};
+
+// Append-only record of every trade on one underlying, stored column by column. Storage grows by
+// adding segments of doubling size, never by moving what is already there, so readers can hold
+// spans into it while trades are still being appended. Only the thread that has the underlying to
+// itself may append, but any thread may read: a trade is published by the store to d_size, after
+// its columns are written.
+class TradeTape
+{
+    friend class TradeRange;
+
+   public:
+    explicit TradeTape(const Underlying& underlying);
+
+    TradeTape(const TradeTape&) = delete;
+    TradeTape& operator=(const TradeTape&) = delete;
+
+    const Underlying& underlying() const;
+
+    // writer only. sequence must be above that of every trade already on the tape
+    void append(uint64_t sequence, Ticks price, int qnty, int bidUid, int askUid);
+
+    size_t size() const;
+    bool empty() const;
+
+    std::optional<Transaction> lastTrade() const;
+
+    TradeRange all() const;
+    // the latest count trades, or all of them if there are fewer
+    TradeRange last(size_t count) const;
+    // every trade numbered after sequence
+    TradeRange since(uint64_t sequence) const;
+
+   private:
+    struct Segment
+    {
+        explicit Segment(size_t capacity);
+
+        std::unique_ptr<uint64_t[]> sequence;
+        std::unique_ptr<Ticks[]> price;
+        std::unique_ptr<int[]> qnty;
+        std::unique_ptr<int[]> bidUid;
+        std::unique_ptr<int[]> askUid;
+    };
+
+    // enough doublings that a tape can never run out of segments
+    static constexpr size_t MAX_SEGMENTS = 48;
+
+    static size_t segmentCapacity(size_t segment);
+    static size_t segmentStart(size_t segment);
+    // the segment holding the trade at position, and its index within that segment
+    static std::pair<size_t, size_t> locate(size_t position);
+
+    uint64_t sequenceAt(size_t position) const;
+    Transaction at(size_t position) const;
+
+    Underlying d_underlying;
+    std::array<std::unique_ptr<Segment>, MAX_SEGMENTS> d_segments;
+    std::atomic<size_t> d_size{0};
+};
+
+template <typename Func>
+void TradeRange::forEachColumns(Func&& func) const
+{
+    size_t position = d_first;
+    while (position < d_last)
+    {
+        const auto [segment, index] = TradeTape::locate(position);
+        const size_t count =
+            std::min(TradeTape::segmentCapacity(segment) - index, d_last - position);
+        const TradeTape::Segment& storage = *d_tape->d_segments[segment];
+
+        func(TradeColumns{{storage.sequence.get() + index, count},
+                          {storage.price.get() + index, count},
+                          {storage.qnty.get() + index, count},
+                          {storage.bidUid.get() + index, count},
+                          {storage.askUid.get() + index, count}});
+
+        position += count;
+    }
+}
+
+}  // namespace solstice::matching
+
+#endif  // TRADE_TAPE_H
@@ -0,0 +1,148 @@
+#include <instrument_registry.h>
+#include <order_queue.h>
+#include <uid_index.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace solstice::matching
+{
+
+// slots a stripe starts with on its first add
+constexpr size_t UID_STRIPE_INITIAL_SLOTS = 64;
+
+uint64_t UidIndex::hashOf(int uid)
+{
+    // Fibonacci hashing spreads the consecutive uids orders are given across stripes and slots
+    return static_cast<uint64_t>(static_cast<uint32_t>(uid)) * 0x9E3779B97F4A7C15ull;
+}
+
+UidIndex::Stripe& UidIndex::stripeOf(uint64_t hash)
+{
+    return d_stripes[hash >> (64 - std::countr_zero(UID_INDEX_STRIPES))];
+}
+
+const UidIndex::Stripe& UidIndex::stripeOf(uint64_t hash) const
+{
+    return d_stripes[hash >> (64 - std::countr_zero(UID_INDEX_STRIPES))];
+}
+
+void UidIndex::rehash(Stripe& stripe)
+{
+    // kept at most half full, so probes stay short
+    const size_t slots = std::max(UID_STRIPE_INITIAL_SLOTS, std::bit_ceil(stripe.live * 4));
+
+    std::vector<Slot> old = std::exchange(stripe.slots, std::vector<Slot>(slots));
+    stripe.used = stripe.live;
+
+    const size_t mask = slots - 1;
+    for (const Slot& slot : old)
+    {
+        if (slot.state != SlotState::Used)
+        {
+            continue;
+        }
+
+        size_t index = static_cast<size_t>(hashOf(slot.entry.uid)) & mask;
+        while (stripe.slots[index].state != SlotState::Empty)
+        {
+            index = (index + 1) & mask;
+        }
+        stripe.slots[index] = slot;
+    }
+}
+
+void UidIndex::add(int uid, InstrumentId instrument, NodeHandle handle)
+{
+    const uint64_t hash = hashOf(uid);
+    Stripe& stripe = stripeOf(hash);
+    std::lock_guard<std::mutex> lock(stripe.mutex);
+
+    if ((stripe.used + 1) * 2 > stripe.slots.size())
+    {
+        rehash(stripe);
+    }
+
+    const size_t mask = stripe.slots.size() - 1;
+    size_t index = static_cast<size_t>(hash) & mask;
+    while (stripe.slots[index].state == SlotState::Used)
+    {
+        index = (index + 1) & mask;
+    }
+
+    if (stripe.slots[index].state == SlotState::Empty)
+    {
+        stripe.used++;
+    }
+    stripe.slots[index] = Slot{{uid, instrument, handle}, SlotState::Used};
+    stripe.live++;
+}
+
+void UidIndex::remove(int uid, InstrumentId instrument)
+{
+    const uint64_t hash = hashOf(uid);
+    Stripe& stripe = stripeOf(hash);
+    std::lock_guard<std::mutex> lock(stripe.mutex);
+
+    if (stripe.slots.empty())
+    {
+        return;
+    }
+
+    const size_t mask = stripe.slots.size() - 1;
+    for (size_t index = static_cast<size_t>(hash) & mask;
+         stripe.slots[index].state != SlotState::Empty; index = (index + 1) & mask)
+    {
+        Slot& slot = stripe.slots[index];
+        if (slot.state == SlotState::Used && slot.entry.uid == uid &&
+            slot.entry.instrument == instrument)
+        {
+            slot.state = SlotState::Removed;
+            stripe.live--;
+            return;
+        }
+    }
+}
+
+std::optional<UidIndex::Entry> UidIndex::find(int uid) const
+{
+    const uint64_t hash = hashOf(uid);
+    const Stripe& stripe = stripeOf(hash);
+    std::lock_guard<std::mutex> lock(stripe.mutex);
+
+    if (stripe.slots.empty())
+    {
+        return std::nullopt;
+    }
+
+    const size_t mask = stripe.slots.size() - 1;
+    for (size_t index = static_cast<size_t>(hash) & mask;
+         stripe.slots[index].state != SlotState::Empty; index = (index + 1) & mask)
+    {
+        const Slot& slot = stripe.slots[index];
+        if (slot.state == SlotState::Used && slot.entry.uid == uid)
+        {
+            return slot.entry;
+        }
+    }
+    return std::nullopt;
+}
+
+size_t UidIndex::size() const
+{
+    size_t live = 0;
+    for (const Stripe& stripe : d_stripes)
+    {
+        std::lock_guard<std::mutex> lock(stripe.mutex);
+        live += stripe.live;
+    }
+    return live;
+}
+
+}  // namespace solstice::matching
@@ -0,0 +1,79 @@
+#ifndef UID_INDEX_H
+#define UID_INDEX_H
+
+#include <instrument_registry.h>
+#include <order_queue.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace solstice::matching
+{
+
+// a power of two, so a stripe is picked by masking the uid's hash
+constexpr size_t UID_INDEX_STRIPES = 64;
+
+// Where every resting order is, found from its uid alone: the instrument's book and the order's
+// node in it. Books for different underlyings are changed at once by different workers, so the
+// index is split into stripes by uid, each an open addressed table under its own lock, and adding
+// or removing an order never allocates once its stripe has grown. Uids can repeat across
+// underlyings, so a uid may have an entry for each.
+class UidIndex
+{
+   public:
+    struct Entry
+    {
+        int uid;
+        InstrumentId instrument;
+        NodeHandle handle;
+    };
+
+    // the uid must not already have an entry for instrument
+    void add(int uid, InstrumentId instrument, NodeHandle handle);
+    void remove(int uid, InstrumentId instrument);
+
+    // any one of the uid's entries, unset if it has none
+    std::optional<Entry> find(int uid) const;
+
+    size_t size() const;
+
+   private:
+    enum class SlotState : uint8_t
+    {
+        Empty,
+        Used,
+        // removed, so probes carry on past it
+        Removed
+    };
+
+    struct Slot
+    {
+        Entry entry;
+        SlotState state = SlotState::Empty;
+    };
+
+    struct alignas(64) Stripe
+    {
+        mutable std::mutex mutex;
+        // a power of two in size, empty until the first add
+        std::vector<Slot> slots;
+        size_t used = 0;  // slots not empty, counting removed ones
+        size_t live = 0;
+    };
+
+    static uint64_t hashOf(int uid);
+    Stripe& stripeOf(uint64_t hash);
+    const Stripe& stripeOf(uint64_t hash) const;
+    // resizes to fit the live entries with room to spare, dropping removed slots
+    static void rehash(Stripe& stripe);
+
+    std::array<Stripe, UID_INDEX_STRIPES> d_stripes;
+};
+
+}  // namespace solstice::matching
+
+#endif  // UID_INDEX_H
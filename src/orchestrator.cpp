@@ -1,5 +1,13 @@
 #include <asset_class.h>
+#include <backpressure_policy.h>
+#include <book_snapshot.h>
+#include <book_event_type.h>
 #include <config.h>
+#include <cycle_clock.h>
+#include <event_log.h>
+#include <fill.h>
+#include <get_random.h>
+#include <instrument_universe.h>
 #include <log_level.h>
 #include <logging.h>
 #include <market_side.h>
@@ -8,39 +16,56 @@
 #include <orchestrator.h>
 #include <order.h>
 #include <order_book.h>
+#include <order_pool.h>
 #include <pricer.h>
+#include <random_stream.h>
 #include <types.h>
+#include <wait_strategy.h>
 
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <format>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <memory_resource>
 #include <mutex>
+#include <random>
+#include <span>
 #include <sstream>
 #include <thread>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace solstice::matching
 {
 
 constexpr int EQUITY_OPTION_ORDER_RATIO = 2;
 
-String formatOptionDetails(OrderPtr order)
+// most orders a worker takes from its queue in one go
+constexpr size_t ORDER_BATCH_SIZE = 32;
+
+// random streams: 0 for the thread calling start, then one per generator and one per worker
+constexpr uint64_t GENERATOR_STREAM_BASE = 1;
+constexpr uint64_t WORKER_STREAM_BASE = 1 << 16;
+
+String formatOptionDetails(const OrderPtr& order)
 {
     if (order->assetClass() != AssetClass::Option)
     {
         return "";
     }
 
-    auto optionOrder = std::dynamic_pointer_cast<OptionOrder>(order);
-    if (!optionOrder)
-    {
-        return "";
-    }
+    const OptionTerms& terms = order->optionTerms();
 
     std::ostringstream oss;
-    oss << " | Strike: $" << (*optionOrder).strike()
-        << " | Type: " << ((*optionOrder).optionType() == OptionType::Call ? "Call" : "Put")
-        << " | Expiry: " << (*optionOrder).expiry() << "y";
+    oss << " | Strike: $" << terms.strike
+        << " | Type: " << (terms.optionType == OptionType::Call ? "Call" : "Put")
+        << " | Expiry: " << terms.expiry << "y";
     return oss.str();
 }
 
@@ -52,32 +77,81 @@ Orchestrator::Orchestrator(Config config, std::shared_ptr<OrderBook> orderBook,
       d_orderBook(orderBook),
       d_matcher(matcher),
       d_pricer(pricer),
-      d_broadcaster(broadcaster)
+      d_broadcaster(broadcaster),
+      d_orderProcessQueue(config.queueCapacity()),
+      d_ordersAvailable(config.waitStrategy()),
+      d_spaceAvailable(config.waitStrategy()),
+      d_highWaterMark(config.queueHighWaterMark() > 0 ? config.queueHighWaterMark()
+                                                      : std::numeric_limits<size_t>::max())
+{
+}
+
+Orchestrator::Shard::Shard(size_t capacity, WaitStrategy waitStrategy)
+    : orders(capacity), ordersAvailable(waitStrategy), spaceAvailable(waitStrategy)
 {
 }
 
 const Config& Orchestrator::config() const { return d_config; }
+bool Orchestrator::shardsMatching() const { return d_shardsMatching.load(); }
 const std::shared_ptr<OrderBook>& Orchestrator::orderBook() const { return d_orderBook; }
 const std::shared_ptr<Matcher>& Orchestrator::matcher() const { return d_matcher; }
 const std::shared_ptr<pricing::Pricer>& Orchestrator::pricer() const { return d_pricer; }
 
-std::map<Underlying, std::mutex>& Orchestrator::underlyingMutexes() { return d_underlyingMutexes; }
+std::mutex* Orchestrator::underlyingMutex(const Underlying& underlying)
+{
+    auto id = d_orderBook->instruments().find(underlying);
+    if (!id || *id >= d_underlyingMutexes.size())
+    {
+        return nullptr;
+    }
+    return d_underlyingMutexes[*id].get();
+}
+
+void Orchestrator::addUnderlyingMutex(const Underlying& underlying)
+{
+    const InstrumentId id = d_orderBook->openInstrument(underlying);
+    if (id >= d_underlyingMutexes.size())
+    {
+        d_underlyingMutexes.resize(id + 1);
+    }
+
+    if (!d_underlyingMutexes[id])
+    {
+        d_underlyingMutexes[id] = std::make_unique<std::mutex>();
+    }
+}
+
+std::vector<Underlying> Orchestrator::lockedUnderlyings() const
+{
+    std::vector<Underlying> underlyings;
+    for (InstrumentId id = 0; id < d_underlyingMutexes.size(); id++)
+    {
+        if (d_underlyingMutexes[id])
+        {
+            underlyings.push_back(d_orderBook->instruments().underlying(id));
+        }
+    }
+    return underlyings;
+}
 
-std::queue<OrderPtr>& Orchestrator::orderProcessQueue() { return d_orderProcessQueue; }
+MpmcRing<OrderPtr>& Orchestrator::orderProcessQueue() { return d_orderProcessQueue; }
 
-Resolution<std::vector<OrderPtr>> Orchestrator::generateOrders(int& ordersGenerated)
+Resolution<std::vector<OrderPtr>> Orchestrator::generateOrders(
+    std::span<const Underlying> underlyings, int& ordersGenerated)
 {
-    auto underlying = getUnderlying(config().assetClass());
-    if (!underlying)
+    if (underlyings.empty())
     {
-        return resolution::err(underlying.error());
+        return resolution::err("Underlying pool is empty");
     }
 
+    const Underlying underlying =
+        underlyings[Random::getRandomInt(0, static_cast<int>(underlyings.size()) - 1)];
+
     std::vector<OrderPtr> orders;
 
     if (config().assetClass() == AssetClass::Option)
     {
-        auto option = std::get<Option>(*underlying);
+        auto option = std::get<Option>(underlying);
 
         auto underlyingEquity = extractUnderlyingEquity(option);
         if (!underlyingEquity)
@@ -87,8 +161,8 @@ Resolution<std::vector<OrderPtr>> Orchestrator::generateOrders(int& ordersGenera
 
         Resolution<OrderPtr> equityOrder =
             config().usePricer()
-                ? Order::createWithPricer(pricer(), ordersGenerated, *underlyingEquity)
-                : Order::createWithRandomValues(config(), ordersGenerated, *underlyingEquity);
+                ? Order::createWithPricer(pricer(), d_nextUid++, *underlyingEquity)
+                : Order::createWithRandomValues(config(), d_nextUid++, *underlyingEquity);
 
         if (!equityOrder)
         {
@@ -106,8 +180,8 @@ Resolution<std::vector<OrderPtr>> Orchestrator::generateOrders(int& ordersGenera
         {
             auto optionOrder =
                 config().usePricer()
-                    ? OptionOrder::createWithPricer(pricer(), ordersGenerated, option)
-                    : OptionOrder::createWithRandomValues(config(), ordersGenerated, option);
+                    ? OptionOrder::createWithPricer(pricer(), d_nextUid++, option)
+                    : OptionOrder::createWithRandomValues(config(), d_nextUid++, option);
 
             if (!optionOrder)
             {
@@ -121,8 +195,8 @@ Resolution<std::vector<OrderPtr>> Orchestrator::generateOrders(int& ordersGenera
     else
     {
         auto order = config().usePricer()
-                         ? Order::createWithPricer(pricer(), ordersGenerated, *underlying)
-                         : Order::createWithRandomValues(config(), ordersGenerated, *underlying);
+                         ? Order::createWithPricer(pricer(), d_nextUid++, underlying)
+                         : Order::createWithRandomValues(config(), d_nextUid++, underlying);
 
         if (!order)
         {
@@ -136,280 +210,1591 @@ Resolution<std::vector<OrderPtr>> Orchestrator::generateOrders(int& ordersGenera
     return orders;
 }
 
-bool Orchestrator::processOrder(OrderPtr order)
+bool Orchestrator::executeOrder(const OrderPtr& order)
 {
-    auto mutexIt = underlyingMutexes().find((*order).underlying());
-    if (mutexIt != underlyingMutexes().end())
+    // reused across calls on the same worker so matching doesn't allocate once warmed up
+    thread_local std::vector<Fill> fills;
+
+    fills.clear();
+    auto orderMatched = d_matcher->matchOrder(order, fills);
+
+    // matched before it is added, so only what is left rests and an order filled on arrival never
+    // enters the book. An order that can't rest only ever takes from the opposite side
+    if (order->canRest() && order->outstandingQnty() > 0)
     {
-        std::lock_guard<std::mutex> lock(mutexIt->second);
-        d_orderBook->addOrderToBook(order);
+        // fails only for an underlying never initialised, which the matcher has reported
+        (void)d_orderBook->addOrderToBook(order);
+    }
 
-        auto orderMatched = matcher()->matchOrder(order);
+    // Broadcast book after order is processed
+    if (d_broadcaster.get().has_value())
+    {
+        d_broadcaster.get()->broadcastBook(order->underlying(), d_orderBook);
+    }
 
-        // Broadcast book after order is processed
-        if (d_broadcaster.get().has_value())
-        {
-            d_broadcaster.get()->broadcastBook((*order).underlying(), d_orderBook);
-        }
+    d_pricer->update(order);
 
-        d_pricer->update(order);
+    if (!d_eventLogs.empty())
+    {
+        logExecution(order, fills);
+    }
 
-        if (!orderMatched)
-        {
-            if (config().logLevel() >= LogLevel::DEBUG)
-            {
-                std::lock_guard<std::mutex> outputLock(d_outputMutex);
-                std::cout << "Order: " << order->uid() << " | Asset class: " << order->assetClass()
-                          << " | Matched with: N/A"
-                          << " | Side: " << order->marketSideString()
-                          << " | Ticker: " << to_string((*order).underlying()) << " | Price: $"
-                          << (*order).price() << " | Qnty: " << (*order).qnty()
-                          << " | Remaining Qnty: " << order->outstandingQnty()
-                          << formatOptionDetails(order) << " | Reason: " << orderMatched.error()
-                          << "\n";
-            }
+    if (order->cyclesSubmitted() != 0)
+    {
+        const Cycles cycles = cyclesNow() - order->cyclesSubmitted();
 
-            return false;
-        }
-        else
-        {
-            if (config().logLevel() >= LogLevel::DEBUG)
-            {
-                std::lock_guard<std::mutex> outputLock(d_outputMutex);
-                std::cout << *orderMatched;
-            }
+        ThreadLatency& latency = threadLatency();
+        latency.orders++;
+        latency.totalCycles += cycles;
+        latency.maxCycles = std::max(latency.maxCycles, cycles);
+    }
 
-            return true;
+    if (d_config.logLevel() >= LogLevel::DEBUG)
+    {
+        std::lock_guard<std::mutex> outputLock(d_outputMutex);
+        std::cout << d_matcher->formatFills(order, fills);
+
+        if (!orderMatched)
+        {
+            std::cout << "Order: " << order->uid() << " | Asset class: " << order->assetClass()
+                      << " | Matched with: N/A"
+                      << " | Side: " << order->marketSideString()
+                      << " | Ticker: " << to_string(order->underlying()) << " | Price: $"
+                      << order->price() << " | Qnty: " << order->qnty()
+                      << " | Remaining Qnty: " << order->outstandingQnty()
+                      << formatOptionDetails(order)
+                      << " | Reason: " << orderMatched.error().message() << "\n";
         }
     }
-    else
+
+    return orderMatched.has_value();
+}
+
+bool Orchestrator::processOrder(OrderPtr order)
+{
+    std::mutex* mutex = underlyingMutex(order->underlying());
+    if (!mutex)
     {
         // no mutex for this underlying - proceed without locking
-        d_orderBook->addOrderToBook(order);
+        return executeOrder(order);
+    }
 
-        auto orderMatched = d_matcher->matchOrder(order);
+    std::lock_guard<std::mutex> lock(*mutex);
+    return executeOrder(order);
+}
 
-        // Broadcast book after order is processed
-        if (d_broadcaster.get().has_value())
-        {
-            d_broadcaster.get()->broadcastBook((*order).underlying(), d_orderBook);
-        }
+Resolution<OrderPtr> Orchestrator::cancelOrder(const Underlying& underlying, int uid)
+{
+    if (d_shardsMatching.load())
+    {
+        // shard workers match without the underlying's lock, so the book can't be touched here
+        return resolution::err(
+            std::format("Can't cancel order {} while shards are matching\n", uid));
+    }
+
+    std::mutex* mutex = underlyingMutex(underlying);
+    if (!mutex)
+    {
+        return resolution::err(
+            std::format("No book available for ticker {}\n", to_string(underlying)));
+    }
 
-        pricer()->update(order);
+    std::lock_guard<std::mutex> lock(*mutex);
 
-        if (!orderMatched)
-        {
-            if (d_config.logLevel() >= LogLevel::DEBUG)
-            {
-                std::lock_guard<std::mutex> outputLock(d_outputMutex);
-
-                std::cout << "Order: " << order->uid() << " | Asset class: " << order->assetClass()
-                          << " | Matched with: N/A"
-                          << " | Side: " << order->marketSideString()
-                          << " | Ticker: " << to_string((*order).underlying()) << " | Price: $"
-                          << (*order).price() << " | Qnty: " << (*order).qnty()
-                          << " | Remaining Qnty: " << order->outstandingQnty()
-                          << formatOptionDetails(order) << " | Reason: " << orderMatched.error()
-                          << "\n";
-            }
-            return false;
-        }
-        else
+    auto cancelled = d_orderBook->cancelOrder(underlying, uid);
+    if (cancelled && !d_eventLogs.empty())
+    {
+        BookEvent event = BookEvent::cancelled(**cancelled);
+        logEvents({&event, 1});
+    }
+
+    if (cancelled && d_broadcaster.get().has_value())
+    {
+        d_broadcaster.get()->broadcastBook(underlying, d_orderBook);
+    }
+
+    return cancelled;
+}
+
+Resolution<std::monostate> Orchestrator::startAuction(const Underlying& underlying)
+{
+    if (d_shardsMatching.load())
+    {
+        return resolution::err(
+            std::format("Can't auction {} while shards are matching\n", to_string(underlying)));
+    }
+
+    std::mutex* mutex = underlyingMutex(underlying);
+    if (!mutex)
+    {
+        return resolution::err(
+            std::format("No book available for ticker {}\n", to_string(underlying)));
+    }
+
+    std::lock_guard<std::mutex> lock(*mutex);
+
+    auto started = d_orderBook->startAuction(underlying);
+    if (!started)
+    {
+        return resolution::err(started.error().message());
+    }
+
+    // logged so a book recovered mid call is still in it
+    if (!d_eventLogs.empty())
+    {
+        BookEvent event = BookEvent::auctionStarted(underlying);
+        logEvents({&event, 1});
+    }
+    return std::monostate{};
+}
+
+Resolution<AuctionResult> Orchestrator::uncross(const Underlying& underlying)
+{
+    if (d_shardsMatching.load())
+    {
+        return resolution::err(
+            std::format("Can't uncross {} while shards are matching\n", to_string(underlying)));
+    }
+
+    std::mutex* mutex = underlyingMutex(underlying);
+    if (!mutex)
+    {
+        return resolution::err(
+            std::format("No book available for ticker {}\n", to_string(underlying)));
+    }
+
+    std::lock_guard<std::mutex> lock(*mutex);
+
+    std::vector<Fill> fills;
+    auto uncrossed = d_orderBook->uncross(underlying, fills);
+    if (!uncrossed)
+    {
+        return resolution::err(uncrossed.error().message());
+    }
+
+    // no order was the aggressor, so each fill is logged against its bid, which recovery finds
+    // resting as it was accepted during the call. The uncross follows them, ending the call
+    if (!d_eventLogs.empty())
+    {
+        std::vector<BookEvent> events;
+        events.reserve(fills.size() + 1);
+        for (const Fill& fill : fills)
         {
-            if (d_config.logLevel() >= LogLevel::DEBUG)
-            {
-                std::lock_guard<std::mutex> outputLock(d_outputMutex);
-                std::cout << *orderMatched;
-            }
-            return true;
+            events.push_back(BookEvent::filled(underlying, MarketSide::Bid, fill));
         }
+        events.push_back(BookEvent::uncrossed(underlying));
+        logEvents(events);
+    }
+
+    if (!fills.empty() && d_broadcaster.get().has_value())
+    {
+        d_broadcaster.get()->broadcastBook(underlying, d_orderBook);
     }
+
+    return *uncrossed;
 }
 
-void Orchestrator::pushToQueue(OrderPtr order)
+Resolution<OrderPtr> Orchestrator::cancelOrder(int uid)
 {
+    if (d_shardsMatching.load())
+    {
+        return resolution::err(
+            std::format("Can't cancel order {} while shards are matching\n", uid));
+    }
+
+    // the uid index has its own locks, and the cancel checks again under the underlying's in
+    // case the order traded in between
+    auto underlying = d_orderBook->underlyingOf(uid);
+    if (!underlying)
     {
-        std::lock_guard<std::mutex> lock(d_queueMutex);
-        orderProcessQueue().push(order);
+        return resolution::err(std::format("Order {} is not resting in the book\n", uid));
     }
-    d_queueConditionVar.notify_one();
+
+    return cancelOrder(*underlying, uid);
 }
 
-OrderPtr Orchestrator::popFromQueue()
+void Orchestrator::logExecution(const OrderPtr& order, std::span<const Fill> fills)
 {
-    std::unique_lock<std::mutex> lock(d_queueMutex);
+    thread_local std::vector<BookEvent> events;
 
-    d_queueConditionVar.wait(lock,
-                             [this] { return !orderProcessQueue().empty() || d_done.load(); });
+    events.clear();
+    events.push_back(BookEvent::accepted(*order));
+    for (const Fill& fill : fills)
+    {
+        events.push_back(BookEvent::filled(*order, fill));
+    }
 
-    if (orderProcessQueue().empty())
+    // recovery replays an order through the book, so what one that can't rest left unfilled is
+    // cancelled as it was dropped
+    if (!order->canRest() && order->outstandingQnty() > 0)
     {
-        return nullptr;
+        events.push_back(BookEvent::cancelled(*order));
     }
 
-    OrderPtr order = orderProcessQueue().front();
-    orderProcessQueue().pop();
-    return order;
+    logEvents(events);
 }
 
-void Orchestrator::workerThread(std::atomic<int>& matched, std::atomic<int>& executed)
+void Orchestrator::logEvents(std::span<BookEvent> events)
 {
-    while (true)
+    // taken while the underlying is held exclusively, so its events are numbered in the order
+    // they happened whichever log they land in
+    auto number = [this, events]
     {
-        OrderPtr order = popFromQueue();
-
-        if (!order)
+        const uint64_t first = d_nextSequence.fetch_add(events.size(), std::memory_order_relaxed);
+        for (size_t i = 0; i < events.size(); i++)
         {
-            break;
+            events[i].sequence = first + i;
         }
+    };
+
+    if (EventLogWriter* log = threadEventLog())
+    {
+        number();
+        log->append(events);
+        return;
+    }
+
+    // threads without a log of their own share the first, so they number their events under its
+    // lock too. Otherwise one could append after a later number, and loading stops at the first
+    // sequence that goes backwards
+    std::lock_guard<std::mutex> lock(d_eventLogMutex);
+    number();
+    d_eventLogs.front()->append(events);
+}
+
+EventLogWriter*& Orchestrator::threadEventLog()
+{
+    thread_local EventLogWriter* log = nullptr;
+    return log;
+}
 
-        if (processOrder(order))
+Resolution<std::monostate> Orchestrator::recoverBook()
+{
+    std::vector<EventLog> logs;
+    if (!config().eventLogPath().empty())
+    {
+        auto loaded = EventLog::loadAll(config().eventLogPath());
+        if (!loaded)
         {
-            matched++;
+            return resolution::err(loaded.error());
         }
-        executed++;
+        logs = std::move(*loaded);
+    }
+
+    if (!config().snapshotPath().empty() && std::filesystem::exists(config().snapshotPath()))
+    {
+        return recoverFromSnapshot(logs);
     }
+    return recoverFromLogs(logs);
 }
 
-void Orchestrator::initialiseUnderlyings(AssetClass assetClass)
+Resolution<std::monostate> Orchestrator::recoverFromLogs(std::span<const EventLog> logs)
 {
-    switch (assetClass)
+    struct Accepted
     {
-        case AssetClass::Equity:
-            setUnderlyingsPool(config().underlyingPoolCount(), ALL_EQUITIES);
+        uint64_t sequence;  // copied so sorting doesn't chase event pointers through the logs
+        const BookEvent* event;
+        int outstandingQnty;
+        // kept once cancelled, as its fills may be in a log read after the cancel
+        bool cancelled = false;
+    };
+
+    // uids are only unique within an underlying's book
+    auto keyOf = [](const JournalRecord& order)
+    {
+        return static_cast<uint64_t>(order.assetClass) << 40 |
+               static_cast<uint64_t>(order.underlying) << 32 | static_cast<uint32_t>(order.uid);
+    };
 
-            orderBook()->initialiseBookAtUnderlyings<Equity>();
-            orderBook()->addEquitiesToDataMap();
+    auto error = [](const BookEvent& event, const char* reason)
+    {
+        return resolution::err(
+            std::format("Could not recover the book from its event log: event {} {} (order {})\n",
+                        event.sequence, reason, event.order.uid));
+    };
 
-            for (Equity underlying : underlyingsPool<Equity>())
-            {
-                underlyingMutexes()[underlying];
-            }
+    size_t events = 0;
+    for (const auto& log : logs)
+    {
+        events += log.events().size();
+    }
 
-            break;
-        case AssetClass::Future:
-            setUnderlyingsPool(config().underlyingPoolCount(), ALL_FUTURES);
+    // every node is freed at once when recovery ends, so they come from one arena
+    std::pmr::monotonic_buffer_resource arena;
+    std::pmr::unordered_map<uint64_t, Accepted> accepted(&arena);
+    accepted.reserve(events);
 
-            orderBook()->initialiseBookAtUnderlyings<Future>();
-            orderBook()->addFuturesToDataMap();
+    uint64_t lastSequence = 0;
+    int lastUid = -1;
 
-            for (Future underlying : underlyingsPool<Future>())
+    // the latest auction event of each underlying, which is a start for those still in a call
+    std::pmr::unordered_map<uint64_t, const BookEvent*> auctions(&arena);
+
+    // most orders fill soon after they arrive, so rather than replay every event through the
+    // book, net each order's fills and cancel off first and only add the orders left resting.
+    // That needs no ordering between logs, as long as accepts are seen before anything else: a
+    // cancel only marks its order, so a fill before it that sits in another log still finds it
+    for (const auto& log : logs)
+    {
+        for (const BookEvent& event : log.events())
+        {
+            lastSequence = std::max(lastSequence, event.sequence);
+            d_recoveredEvents++;
+
+            if (event.eventType() != BookEventType::Accept)
             {
-                underlyingMutexes()[underlying];
+                continue;
             }
 
-            break;
-        case AssetClass::Option:
-            setUnderlyingsPool(config().underlyingPoolCount(), ALL_OPTIONS);
-            setUnderlyingsPool(config().underlyingPoolCount(), ALL_EQUITIES);
-
-            orderBook()->initialiseBookAtUnderlyings<Equity>();
-            orderBook()->initialiseBookAtUnderlyings<Option>();
+            if (!accepted.try_emplace(keyOf(event.order), event.sequence, &event, event.order.qnty)
+                     .second)
+            {
+                return error(event, "repeats the accept");
+            }
+            lastUid = std::max(lastUid, event.order.uid);
+        }
+    }
 
-            orderBook()->addEquitiesToDataMap();
-            orderBook()->addOptionsToDataMap();
+    for (const auto& log : logs)
+    {
+        for (const BookEvent& event : log.events())
+        {
+            if (event.eventType() == BookEventType::Accept)
+            {
+                continue;
+            }
 
-            for (Equity underlying : underlyingsPool<Equity>())
+            if (event.eventType() == BookEventType::AuctionStart ||
+                event.eventType() == BookEventType::Uncross)
             {
-                underlyingMutexes()[underlying];
+                const BookEvent*& latest = auctions[keyOf(event.order)];
+                if (!latest || latest->sequence < event.sequence)
+                {
+                    latest = &event;
+                }
+                continue;
             }
-            for (Option underlying : underlyingsPool<Option>())
+
+            auto it = accepted.find(keyOf(event.order));
+            if (it == accepted.end())
             {
-                underlyingMutexes()[underlying];
+                return error(event, "is for an unknown order");
             }
 
-            break;
-        case AssetClass::COUNT:
-            break;
-    }
-}
+            if (event.eventType() == BookEventType::Cancel)
+            {
+                it->second.cancelled = true;
+                continue;
+            }
 
-Resolution<std::pair<int, int>> Orchestrator::produceOrders()
-{
-    d_done.store(false);
+            JournalRecord resting = event.order;
+            resting.uid = event.restingUid;
 
-    std::atomic<int> ordersMatched{0};
-    std::atomic<int> ordersExecuted{0};
+            auto restingIt = accepted.find(keyOf(resting));
+            if (restingIt == accepted.end())
+            {
+                return error(event, "is against an unknown order");
+            }
 
-    const int numThreads = std::thread::hardware_concurrency();
-    std::vector<std::thread> threadPool;
+            for (auto* order : {&it->second, &restingIt->second})
+            {
+                order->outstandingQnty -= event.order.qnty;
+                if (order->outstandingQnty < 0)
+                {
+                    return error(event, "overfills an order");
+                }
+            }
+        }
+    }
 
-    for (int i = 0; i < numThreads; i++)
+    // resting orders go back in the order they arrived, so each keeps its time priority
+    std::vector<Accepted> resting;
+    for (const auto& [key, order] : accepted)
     {
-        threadPool.emplace_back(&Orchestrator::workerThread, this, std::ref(ordersMatched),
-                                std::ref(ordersExecuted));
+        if (!order.cancelled && order.outstandingQnty > 0)
+        {
+            resting.push_back(order);
+        }
     }
+    std::ranges::sort(resting, {}, &Accepted::sequence);
 
-    size_t i = 0;
-    bool infiniteMode = (config().ordersToGenerate() == -1);
-
-    int ordersGenerated = 0;
-    while (infiniteMode || i < static_cast<size_t>(config().ordersToGenerate()))
+    for (const Accepted& accept : resting)
     {
-        auto orders = generateOrders(ordersGenerated);
-        if (!orders)
+        const Underlying underlying = accept.event->order.toUnderlying();
+        if (!underlyingMutex(underlying))
         {
-            d_done.store(true);
-            d_queueConditionVar.notify_all();
-            for (auto& thread : threadPool) thread.join();
-            return resolution::err(orders.error());
+            orderBook()->initialiseUnderlying(underlying);
+            addUnderlyingMutex(underlying);
         }
 
-        for (const auto& order : *orders)
+        auto order = accept.event->order.toOrder();
+        if (!order)
         {
-            pushToQueue(order);
+            return error(*accept.event, order.error().c_str());
         }
 
-        if (!infiniteMode)
+        (*order)->outstandingQnty(accept.outstandingQnty);
+
+        auto added = orderBook()->addOrderToBook(*order);
+        if (!added)
         {
-            i++;
+            return error(*accept.event, added.error().message().c_str());
         }
     }
 
-    d_done.store(true);
-    d_queueConditionVar.notify_all();
-
-    for (auto& worker : threadPool)
+    // started once the orders rest, as adding them never matches anyway
+    for (const auto& [key, event] : auctions)
     {
-        worker.join();
+        if (event->eventType() != BookEventType::AuctionStart)
+        {
+            continue;
+        }
+
+        const Underlying underlying = event->order.toUnderlying();
+        if (!underlyingMutex(underlying))
+        {
+            orderBook()->initialiseUnderlying(underlying);
+            addUnderlyingMutex(underlying);
+        }
+        (void)orderBook()->startAuction(underlying);
     }
 
-    return std::pair{ordersExecuted.load(), ordersMatched.load()};
+    // carry on from the recovered run, so new orders don't reuse the uid of one still resting
+    d_nextSequence.store(lastSequence + 1);
+    d_nextUid.store(lastUid + 1);
+
+    return std::monostate{};
 }
 
-Resolution<std::monostate> Orchestrator::start(std::optional<broadcaster::Broadcaster>& broadcaster)
+Resolution<std::monostate> Orchestrator::recoverFromSnapshot(std::span<const EventLog> logs)
 {
-    auto config = Config::instance();
+    const String& path = config().snapshotPath();
 
-    if (!config)
+    auto snapshot = BookSnapshot::load(path);
+    if (!snapshot)
     {
-        return resolution::err(config.error());
+        return resolution::err(snapshot.error());
     }
 
-    auto orderBook = std::make_shared<OrderBook>();
-    auto matcher = std::make_shared<Matcher>(orderBook);
-    auto pricer = std::make_shared<pricing::Pricer>(orderBook);
+    auto restored = (*snapshot).restore(*orderBook());
+    if (!restored)
+    {
+        return resolution::err(
+            std::format("Could not restore the book from snapshot {}: {}", path, restored.error()));
+    }
+    d_restoredOrders = (*snapshot).orders().size();
 
-    Orchestrator orchestrator{*config, orderBook, matcher, pricer, broadcaster};
+    for (const SnapshotBook& book : (*snapshot).books())
+    {
+        addUnderlyingMutex(book.toUnderlying());
+    }
 
-    orchestrator.initialiseUnderlyings((*config).assetClass());
+    // each book was copied at its own point in the logs, so only its later events are replayed.
+    // Indexed by InstrumentId, empty for underlyings the snapshot holds no book for
+    const InstrumentRegistry& instruments = orderBook()->instruments();
+    std::vector<std::optional<uint64_t>> bookSequences(instruments.size());
+    for (const SnapshotBook& book : (*snapshot).books())
+    {
+        bookSequences[*instruments.find(book.toUnderlying())] = book.sequence;
+    }
 
-    auto start = timeNow();
-    auto result = orchestrator.produceOrders();
-    auto end = timeNow();
+    const BookSnapshotHeader& header = (*snapshot).header();
 
-    if (!result)
+    std::vector<const BookEvent*> tail;
+    for (const auto& log : logs)
     {
-        return resolution::err("An error occured when trying to create orders: " + result.error());
+        // logs are in sequence order, and nothing up to the earliest book's copy is needed
+        auto events = log.events();
+        auto it = std::ranges::partition_point(events, [&header](const BookEvent& event)
+                                               { return event.sequence <= header.sequence; });
+
+        for (; it != events.end(); ++it)
+        {
+            auto id = instruments.find(it->order.toUnderlying());
+            if (!id || !bookSequences[*id] || it->sequence > *bookSequences[*id])
+            {
+                tail.push_back(&*it);
+            }
+        }
     }
 
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+    std::ranges::sort(tail, {}, [](const BookEvent* event) { return event->sequence; });
+
+    uint64_t lastSequence = header.lastSequence;
+    int64_t lastUid = header.lastUid;
 
-    if ((*config).logLevel() >= LogLevel::INFO)
+    for (const BookEvent* event : tail)
     {
-        std::cout << "\nSUMMARY:"
-                  << "\nOrders executed: " << (*result).first
-                  << "\nOrders matched: " << (*result).second << "\nTime taken: " << duration;
+        const Underlying underlying = event->order.toUnderlying();
+        if (!underlyingMutex(underlying))
+        {
+            orderBook()->initialiseUnderlying(underlying);
+            addUnderlyingMutex(underlying);
+        }
+
+        auto applied = orderBook()->applyEvent(*event);
+        if (!applied)
+        {
+            return resolution::err(std::format(
+                "Could not replay the event log after snapshot {}: {}", path, applied.error()));
+        }
+
+        lastSequence = std::max(lastSequence, event->sequence);
+        if (event->eventType() == BookEventType::Accept)
+        {
+            lastUid = std::max<int64_t>(lastUid, event->order.uid);
+        }
+        d_recoveredEvents++;
+    }
+
+    d_nextSequence.store(lastSequence + 1);
+    d_nextUid.store(static_cast<int>(lastUid + 1));
+
+    return std::monostate{};
+}
+
+Resolution<std::monostate> Orchestrator::takeSnapshot()
+{
+    std::lock_guard<std::mutex> inProgress(d_snapshotInProgress);
+
+    BookSnapshotWriter writer;
+    // books this thread copies itself, under their underlying's lock
+    std::vector<Underlying> unowned;
+
+    {
+        std::unique_lock<std::mutex> lock(d_snapshotMutex);
+
+        if (d_shardsMatching.load())
+        {
+            d_snapshotWriter = &writer;
+
+            for (auto& shard : d_shards)
+            {
+                // a worker that has stopped can't be asked, but no longer touches its books
+                if (shard->stopped)
+                {
+                    unowned.insert(unowned.end(), shard->underlyings.begin(),
+                                   shard->underlyings.end());
+                    continue;
+                }
+
+                d_shardSnapshotsPending++;
+                shard->snapshotRequested.store(true, std::memory_order_release);
+                shard->ordersAvailable.notifyAll();
+            }
+
+            d_shardSnapshotCopied.wait(lock, [this] { return d_shardSnapshotsPending == 0; });
+            d_snapshotWriter = nullptr;
+        }
+        else
+        {
+            unowned = lockedUnderlyings();
+        }
+    }
+
+    for (const Underlying& underlying : unowned)
+    {
+        std::lock_guard<std::mutex> lock(*underlyingMutex(underlying));
+
+        // the underlying's events are numbered under its lock, so every one logged so far is
+        // below the next sequence and every one still to come above it
+        writer.addBook(*d_orderBook, underlying, d_nextSequence.load() - 1);
+    }
+
+    writer.addPriceData(*d_orderBook);
+
+    auto written = writer.write(config().snapshotPath(), d_nextUid.load() - 1);
+    if (written)
+    {
+        d_snapshotsTaken++;
+    }
+    return written;
+}
+
+bool Orchestrator::copyShardSnapshot(Shard& shard)
+{
+    if (!shard.snapshotRequested.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    // only this worker numbers events for its underlyings, so the next sequence bounds them all
+    for (const Underlying& underlying : shard.underlyings)
+    {
+        d_snapshotWriter->addBook(*d_orderBook, underlying, d_nextSequence.load() - 1);
+    }
+
+    std::lock_guard<std::mutex> lock(d_snapshotMutex);
+    shard.snapshotRequested.store(false, std::memory_order_relaxed);
+    if (--d_shardSnapshotsPending == 0)
+    {
+        d_shardSnapshotCopied.notify_all();
+    }
+    return true;
+}
+
+void Orchestrator::snapshotPeriodically()
+{
+    const auto interval = std::chrono::milliseconds(config().snapshotInterval());
+
+    std::unique_lock<std::mutex> lock(d_reportMutex);
+    while (!d_reportConditionVar.wait_for(lock, interval, [this] { return d_done.load(); }))
+    {
+        lock.unlock();
+        auto taken = takeSnapshot();
+        lock.lock();
+
+        if (!taken && d_periodicSnapshot)
+        {
+            d_periodicSnapshot = taken;
+        }
+    }
+}
+
+Resolution<std::monostate> Orchestrator::openEventLogs(size_t matchingThreads)
+{
+    for (size_t i = 0; i <= matchingThreads; i++)
+    {
+        auto log = EventLogWriter::open(eventLogPath(config().eventLogPath(), i),
+                                        config().eventLogFlushInterval());
+        if (!log)
+        {
+            d_eventLogs.clear();
+            return resolution::err(log.error());
+        }
+        d_eventLogs.push_back(std::move(*log));
+    }
+
+    return std::monostate{};
+}
+
+Resolution<std::monostate> Orchestrator::closeEventLogs()
+{
+    Resolution<std::monostate> result = std::monostate{};
+
+    for (auto& log : d_eventLogs)
+    {
+        auto closed = log->close();
+        if (!closed && result)
+        {
+            result = closed;
+        }
+    }
+
+    d_eventLogs.clear();
+    return result;
+}
+
+template <typename Ring>
+bool Orchestrator::enqueue(Ring& ring, RingWaiter& spaceAvailable, RingWaiter& ordersAvailable,
+                           OrderPtr order)
+{
+    // tryPush only moves from order once it succeeds, so retrying is safe
+    auto admit = [&] { return ring.size() < d_highWaterMark && ring.tryPush(std::move(order)); };
+
+    if (!admit())
+    {
+        if (config().backpressurePolicy() == BackpressurePolicy::Shed)
+        {
+            d_ingressStats.shed.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        const auto blockedFrom = std::chrono::steady_clock::now();
+        spaceAvailable.waitUntil(admit);
+
+        const auto blockedFor = std::chrono::steady_clock::now() - blockedFrom;
+        d_ingressStats.blockedNanos.fetch_add(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(blockedFor).count(),
+            std::memory_order_relaxed);
+    }
+
+    ordersAvailable.notify();
+    d_ingressStats.queued.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool Orchestrator::submitOrder(OrderPtr order)
+{
+    if (config().measureLatency())
+    {
+        order->cyclesSubmitted(cyclesNow());
+    }
+
+    if (!config().shardedMatching())
+    {
+        return enqueue(orderProcessQueue(), d_spaceAvailable, d_ordersAvailable, std::move(order));
+    }
+
+    if (d_shards.empty())
+    {
+        assignShards(workerCount());
+    }
+
+    Shard& shard = *d_shards[shardOf(order->underlying())];
+
+    return enqueue(shard.orders, shard.spaceAvailable, shard.ordersAvailable, std::move(order));
+}
+
+size_t Orchestrator::queueDepth() const
+{
+    size_t depth = d_orderProcessQueue.size();
+    for (const auto& shard : d_shards)
+    {
+        depth += shard->orders.size();
+    }
+    return depth;
+}
+
+const IngressStats& Orchestrator::ingressStats() const { return d_ingressStats; }
+
+const LatencyStats& Orchestrator::latencyStats() const { return d_latencyStats; }
+
+Orchestrator::ThreadLatency& Orchestrator::threadLatency()
+{
+    thread_local ThreadLatency latency;
+    return latency;
+}
+
+void Orchestrator::flushLatency()
+{
+    ThreadLatency& latency = threadLatency();
+    if (latency.orders == 0)
+    {
+        return;
+    }
+
+    d_latencyStats.orders.fetch_add(latency.orders, std::memory_order_relaxed);
+    d_latencyStats.totalCycles.fetch_add(latency.totalCycles, std::memory_order_relaxed);
+
+    uint64_t max = d_latencyStats.maxCycles.load(std::memory_order_relaxed);
+    while (latency.maxCycles > max &&
+           !d_latencyStats.maxCycles.compare_exchange_weak(max, latency.maxCycles,
+                                                           std::memory_order_relaxed))
+    {
+    }
+
+    latency = ThreadLatency{};
+}
+
+void Orchestrator::printLatency(std::ostream& os) const
+{
+    const uint64_t orders = d_latencyStats.orders.load();
+    const double nanos = nanosPerCycle();
+
+    const double mean =
+        orders == 0 ? 0.0 : static_cast<double>(d_latencyStats.totalCycles.load()) / orders;
+
+    os << "Orders timed: " << orders << " | Mean: " << static_cast<uint64_t>(mean * nanos)
+       << "ns | Max: " << static_cast<uint64_t>(d_latencyStats.maxCycles.load() * nanos) << "ns";
+}
+
+void Orchestrator::printBookMemory(std::ostream& os) const
+{
+    const auto instruments = d_orderBook->instruments().instruments();
+
+    auto print = [&os](const BookMemory& memory)
+    {
+        os << memory.bytes / 1024 << " KB | Levels: " << memory.levels
+           << " | Spare levels: " << memory.spareLevels << " | Order nodes: " << memory.nodes;
+    };
+
+    BookMemory total;
+    for (const Underlying& underlying : instruments)
+    {
+        total += d_orderBook->bookMemory(underlying);
+    }
+
+    os << instruments.size() << " books | ";
+    print(total);
+
+    if (config().logLevel() < LogLevel::DEBUG)
+    {
+        return;
+    }
+
+    for (const Underlying& underlying : instruments)
+    {
+        os << "\n  " << to_string(underlying) << ": ";
+        print(d_orderBook->bookMemory(underlying));
+    }
+}
+
+size_t Orchestrator::popFromQueue(std::span<OrderPtr> batch)
+{
+    size_t count = 0;
+
+    d_ordersAvailable.waitUntil(
+        [&]
+        {
+            count = orderProcessQueue().popBatch(batch.data(), batch.size());
+            if (count > 0 || !d_done.load())
+            {
+                return count > 0;
+            }
+
+            // orders pushed before d_done was set may have landed since the pop above
+            count = orderProcessQueue().popBatch(batch.data(), batch.size());
+            return true;
+        });
+
+    if (count > 0)
+    {
+        d_spaceAvailable.notify();
+    }
+    return count;
+}
+
+void Orchestrator::workerThread(std::atomic<int>& matched, std::atomic<int>& executed)
+{
+    std::array<OrderPtr, ORDER_BATCH_SIZE> batch;
+
+    while (size_t count = popFromQueue(batch))
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            if (processOrder(batch[i]))
+            {
+                matched++;
+            }
+            executed++;
+
+            batch[i].reset();
+        }
+    }
+
+    flushLatency();
+}
+
+size_t Orchestrator::workerCount() const
+{
+    if (config().matchingThreads() > 0)
+    {
+        return config().matchingThreads();
+    }
+
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+size_t Orchestrator::shardCount(size_t workerCount) const
+{
+    return std::max<size_t>(1, std::min(workerCount, lockedUnderlyings().size()));
+}
+
+void Orchestrator::assignShards(size_t workerCount)
+{
+    const size_t shards = shardCount(workerCount);
+
+    const InstrumentRegistry& instruments = d_orderBook->instruments();
+
+    d_shards.clear();
+    d_shardOfInstrument.assign(instruments.size(), 0);
+
+    for (size_t i = 0; i < shards; i++)
+    {
+        d_shards.push_back(
+            std::make_unique<Shard>(config().queueCapacity(), config().waitStrategy()));
+    }
+
+    // indexed by the id of the underlying that decides the shard
+    std::vector<std::optional<size_t>> ownerShard(instruments.size());
+
+    size_t next = 0;
+    for (InstrumentId id = 0; id < d_underlyingMutexes.size(); id++)
+    {
+        if (!d_underlyingMutexes[id])
+        {
+            continue;
+        }
+
+        // options share a shard with their underlying equity, so a generator pricing an option
+        // feeds the same queue with both the option and equity orders it produces
+        const Underlying& underlying = instruments.underlying(id);
+        InstrumentId owner = id;
+        if (const auto* option = std::get_if<Option>(&underlying))
+        {
+            if (auto equity = extractUnderlyingEquity(*option))
+            {
+                owner = instruments.find(*equity).value_or(id);
+            }
+        }
+
+        if (!ownerShard[owner])
+        {
+            ownerShard[owner] = next;
+            next = (next + 1) % shards;
+        }
+        d_shardOfInstrument[id] = *ownerShard[owner];
+        d_shards[*ownerShard[owner]]->underlyings.push_back(underlying);
+    }
+}
+
+size_t Orchestrator::shardOf(const Underlying& underlying) const
+{
+    auto id = d_orderBook->instruments().find(underlying);
+    if (!id || *id >= d_shardOfInstrument.size())
+    {
+        return 0;
+    }
+    return d_shardOfInstrument[*id];
+}
+
+size_t Orchestrator::popFromShard(Shard& shard, std::span<OrderPtr> batch)
+{
+    size_t count = 0;
+
+    shard.ordersAvailable.waitUntil(
+        [&]
+        {
+            count = shard.orders.popBatch(batch.data(), batch.size());
+            if (count > 0 || shard.snapshotRequested.load(std::memory_order_relaxed))
+            {
+                return true;
+            }
+            if (!d_done.load())
+            {
+                return false;
+            }
+
+            count = shard.orders.popBatch(batch.data(), batch.size());
+            return true;
+        });
+
+    if (count > 0)
+    {
+        shard.spaceAvailable.notify();
+    }
+    return count;
+}
+
+void Orchestrator::shardWorker(Shard& shard, std::atomic<int>& matched,
+                               std::atomic<int>& executed)
+{
+    std::array<OrderPtr, ORDER_BATCH_SIZE> batch;
+
+    // counted locally so shards don't contend on the shared totals for every order
+    int shardMatched = 0;
+    int shardExecuted = 0;
+
+    while (true)
+    {
+        const size_t count = popFromShard(shard, batch);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            // this worker is the only one that ever sees orders for its underlyings, so the book
+            // can be matched without taking the underlying's lock
+            if (executeOrder(batch[i]))
+            {
+                shardMatched++;
+            }
+            shardExecuted++;
+
+            batch[i].reset();
+        }
+
+        // between batches the shard's books are at rest, so this is where snapshots copy them.
+        // Nothing popped and no snapshot asked for means work has finished
+        const bool copied = copyShardSnapshot(shard);
+        if (count == 0 && !copied)
+        {
+            break;
+        }
+    }
+
+    bool requested = false;
+    {
+        std::lock_guard<std::mutex> lock(d_snapshotMutex);
+        shard.stopped = true;
+        requested = shard.snapshotRequested.load(std::memory_order_relaxed);
+    }
+
+    // a snapshot asked for as the run ended is still owed this shard's books
+    if (requested)
+    {
+        copyShardSnapshot(shard);
+    }
+
+    flushLatency();
+
+    matched += shardMatched;
+    executed += shardExecuted;
+}
+
+size_t Orchestrator::generatorCount() const
+{
+    if (config().generatorThreads() > 0)
+    {
+        return config().generatorThreads();
+    }
+
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+void Orchestrator::assignGenerators(size_t generatorCount)
+{
+    std::vector<Underlying> underlyings;
+    auto addPool = [&underlyings](const auto& pool)
+    { underlyings.insert(underlyings.end(), pool.begin(), pool.end()); };
+
+    switch (config().assetClass())
+    {
+        case AssetClass::Equity:
+            addPool(underlyingsPool<Equity>());
+            break;
+        case AssetClass::Future:
+            addPool(underlyingsPool<Future>());
+            break;
+        case AssetClass::Option:
+            addPool(underlyingsPool<Option>());
+            break;
+        case AssetClass::COUNT:
+            break;
+    }
+
+    const bool sharded = config().shardedMatching();
+
+    // a generator without an underlying, or without a shard to itself, would have nothing to do
+    const size_t count = std::max<size_t>(
+        1, std::min(generatorCount, sharded ? d_shards.size() : underlyings.size()));
+
+    d_generatorUnderlyings.assign(count, {});
+
+    for (size_t i = 0; i < underlyings.size(); i++)
+    {
+        size_t generator = i % count;
+        if (sharded)
+        {
+            generator = shardOf(underlyings[i]) % count;
+        }
+
+        d_generatorUnderlyings[generator].push_back(underlyings[i]);
+    }
+
+    // shards owning none of the generated asset class leave their generator without underlyings
+    std::erase_if(d_generatorUnderlyings, [](const auto& partition) { return partition.empty(); });
+
+    if (d_generatorUnderlyings.empty())
+    {
+        // still run one generator, so an empty pool is reported as an error
+        d_generatorUnderlyings.emplace_back();
+    }
+}
+
+Resolution<std::monostate> Orchestrator::generatorThread(std::span<const Underlying> underlyings,
+                                                         int iterations)
+{
+    int ordersGenerated = 0;
+
+    for (int i = 0; iterations == -1 || i < iterations; i++)
+    {
+        if (d_generationFailed.load(std::memory_order_relaxed))
+        {
+            break;
+        }
+
+        auto orders = generateOrders(underlyings, ordersGenerated);
+        if (!orders)
+        {
+            // stop the other generators rather than leave them feeding workers about to exit
+            d_generationFailed.store(true, std::memory_order_relaxed);
+            return resolution::err(orders.error());
+        }
+
+        if (d_journal)
+        {
+            d_journal->append(*orders);
+        }
+
+        for (auto& order : *orders)
+        {
+            submitOrder(std::move(order));
+        }
+    }
+
+    return std::monostate{};
+}
+
+void Orchestrator::stopWorkers()
+{
+    {
+        // set under the lock so the reporter can't miss the wakeup between checking and waiting
+        std::lock_guard<std::mutex> lock(d_reportMutex);
+        d_done.store(true);
+    }
+    d_reportConditionVar.notify_all();
+
+    d_ordersAvailable.notifyAll();
+
+    for (auto& shard : d_shards)
+    {
+        shard->ordersAvailable.notifyAll();
+    }
+}
+
+void Orchestrator::stopWorkers(std::vector<std::thread>& threads)
+{
+    stopWorkers();
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    d_shardsMatching.store(false);
+}
+
+void Orchestrator::printIngress(std::ostream& os) const
+{
+    const auto blocked = std::chrono::nanoseconds(d_ingressStats.blockedNanos.load());
+
+    os << "Queue depth: " << queueDepth() << " | Orders queued: " << d_ingressStats.queued.load()
+       << " | Orders shed: " << d_ingressStats.shed.load() << " | Time blocked: "
+       << std::chrono::duration_cast<std::chrono::milliseconds>(blocked);
+}
+
+void Orchestrator::reportIngress()
+{
+    const auto interval = std::chrono::milliseconds(config().statsInterval());
+
+    std::unique_lock<std::mutex> lock(d_reportMutex);
+    while (!d_reportConditionVar.wait_for(lock, interval, [this] { return d_done.load(); }))
+    {
+        std::lock_guard<std::mutex> outputLock(d_outputMutex);
+        std::cout << "[INGRESS] ";
+        printIngress(std::cout);
+        std::cout << "\n";
+    }
+}
+
+void Orchestrator::initialiseUnderlyings(const OrderJournal& journal)
+{
+    for (const auto& record : journal.records)
+    {
+        const Underlying underlying = record.toUnderlying();
+        if (underlyingMutex(underlying))
+        {
+            continue;
+        }
+
+        orderBook()->initialiseUnderlying(underlying);
+        addUnderlyingMutex(underlying);
+    }
+}
+
+void Orchestrator::addOptionUnderlyingsToPool()
+{
+    // options are priced off their underlying equity, so each one's must be priced too, even where
+    // a large universe didn't draw it into the equity pool
+    std::vector<Equity> equities = underlyingsPool<Equity>();
+    for (Option option : underlyingsPool<Option>())
+    {
+        auto equity = extractUnderlyingEquity(option);
+        if (equity && std::ranges::find(equities, *equity) == equities.end())
+        {
+            equities.push_back(*equity);
+        }
+    }
+
+    setUnderlyingsPoolInitialised<Equity>(false);
+    setUnderlyingsPool(-1, std::span<const Equity>(equities));
+}
+
+void Orchestrator::initialiseUnderlyings(AssetClass assetClass)
+{
+    switch (assetClass)
+    {
+        case AssetClass::Equity:
+            setUnderlyingsPool<Equity>(config().underlyingPoolCount());
+
+            orderBook()->initialiseBookAtUnderlyings<Equity>();
+            orderBook()->addEquitiesToDataMap();
+
+            for (Equity underlying : underlyingsPool<Equity>())
+            {
+                addUnderlyingMutex(underlying);
+            }
+
+            break;
+        case AssetClass::Future:
+            setUnderlyingsPool<Future>(config().underlyingPoolCount());
+
+            orderBook()->initialiseBookAtUnderlyings<Future>();
+            orderBook()->addFuturesToDataMap();
+
+            for (Future underlying : underlyingsPool<Future>())
+            {
+                addUnderlyingMutex(underlying);
+            }
+
+            break;
+        case AssetClass::Option:
+            setUnderlyingsPool<Option>(config().underlyingPoolCount());
+            setUnderlyingsPool<Equity>(config().underlyingPoolCount());
+            addOptionUnderlyingsToPool();
+
+            orderBook()->initialiseBookAtUnderlyings<Equity>();
+            orderBook()->initialiseBookAtUnderlyings<Option>();
+
+            orderBook()->addEquitiesToDataMap();
+            orderBook()->addOptionsToDataMap();
+
+            for (Equity underlying : underlyingsPool<Equity>())
+            {
+                addUnderlyingMutex(underlying);
+            }
+            for (Option underlying : underlyingsPool<Option>())
+            {
+                addUnderlyingMutex(underlying);
+            }
+
+            break;
+        case AssetClass::COUNT:
+            break;
+    }
+}
+
+std::vector<std::thread> Orchestrator::startWorkers(std::atomic<int>& matched,
+                                                    std::atomic<int>& executed)
+{
+    d_done.store(false);
+
+    std::vector<std::thread> threads;
+
+    if (config().shardedMatching())
+    {
+        assignShards(workerCount());
+        d_shardsMatching.store(true);
+
+        for (size_t i = 0; i < d_shards.size(); i++)
+        {
+            threads.emplace_back(
+                [this, i, &matched, &executed]
+                {
+                    RandomStream::bind(WORKER_STREAM_BASE + i);
+                    threadEventLog() = i + 1 < d_eventLogs.size() ? d_eventLogs[i + 1].get()
+                                                                   : nullptr;
+                    shardWorker(*d_shards[i], matched, executed);
+                    threadEventLog() = nullptr;
+                });
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < workerCount(); i++)
+        {
+            threads.emplace_back(
+                [this, i, &matched, &executed]
+                {
+                    RandomStream::bind(WORKER_STREAM_BASE + i);
+                    threadEventLog() = i + 1 < d_eventLogs.size() ? d_eventLogs[i + 1].get()
+                                                                   : nullptr;
+                    workerThread(matched, executed);
+                    threadEventLog() = nullptr;
+                });
+        }
+    }
+
+    if (config().statsInterval() > 0 && config().logLevel() >= LogLevel::INFO)
+    {
+        threads.emplace_back(&Orchestrator::reportIngress, this);
+    }
+
+    if (!config().snapshotPath().empty() && config().snapshotInterval() > 0)
+    {
+        threads.emplace_back(&Orchestrator::snapshotPeriodically, this);
+    }
+
+    return threads;
+}
+
+Resolution<std::pair<int, int>> Orchestrator::produceOrders()
+{
+    if (!config().journalPath().empty())
+    {
+        auto journal = OrderJournalWriter::open(config().journalPath(), RandomStream::masterSeed());
+        if (!journal)
+        {
+            return resolution::err(journal.error());
+        }
+        d_journal = std::move(*journal);
+    }
+
+    std::atomic<int> ordersMatched{0};
+    std::atomic<int> ordersExecuted{0};
+
+    auto threadPool = startWorkers(ordersMatched, ordersExecuted);
+    d_generationFailed.store(false);
+    assignGenerators(generatorCount());
+
+    const int ordersToGenerate = config().ordersToGenerate();
+    const int generators = static_cast<int>(d_generatorUnderlyings.size());
+
+    std::vector<Resolution<std::monostate>> generated(generators, std::monostate{});
+    std::vector<std::thread> generatorPool;
+
+    for (int g = 0; g < generators; g++)
+    {
+        // split the orders evenly, with the first generators taking any remainder
+        const int iterations = ordersToGenerate == -1
+                                   ? -1
+                                   : ordersToGenerate / generators +
+                                         (g < ordersToGenerate % generators ? 1 : 0);
+
+        generatorPool.emplace_back(
+            [this, &generated, g, iterations]
+            {
+                RandomStream::bind(GENERATOR_STREAM_BASE + g);
+                generated[g] = generatorThread(d_generatorUnderlyings[g], iterations);
+            });
+    }
+
+    for (auto& generator : generatorPool)
+    {
+        generator.join();
+    }
+
+    stopWorkers(threadPool);
+
+    for (const auto& result : generated)
+    {
+        if (!result)
+        {
+            return resolution::err(result.error());
+        }
+    }
+
+    if (d_journal)
+    {
+        auto flushed = d_journal->flush();
+        d_journal.reset();
+
+        if (!flushed)
+        {
+            return resolution::err(flushed.error());
+        }
+    }
+
+    return std::pair{ordersExecuted.load(), ordersMatched.load()};
+}
+
+Resolution<std::pair<int, int>> Orchestrator::replayOrders(const OrderJournal& journal)
+{
+    if (!config().shardedMatching())
+    {
+        // one thread, so every run matches the orders in exactly the recorded order
+        int matched = 0;
+        for (const auto& record : journal.records)
+        {
+            auto order = record.toOrder();
+            if (!order)
+            {
+                return resolution::err(order.error());
+            }
+
+            if (executeOrder(*order))
+            {
+                matched++;
+            }
+        }
+
+        return std::pair{static_cast<int>(journal.records.size()), matched};
+    }
+
+    std::atomic<int> ordersMatched{0};
+    std::atomic<int> ordersExecuted{0};
+
+    auto threadPool = startWorkers(ordersMatched, ordersExecuted);
+
+    // a single feeding thread keeps each shard's orders in recorded order
+    for (const auto& record : journal.records)
+    {
+        auto order = record.toOrder();
+        if (!order)
+        {
+            stopWorkers(threadPool);
+            return resolution::err(order.error());
+        }
+
+        submitOrder(std::move(*order));
+    }
+
+    stopWorkers(threadPool);
+
+    return std::pair{ordersExecuted.load(), ordersMatched.load()};
+}
+
+Resolution<std::monostate> Orchestrator::start(std::optional<broadcaster::Broadcaster>& broadcaster)
+{
+    auto config = Config::instance();
+
+    if (!config)
+    {
+        return resolution::err(config.error());
+    }
+
+    return start(*config, broadcaster);
+}
+
+Resolution<std::monostate> Orchestrator::start(const Config& config,
+                                               std::optional<broadcaster::Broadcaster>& broadcaster)
+{
+    OrderPool::enabled(config.usePooledOrders());
+
+    // before anything reads instruments back, as a journal or log may be of loaded ones
+    if (!config.instrumentsPath().empty())
+    {
+        auto loaded = loadInstruments(config.instrumentsPath());
+        if (!loaded)
+        {
+            return resolution::err(loaded.error());
+        }
+    }
+
+    std::optional<OrderJournal> replay;
+    if (!config.replayPath().empty())
+    {
+        auto journal = OrderJournal::load(config.replayPath());
+        if (!journal)
+        {
+            return resolution::err(journal.error());
+        }
+        replay = std::move(*journal);
+    }
+
+    // a replay reuses the recorded run's seed, so the pricer's updates draw the same values too
+    const uint64_t seed = replay ? replay->header.randomSeed : config.randomSeed();
+    RandomStream::seed(seed != 0 ? seed : std::random_device{}());
+    RandomStream::bind(0);
+
+    auto orderBook = std::make_shared<OrderBook>(config.bookBackend());
+    auto matcher = std::make_shared<Matcher>(orderBook);
+    auto pricer = std::make_shared<pricing::Pricer>(orderBook);
+
+    // shedding would drop recorded orders, so a replay always waits for queue space
+    Config runConfig = config;
+    if (replay)
+    {
+        runConfig.backpressurePolicy(BackpressurePolicy::Block);
+    }
+
+    Orchestrator orchestrator{runConfig, orderBook, matcher, pricer, broadcaster};
+
+    if (replay)
+    {
+        orchestrator.initialiseUnderlyings(*replay);
+    }
+    else
+    {
+        orchestrator.initialiseUnderlyings(config.assetClass());
+    }
+
+    // a non-sharded replay matches on the calling thread
+    const size_t matchingThreads = config.shardedMatching()
+                                       ? orchestrator.shardCount(orchestrator.workerCount())
+                                   : replay ? 0
+                                            : orchestrator.workerCount();
+
+    if (!config.eventLogPath().empty() || !config.snapshotPath().empty())
+    {
+        const auto recoveryStart = timeNow();
+        auto recovered = orchestrator.recoverBook();
+        orchestrator.d_recoveryTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+            timeNow() - recoveryStart);
+
+        if (!recovered)
+        {
+            return resolution::err(recovered.error());
+        }
+    }
+
+    if (!config.eventLogPath().empty())
+    {
+        auto opened = orchestrator.openEventLogs(matchingThreads);
+        if (!opened)
+        {
+            return resolution::err(opened.error());
+        }
+    }
+
+    auto start = timeNow();
+    auto result = replay ? orchestrator.replayOrders(*replay) : orchestrator.produceOrders();
+    auto end = timeNow();
+
+    auto logsClosed = orchestrator.closeEventLogs();
+
+    if (!result)
+    {
+        return resolution::err("An error occured when trying to create orders: " + result.error());
+    }
+
+    if (!logsClosed)
+    {
+        return resolution::err(logsClosed.error());
+    }
+
+    if (!config.snapshotPath().empty())
+    {
+        if (!orchestrator.d_periodicSnapshot)
+        {
+            return resolution::err(orchestrator.d_periodicSnapshot.error());
+        }
+
+        // every worker has stopped, so this one copies each book at the end of the run
+        auto snapshotted = orchestrator.takeSnapshot();
+        if (!snapshotted)
+        {
+            return resolution::err(snapshotted.error());
+        }
+    }
+
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+
+    if (config.logLevel() >= LogLevel::INFO)
+    {
+        std::cout << "\nSUMMARY:"
+                  << "\nBook backend: " << config.bookBackend()
+                  << "\nPooled orders: " << std::boolalpha << config.usePooledOrders()
+                  << "\nSharded matching: " << config.shardedMatching()
+                  << "\nWait strategy: " << config.waitStrategy()
+                  << "\nMatching threads: " << std::max<size_t>(1, matchingThreads)
+                  << "\nGenerator threads: " << orchestrator.d_generatorUnderlyings.size()
+                  << "\nOrder source: " << (replay ? config.replayPath() : "generated")
+                  << "\nEvent log: "
+                  << (config.eventLogPath().empty() ? "disabled" : config.eventLogPath());
+
+        if (!config.eventLogPath().empty())
+        {
+            std::cout << " | Recovered events: " << orchestrator.d_recoveredEvents;
+        }
+
+        std::cout << "\nSnapshot: "
+                  << (config.snapshotPath().empty() ? "disabled" : config.snapshotPath());
+
+        if (!config.snapshotPath().empty())
+        {
+            std::cout << " | Restored orders: " << orchestrator.d_restoredOrders
+                      << " | Snapshots taken: " << orchestrator.d_snapshotsTaken;
+        }
+
+        if (!config.eventLogPath().empty() || !config.snapshotPath().empty())
+        {
+            std::cout << "\nRecovery time: " << orchestrator.d_recoveryTime;
+        }
+
+        std::cout << "\nOrders executed: " << (*result).first
+                  << "\nOrders matched: " << (*result).second << "\nTime taken: " << duration
+                  << "\nIngress: ";
+        orchestrator.printIngress(std::cout);
+
+        std::cout << "\nBook memory: ";
+        orchestrator.printBookMemory(std::cout);
+
+        if (config.measureLatency())
+        {
+            std::cout << "\nLatency: ";
+            orchestrator.printLatency(std::cout);
+        }
     }
 
     return std::monostate{};
@@ -1,52 +1,233 @@
 #ifndef ORCHESTRATOR_H
 #define ORCHESTRATOR_H
 
+#include <book_snapshot.h>
 #include <broadcaster.h>
 #include <config.h>
+#include <event_log.h>
+#include <fill.h>
 #include <matcher.h>
+#include <mpmc_ring.h>
 #include <order.h>
 #include <order_book.h>
+#include <order_journal.h>
 #include <pricer.h>
+#include <ring_waiter.h>
+#include <spsc_ring.h>
 #include <types.h>
+#include <wait_strategy.h>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <optional>
-#include <queue>
+#include <ostream>
+#include <span>
+#include <thread>
+#include <vector>
 
 namespace solstice::matching
 {
 
+// counts kept by the producer as it hands orders to the workers
+struct IngressStats
+{
+    std::atomic<uint64_t> queued{0};
+    std::atomic<uint64_t> shed{0};
+    std::atomic<uint64_t> blockedNanos{0};
+};
+
+// time from submitOrder until the order has been matched, in cycles of cyclesNow. Each matching
+// thread keeps its own and adds them in when it finishes
+struct LatencyStats
+{
+    std::atomic<uint64_t> orders{0};
+    std::atomic<uint64_t> totalCycles{0};
+    std::atomic<uint64_t> maxCycles{0};
+};
+
 class Orchestrator
 {
    public:
     static Resolution<std::monostate> start(std::optional<broadcaster::Broadcaster>& broadcaster);
+    static Resolution<std::monostate> start(const Config& config,
+                                            std::optional<broadcaster::Broadcaster>& broadcaster);
 
     Orchestrator(Config config, std::shared_ptr<OrderBook> orderBook,
                  std::shared_ptr<Matcher> matcher, std::shared_ptr<pricing::Pricer> pricer,
                  std::optional<broadcaster::Broadcaster>& broadcaster);
 
+    // this takes the underlying's lock, so must not be called while a sharded run is in progress
+    // as shard workers match their underlyings without it
     bool processOrder(OrderPtr order);
 
+    // fail while shards are matching, as the owning worker could be matching the same book
+    Resolution<OrderPtr> cancelOrder(int uid);
+    Resolution<OrderPtr> cancelOrder(const Underlying& underlying, int uid);
+
+    // starts a call auction on the underlying: orders that arrive rest without matching, and
+    // orders that can't rest are dropped, until it uncrosses. Fails while shards are matching
+    Resolution<std::monostate> startAuction(const Underlying& underlying);
+    // ends the call, trading every crossed order at the single price that executes the most and
+    // logging each fill. Fails while shards are matching
+    Resolution<AuctionResult> uncross(const Underlying& underlying);
+
+    // rebuilds the book left by earlier runs: from the configured snapshot, if there is one, and
+    // the events logged after it, otherwise from every logged event. Orders generated afterwards
+    // carry on from the highest uid recovered
+    Resolution<std::monostate> recoverBook();
+
+    // writes every resting order and the price data to the configured snapshot path. While a
+    // sharded run is matching, each shard worker copies its own books between batches, otherwise
+    // each book is copied under its underlying's lock, so matching never stops as a whole
+    Resolution<std::monostate> takeSnapshot();
+
+    // hands an order to the worker for its underlying, applying the configured backpressure policy
+    // once that queue reaches its high-water mark. Returns false if the order was shed
+    bool submitOrder(OrderPtr order);
+
+    // orders waiting across every worker queue, approximate while workers are running
+    size_t queueDepth() const;
+    const IngressStats& ingressStats() const;
+    const LatencyStats& latencyStats() const;
+
     const Config& config() const;
+    // set while shard workers are matching, when cancels and auction calls are refused
+    bool shardsMatching() const;
+
+    // generates the configured number of orders and matches them on the books already set up,
+    // returning how many were executed and how many matched
+    Resolution<std::pair<int, int>> produceOrders();
 
     const std::shared_ptr<OrderBook>& orderBook() const;
     const std::shared_ptr<Matcher>& matcher() const;
     const std::shared_ptr<pricing::Pricer>& pricer() const;
 
-    std::map<Underlying, std::mutex>& underlyingMutexes();
-    std::queue<OrderPtr>& orderProcessQueue();
+    // the lock orders for the underlying are matched under, null if it has none
+    std::mutex* underlyingMutex(const Underlying& underlying);
+    // gives the underlying a lock, opening an empty book for it if it has none
+    void addUnderlyingMutex(const Underlying& underlying);
+    MpmcRing<OrderPtr>& orderProcessQueue();
 
    private:
+    // orders for a fixed set of underlyings, consumed by the one worker that owns them
+    struct Shard
+    {
+        Shard(size_t capacity, WaitStrategy waitStrategy);
+
+        SpscRing<OrderPtr> orders;
+        RingWaiter ordersAvailable;
+        RingWaiter spaceAvailable;
+
+        std::vector<Underlying> underlyings;
+        // set by takeSnapshot for the worker to copy its books, cleared once it has
+        std::atomic<bool> snapshotRequested{false};
+        // set under d_snapshotMutex once the worker takes no more snapshot requests
+        bool stopped = false;
+    };
+
     void initialiseUnderlyings(AssetClass assetClass);
-    void pushToQueue(OrderPtr order);
+    void addOptionUnderlyingsToPool();
+    // opens a book for every underlying the journal trades, whatever the configured pool
+    void initialiseUnderlyings(const OrderJournal& journal);
+
+    Resolution<std::monostate> recoverFromLogs(std::span<const EventLog> logs);
+    // restores the snapshot then replays the logged events for each book that came after it
+    Resolution<std::monostate> recoverFromSnapshot(std::span<const EventLog> logs);
+
+    // opens one log for the calling thread and one for each of matchingThreads workers
+    Resolution<std::monostate> openEventLogs(size_t matchingThreads);
+    Resolution<std::monostate> closeEventLogs();
+
+    // logs the acceptance of an order and every fill it made, then the cancel of whatever an order
+    // that can't rest left unfilled
+    void logExecution(const OrderPtr& order, std::span<const Fill> fills);
+    // numbers the events and appends them to the calling thread's log
+    void logEvents(std::span<BookEvent> events);
+
+    // the log of the worker running on this thread, null on any other thread
+    static EventLogWriter*& threadEventLog();
+
     void workerThread(std::atomic<int>& matched, std::atomic<int>& executed);
 
-    OrderPtr popFromQueue();
+    template <typename Ring>
+    bool enqueue(Ring& ring, RingWaiter& spaceAvailable, RingWaiter& ordersAvailable,
+                 OrderPtr order);
 
-    Resolution<std::vector<OrderPtr>> generateOrders(int& ordersGenerated);
-    Resolution<std::pair<int, int>> produceOrders();
+    // every underlying with a lock, in instrument id order
+    std::vector<Underlying> lockedUnderlyings() const;
+
+    // no point starting workers that would never own an underlying
+    size_t shardCount(size_t workerCount) const;
+    void assignShards(size_t workerCount);
+    // underlyings outside the configured pool all fall to the first shard, which still leaves
+    // each underlying with a single owner
+    size_t shardOf(const Underlying& underlying) const;
+    void shardWorker(Shard& shard, std::atomic<int>& matched, std::atomic<int>& executed);
+    // copies the shard's books into the snapshot being taken, if it has been asked to. Returns
+    // whether it was
+    bool copyShardSnapshot(Shard& shard);
+
+    // starts the matching workers, and the ingress reporter if enabled, for stopWorkers to end
+    std::vector<std::thread> startWorkers(std::atomic<int>& matched, std::atomic<int>& executed);
+    void stopWorkers();
+    void stopWorkers(std::vector<std::thread>& threads);
+
+    // prints ingress stats every statsInterval until d_done is set
+    void reportIngress();
+    void printIngress(std::ostream& os) const;
+
+    // latency of the orders this thread has matched since it last flushed
+    struct ThreadLatency
+    {
+        uint64_t orders = 0;
+        uint64_t totalCycles = 0;
+        uint64_t maxCycles = 0;
+    };
+
+    static ThreadLatency& threadLatency();
+    // adds this thread's latency to d_latencyStats, for workers to call as they finish
+    void flushLatency();
+    void printLatency(std::ostream& os) const;
+
+    // memory held by every book, and by each underlying's at debug level. Only once the workers
+    // have stopped, as it reads the books unsynchronised
+    void printBookMemory(std::ostream& os) const;
+
+    // takes a snapshot every snapshotInterval until d_done is set
+    void snapshotPeriodically();
+
+    // matches and publishes an order, the caller must have exclusive access to its underlying
+    bool executeOrder(const OrderPtr& order);
+
+    size_t workerCount() const;
+
+    // block until at least one order can be moved into batch, returning 0 once work has finished
+    size_t popFromQueue(std::span<OrderPtr> batch);
+    size_t popFromShard(Shard& shard, std::span<OrderPtr> batch);
+
+    size_t generatorCount() const;
+
+    // splits the generated asset class's underlyings between at most generatorCount generators.
+    // When sharded, each shard's underlyings all go to one generator so its queue keeps a single
+    // producer
+    void assignGenerators(size_t generatorCount);
+
+    // generates from a random underlying in underlyings. ordersGenerated counts this generator's
+    // orders and sets the equity to option order ratio, uids are unique across generators
+    Resolution<std::vector<OrderPtr>> generateOrders(std::span<const Underlying> underlyings,
+                                                     int& ordersGenerated);
+
+    // runs the generation loop iterations times, or until stopped if iterations is -1
+    Resolution<std::monostate> generatorThread(std::span<const Underlying> underlyings,
+                                               int iterations);
+
+    // matches the journal's orders in recorded order, on this thread or through the shard workers
+    Resolution<std::pair<int, int>> replayOrders(const OrderJournal& journal);
 
     template <typename T>
     void initialiseMutexes(T underlying);
@@ -57,15 +238,49 @@ class Orchestrator
     std::shared_ptr<pricing::Pricer> d_pricer;
     std::reference_wrapper<std::optional<broadcaster::Broadcaster>> d_broadcaster;
 
-    std::map<Underlying, std::mutex> d_underlyingMutexes;
-    std::queue<OrderPtr> d_orderProcessQueue;
-    std::mutex d_queueMutex;
+    // indexed by the book's InstrumentId, null for underlyings without a lock
+    std::vector<std::unique_ptr<std::mutex>> d_underlyingMutexes;
+    MpmcRing<OrderPtr> d_orderProcessQueue;
+    RingWaiter d_ordersAvailable;
+    RingWaiter d_spaceAvailable;
     std::mutex d_outputMutex;  // protects std::cout from interleaving
-    std::condition_variable d_queueConditionVar;
     std::atomic<bool> d_done{false};
+
+    size_t d_highWaterMark;
+    IngressStats d_ingressStats;
+    LatencyStats d_latencyStats;
+    std::mutex d_reportMutex;
+    std::condition_variable d_reportConditionVar;
+
+    std::vector<std::unique_ptr<Shard>> d_shards;
+    // indexed by the book's InstrumentId
+    std::vector<size_t> d_shardOfInstrument;
+
+    std::vector<std::vector<Underlying>> d_generatorUnderlyings;
+    std::atomic<int> d_nextUid{0};
+    std::atomic<bool> d_generationFailed{false};
+    std::unique_ptr<OrderJournalWriter> d_journal;
+
+    // d_eventLogs[0] is shared by threads that aren't workers, under d_eventLogMutex
+    std::vector<std::unique_ptr<EventLogWriter>> d_eventLogs;
+    std::mutex d_eventLogMutex;
+    std::atomic<uint64_t> d_nextSequence{1};
+    uint64_t d_recoveredEvents = 0;
+    std::chrono::milliseconds d_recoveryTime{0};
+
+    // one snapshot at a time, with the shard workers' part coordinated under d_snapshotMutex
+    std::mutex d_snapshotInProgress;
+    std::mutex d_snapshotMutex;
+    std::condition_variable d_shardSnapshotCopied;
+    BookSnapshotWriter* d_snapshotWriter = nullptr;
+    size_t d_shardSnapshotsPending = 0;
+    std::atomic<bool> d_shardsMatching{false};
+    Resolution<std::monostate> d_periodicSnapshot = std::monostate{};  // first failure, if any
+    uint64_t d_snapshotsTaken = 0;
+    uint64_t d_restoredOrders = 0;
 };
 
-std::ostream& operator<<(std::ostream& os, ActiveOrders activeOrders);
+std::ostream& operator<<(std::ostream& os, const ActiveOrders& activeOrders);
 
 }  // namespace solstice::matching
 
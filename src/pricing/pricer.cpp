@@ -1,6 +1,7 @@
 #include <asset_class.h>
 #include <config.h>
 #include <get_random.h>
+#include <instrument_universe.h>
 #include <market_side.h>
 #include <option_price_data.h>
 #include <option_type.h>
@@ -69,37 +70,11 @@ constexpr int MIN_QUANTITY = 1;             // Minimum order quantity
 namespace
 {
 
-double timeToExpiry(Future fut)
+double timeToExpiry(const Underlying& underlying)
 {
-    String name = to_string(fut);
+    const int expiryMonth = instrumentDefinition(underlying).expiryMonth;
     CurrentDate dateNow = currentDate();
 
-    int expiryMonth = monthToInt(name.substr(name.length() - 5, 3));
-    int expiryYear = std::stoi(name.substr(name.length() - 2, 2));
-
-    double monthsToExpiry;
-
-    // NOTE: expiry year is ignored to avoid expiration in the future if securities are not updated
-    if (expiryMonth == dateNow.month)
-    {
-        monthsToExpiry = 1.0;
-    }
-    else
-    {
-        monthsToExpiry = std::abs(expiryMonth - dateNow.month);
-    }
-    // convert to years
-    return monthsToExpiry / 12;
-}
-
-double timeToExpiry(Option opt)
-{
-    String name = to_string(opt);
-    CurrentDate dateNow = currentDate();
-
-    int expiryMonth = monthToInt(name.substr(name.length() - 7, 3));
-    int expiryYear = std::stoi(name.substr(name.length() - 4, 2));
-
     double monthsToExpiry;
 
     // NOTE: expiry year is ignored to avoid expiration in the future if securities are not updated
@@ -139,7 +114,7 @@ double Pricer::generateSeedPrice()
 
 MarketSide Pricer::calculateMarketSide(Equity eq)
 {
-    EquityPriceData data = orderBook()->getPriceData(eq);
+    EquityPriceData data = orderBook()->sharedPriceData(eq).read();
     double p = data.demandFactor() * data.demandFactor();
 
     return calculateMarketSideImpl(p);
@@ -147,7 +122,7 @@ MarketSide Pricer::calculateMarketSide(Equity eq)
 
 MarketSide Pricer::calculateMarketSide(Future fut)
 {
-    FuturePriceData data = orderBook()->getPriceData(fut);
+    FuturePriceData data = orderBook()->sharedPriceData(fut).read();
     double p = data.demandFactor() * data.demandFactor();
 
     return calculateMarketSideImpl(p);
@@ -155,7 +130,7 @@ MarketSide Pricer::calculateMarketSide(Future fut)
 
 MarketSide Pricer::calculateMarketSide(Option opt)
 {
-    OptionPriceData data = orderBook()->getPriceData(opt);
+    OptionPriceData data = orderBook()->sharedPriceData(opt).read();
     double p = data.demandFactor() * data.demandFactor();
 
     return calculateMarketSideImpl(p);
@@ -334,7 +309,7 @@ double Pricer::calculateMarketPriceImpl(MarketSide mktSide, double lowestAsk, do
 
 double Pricer::calculateCarryAdjustment(Future fut)
 {
-    FuturePriceData data = orderBook()->getPriceData(fut);
+    FuturePriceData data = orderBook()->sharedPriceData(fut).read();
 
     double spot = data.lastPrice();
     double t = timeToExpiry(fut);
@@ -345,32 +320,37 @@ double Pricer::calculateCarryAdjustment(Future fut)
 
 double Pricer::calculateMarketPrice(Equity eq, MarketSide mktSide)
 {
-    EquityPriceData& data = orderBook()->getPriceData(eq);
+    // the spread is adjusted under the write section and priced off the copy it leaves behind
+    const EquityPriceData data = orderBook()->sharedPriceData(eq).write(
+        [](EquityPriceData& data)
+        {
+            if (data.highestBid() == 0.0 && data.lowestAsk() == 0.0)
+            {
+                double initialPrice = data.lastPrice();
+                double spreadWidth = initialPrice * EQUITY_INITIAL_SPREAD_PCT;
 
-    if (data.highestBid() == 0.0 && data.lowestAsk() == 0.0)
-    {
-        double initialPrice = data.lastPrice();
-        double spreadWidth = initialPrice * EQUITY_INITIAL_SPREAD_PCT;
+                data.highestBid(initialPrice - spreadWidth / 2);
+                data.lowestAsk(initialPrice + spreadWidth / 2);
+            }
+            else if (data.executions() >= EQUITY_MIN_EXEC_FOR_SPREAD_CALC)
+            {
+                double basePrice = data.movingAverage();
+                double sigma = data.standardDeviation(data);
 
-        data.highestBid(initialPrice - spreadWidth / 2);
-        data.lowestAsk(initialPrice + spreadWidth / 2);
-    }
-    else if (data.executions() >= EQUITY_MIN_EXEC_FOR_SPREAD_CALC)
-    {
-        double basePrice = data.movingAverage();
-        double sigma = data.standardDeviation(data);
+                double spreadWidth = basePrice * (EQUITY_BASE_SPREAD_PCT +
+                                                  sigma * EQUITY_VOLATILITY_SPREAD_MULTIPLIER);
 
-        double spreadWidth =
-            basePrice * (EQUITY_BASE_SPREAD_PCT + sigma * EQUITY_VOLATILITY_SPREAD_MULTIPLIER);
+                double targetBid = basePrice - spreadWidth / 2;
+                double targetAsk = basePrice + spreadWidth / 2;
 
-        double targetBid = basePrice - spreadWidth / 2;
-        double targetAsk = basePrice + spreadWidth / 2;
+                data.highestBid(data.highestBid() * EQUITY_SPREAD_ADJUSTMENT_WEIGHT +
+                                targetBid * EQUITY_TARGET_ADJUSTMENT_WEIGHT);
+                data.lowestAsk(data.lowestAsk() * EQUITY_SPREAD_ADJUSTMENT_WEIGHT +
+                               targetAsk * EQUITY_TARGET_ADJUSTMENT_WEIGHT);
+            }
 
-        data.highestBid(data.highestBid() * EQUITY_SPREAD_ADJUSTMENT_WEIGHT +
-                        targetBid * EQUITY_TARGET_ADJUSTMENT_WEIGHT);
-        data.lowestAsk(data.lowestAsk() * EQUITY_SPREAD_ADJUSTMENT_WEIGHT +
-                       targetAsk * EQUITY_TARGET_ADJUSTMENT_WEIGHT);
-    }
+            return data;
+        });
 
     double bidDrift =
         Random::getRandomDouble(-EQUITY_TRANSIENT_DRIFT_PCT, EQUITY_TRANSIENT_DRIFT_PCT);
@@ -385,28 +365,33 @@ double Pricer::calculateMarketPrice(Equity eq, MarketSide mktSide)
 
 double Pricer::calculateMarketPrice(Future fut, MarketSide mktSide)
 {
-    FuturePriceData& data = orderBook()->getPriceData(fut);
-    double basePrice = data.lastPrice();
+    const FuturePriceData data = orderBook()->sharedPriceData(fut).write(
+        [](FuturePriceData& data)
+        {
+            double basePrice = data.lastPrice();
 
-    if (data.executions() > 0)
-    {
-        basePrice = data.movingAverage();
-    }
+            if (data.executions() > 0)
+            {
+                basePrice = data.movingAverage();
+            }
 
-    double spreadWidth;
-    if (data.executions() > 1)
-    {
-        double sigma = data.standardDeviation(data);
-        spreadWidth =
-            basePrice * (FUTURE_BASE_SPREAD_PCT + sigma * FUTURE_VOLATILITY_SPREAD_MULTIPLIER);
-    }
-    else
-    {
-        spreadWidth = basePrice * FUTURE_INITIAL_SPREAD_PCT;
-    }
+            double spreadWidth;
+            if (data.executions() > 1)
+            {
+                double sigma = data.standardDeviation(data);
+                spreadWidth = basePrice * (FUTURE_BASE_SPREAD_PCT +
+                                           sigma * FUTURE_VOLATILITY_SPREAD_MULTIPLIER);
+            }
+            else
+            {
+                spreadWidth = basePrice * FUTURE_INITIAL_SPREAD_PCT;
+            }
+
+            data.highestBid(basePrice - spreadWidth / 2);
+            data.lowestAsk(basePrice + spreadWidth / 2);
 
-    data.highestBid(basePrice - spreadWidth / 2);
-    data.lowestAsk(basePrice + spreadWidth / 2);
+            return data;
+        });
 
     double costOfCarry = calculateCarryAdjustment(fut);
     double adjustedBid = data.highestBid() + costOfCarry;
@@ -418,9 +403,7 @@ double Pricer::calculateMarketPrice(Future fut, MarketSide mktSide)
 double Pricer::calculateMarketPrice(PricerDepOptionData optInfo, double theoreticalPrice,
                                     MarketSide mktSide)
 {
-    OptionPriceData& priceData = orderBook()->getPriceData(optInfo.optionTicker());
-
-    auto equityData = orderBook()->getPriceData(optInfo.underlyingEquity());
+    auto equityData = orderBook()->sharedPriceData(optInfo.underlyingEquity()).read();
     double spot = equityData.lastPrice();
     double strike = optInfo.strike();
     double moneyness = std::abs(spot - strike) / spot;
@@ -428,44 +411,51 @@ double Pricer::calculateMarketPrice(PricerDepOptionData optInfo, double theoreti
     // higher timeDecayFactor for options closer to expiry
     double timeDecayFactor = 1.0 / std::max(0.1, optInfo.expiry());
 
-    double spreadWidth;
+    auto& sharedData = orderBook()->sharedPriceData(optInfo.optionTicker());
+    const OptionPriceData priceData = sharedData.write(
+        [&](OptionPriceData& priceData)
+        {
+            double spreadWidth;
 
-    if (priceData.highestBid() == 0.0 && priceData.lowestAsk() == 0.0)
-    {
-        spreadWidth = theoreticalPrice * OPTION_INITIAL_SPREAD_PCT;
-        spreadWidth *= (1.0 + moneyness * OPTION_MONEYNESS_SPREAD_MULTIPLIER);
+            if (priceData.highestBid() == 0.0 && priceData.lowestAsk() == 0.0)
+            {
+                spreadWidth = theoreticalPrice * OPTION_INITIAL_SPREAD_PCT;
+                spreadWidth *= (1.0 + moneyness * OPTION_MONEYNESS_SPREAD_MULTIPLIER);
 
-        priceData.highestBid(theoreticalPrice - spreadWidth / 2);
-        priceData.lowestAsk(theoreticalPrice + spreadWidth / 2);
-    }
-    else if (priceData.executions() >= OPTION_MIN_EXEC_FOR_SPREAD_CALC)
-    {
-        double sigma = priceData.standardDeviation(priceData);
+                priceData.highestBid(theoreticalPrice - spreadWidth / 2);
+                priceData.lowestAsk(theoreticalPrice + spreadWidth / 2);
+            }
+            else if (priceData.executions() >= OPTION_MIN_EXEC_FOR_SPREAD_CALC)
+            {
+                double sigma = priceData.standardDeviation(priceData);
 
-        spreadWidth = theoreticalPrice *
-                      (OPTION_BASE_SPREAD_PCT + sigma * OPTION_VOLATILITY_SPREAD_MULTIPLIER);
+                spreadWidth = theoreticalPrice * (OPTION_BASE_SPREAD_PCT +
+                                                  sigma * OPTION_VOLATILITY_SPREAD_MULTIPLIER);
 
-        // wider spread for OTM options and near expiry
-        spreadWidth *= (1.0 + moneyness * OPTION_MONEYNESS_SPREAD_MULTIPLIER);
-        spreadWidth *= (1.0 + timeDecayFactor * OPTION_TIME_DECAY_SPREAD_MULTIPLIER);
+                // wider spread for OTM options and near expiry
+                spreadWidth *= (1.0 + moneyness * OPTION_MONEYNESS_SPREAD_MULTIPLIER);
+                spreadWidth *= (1.0 + timeDecayFactor * OPTION_TIME_DECAY_SPREAD_MULTIPLIER);
 
-        double targetBid = theoreticalPrice - spreadWidth / 2;
-        double targetAsk = theoreticalPrice + spreadWidth / 2;
+                double targetBid = theoreticalPrice - spreadWidth / 2;
+                double targetAsk = theoreticalPrice + spreadWidth / 2;
 
-        priceData.highestBid(priceData.highestBid() * OPTION_SPREAD_ADJUSTMENT_WEIGHT +
-                             targetBid * OPTION_TARGET_ADJUSTMENT_WEIGHT);
-        priceData.lowestAsk(priceData.lowestAsk() * OPTION_SPREAD_ADJUSTMENT_WEIGHT +
-                            targetAsk * OPTION_TARGET_ADJUSTMENT_WEIGHT);
-    }
-    else
-    {
-        // not enough executions yet so use theoretical price with initial spread
-        spreadWidth = theoreticalPrice * OPTION_INITIAL_SPREAD_PCT;
-        spreadWidth *= (1.0 + moneyness * OPTION_MONEYNESS_SPREAD_MULTIPLIER);
+                priceData.highestBid(priceData.highestBid() * OPTION_SPREAD_ADJUSTMENT_WEIGHT +
+                                     targetBid * OPTION_TARGET_ADJUSTMENT_WEIGHT);
+                priceData.lowestAsk(priceData.lowestAsk() * OPTION_SPREAD_ADJUSTMENT_WEIGHT +
+                                    targetAsk * OPTION_TARGET_ADJUSTMENT_WEIGHT);
+            }
+            else
+            {
+                // not enough executions yet so use theoretical price with initial spread
+                spreadWidth = theoreticalPrice * OPTION_INITIAL_SPREAD_PCT;
+                spreadWidth *= (1.0 + moneyness * OPTION_MONEYNESS_SPREAD_MULTIPLIER);
 
-        priceData.highestBid(theoreticalPrice - spreadWidth / 2);
-        priceData.lowestAsk(theoreticalPrice + spreadWidth / 2);
-    }
+                priceData.highestBid(theoreticalPrice - spreadWidth / 2);
+                priceData.lowestAsk(theoreticalPrice + spreadWidth / 2);
+            }
+
+            return priceData;
+        });
 
     return calculateMarketPriceImpl(mktSide, priceData.lowestAsk(), priceData.highestBid(),
                                     priceData.demandFactor());
@@ -473,7 +463,7 @@ double Pricer::calculateMarketPrice(PricerDepOptionData optInfo, double theoreti
 
 int Pricer::calculateQnty(Equity eq, MarketSide mktSide, double price)
 {
-    EquityPriceData data = orderBook()->getPriceData(eq);
+    EquityPriceData data = orderBook()->sharedPriceData(eq).read();
     double n = data.executions();
     double demandScale = MIN_DEMAND_SCALE + (MAX_DEMAND_SCALE * std::abs(data.demandFactor()));
 
@@ -489,7 +479,7 @@ int Pricer::calculateQnty(Equity eq, MarketSide mktSide, double price)
 
 int Pricer::calculateQnty(Future fut, MarketSide mktSide, double price)
 {
-    FuturePriceData data = orderBook()->getPriceData(fut);
+    FuturePriceData data = orderBook()->sharedPriceData(fut).read();
     double n = data.executions();
     double demandScale = MIN_DEMAND_SCALE + (MAX_DEMAND_SCALE * std::abs(data.demandFactor()));
 
@@ -505,7 +495,7 @@ int Pricer::calculateQnty(Future fut, MarketSide mktSide, double price)
 
 int Pricer::calculateQnty(Option opt, MarketSide mktSide, double price)
 {
-    OptionPriceData data = orderBook()->getPriceData(opt);
+    OptionPriceData data = orderBook()->sharedPriceData(opt).read();
     double n = data.executions();
     double demandScale = MIN_DEMAND_SCALE + (MAX_DEMAND_SCALE * std::abs(data.demandFactor()));
 
@@ -525,7 +515,7 @@ double Pricer::calculateStrikeImpl(PricerDepOptionData& data)
     double strikeUpperBound;
     double strike;
 
-    auto equityPriceData = orderBook()->getPriceData(data.underlyingEquity());
+    auto equityPriceData = orderBook()->sharedPriceData(data.underlyingEquity()).read();
     double spot = equityPriceData.lastPrice();
 
     // integer to determine if option is OTM, ATM or ITM
@@ -600,10 +590,14 @@ PricerDepOptionData Pricer::computeOptionData(Option opt)
         data.underlyingEquity(*underlyingEquity);
     }
 
+    // a loaded option fixes its strike and type; a built-in one leaves the pricer to pick them
+    const InstrumentDefinition& definition = instrumentDefinition(opt);
+
     data.optionTicker(opt);
-    data.strike(calculateStrikeImpl(data));
+    data.strike(definition.strike > 0.0 ? definition.strike : calculateStrikeImpl(data));
     data.marketSide(calculateMarketSide(opt));
-    data.optionType(Random::getRandomOptionType());
+    data.optionType(definition.optionType ? *definition.optionType
+                                          : Random::getRandomOptionType());
     data.expiry(timeToExpiry(opt));
 
     return data;
@@ -611,7 +605,8 @@ PricerDepOptionData Pricer::computeOptionData(Option opt)
 
 double Pricer::computeBlackScholes(PricerDepOptionData& optionData)
 {
-    auto underlyingEquity = orderBook()->getPriceData(optionData.underlyingEquity());
+    const auto underlyingEquity =
+        orderBook()->sharedPriceData(optionData.underlyingEquity()).read();
 
     double S = underlyingEquity.lastPrice();
     double K = optionData.strike();
@@ -652,7 +647,7 @@ Greeks Pricer::computeGreeks(OptionOrder& option)
 {
     Option optionTicker = std::get<Option>(option.underlying());
 
-    auto priceData = orderBook()->getPriceData(option.underlyingEquity());
+    auto priceData = orderBook()->sharedPriceData(option.underlyingEquity()).read();
     double S = priceData.lastPrice();
     double sigma = priceData.volatility();
     double K = option.strike();
@@ -693,7 +688,7 @@ Greeks Pricer::computeGreeks(OptionOrder& option)
 
 void Pricer::update(matching::OrderPtr order)
 {
-    withPriceData(
+    withSharedPriceData(
         order->underlying(),
         [&order, this](auto& priceData)
         {
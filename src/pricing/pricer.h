@@ -14,6 +14,7 @@
 #include <order_type.h>
 #include <pricing_data.h>
 #include <pricing_utils.h>
+#include <ticks.h>
 #include <time_point.h>
 
 #include <memory>
@@ -87,7 +88,11 @@ class Pricer
                 else
                 {
                     auto marketSide = calculateMarketSide(underlyingValue);
-                    auto price = calculateMarketPrice(underlyingValue, marketSide);
+
+                    // snap to the tick grid so qnty is sized off the price the book will see
+                    auto price = fromTicks(
+                        toTicks(calculateMarketPrice(underlyingValue, marketSide), underlying),
+                        underlying);
                     auto qnty = calculateQnty(underlyingValue, marketSide, price);
                     return PricerDepOrderData(underlying, marketSide, price, qnty);
                 }
@@ -120,18 +125,12 @@ class Pricer
    private:
     double generateSeedPrice();
 
+    // runs func on the underlying's price data inside its write section
     template <typename Func>
-    auto withPriceData(Underlying underlying, Func&& func)
-    {
-        return std::visit([this, &func](auto asset)
-                          { return func(orderBook()->getPriceData(asset)); }, underlying);
-    }
-
-    template <typename Func>
-    auto withPriceData(matching::OrderPtr order, Func&& func)
+    auto withSharedPriceData(Underlying underlying, Func&& func)
     {
         return std::visit([this, &func](auto asset)
-                          { return func(orderBook()->getPriceData(asset)); }, order->underlying());
+                          { return orderBook()->sharedPriceData(asset).write(func); }, underlying);
     }
 
     MarketSide calculateMarketSide(Equity eq);
@@ -0,0 +1,32 @@
+#include <cycle_clock.h>
+
+#include <chrono>
+#include <thread>
+
+namespace solstice
+{
+
+double nanosPerCycle()
+{
+    static const double ratio = []
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        const auto start = std::chrono::steady_clock::now();
+        const Cycles startCycles = cyclesNow();
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        const Cycles cycles = cyclesNow() - startCycles;
+        const auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                               std::chrono::steady_clock::now() - start)
+                               .count();
+        return cycles == 0 ? 1.0 : static_cast<double>(nanos) / static_cast<double>(cycles);
+#else
+        return 1.0;
+#endif
+    }();
+
+    return ratio;
+}
+
+}  // namespace solstice
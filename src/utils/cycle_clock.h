@@ -0,0 +1,34 @@
+#ifndef CYCLE_CLOCK_H
+#define CYCLE_CLOCK_H
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace solstice
+{
+
+using Cycles = uint64_t;
+
+// Cheap timestamp for measuring latency, never for ordering: the CPU's time stamp counter where
+// there is one, which is a few nanoseconds to read, otherwise steady_clock nanoseconds
+inline Cycles cyclesNow()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+#endif
+}
+
+// calibrated against steady_clock the first time it is called, which takes a few milliseconds
+double nanosPerCycle();
+
+}  // namespace solstice
+
+#endif  // CYCLE_CLOCK_H
@@ -5,8 +5,13 @@
 #include <option_type.h>
 #include <options.h>
 #include <pricing_data.h>
+#include <random_stream.h>
 #include <types.h>
 
+#include <cmath>
+#include <numbers>
+#include <span>
+
 namespace solstice
 {
 
@@ -28,13 +33,10 @@ constexpr double THETA_UPPER_BOUND = 0.5;
 constexpr double VEGA_LOWER_BOUND = 0.01;
 constexpr double VEGA_UPPER_BOUND = 0.8;
 
-std::random_device Random::rd;
-
+// every draw comes from the calling thread's own stream, see RandomStream
 String Random::getRandomUid()
 {
-    static std::mt19937_64 rng(std::random_device{}());
-    static std::uniform_int_distribution<uint64_t> dist;
-    String uid = std::to_string(dist(rng));
+    String uid = std::to_string(RandomStream::local()());
 
     uid.insert(uid.begin(), 20 - uid.length(), '0');
 
@@ -43,28 +45,46 @@ String Random::getRandomUid()
 
 int Random::getRandomInt(int min, int max)
 {
-    static std::mt19937 gen(std::random_device{}());
-    std::uniform_int_distribution<> dist(min, max);
-
-    return dist(gen);
+    return static_cast<int>(RandomStream::local().uniformInt(min, max));
 }
 
 double Random::getRandomDouble(double min, double max)
 {
-    static std::mt19937 gen(std::random_device{}());
-    std::uniform_real_distribution<> dist(min, max);
-
-    double value = dist(gen);
+    double value = min + (max - min) * RandomStream::local().uniform();
 
     return std::round(value * 100.0) / 100.0;
 }
 
-int Random::getRandomBool()
+int Random::getRandomBool() { return (RandomStream::local()() >> 63) == 1; }
+
+void Random::fillUniform(std::span<double> out, double min, double max)
+{
+    auto& engine = RandomStream::local();
+    const double range = max - min;
+
+    for (double& value : out)
+    {
+        value = min + range * engine.uniform();
+    }
+}
+
+void Random::fillNormal(std::span<double> out, double mean, double stddev)
 {
-    static std::mt19937 gen(std::random_device{}());
-    std::uniform_int_distribution<> dist(0, 1);
+    auto& engine = RandomStream::local();
+
+    // Box-Muller, producing two normals from each pair of uniforms
+    for (size_t i = 0; i < out.size(); i += 2)
+    {
+        // 1 - uniform() is in (0, 1], keeping log away from 0
+        const double radius = std::sqrt(-2.0 * std::log(1.0 - engine.uniform()));
+        const double angle = 2.0 * std::numbers::pi * engine.uniform();
 
-    return dist(gen) == 1;
+        out[i] = mean + stddev * radius * std::cos(angle);
+        if (i + 1 < out.size())
+        {
+            out[i + 1] = mean + stddev * radius * std::sin(angle);
+        }
+    }
 }
 
 // ===================================================================
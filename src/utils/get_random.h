@@ -8,7 +8,7 @@
 #include <pricing_data.h>
 #include <types.h>
 
-#include <random>
+#include <span>
 
 namespace solstice
 {
@@ -23,6 +23,10 @@ class Random
 
     static int getRandomBool();
 
+    // fill out in one pass, for callers that need many draws at once
+    static void fillUniform(std::span<double> out, double min, double max);
+    static void fillNormal(std::span<double> out, double mean, double stddev);
+
     // spot values
     static double getRandomSpotPrice(double minPrice, double maxPrice);
     static int getRandomQnty(int minQnty, int maxQnty);
@@ -40,9 +44,6 @@ class Random
     static double getRandomVega();
     static Resolution<pricing::PricerDepOptionData> generateOptionData(const Config& cfg);
     static pricing::Greeks generateGreeks(const pricing::PricerDepOptionData& data);
-
-   private:
-    static std::random_device rd;
 };
 
 }  // namespace solstice
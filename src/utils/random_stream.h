@@ -0,0 +1,160 @@
+#ifndef RANDOM_STREAM_H
+#define RANDOM_STREAM_H
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <random>
+
+namespace solstice
+{
+
+// xoshiro256++ (Blackman & Vigna): 256 bits of state, four shifts/rotates per draw and a period
+// of 2^256 - 1. Satisfies UniformRandomBitGenerator, but the helpers below are preferred over the
+// std distributions since their output is the same on every standard library
+class Xoshiro256pp
+{
+   public:
+    using result_type = uint64_t;
+
+    explicit Xoshiro256pp(uint64_t seed = 0) { reseed(seed, 0); }
+
+    // stream n of seed is an independent sequence, so threads can be given one each
+    void reseed(uint64_t seed, uint64_t stream)
+    {
+        uint64_t mix = seed ^ splitMix64(stream);
+        for (auto& word : d_state)
+        {
+            word = splitMix64(mix);
+        }
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()()
+    {
+        const uint64_t result = std::rotl(d_state[0] + d_state[3], 23) + d_state[0];
+        const uint64_t shifted = d_state[1] << 17;
+
+        d_state[2] ^= d_state[0];
+        d_state[3] ^= d_state[1];
+        d_state[1] ^= d_state[2];
+        d_state[0] ^= d_state[3];
+        d_state[2] ^= shifted;
+        d_state[3] = std::rotl(d_state[3], 45);
+
+        return result;
+    }
+
+    // uniform in [0, 1) from the top 53 bits
+    double uniform() { return static_cast<double>((*this)() >> 11) * 0x1.0p-53; }
+
+    // uniform in [min, max], unbiased via Lemire's multiply and reject
+    int64_t uniformInt(int64_t min, int64_t max)
+    {
+        const uint64_t range = static_cast<uint64_t>(max) - static_cast<uint64_t>(min) + 1;
+        if (range == 0)
+        {
+            // min and max span every int64_t
+            return static_cast<int64_t>((*this)());
+        }
+
+        unsigned __int128 product = static_cast<unsigned __int128>((*this)()) * range;
+        if (static_cast<uint64_t>(product) < range)
+        {
+            const uint64_t threshold = -range % range;
+            while (static_cast<uint64_t>(product) < threshold)
+            {
+                product = static_cast<unsigned __int128>((*this)()) * range;
+            }
+        }
+
+        return min + static_cast<int64_t>(product >> 64);
+    }
+
+   private:
+    static uint64_t splitMix64(uint64_t& x)
+    {
+        uint64_t z = (x += 0x9e3779b97f4a7c15);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+        return z ^ (z >> 31);
+    }
+
+    std::array<uint64_t, 4> d_state;
+};
+
+// Hands every thread its own Xoshiro256pp, seeded as one stream of a process-wide master seed.
+// Threads that bind a stream number draw the same sequence for the same master seed regardless of
+// scheduling; threads that don't are given a stream of their own on first use. Reseeding the
+// master moves every thread onto its stream of the new seed at its next draw.
+class RandomStream
+{
+   public:
+    static void seed(uint64_t masterSeed)
+    {
+        d_masterSeed.store(masterSeed, std::memory_order_relaxed);
+        d_epoch.fetch_add(1, std::memory_order_release);
+    }
+
+    static uint64_t masterSeed() { return d_masterSeed.load(std::memory_order_relaxed); }
+
+    // pins the calling thread to the given stream of the master seed, starting it from the top
+    static void bind(uint64_t stream)
+    {
+        Local& local = localState();
+        local.stream = stream;
+        local.hasStream = true;
+        local.epoch = d_epoch.load(std::memory_order_acquire);
+        local.engine.reseed(masterSeed(), stream);
+    }
+
+    static Xoshiro256pp& local()
+    {
+        Local& local = localState();
+
+        const uint32_t epoch = d_epoch.load(std::memory_order_acquire);
+        if (local.epoch != epoch)
+        {
+            if (!local.hasStream)
+            {
+                local.stream = d_nextAutoStream.fetch_add(1, std::memory_order_relaxed);
+                local.hasStream = true;
+            }
+
+            local.epoch = epoch;
+            local.engine.reseed(masterSeed(), local.stream);
+        }
+
+        return local.engine;
+    }
+
+   private:
+    // unbound threads take streams from the top half, leaving the bottom half for bind()
+    static constexpr uint64_t AUTO_STREAM_BASE = uint64_t{1} << 63;
+
+    struct Local
+    {
+        Xoshiro256pp engine;
+        uint64_t stream = 0;
+        bool hasStream = false;
+        uint32_t epoch = 0;  // 0 never matches d_epoch, so the first draw seeds the engine
+    };
+
+    static inline std::atomic<uint64_t> d_masterSeed{std::random_device{}()};
+    static inline std::atomic<uint32_t> d_epoch{1};
+    static inline std::atomic<uint64_t> d_nextAutoStream{AUTO_STREAM_BASE};
+
+    static Local& localState()
+    {
+        thread_local Local local;
+        return local;
+    }
+};
+
+}  // namespace solstice
+
+#endif  // RANDOM_STREAM_H
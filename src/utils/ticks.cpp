@@ -0,0 +1,41 @@
+#include <asset_class.h>
+#include <instrument_universe.h>
+#include <ticks.h>
+
+#include <cmath>
+#include <variant>
+
+namespace solstice
+{
+
+namespace
+{
+
+// tick sizes are expected to divide 1 exactly (0.01, 0.05, 0.25 etc), so dividing by the
+// whole number of ticks per unit gives the closest double to the original decimal price
+double ticksPerUnit(const Underlying& underlying) { return std::round(1.0 / tickSize(underlying)); }
+
+}  // namespace
+
+double tickSize(Equity eq) { return instrumentDefinition(eq).tickSize; }
+
+double tickSize(Future fut) { return instrumentDefinition(fut).tickSize; }
+
+double tickSize(Option opt) { return instrumentDefinition(opt).tickSize; }
+
+double tickSize(const Underlying& underlying)
+{
+    return std::visit([](auto asset) { return tickSize(asset); }, underlying);
+}
+
+Ticks toTicks(double price, const Underlying& underlying)
+{
+    return static_cast<Ticks>(std::llround(price * ticksPerUnit(underlying)));
+}
+
+double fromTicks(Ticks ticks, const Underlying& underlying)
+{
+    return static_cast<double>(ticks) / ticksPerUnit(underlying);
+}
+
+}  // namespace solstice
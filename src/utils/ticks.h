@@ -0,0 +1,31 @@
+#ifndef TICKS_H
+#define TICKS_H
+
+#include <asset_class.h>
+
+#include <cstdint>
+
+namespace solstice
+{
+
+// prices inside the book are held as an integer number of ticks, so level lookups and price
+// comparisons on the matching path never touch floating point
+using Ticks = int64_t;
+
+// tick sizes of the built-in instruments. A definitions file sets each loaded instrument's own
+constexpr double EQUITY_TICK_SIZE = 0.01;
+constexpr double FUTURE_TICK_SIZE = 0.01;
+constexpr double OPTION_TICK_SIZE = 0.01;
+
+double tickSize(Equity eq);
+double tickSize(Future fut);
+double tickSize(Option opt);
+double tickSize(const Underlying& underlying);
+
+// conversions should only happen at the edges (order creation, logging, broadcasting)
+Ticks toTicks(double price, const Underlying& underlying);
+double fromTicks(Ticks ticks, const Underlying& underlying);
+
+}  // namespace solstice
+
+#endif  // TICKS_H
@@ -0,0 +1,240 @@
+#include <book_backend.h>
+#include <book_snapshot.h>
+#include <broadcaster.h>
+#include <config.h>
+#include <event_log.h>
+#include <fill.h>
+#include <gtest/gtest.h>
+#include <log_level.h>
+#include <matcher.h>
+#include <orchestrator.h>
+#include <order.h>
+#include <order_book.h>
+#include <pricer.h>
+
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace solstice
+{
+
+namespace
+{
+
+String tempPath(const char* name)
+{
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+void removeLogs(const String& prefix)
+{
+    for (size_t i = 0; std::filesystem::remove(eventLogPath(prefix, i)); i++)
+    {
+    }
+}
+
+// uid and outstanding quantity of every resting order, in the order the book visits them
+std::vector<std::pair<int, int>> restingOrders(const matching::OrderBook& book,
+                                               const Underlying& underlying)
+{
+    std::vector<std::pair<int, int>> resting;
+    book.forEachRestingOrder(underlying, [&](const matching::OrderPtr& order)
+                             { resting.emplace_back(order->uid(), order->outstandingQnty()); });
+    return resting;
+}
+
+// uid -> outstanding quantity, for books built up in different orders
+std::map<int, int> restingQuantities(const matching::OrderBook& book, const Underlying& underlying)
+{
+    const auto resting = restingOrders(book, underlying);
+    return {resting.begin(), resting.end()};
+}
+
+}  // namespace
+
+TEST(BookSnapshotTests, RestoredBookKeepsTimePriorityAndPriceData)
+{
+    const String path = tempPath("solstice_restore.snapshot");
+
+    for (BookBackend backend : {BookBackend::Tree, BookBackend::Ladder})
+    {
+        auto book = std::make_shared<matching::OrderBook>(backend);
+        book->initialiseUnderlying(Equity::AAPL);
+        book->getPriceData(Equity::AAPL).lastPrice(123.45);
+
+        matching::Matcher matcher(book);
+        auto execute = [&](int uid, double price, int qnty, MarketSide side)
+        {
+            auto order = *Order::create(uid, Equity::AAPL, price, qnty, side);
+
+            std::vector<matching::Fill> fills;
+            (void)matcher.matchOrder(order, fills);
+
+            if (order->outstandingQnty() > 0)
+            {
+                book->addOrderToBook(order);
+            }
+        };
+
+        execute(1, 10.00, 10, MarketSide::Bid);
+        execute(2, 10.00, 5, MarketSide::Bid);
+        execute(3, 9.95, 8, MarketSide::Bid);
+        execute(4, 10.10, 7, MarketSide::Ask);
+        execute(5, 10.00, 4, MarketSide::Ask);
+
+        matching::BookSnapshotWriter writer;
+        writer.addBook(*book, Equity::AAPL, 9);
+        writer.addPriceData(*book);
+        ASSERT_TRUE(writer.write(path, 5).has_value());
+
+        auto snapshot = matching::BookSnapshot::load(path);
+        ASSERT_TRUE(snapshot.has_value()) << snapshot.error();
+        EXPECT_EQ((*snapshot).header().sequence, 9);
+        EXPECT_EQ((*snapshot).header().lastUid, 5);
+        ASSERT_EQ((*snapshot).books().size(), 1);
+        EXPECT_EQ((*snapshot).books()[0].toUnderlying(), Underlying{Equity::AAPL});
+
+        matching::OrderBook restored(backend);
+        ASSERT_TRUE((*snapshot).restore(restored).has_value());
+
+        // uid 1 was partly filled by uid 5 and is still ahead of uid 2 at 10.00
+        const auto resting = restingOrders(*book, Equity::AAPL);
+        EXPECT_EQ(resting.size(), 4);
+        EXPECT_EQ(restingOrders(restored, Equity::AAPL), resting);
+        EXPECT_EQ(restingQuantities(restored, Equity::AAPL).at(1), 6);
+
+        EXPECT_EQ(restored.topOfBook(Equity::AAPL, MarketSide::Bid),
+                  book->topOfBook(Equity::AAPL, MarketSide::Bid));
+        EXPECT_EQ(restored.topOfBook(Equity::AAPL, MarketSide::Ask),
+                  book->topOfBook(Equity::AAPL, MarketSide::Ask));
+        EXPECT_DOUBLE_EQ(restored.getPriceData(Equity::AAPL).lastPrice(), 123.45);
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST(BookSnapshotTests, RestoredBookStaysInItsCallAuction)
+{
+    const String path = tempPath("solstice_auction.snapshot");
+
+    matching::OrderBook book;
+    book.initialiseUnderlying(Equity::AAPL);
+    book.initialiseUnderlying(Equity::MSFT);
+    ASSERT_TRUE(book.startAuction(Equity::AAPL).has_value());
+
+    // crossed, as orders rest without matching during the call
+    book.addOrderToBook(*Order::create(1, Equity::AAPL, 10.05, 10, MarketSide::Bid));
+    book.addOrderToBook(*Order::create(2, Equity::AAPL, 10.00, 6, MarketSide::Ask));
+
+    matching::BookSnapshotWriter writer;
+    writer.addBook(book, Equity::AAPL, 3);
+    writer.addBook(book, Equity::MSFT, 3);
+    ASSERT_TRUE(writer.write(path, 2).has_value());
+
+    auto snapshot = matching::BookSnapshot::load(path);
+    ASSERT_TRUE(snapshot.has_value()) << snapshot.error();
+
+    matching::OrderBook restored;
+    ASSERT_TRUE((*snapshot).restore(restored).has_value());
+
+    EXPECT_TRUE(restored.inAuction(Equity::AAPL));
+    EXPECT_FALSE(restored.inAuction(Equity::MSFT));
+    EXPECT_EQ(restingOrders(restored, Equity::AAPL), restingOrders(book, Equity::AAPL));
+
+    std::filesystem::remove(path);
+}
+
+TEST(BookSnapshotTests, LoadRejectsFilesThatAreNotWholeSnapshots)
+{
+    const String path = tempPath("solstice_rejected.snapshot");
+
+    matching::OrderBook book;
+    book.initialiseUnderlying(Equity::MSFT);
+    book.addOrderToBook(*Order::create(1, Equity::MSFT, 20.0, 5, MarketSide::Ask));
+
+    matching::BookSnapshotWriter writer;
+    writer.addBook(book, Equity::MSFT, 1);
+    ASSERT_TRUE(writer.write(path, 1).has_value());
+    ASSERT_TRUE(matching::BookSnapshot::load(path).has_value());
+
+    // snapshots are renamed into place complete, so a short one has been damaged since
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    EXPECT_FALSE(matching::BookSnapshot::load(path).has_value());
+
+    std::ofstream(path, std::ios::trunc) << "not a snapshot";
+    EXPECT_FALSE(matching::BookSnapshot::load(path).has_value());
+
+    std::filesystem::remove(path);
+}
+
+TEST(BookSnapshotTests, WarmStartMatchesRecoveryFromEveryLoggedEvent)
+{
+    const String prefix = tempPath("solstice_warm_start.events");
+    const String path = tempPath("solstice_warm_start.snapshot");
+    removeLogs(prefix);
+    std::filesystem::remove(path);
+
+    auto config = *Config::instance();
+    config.ordersToGenerate(3000);
+    config.logLevel(LogLevel::ERROR);
+    config.matchingThreads(2);
+    config.shardedMatching(true);
+    config.eventLogPath(prefix);
+    config.snapshotPath(path);
+    config.snapshotInterval(1);
+
+    std::optional<broadcaster::Broadcaster> broadcaster;
+    ASSERT_TRUE(matching::Orchestrator::start(config, broadcaster).has_value());
+    ASSERT_TRUE(std::filesystem::exists(path));
+
+    // a second run logs more events without snapshotting, leaving a tail to replay
+    Config logOnly = config;
+    logOnly.snapshotPath("");
+    logOnly.shardedMatching(false);
+    ASSERT_TRUE(matching::Orchestrator::start(logOnly, broadcaster).has_value());
+
+    auto recover = [&](const Config& recoveryConfig)
+    {
+        auto book = std::make_shared<matching::OrderBook>();
+        matching::Orchestrator orchestrator(recoveryConfig, book,
+                                            std::make_shared<matching::Matcher>(book),
+                                            std::make_shared<pricing::Pricer>(book), broadcaster);
+        EXPECT_TRUE(orchestrator.recoverBook().has_value());
+        return book;
+    };
+
+    auto warmBook = recover(config);
+    auto coldBook = recover(logOnly);
+
+    auto logs = EventLog::loadAll(prefix);
+    ASSERT_TRUE(logs.has_value());
+
+    std::set<Underlying> underlyings;
+    for (const auto& log : *logs)
+    {
+        for (const auto& event : log.events())
+        {
+            underlyings.insert(event.order.toUnderlying());
+        }
+    }
+
+    size_t resting = 0;
+    for (const auto& underlying : underlyings)
+    {
+        const auto recovered = restingQuantities(*warmBook, underlying);
+        EXPECT_EQ(recovered, restingQuantities(*coldBook, underlying));
+        resting += recovered.size();
+    }
+    EXPECT_GT(resting, 0);
+
+    removeLogs(prefix);
+    std::filesystem::remove(path);
+}
+
+}  // namespace solstice
@@ -31,6 +31,7 @@ TEST(ConfigTests, CanModifyAllFields)
     result.maxPrice(200.0);
     result.usePricer(true);
     result.broadcastInterval(20);
+    result.broadcastDepth(3);
 
     EXPECT_EQ(result.logLevel(), LogLevel::DEBUG);
     EXPECT_EQ(result.assetClass(), AssetClass::Equity);
@@ -42,6 +43,7 @@ TEST(ConfigTests, CanModifyAllFields)
     EXPECT_EQ(result.maxPrice(), 200.0);
     EXPECT_EQ(result.usePricer(), true);
     EXPECT_EQ(result.broadcastInterval(), 20);
+    EXPECT_EQ(result.broadcastDepth(), 3);
 }
 
 }  // namespace solstice
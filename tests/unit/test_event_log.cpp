@@ -0,0 +1,433 @@
+#include <book_event_type.h>
+#include <broadcaster.h>
+#include <config.h>
+#include <event_log.h>
+#include <fill.h>
+#include <gtest/gtest.h>
+#include <log_level.h>
+#include <matcher.h>
+#include <orchestrator.h>
+#include <order.h>
+#include <order_book.h>
+#include <pricer.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <vector>
+
+namespace solstice
+{
+
+namespace
+{
+
+String logPrefix(const char* name)
+{
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+void removeLogs(const String& prefix)
+{
+    for (size_t i = 0; std::filesystem::remove(eventLogPath(prefix, i)); i++)
+    {
+    }
+}
+
+BookEvent acceptEvent(uint64_t sequence, int uid, double price, int qnty, MarketSide side)
+{
+    BookEvent event = BookEvent::accepted(**Order::create(uid, Equity::AAPL, price, qnty, side));
+    event.sequence = sequence;
+    return event;
+}
+
+// uid -> outstanding quantity of every order resting in the book for underlying
+std::map<int, int> restingOrders(const matching::OrderBook& book, const Underlying& underlying)
+{
+    std::map<int, int> resting;
+
+    auto activeOrders = book.getActiveOrders(underlying);
+    if (!activeOrders)
+    {
+        return resting;
+    }
+
+    for (const auto& [uid, handle] : activeOrders->get().orderIndex)
+    {
+        resting[uid] = activeOrders->get().nodePool[handle].order->outstandingQnty();
+    }
+    return resting;
+}
+
+}  // namespace
+
+TEST(EventLogTests, WriterContinuesAfterEventsAlreadyInLog)
+{
+    const String prefix = logPrefix("solstice_continue.events");
+    removeLogs(prefix);
+    const String path = eventLogPath(prefix, 0);
+
+    for (uint64_t sequence : {1, 3})
+    {
+        auto writer = EventLogWriter::open(path, 1);
+        ASSERT_TRUE(writer.has_value());
+        EXPECT_EQ((*writer)->size(), sequence - 1);
+
+        std::vector<BookEvent> events{
+            acceptEvent(sequence, static_cast<int>(sequence), 10.0, 5, MarketSide::Bid),
+            acceptEvent(sequence + 1, static_cast<int>(sequence + 1), 11.0, 5, MarketSide::Ask)};
+        (*writer)->append(events);
+
+        ASSERT_TRUE((*writer)->close().has_value());
+    }
+
+    // closing trims the file down to the events written
+    EXPECT_EQ(std::filesystem::file_size(path), sizeof(EventLogHeader) + 4 * sizeof(BookEvent));
+
+    auto logs = EventLog::loadAll(prefix);
+    ASSERT_TRUE(logs.has_value());
+    ASSERT_EQ((*logs).size(), 1);
+
+    const auto events = (*logs)[0].events();
+    ASSERT_EQ(events.size(), 4);
+    for (size_t i = 0; i < events.size(); i++)
+    {
+        EXPECT_EQ(events[i].sequence, i + 1);
+        EXPECT_EQ(events[i].eventType(), BookEventType::Accept);
+        EXPECT_EQ(events[i].order.uid, static_cast<int>(i + 1));
+    }
+
+    removeLogs(prefix);
+}
+
+TEST(EventLogTests, LoadStopsWhereALogWasLeftPartlyWritten)
+{
+    const String prefix = logPrefix("solstice_torn.events");
+    removeLogs(prefix);
+    const String path = eventLogPath(prefix, 0);
+
+    {
+        auto writer = EventLogWriter::open(path, 0);
+        ASSERT_TRUE(writer.has_value());
+
+        std::vector<BookEvent> events{acceptEvent(1, 1, 10.0, 5, MarketSide::Bid),
+                                      acceptEvent(2, 2, 10.0, 5, MarketSide::Bid)};
+        (*writer)->append(events);
+    }
+
+    {
+        // a stale event from before a restart, then half an event cut short by a crash
+        std::ofstream file(path, std::ios::binary | std::ios::app);
+        BookEvent stale = acceptEvent(1, 9, 10.0, 5, MarketSide::Bid);
+        file.write(reinterpret_cast<const char*>(&stale), sizeof(stale));
+        file.write(reinterpret_cast<const char*>(&stale), sizeof(stale) / 2);
+    }
+
+    auto log = EventLog::load(path);
+    ASSERT_TRUE(log.has_value());
+    EXPECT_EQ((*log).events().size(), 2);
+
+    // a writer reopening the log writes over what follows the last good event
+    auto writer = EventLogWriter::open(path, 0);
+    ASSERT_TRUE(writer.has_value());
+    EXPECT_EQ((*writer)->size(), 2);
+
+    std::ofstream(logPrefix("solstice_torn.not_a_log")) << "not an event log";
+    EXPECT_FALSE(EventLog::load(logPrefix("solstice_torn.not_a_log")).has_value());
+    std::filesystem::remove(logPrefix("solstice_torn.not_a_log"));
+
+    removeLogs(prefix);
+}
+
+TEST(EventLogTests, AppliedEventsRebuildRestingOrders)
+{
+    auto liveBook = std::make_shared<matching::OrderBook>();
+    liveBook->initialiseUnderlying(Equity::AAPL);
+    matching::Matcher matcher(liveBook);
+
+    std::vector<BookEvent> events;
+    auto execute = [&](int uid, double price, int qnty, MarketSide side)
+    {
+        auto order = *Order::create(uid, Equity::AAPL, price, qnty, side);
+
+        std::vector<matching::Fill> fills;
+        (void)matcher.matchOrder(order, fills);
+
+        if (order->outstandingQnty() > 0)
+        {
+            liveBook->addOrderToBook(order);
+        }
+
+        events.push_back(BookEvent::accepted(*order));
+        for (const auto& fill : fills)
+        {
+            events.push_back(BookEvent::filled(*order, fill));
+        }
+    };
+
+    execute(1, 10.00, 10, MarketSide::Bid);
+    execute(2, 10.05, 4, MarketSide::Bid);
+    execute(3, 10.10, 7, MarketSide::Ask);
+    execute(4, 9.95, 12, MarketSide::Ask);
+    execute(5, 10.20, 3, MarketSide::Bid);
+
+    auto cancelled = liveBook->cancelOrder(Equity::AAPL, 3);
+    ASSERT_TRUE(cancelled.has_value());
+    events.push_back(BookEvent::cancelled(**cancelled));
+
+    for (size_t i = 0; i < events.size(); i++)
+    {
+        events[i].sequence = i + 1;
+    }
+
+    matching::OrderBook recoveredBook;
+    for (const auto& event : events)
+    {
+        ASSERT_TRUE(recoveredBook.applyEvent(event).has_value()) << "event " << event.sequence;
+    }
+
+    const auto resting = restingOrders(*liveBook, Equity::AAPL);
+    EXPECT_FALSE(resting.empty());
+    EXPECT_EQ(restingOrders(recoveredBook, Equity::AAPL), resting);
+    EXPECT_EQ(recoveredBook.topOfBook(Equity::AAPL, MarketSide::Bid),
+              liveBook->topOfBook(Equity::AAPL, MarketSide::Bid));
+    EXPECT_EQ(recoveredBook.topOfBook(Equity::AAPL, MarketSide::Ask),
+              liveBook->topOfBook(Equity::AAPL, MarketSide::Ask));
+
+    // a fill against an order the book has never seen means the log is not the book's
+    auto fill = std::ranges::find(events, BookEventType::Fill, &BookEvent::eventType);
+    ASSERT_NE(fill, events.end());
+
+    BookEvent unknownFill = *fill;
+    unknownFill.restingUid = 99;
+    EXPECT_FALSE(recoveredBook.applyEvent(unknownFill).has_value());
+}
+
+TEST(EventLogTests, RecoveryRestsTheSameOrdersAsReplayingEveryEvent)
+{
+    const String prefix = logPrefix("solstice_recover.events");
+    removeLogs(prefix);
+
+    auto config = *Config::instance();
+    config.ordersToGenerate(5000);
+    config.logLevel(LogLevel::ERROR);
+    config.matchingThreads(3);
+    config.shardedMatching(false);
+    config.eventLogPath(prefix);
+
+    std::optional<broadcaster::Broadcaster> broadcaster;
+    ASSERT_TRUE(matching::Orchestrator::start(config, broadcaster).has_value());
+
+    auto logs = EventLog::loadAll(prefix);
+    ASSERT_TRUE(logs.has_value());
+
+    std::vector<BookEvent> events;
+    for (const auto& log : *logs)
+    {
+        events.insert(events.end(), log.events().begin(), log.events().end());
+    }
+    std::ranges::sort(events, {}, &BookEvent::sequence);
+
+    matching::OrderBook replayedBook;
+    for (const auto& event : events)
+    {
+        ASSERT_TRUE(replayedBook.applyEvent(event).has_value()) << "event " << event.sequence;
+    }
+
+    auto recoveredBook = std::make_shared<matching::OrderBook>();
+    matching::Orchestrator orchestrator(config, recoveredBook,
+                                        std::make_shared<matching::Matcher>(recoveredBook),
+                                        std::make_shared<pricing::Pricer>(recoveredBook),
+                                        broadcaster);
+    ASSERT_TRUE(orchestrator.recoverBook().has_value());
+
+    std::set<Underlying> underlyings;
+    for (const auto& event : events)
+    {
+        underlyings.insert(event.order.toUnderlying());
+    }
+
+    size_t resting = 0;
+    for (const auto& underlying : underlyings)
+    {
+        const auto recovered = restingOrders(*recoveredBook, underlying);
+        EXPECT_EQ(recovered, restingOrders(replayedBook, underlying));
+        resting += recovered.size();
+    }
+    EXPECT_GT(resting, 0);
+
+    removeLogs(prefix);
+}
+
+TEST(EventLogTests, RecoveryCountsFillsLoggedBeforeACancelInAnotherLog)
+{
+    const String prefix = logPrefix("solstice_cancel.events");
+    removeLogs(prefix);
+
+    // a worker matches into its own log, log 1, while Orchestrator::cancelOrder logs to log 0. So
+    // a resting order part filled on a worker and then cancelled has its cancel in a log that is
+    // read before its fill
+    auto bid = *Order::create(1, Equity::AAPL, 100.0, 10, MarketSide::Bid);
+    auto ask = *Order::create(2, Equity::AAPL, 100.0, 4, MarketSide::Ask);
+
+    std::vector<BookEvent> workerEvents{
+        acceptEvent(1, 1, 100.0, 10, MarketSide::Bid),
+        acceptEvent(2, 2, 100.0, 4, MarketSide::Ask),
+        BookEvent::filled(*ask, matching::Fill{2, 1, ask->priceTicks(), 4, 0, 10, 6}),
+        acceptEvent(4, 3, 99.0, 5, MarketSide::Bid)};
+    workerEvents[2].sequence = 3;
+
+    BookEvent cancel = BookEvent::cancelled(*bid);
+    cancel.sequence = 5;
+
+    for (size_t i = 0; i < 2; i++)
+    {
+        auto writer = EventLogWriter::open(eventLogPath(prefix, i), 1);
+        ASSERT_TRUE(writer.has_value());
+        if (i == 0)
+        {
+            (*writer)->append({&cancel, 1});
+        }
+        else
+        {
+            (*writer)->append(workerEvents);
+        }
+        ASSERT_TRUE((*writer)->close().has_value());
+    }
+
+    auto config = *Config::instance();
+    config.logLevel(LogLevel::ERROR);
+    config.eventLogPath(prefix);
+
+    std::optional<broadcaster::Broadcaster> broadcaster;
+    auto recoveredBook = std::make_shared<matching::OrderBook>();
+    matching::Orchestrator orchestrator(config, recoveredBook,
+                                        std::make_shared<matching::Matcher>(recoveredBook),
+                                        std::make_shared<pricing::Pricer>(recoveredBook),
+                                        broadcaster);
+
+    auto recovered = orchestrator.recoverBook();
+    ASSERT_TRUE(recovered.has_value()) << recovered.error();
+
+    // the cancelled bid is not put back, and only the untouched bid rests
+    EXPECT_EQ(restingOrders(*recoveredBook, Equity::AAPL), (std::map<int, int>{{3, 5}}));
+
+    removeLogs(prefix);
+}
+
+TEST(EventLogTests, RecoveryResumesCallAuctionsStillOpen)
+{
+    const String prefix = logPrefix("solstice_auction.events");
+    removeLogs(prefix);
+
+    // AAPL is still in its call, with orders resting crossed, while MSFT's call has uncrossed
+    auto msftBid = *Order::create(3, Equity::MSFT, 50.0, 10, MarketSide::Bid);
+    auto msftAsk = *Order::create(4, Equity::MSFT, 49.0, 6, MarketSide::Ask);
+
+    std::vector<BookEvent> events{
+        BookEvent::auctionStarted(Equity::AAPL),
+        acceptEvent(0, 1, 100.0, 10, MarketSide::Bid),
+        acceptEvent(0, 2, 99.0, 4, MarketSide::Ask),
+        BookEvent::auctionStarted(Equity::MSFT),
+        BookEvent::accepted(*msftBid),
+        BookEvent::accepted(*msftAsk),
+        BookEvent::filled(Equity::MSFT, MarketSide::Bid,
+                          matching::Fill{3, 4, msftBid->priceTicks(), 6, 4, 6, 0}),
+        BookEvent::uncrossed(Equity::MSFT)};
+    for (size_t i = 0; i < events.size(); i++)
+    {
+        events[i].sequence = i + 1;
+    }
+
+    {
+        auto writer = EventLogWriter::open(eventLogPath(prefix, 0), 1);
+        ASSERT_TRUE(writer.has_value());
+        (*writer)->append(events);
+        ASSERT_TRUE((*writer)->close().has_value());
+    }
+
+    auto config = *Config::instance();
+    config.logLevel(LogLevel::ERROR);
+    config.eventLogPath(prefix);
+
+    std::optional<broadcaster::Broadcaster> broadcaster;
+    auto recoveredBook = std::make_shared<matching::OrderBook>();
+    matching::Orchestrator orchestrator(config, recoveredBook,
+                                        std::make_shared<matching::Matcher>(recoveredBook),
+                                        std::make_shared<pricing::Pricer>(recoveredBook),
+                                        broadcaster);
+
+    auto recovered = orchestrator.recoverBook();
+    ASSERT_TRUE(recovered.has_value()) << recovered.error();
+
+    matching::OrderBook replayedBook;
+    for (const auto& event : events)
+    {
+        ASSERT_TRUE(replayedBook.applyEvent(event).has_value()) << "event " << event.sequence;
+    }
+
+    for (const matching::OrderBook* book : {recoveredBook.get(), &replayedBook})
+    {
+        EXPECT_TRUE(book->inAuction(Equity::AAPL));
+        EXPECT_FALSE(book->inAuction(Equity::MSFT));
+        EXPECT_EQ(restingOrders(*book, Equity::AAPL), (std::map<int, int>{{1, 10}, {2, 4}}));
+        EXPECT_EQ(restingOrders(*book, Equity::MSFT), (std::map<int, int>{{3, 4}}));
+    }
+
+    removeLogs(prefix);
+}
+
+TEST(EventLogTests, RestartRecoversBookFromEveryWorkersLog)
+{
+    const String prefix = logPrefix("solstice_restart.events");
+    removeLogs(prefix);
+
+    auto config = *Config::instance();
+    config.ordersToGenerate(2000);
+    config.logLevel(LogLevel::ERROR);
+    config.matchingThreads(2);
+    config.eventLogPath(prefix);
+
+    std::optional<broadcaster::Broadcaster> broadcaster;
+
+    uint64_t previousEvents = 0;
+    for (bool sharded : {true, false, true})
+    {
+        config.shardedMatching(sharded);
+        ASSERT_TRUE(matching::Orchestrator::start(config, broadcaster).has_value());
+
+        auto logs = EventLog::loadAll(prefix);
+        ASSERT_TRUE(logs.has_value());
+
+        // every run continues the sequence of the one before, which only holds if recovering
+        // the earlier runs' events succeeded
+        std::vector<uint64_t> sequences;
+        size_t accepted = 0;
+        for (const auto& log : *logs)
+        {
+            for (const auto& event : log.events())
+            {
+                sequences.push_back(event.sequence);
+                accepted += event.eventType() == BookEventType::Accept;
+            }
+        }
+
+        std::ranges::sort(sequences);
+        ASSERT_GT(sequences.size(), previousEvents);
+        EXPECT_GE(accepted, 2000);
+        for (size_t i = 0; i < sequences.size(); i++)
+        {
+            ASSERT_EQ(sequences[i], i + 1);
+        }
+
+        previousEvents = sequences.size();
+    }
+
+    removeLogs(prefix);
+}
+
+}  // namespace solstice
@@ -0,0 +1,66 @@
+#include <asset_class.h>
+#include <gtest/gtest.h>
+#include <instrument_registry.h>
+#include <order.h>
+#include <order_book.h>
+
+namespace solstice
+{
+
+TEST(InstrumentRegistryTests, IdsAreDenseInOrderAdded)
+{
+    InstrumentRegistry registry;
+
+    EXPECT_TRUE(registry.empty());
+    EXPECT_EQ(registry.add(Option::TSLA_DEC26_P), 0u);
+    EXPECT_EQ(registry.add(Equity::AAPL), 1u);
+    EXPECT_EQ(registry.add(Future::AAPL_MAR26), 2u);
+
+    // adding again returns the id already given
+    EXPECT_EQ(registry.add(Equity::AAPL), 1u);
+    EXPECT_EQ(registry.size(), 3u);
+
+    EXPECT_EQ(registry.underlying(0), Option::TSLA_DEC26_P);
+    EXPECT_EQ(registry.underlying(2), Future::AAPL_MAR26);
+}
+
+TEST(InstrumentRegistryTests, FindDistinguishesAssetClasses)
+{
+    InstrumentRegistry registry;
+    registry.add(Equity::MSFT);
+
+    // the first future and option share Equity::MSFT's enum value, not its id
+    static_assert(static_cast<int>(Equity::MSFT) == static_cast<int>(Future::AAPL_JUN26));
+    EXPECT_EQ(registry.find(Equity::MSFT), 0u);
+    EXPECT_FALSE(registry.find(Future::AAPL_JUN26).has_value());
+    EXPECT_FALSE(registry.contains(Option::AAPL_JUN26_C));
+}
+
+TEST(InstrumentRegistryTests, OrderBookNumbersUnderlyingsAsBooksOpen)
+{
+    matching::OrderBook book;
+    EXPECT_TRUE(book.instruments().empty());
+
+    auto order = Order::create(1, Future::NVDA_SEP26, 100.0, 10, MarketSide::Bid);
+    ASSERT_TRUE(order.has_value());
+
+    // adding an order never opens its underlying, as matching threads may be reading the registry
+    auto added = book.addOrderToBook(*order);
+    ASSERT_FALSE(added.has_value());
+    EXPECT_EQ(added.error().code(), MatchError::NoBook);
+    EXPECT_TRUE(book.instruments().empty());
+
+    book.initialiseUnderlying(Future::NVDA_SEP26);
+    book.initialiseUnderlying(Equity::NVDA);
+    EXPECT_TRUE(book.addOrderToBook(*order).has_value());
+
+    ASSERT_EQ(book.instruments().size(), 2u);
+    EXPECT_EQ(book.instruments().find(Future::NVDA_SEP26), 0u);
+    EXPECT_EQ(book.instruments().find(Equity::NVDA), 1u);
+
+    EXPECT_TRUE(book.hasOrder(Future::NVDA_SEP26, 1));
+    EXPECT_TRUE(book.tradeTape(Equity::NVDA).has_value());
+    EXPECT_FALSE(book.getActiveOrders(Equity::TSLA).has_value());
+}
+
+}  // namespace solstice
@@ -0,0 +1,194 @@
+#include <asset_class.h>
+#include <gtest/gtest.h>
+#include <instrument_registry.h>
+#include <instrument_universe.h>
+#include <option_type.h>
+#include <options.h>
+#include <ticks.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+namespace solstice
+{
+
+namespace
+{
+
+String instrumentsPath(const char* name)
+{
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+String writeInstruments(const char* name, const char* contents)
+{
+    const String path = instrumentsPath(name);
+    std::ofstream(path) << contents;
+    return path;
+}
+
+constexpr const char* DEFINITIONS =
+    "# test universe\n"
+    "symbol,asset_class,tick_size,underlying,strike,expiry,option_type\n"
+    "ACME_MAR27_150_C,Option,0.05,ACME,150,2027-03,Call\n"
+    "ACME,Equity,0.01,,,,\n"
+    "\n"
+    "ACME_MAR27,Future,0.25,ACME,,2027-03-19,\n"
+    "AAPL,Equity,0.05,,,,\n";
+
+}  // namespace
+
+class InstrumentUniverseTests : public ::testing::Test
+{
+   protected:
+    void SetUp() override { resetPools(); }
+
+    void TearDown() override
+    {
+        resetInstruments();
+        resetPools();
+    }
+
+    static void resetPools()
+    {
+        d_underlyingsPool<Equity> = {};
+        d_underlyingsPool<Future> = {};
+        d_underlyingsPool<Option> = {};
+        d_underlyingsPoolInitialised<Equity> = false;
+        d_underlyingsPoolInitialised<Future> = false;
+        d_underlyingsPoolInitialised<Option> = false;
+    }
+};
+
+TEST_F(InstrumentUniverseTests, BuiltInInstrumentsAreDefined)
+{
+    EXPECT_EQ(instrumentCount<Equity>(), static_cast<size_t>(Equity::COUNT));
+    EXPECT_STREQ(to_string(Option::TSLA_DEC26_P), "TSLA_DEC26_P");
+
+    const auto& future = instrumentDefinition(Future::NVDA_SEP26);
+    EXPECT_EQ(future.underlyingEquity, Equity::NVDA);
+    EXPECT_EQ(future.expiryMonth, 9);
+    EXPECT_EQ(future.expiryYear, 2026);
+
+    // the pricer picks a built-in option's strike and type
+    EXPECT_FALSE(instrumentDefinition(Option::AAPL_MAR26_C).optionType.has_value());
+    EXPECT_EQ(std::get<Equity>(*findInstrument("MSFT")), Equity::MSFT);
+}
+
+TEST_F(InstrumentUniverseTests, LoadsDefinitionsFile)
+{
+    const String path = writeInstruments("solstice_instruments_load.csv", DEFINITIONS);
+
+    auto loaded = loadInstruments(path);
+    ASSERT_TRUE(loaded.has_value()) << loaded.error();
+
+    auto acme = findInstrument("ACME");
+    ASSERT_TRUE(acme.has_value());
+    const Equity equity = std::get<Equity>(*acme);
+    EXPECT_EQ(static_cast<size_t>(equity), static_cast<size_t>(Equity::COUNT));
+
+    auto option = std::get<Option>(*findInstrument("ACME_MAR27_150_C"));
+    EXPECT_EQ(*extractUnderlyingEquity(option), equity);
+    EXPECT_EQ(instrumentDefinition(option).strike, 150.0);
+    EXPECT_EQ(instrumentDefinition(option).optionType, OptionType::Call);
+    EXPECT_EQ(tickSize(option), 0.05);
+
+    auto future = std::get<Future>(*findInstrument("ACME_MAR27"));
+    EXPECT_EQ(tickSize(future), 0.25);
+    EXPECT_EQ(instrumentDefinition(future).expiryMonth, 3);
+    EXPECT_EQ(toTicks(100.25, future), 401);
+
+    // a built-in symbol is redefined in place rather than added again
+    EXPECT_EQ(std::get<Equity>(*findInstrument("AAPL")), Equity::AAPL);
+    EXPECT_EQ(tickSize(Equity::AAPL), 0.05);
+    EXPECT_EQ(instrumentCount<Equity>(), static_cast<size_t>(Equity::COUNT) + 1);
+
+    // only the file's instruments are tradable
+    auto equities = tradableUnderlyings<Equity>();
+    ASSERT_EQ(equities.size(), 2u);
+    EXPECT_EQ(equities[0], equity);
+    EXPECT_EQ(equities[1], Equity::AAPL);
+
+    resetInstruments();
+    EXPECT_FALSE(findInstrument("ACME").has_value());
+    EXPECT_EQ(tickSize(Equity::AAPL), EQUITY_TICK_SIZE);
+}
+
+TEST_F(InstrumentUniverseTests, PoolsDrawFromLoadedInstruments)
+{
+    const String path = writeInstruments("solstice_instruments_pool.csv", DEFINITIONS);
+    ASSERT_TRUE(loadInstruments(path).has_value());
+
+    setUnderlyingsPool<Future>(10);
+    ASSERT_EQ(underlyingsPool<Future>().size(), 1u);
+    EXPECT_EQ(*randomUnderlying<Future>(), std::get<Future>(*findInstrument("ACME_MAR27")));
+
+    setUnderlyingsPool<Equity>(1);
+    auto equities = tradableUnderlyings<Equity>();
+    ASSERT_EQ(underlyingsPool<Equity>().size(), 1u);
+    EXPECT_NE(std::ranges::find(equities, underlyingsPool<Equity>()[0]), equities.end());
+}
+
+TEST_F(InstrumentUniverseTests, RegistryNumbersLoadedInstruments)
+{
+    const String path = writeInstruments("solstice_instruments_registry.csv", DEFINITIONS);
+    ASSERT_TRUE(loadInstruments(path).has_value());
+
+    const Underlying acme = *findInstrument("ACME");
+
+    InstrumentRegistry registry;
+    EXPECT_FALSE(registry.find(acme).has_value());
+    EXPECT_EQ(registry.add(Equity::AAPL), 0u);
+    EXPECT_EQ(registry.add(acme), 1u);
+    EXPECT_EQ(registry.find(acme), 1u);
+}
+
+TEST_F(InstrumentUniverseTests, ReportsTheLineOfABadDefinition)
+{
+    const String path = writeInstruments("solstice_instruments_bad.csv",
+                                         "symbol,asset_class,tick_size,underlying,strike,expiry,"
+                                         "option_type\n"
+                                         "ACME,Equity,0.01,,,,\n"
+                                         "ACME_C,Option,0.01,ACME,abc,2027-03,Call\n");
+
+    auto loaded = loadInstruments(path);
+    ASSERT_FALSE(loaded.has_value());
+    EXPECT_NE(loaded.error().find(":3:"), String::npos) << loaded.error();
+
+    // nothing is added when the file fails
+    EXPECT_FALSE(findInstrument("ACME").has_value());
+}
+
+TEST_F(InstrumentUniverseTests, RejectsInvalidInstruments)
+{
+    InstrumentDefinition option;
+    option.symbol = "ACME_C";
+    option.assetClass = AssetClass::Option;
+    option.underlying = "ACME";
+    option.expiryYear = 2027;
+    option.expiryMonth = 3;
+    option.strike = 100.0;
+    option.optionType = OptionType::Put;
+
+    // the underlying must be an equity
+    EXPECT_FALSE(addInstruments(std::span(&option, 1)).has_value());
+
+    option.underlying = "AAPL";
+    option.tickSize = 0.03;
+    EXPECT_FALSE(addInstruments(std::span(&option, 1)).has_value());
+
+    option.tickSize = 0.05;
+    option.strike = 0.0;
+    EXPECT_FALSE(addInstruments(std::span(&option, 1)).has_value());
+
+    option.strike = 100.0;
+    EXPECT_TRUE(addInstruments(std::span(&option, 1)).has_value());
+
+    // a symbol can't change asset class
+    InstrumentDefinition equity;
+    equity.symbol = "ACME_C";
+    EXPECT_FALSE(addInstruments(std::span(&equity, 1)).has_value());
+}
+
+}  // namespace solstice
@@ -3,6 +3,8 @@
 #include <options.h>
 #include <order_book.h>
 
+#include <array>
+
 namespace solstice::matching
 {
 
@@ -128,6 +130,351 @@ TEST_F(MatcherFixture, MatchOrderWithIncomingOrderLargerThanResting)
     EXPECT_EQ((*bidOrder)->outstandingQnty(), 5.0);
 }
 
+TEST_F(MatcherFixture, MatchOrderSweepsMultiplePriceLevels)
+{
+    auto askOrder1 = Order::create(1, Equity::AAPL, 100.0, 4.0, MarketSide::Ask);
+    auto askOrder2 = Order::create(2, Equity::AAPL, 101.0, 6.0, MarketSide::Ask);
+    ASSERT_TRUE(askOrder1.has_value());
+    ASSERT_TRUE(askOrder2.has_value());
+    orderBook->addOrderToBook(*askOrder1);
+    orderBook->addOrderToBook(*askOrder2);
+
+    auto bidOrder = Order::create(3, Equity::AAPL, 102.0, 10.0, MarketSide::Bid);
+    ASSERT_TRUE(bidOrder.has_value());
+    orderBook->addOrderToBook(*bidOrder);
+
+    auto result = matcher->matchOrder(*bidOrder);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ((*bidOrder)->outstandingQnty(), 0);
+    EXPECT_FALSE(orderBook->topOfBook(Equity::AAPL, MarketSide::Ask).has_value());
+}
+
+TEST_F(MatcherFixture, MatchOrderAppendsEachFillToTheTradeTape)
+{
+    auto askOrder1 = Order::create(1, Equity::AAPL, 100.0, 4.0, MarketSide::Ask);
+    auto askOrder2 = Order::create(2, Equity::AAPL, 101.0, 6.0, MarketSide::Ask);
+    ASSERT_TRUE(askOrder1.has_value());
+    ASSERT_TRUE(askOrder2.has_value());
+    orderBook->addOrderToBook(*askOrder1);
+    orderBook->addOrderToBook(*askOrder2);
+
+    auto bidOrder = Order::create(3, Equity::AAPL, 102.0, 10.0, MarketSide::Bid);
+    ASSERT_TRUE(bidOrder.has_value());
+    orderBook->addOrderToBook(*bidOrder);
+    ASSERT_TRUE(matcher->matchOrder(*bidOrder).has_value());
+
+    auto tape = orderBook->tradeTape(Equity::AAPL);
+    ASSERT_TRUE(tape.has_value());
+
+    const TradeRange trades = tape->get().all();
+    ASSERT_EQ(trades.size(), 2);
+
+    EXPECT_EQ(trades[0].bidUid(), 3);
+    EXPECT_EQ(trades[0].askUid(), 1);
+    EXPECT_EQ(trades[0].priceTicks(), toTicks(100.0, Equity::AAPL));
+    EXPECT_EQ(trades[0].qnty(), 4);
+
+    EXPECT_EQ(trades[1].bidUid(), 3);
+    EXPECT_EQ(trades[1].askUid(), 2);
+    EXPECT_DOUBLE_EQ(trades[1].price(), 101.0);
+    EXPECT_EQ(trades[1].qnty(), 6);
+    EXPECT_GT(trades[1].sequence(), trades[0].sequence());
+}
+
+TEST_F(MatcherFixture, MatchOrderRecordsFillsInPriceTimePriority)
+{
+    auto askOrder1 = Order::create(1, Equity::AAPL, 100.0, 4.0, MarketSide::Ask);
+    auto askOrder2 = Order::create(2, Equity::AAPL, 100.0, 3.0, MarketSide::Ask);
+    auto askOrder3 = Order::create(3, Equity::AAPL, 101.0, 6.0, MarketSide::Ask);
+    orderBook->addOrderToBook(*askOrder1);
+    orderBook->addOrderToBook(*askOrder2);
+    orderBook->addOrderToBook(*askOrder3);
+
+    auto bidOrder = Order::create(4, Equity::AAPL, 101.0, 10.0, MarketSide::Bid);
+    ASSERT_TRUE(bidOrder.has_value());
+
+    auto result = matcher->matchOrder(*bidOrder);
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ((*result).size(), 3);
+
+    const auto& fills = *result;
+    EXPECT_EQ(fills[0].restingUid, 1);
+    EXPECT_EQ(fills[0].qnty, 4);
+    EXPECT_EQ(fills[0].price, toTicks(100.0, Equity::AAPL));
+    EXPECT_EQ(fills[1].restingUid, 2);
+    EXPECT_EQ(fills[1].qnty, 3);
+    EXPECT_EQ(fills[2].restingUid, 3);
+    EXPECT_EQ(fills[2].qnty, 3);
+    EXPECT_EQ(fills[2].price, toTicks(101.0, Equity::AAPL));
+    EXPECT_EQ(fills[2].incomingRemainingQnty, 0);
+    EXPECT_EQ(fills[2].restingRemainingQnty, 3);
+}
+
+TEST_F(MatcherFixture, MatchOrderKeepsPartialFillsOnFailure)
+{
+    auto askOrder = Order::create(1, Equity::AAPL, 100.0, 4.0, MarketSide::Ask);
+    orderBook->addOrderToBook(*askOrder);
+
+    auto bidOrder = Order::create(2, Equity::AAPL, 100.0, 10.0, MarketSide::Bid);
+    ASSERT_TRUE(bidOrder.has_value());
+
+    std::vector<Fill> fills;
+    auto result = matcher->matchOrder(*bidOrder, fills);
+
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error().code(), MatchError::InsufficientOrders);
+    ASSERT_EQ(fills.size(), 1);
+    EXPECT_EQ(fills[0].qnty, 4);
+    EXPECT_EQ((*bidOrder)->outstandingQnty(), 6);
+}
+
+TEST_F(MatcherFixture, MatchOrderKeepsLevelQuantitiesInStep)
+{
+    orderBook->addOrderToBook(*Order::create(1, Equity::AAPL, 100.0, 4.0, MarketSide::Ask));
+    orderBook->addOrderToBook(*Order::create(2, Equity::AAPL, 100.0, 8.0, MarketSide::Ask));
+
+    auto bidOrder = *Order::create(3, Equity::AAPL, 100.0, 10.0, MarketSide::Bid);
+    ASSERT_TRUE(matcher->matchOrder(bidOrder).has_value());
+
+    std::array<DepthLevel, 2> levels;
+    ASSERT_EQ(orderBook->depth(Equity::AAPL, MarketSide::Ask, levels), 1);
+    EXPECT_EQ(levels[0].qnty, 2);
+    EXPECT_EQ(levels[0].orders, 1);
+    EXPECT_EQ(orderBook->depth(Equity::AAPL, MarketSide::Bid, levels), 0);
+}
+
+TEST_F(MatcherFixture, ImmediateOrCancelNeverEntersTheBook)
+{
+    orderBook->addOrderToBook(*Order::create(1, Equity::AAPL, 100.0, 4.0, MarketSide::Ask));
+    orderBook->addOrderToBook(*Order::create(2, Equity::AAPL, 101.0, 4.0, MarketSide::Ask));
+
+    auto bidOrder = *Order::create(3, Equity::AAPL, 100.0, 10.0, MarketSide::Bid);
+    bidOrder->timeInForce(TimeInForce::ImmediateOrCancel);
+
+    std::vector<Fill> fills;
+    auto result = matcher->matchOrder(bidOrder, fills);
+
+    // fills what it can at its price, and the rest is never added
+    ASSERT_FALSE(result.has_value());
+    ASSERT_EQ(fills.size(), 1);
+    EXPECT_EQ(bidOrder->outstandingQnty(), 6);
+    EXPECT_FALSE(orderBook->hasOrder(Equity::AAPL, 3));
+    EXPECT_FALSE(orderBook->topOfBook(Equity::AAPL, MarketSide::Bid).has_value());
+    EXPECT_EQ(orderBook->topOfBook(Equity::AAPL, MarketSide::Ask), toTicks(101.0, Equity::AAPL));
+}
+
+TEST_F(MatcherFixture, MarketOrderSweepsPastItsPrice)
+{
+    orderBook->addOrderToBook(*Order::create(1, Equity::AAPL, 100.0, 4.0, MarketSide::Bid));
+    orderBook->addOrderToBook(*Order::create(2, Equity::AAPL, 90.0, 4.0, MarketSide::Bid));
+
+    auto askOrder = *Order::create(3, Equity::AAPL, 100.0, 6.0, MarketSide::Ask);
+    askOrder->priceType(PriceType::Market);
+
+    auto fills = matcher->matchOrder(askOrder);
+    ASSERT_TRUE(fills.has_value());
+    ASSERT_EQ((*fills).size(), 2);
+    EXPECT_EQ((*fills)[1].price, toTicks(90.0, Equity::AAPL));
+    EXPECT_TRUE(askOrder->matched());
+    EXPECT_EQ(askOrder->matchedPriceTicks(), toTicks(90.0, Equity::AAPL));
+    EXPECT_FALSE(orderBook->hasOrder(Equity::AAPL, 3));
+}
+
+TEST_F(MatcherFixture, FillOrKillIsKilledWithoutTrading)
+{
+    orderBook->addOrderToBook(*Order::create(1, Equity::AAPL, 100.0, 4.0, MarketSide::Ask));
+    orderBook->addOrderToBook(*Order::create(2, Equity::AAPL, 101.0, 4.0, MarketSide::Ask));
+    orderBook->addOrderToBook(*Order::create(3, Equity::AAPL, 102.0, 4.0, MarketSide::Ask));
+
+    // 8 resting within its price, 12 in all
+    auto bidOrder = *Order::create(4, Equity::AAPL, 101.0, 10.0, MarketSide::Bid);
+    bidOrder->timeInForce(TimeInForce::FillOrKill);
+
+    std::vector<Fill> fills;
+    auto result = matcher->matchOrder(bidOrder, fills);
+
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error().code(), MatchError::InsufficientLiquidity);
+    EXPECT_TRUE(fills.empty());
+    EXPECT_EQ(bidOrder->outstandingQnty(), 10);
+
+    std::array<DepthLevel, 3> levels;
+    EXPECT_EQ(orderBook->depth(Equity::AAPL, MarketSide::Ask, levels), 3);
+    EXPECT_EQ(levels[0].qnty, 4);
+
+    bidOrder->price(102.0);
+    ASSERT_TRUE(matcher->matchOrder(bidOrder, fills).has_value());
+    EXPECT_EQ(fills.size(), 3);
+    EXPECT_EQ(orderBook->depth(Equity::AAPL, MarketSide::Ask, levels), 1);
+    EXPECT_EQ(levels[0].qnty, 2);
+}
+
+TEST_F(MatcherFixture, MatchOrderWaitsForAuctionToUncross)
+{
+    orderBook->addOrderToBook(*Order::create(1, Equity::AAPL, 100.0, 4.0, MarketSide::Ask));
+    orderBook->startAuction(Equity::AAPL);
+
+    auto bidOrder = *Order::create(2, Equity::AAPL, 101.0, 4.0, MarketSide::Bid);
+
+    std::vector<Fill> fills;
+    auto result = matcher->matchOrder(bidOrder, fills);
+
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error().code(), MatchError::InAuction);
+    EXPECT_TRUE(fills.empty());
+    EXPECT_EQ(bidOrder->outstandingQnty(), 4);
+}
+
+TEST_F(MatcherFixture, MatchOrderReportsEmptyOppositeSide)
+{
+    auto bidOrder = Order::create(1, Equity::AAPL, 100.0, 10.0, MarketSide::Bid);
+    orderBook->addOrderToBook(*bidOrder);
+
+    auto result = matcher->matchOrder(*bidOrder);
+
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error().code(), MatchError::NoAskOrders);
+    EXPECT_EQ(result.error().context(), Underlying{Equity::AAPL});
+    EXPECT_EQ(result.error().message(), "No ask orders found for ticker AAPL\n");
+}
+
+TEST_F(MatcherFixture, MatchOrderReportsNoAsksWithinPrice)
+{
+    auto askOrder = Order::create(1, Equity::AAPL, 105.0, 10.0, MarketSide::Ask);
+    orderBook->addOrderToBook(*askOrder);
+
+    auto bidOrder = Order::create(2, Equity::AAPL, 100.0, 10.0, MarketSide::Bid);
+    ASSERT_TRUE(bidOrder.has_value());
+
+    auto result = matcher->matchOrder(*bidOrder);
+
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error().code(), MatchError::NoAsksWithinPrice);
+}
+
+TEST_F(MatcherFixture, FormatFillsDescribesBothOrders)
+{
+    auto askOrder = Order::create(1, Equity::AAPL, 100.0, 10.0, MarketSide::Ask);
+    orderBook->addOrderToBook(*askOrder);
+
+    auto bidOrder = Order::create(2, Equity::AAPL, 100.0, 10.0, MarketSide::Bid);
+    ASSERT_TRUE(bidOrder.has_value());
+
+    auto result = matcher->matchOrder(*bidOrder);
+    ASSERT_TRUE(result.has_value());
+
+    const String output = matcher->formatFills(*bidOrder, *result);
+    EXPECT_NE(output.find("Order: 2 | Asset class: Equity | Status: Matched | Matched with: 1"),
+              String::npos);
+    EXPECT_NE(output.find("Order: 1 | Asset class: Equity | Status: Matched | Matched with: 2"),
+              String::npos);
+    EXPECT_NE(output.find("[FULFILLED]"), String::npos);
+}
+
+class LadderMatcherFixture : public MatcherFixture
+{
+   protected:
+    void SetUp() override
+    {
+        MatcherFixture::SetUp();
+
+        orderBook = std::make_shared<OrderBook>(BookBackend::Ladder);
+        matcher = std::make_shared<Matcher>(orderBook);
+        orderBook->initialiseBookAtUnderlyings<Equity>();
+    }
+};
+
+TEST_F(LadderMatcherFixture, MatchOrderWithMultiplePartialFills)
+{
+    auto bidOrder1 = Order::create(1, Equity::AAPL, 100.0, 3.0, MarketSide::Bid);
+    auto bidOrder2 = Order::create(2, Equity::AAPL, 100.0, 3.0, MarketSide::Bid);
+    auto bidOrder3 = Order::create(3, Equity::AAPL, 99.0, 4.0, MarketSide::Bid);
+    orderBook->addOrderToBook(*bidOrder1);
+    orderBook->addOrderToBook(*bidOrder2);
+    orderBook->addOrderToBook(*bidOrder3);
+
+    auto askOrder = Order::create(4, Equity::AAPL, 99.0, 10.0, MarketSide::Ask);
+    ASSERT_TRUE(askOrder.has_value());
+
+    auto result = matcher->matchOrder(*askOrder);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ((*askOrder)->outstandingQnty(), 0);
+    EXPECT_FALSE(orderBook->topOfBook(Equity::AAPL, MarketSide::Bid).has_value());
+    EXPECT_FALSE(orderBook->topOfBook(Equity::AAPL, MarketSide::Ask).has_value());
+}
+
+TEST_F(LadderMatcherFixture, FillOrKillChecksTheLadder)
+{
+    orderBook->addOrderToBook(*Order::create(1, Equity::AAPL, 100.0, 3.0, MarketSide::Bid));
+    orderBook->addOrderToBook(*Order::create(2, Equity::AAPL, 99.0, 3.0, MarketSide::Bid));
+
+    auto askOrder = *Order::create(3, Equity::AAPL, 99.0, 7.0, MarketSide::Ask);
+    askOrder->timeInForce(TimeInForce::FillOrKill);
+    EXPECT_FALSE(orderBook->canFill(*askOrder));
+
+    askOrder->outstandingQnty(6);
+    EXPECT_TRUE(orderBook->canFill(*askOrder));
+    ASSERT_TRUE(matcher->matchOrder(askOrder).has_value());
+    EXPECT_FALSE(orderBook->topOfBook(Equity::AAPL, MarketSide::Bid).has_value());
+}
+
+TEST_F(LadderMatcherFixture, MatchOrderFailsWhenPriceOutOfRange)
+{
+    auto bidOrder = Order::create(1, Equity::AAPL, 95.0, 10.0, MarketSide::Bid);
+    ASSERT_TRUE(bidOrder.has_value());
+    orderBook->addOrderToBook(*bidOrder);
+
+    auto askOrder = Order::create(2, Equity::AAPL, 100.0, 10.0, MarketSide::Ask);
+    ASSERT_TRUE(askOrder.has_value());
+
+    auto result = matcher->matchOrder(*askOrder);
+    ASSERT_FALSE(result.has_value());
+}
+
+TEST_F(LadderMatcherFixture, FirstOrderOfANewSeriesFindsNoBook)
+{
+    orderBook->initialiseUnderlying(Option::AAPL_JUN26_C);
+
+    // matched before it rests, so its series has no book yet
+    auto bidOption = OptionOrder::create(1, Option::AAPL_JUN26_C, 5.0, 10, MarketSide::Bid, 150.0,
+                                         OptionType::Call, 0.5);
+    ASSERT_TRUE(bidOption.has_value());
+
+    auto result = matcher->matchOrder(*bidOption);
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error().code(), MatchError::NoBook);
+
+    ASSERT_TRUE(orderBook->addOrderToBook(*bidOption).has_value());
+    auto askOption = OptionOrder::create(2, Option::AAPL_JUN26_C, 5.0, 10, MarketSide::Ask, 150.0,
+                                         OptionType::Call, 0.5);
+    ASSERT_TRUE(askOption.has_value());
+    EXPECT_TRUE(matcher->matchOrder(*askOption).has_value());
+
+    // nor does an underlying that was never initialised
+    auto msftOrder = Order::create(3, Equity::MSFT, 100.0, 10.0, MarketSide::Ask);
+    ASSERT_TRUE(msftOrder.has_value());
+    auto unknown = matcher->matchOrder(*msftOrder);
+    ASSERT_FALSE(unknown.has_value());
+    EXPECT_EQ(unknown.error().code(), MatchError::NoBook);
+}
+
+TEST_F(LadderMatcherFixture, ExtremePriceRestsWithoutGrowingTheLadderToReachIt)
+{
+    orderBook->addOrderToBook(*Order::create(1, Equity::AAPL, 100.0, 10.0, MarketSide::Ask));
+    orderBook->addOrderToBook(*Order::create(2, Equity::AAPL, 1e9, 10.0, MarketSide::Ask));
+
+    // the far ask takes one overflow level rather than a window spanning the distance
+    EXPECT_LE(orderBook->bookMemory(Equity::AAPL).levels, LADDER_MAX_LEVELS + 1);
+    EXPECT_EQ(*orderBook->topOfBook(Equity::AAPL, MarketSide::Ask), toTicks(100.0, Equity::AAPL));
+
+    // a bid priced through both levels fills against each in turn
+    auto bidOrder = Order::create(3, Equity::AAPL, 1e9, 20.0, MarketSide::Bid);
+    ASSERT_TRUE(bidOrder.has_value());
+    ASSERT_TRUE(matcher->matchOrder(*bidOrder).has_value());
+    EXPECT_EQ((*bidOrder)->outstandingQnty(), 0);
+    EXPECT_FALSE(orderBook->topOfBook(Equity::AAPL, MarketSide::Ask).has_value());
+}
+
 class OptionMatcherFixture : public ::testing::Test
 {
    protected:
@@ -154,13 +501,13 @@ class OptionMatcherFixture : public ::testing::Test
 
 TEST_F(OptionMatcherFixture, OptionsMatchWhenAllAttributesMatch)
 {
-    auto bidOption = OptionOrder::create(1, Option::AAPL_JUN26_C, 5.0, 10, MarketSide::Bid,
-                                         timeNow(), 150.0, OptionType::Call, 0.5);
+    auto bidOption = OptionOrder::create(1, Option::AAPL_JUN26_C, 5.0, 10, MarketSide::Bid, 150.0,
+                                         OptionType::Call, 0.5);
     ASSERT_TRUE(bidOption.has_value());
     orderBook->addOrderToBook(*bidOption);
 
-    auto askOption = OptionOrder::create(2, Option::AAPL_JUN26_C, 5.0, 10, MarketSide::Ask,
-                                         timeNow(), 150.0, OptionType::Call, 0.5);
+    auto askOption = OptionOrder::create(2, Option::AAPL_JUN26_C, 5.0, 10, MarketSide::Ask, 150.0,
+                                         OptionType::Call, 0.5);
     ASSERT_TRUE(askOption.has_value());
 
     auto result = matcher->matchOrder(*askOption);
@@ -169,50 +516,149 @@ TEST_F(OptionMatcherFixture, OptionsMatchWhenAllAttributesMatch)
 
 TEST_F(OptionMatcherFixture, OptionsDoNotMatchWhenStrikeDiffers)
 {
-    auto bidOption = OptionOrder::create(1, Option::AAPL_JUN26_C, 5.0, 10, MarketSide::Bid,
-                                         timeNow(), 150.0, OptionType::Call, 0.5);
+    auto bidOption = OptionOrder::create(1, Option::AAPL_JUN26_C, 5.0, 10, MarketSide::Bid, 150.0,
+                                         OptionType::Call, 0.5);
     ASSERT_TRUE(bidOption.has_value());
     orderBook->addOrderToBook(*bidOption);
 
-    auto askOption = OptionOrder::create(2, Option::AAPL_JUN26_C, 5.0, 10, MarketSide::Ask,
-                                         timeNow(), 155.0, OptionType::Call, 0.5);
+    auto askOption = OptionOrder::create(2, Option::AAPL_JUN26_C, 5.0, 10, MarketSide::Ask, 155.0,
+                                         OptionType::Call, 0.5);
     ASSERT_TRUE(askOption.has_value());
+    orderBook->addOrderToBook(*askOption);
 
+    // each rests alone in its own series' book
     auto result = matcher->matchOrder(*askOption);
     ASSERT_FALSE(result.has_value());
-    EXPECT_TRUE(result.error().find("matching strike") != String::npos);
+    EXPECT_EQ(result.error().code(), MatchError::NoBidOrders);
+    EXPECT_TRUE(orderBook->hasOrder(Option::AAPL_JUN26_C, 1));
+    EXPECT_TRUE(orderBook->hasOrder(Option::AAPL_JUN26_C, 2));
+    EXPECT_EQ(orderBook->optionChain(Option::AAPL_JUN26_C)->get().size(), 2u);
 }
 
 TEST_F(OptionMatcherFixture, OptionsDoNotMatchWhenExpiryDiffers)
 {
-    auto bidOption = OptionOrder::create(1, Option::AAPL_JUN26_C, 5.0, 10, MarketSide::Bid,
-                                         timeNow(), 150.0, OptionType::Call, 0.5);
+    auto bidOption = OptionOrder::create(1, Option::AAPL_JUN26_C, 5.0, 10, MarketSide::Bid, 150.0,
+                                         OptionType::Call, 0.5);
     ASSERT_TRUE(bidOption.has_value());
     orderBook->addOrderToBook(*bidOption);
 
-    auto askOption = OptionOrder::create(2, Option::AAPL_JUN26_C, 5.0, 10, MarketSide::Ask,
-                                         timeNow(), 150.0, OptionType::Call, 0.75);
+    auto askOption = OptionOrder::create(2, Option::AAPL_JUN26_C, 5.0, 10, MarketSide::Ask, 150.0,
+                                         OptionType::Call, 0.75);
     ASSERT_TRUE(askOption.has_value());
+    orderBook->addOrderToBook(*askOption);
 
     auto result = matcher->matchOrder(*askOption);
     ASSERT_FALSE(result.has_value());
-    EXPECT_TRUE(result.error().find("matching strike") != String::npos);
+    EXPECT_EQ(result.error().code(), MatchError::NoBidOrders);
 }
 
 TEST_F(OptionMatcherFixture, OptionsDoNotMatchWhenTypeDiffers)
 {
-    auto bidOption = OptionOrder::create(1, Option::AAPL_JUN26_C, 5.0, 10, MarketSide::Bid,
-                                         timeNow(), 150.0, OptionType::Call, 0.5);
+    auto bidOption = OptionOrder::create(1, Option::AAPL_JUN26_C, 5.0, 10, MarketSide::Bid, 150.0,
+                                         OptionType::Call, 0.5);
     ASSERT_TRUE(bidOption.has_value());
     orderBook->addOrderToBook(*bidOption);
 
-    auto askOption = OptionOrder::create(2, Option::AAPL_JUN26_C, 5.0, 10, MarketSide::Ask,
-                                         timeNow(), 150.0, OptionType::Put, 0.5);
+    auto askOption = OptionOrder::create(2, Option::AAPL_JUN26_C, 5.0, 10, MarketSide::Ask, 150.0,
+                                         OptionType::Put, 0.5);
     ASSERT_TRUE(askOption.has_value());
+    orderBook->addOrderToBook(*askOption);
 
     auto result = matcher->matchOrder(*askOption);
     ASSERT_FALSE(result.has_value());
-    EXPECT_TRUE(result.error().find("matching strike") != String::npos);
+    EXPECT_EQ(result.error().code(), MatchError::NoBidOrders);
+}
+
+TEST_F(OptionMatcherFixture, BetterPricedSeriesDoesNotBlockAnother)
+{
+    // the best bid on the ticker is for another strike, so sharing a book it would have stopped the
+    // sweep before reaching the bid that can trade
+    auto otherStrike = OptionOrder::create(1, Option::AAPL_JUN26_C, 6.0, 10, MarketSide::Bid, 150.0,
+                                           OptionType::Call, 0.5);
+    auto sameStrike = OptionOrder::create(2, Option::AAPL_JUN26_C, 5.0, 10, MarketSide::Bid, 155.0,
+                                          OptionType::Call, 0.5);
+    ASSERT_TRUE(otherStrike.has_value() && sameStrike.has_value());
+    orderBook->addOrderToBook(*otherStrike);
+    orderBook->addOrderToBook(*sameStrike);
+
+    auto askOption = OptionOrder::create(3, Option::AAPL_JUN26_C, 5.0, 10, MarketSide::Ask, 155.0,
+                                         OptionType::Call, 0.5);
+    ASSERT_TRUE(askOption.has_value());
+    orderBook->addOrderToBook(*askOption);
+
+    auto result = matcher->matchOrder(*askOption);
+    ASSERT_TRUE(result.has_value());
+    const std::vector<Fill>& fills = *result;
+    ASSERT_EQ(fills.size(), 1u);
+    EXPECT_EQ(fills[0].restingUid, 2);
+
+    EXPECT_TRUE(orderBook->hasOrder(Option::AAPL_JUN26_C, 1));
+    EXPECT_FALSE(orderBook->hasOrder(Option::AAPL_JUN26_C, 2));
+    const auto series = OptionSeries::of(Option::AAPL_JUN26_C, 150.0, 0.5, OptionType::Call);
+    EXPECT_EQ(orderBook->topOfBook(Option::AAPL_JUN26_C, series, MarketSide::Bid),
+              (*otherStrike)->priceTicks());
+}
+
+TEST_F(OptionMatcherFixture, OptionsCancelFromTheirSeries)
+{
+    auto bidOption = OptionOrder::create(1, Option::AAPL_JUN26_C, 5.0, 10, MarketSide::Bid, 150.0,
+                                         OptionType::Call, 0.5);
+    ASSERT_TRUE(bidOption.has_value());
+    orderBook->addOrderToBook(*bidOption);
+
+    auto cancelled = orderBook->cancelOrder(1);
+    ASSERT_TRUE(cancelled.has_value());
+    EXPECT_EQ((*cancelled)->uid(), 1);
+    EXPECT_FALSE(orderBook->hasOrder(Option::AAPL_JUN26_C, 1));
+    const auto series = OptionSeries::of(Option::AAPL_JUN26_C, 150.0, 0.5, OptionType::Call);
+    EXPECT_FALSE(orderBook->topOfBook(Option::AAPL_JUN26_C, series, MarketSide::Bid).has_value());
+}
+
+TEST_F(OptionMatcherFixture, TermsBelowSeriesPrecisionShareASeries)
+{
+    // a fraction of a tick on the strike and a few days on the expiry
+    auto bidOption = OptionOrder::create(1, Option::AAPL_JUN26_C, 5.0, 10, MarketSide::Bid,
+                                         150.001, OptionType::Call, 0.5);
+    auto askOption = OptionOrder::create(2, Option::AAPL_JUN26_C, 5.0, 10, MarketSide::Ask, 150.0,
+                                         OptionType::Call, 0.5 + 3.0 / 365);
+    ASSERT_TRUE(bidOption.has_value() && askOption.has_value());
+    orderBook->addOrderToBook(*bidOption);
+
+    auto result = matcher->matchOrder(*askOption);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ((*result).size(), 1u);
+    EXPECT_EQ(orderBook->optionChain(Option::AAPL_JUN26_C)->get().size(), 1u);
+}
+
+TEST_F(OptionMatcherFixture, SeriesEmptiedHandTheirBooksToNewSeries)
+{
+    // every order rests alone and leaves before the next strike opens, so one book serves them all
+    for (int uid = 1; uid <= 50; ++uid)
+    {
+        auto bidOption = OptionOrder::create(uid, Option::AAPL_JUN26_C, 5.0, 10, MarketSide::Bid,
+                                             100.0 + uid, OptionType::Call, 0.5);
+        ASSERT_TRUE(bidOption.has_value());
+        ASSERT_TRUE(orderBook->addOrderToBook(*bidOption).has_value());
+        ASSERT_TRUE(orderBook->cancelOrder(uid).has_value());
+    }
+
+    const OptionChain& chain = orderBook->optionChain(Option::AAPL_JUN26_C)->get();
+    EXPECT_EQ(chain.size(), 1u);
+
+    auto lastStrike = OptionSeries::of(Option::AAPL_JUN26_C, 150.0, 0.5, OptionType::Call);
+    EXPECT_NE(chain.find(lastStrike), nullptr);
+
+    // a series still resting is never handed over
+    auto resting = OptionOrder::create(51, Option::AAPL_JUN26_C, 5.0, 10, MarketSide::Bid, 200.0,
+                                       OptionType::Call, 0.5);
+    auto other = OptionOrder::create(52, Option::AAPL_JUN26_C, 5.0, 10, MarketSide::Bid, 201.0,
+                                     OptionType::Call, 0.5);
+    ASSERT_TRUE(resting.has_value() && other.has_value());
+    orderBook->addOrderToBook(*resting);
+    orderBook->addOrderToBook(*other);
+    EXPECT_EQ(chain.size(), 2u);
+    EXPECT_TRUE(orderBook->hasOrder(Option::AAPL_JUN26_C, 51));
+    EXPECT_TRUE(orderBook->hasOrder(Option::AAPL_JUN26_C, 52));
 }
 
 }  // namespace solstice::matching
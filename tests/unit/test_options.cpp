@@ -94,8 +94,8 @@ TEST(ExtractUnderlyingEquityTest, AllOptionsExtractCorrectly)
 
 TEST_F(OptionsTest, ValidOptionOrderCreationSucceeds)
 {
-    auto result = OptionOrder::create(1, Option::AAPL_MAR26_C, 5.50, 10, MarketSide::Bid, timeNow(),
-                                      150.0, OptionType::Call, 0.25);
+    auto result = OptionOrder::create(1, Option::AAPL_MAR26_C, 5.50, 10, MarketSide::Bid, 150.0,
+                                      OptionType::Call, 0.25);
     ASSERT_TRUE(result.has_value());
     EXPECT_EQ((*result)->strike(), 150.0);
     EXPECT_EQ((*result)->optionType(), OptionType::Call);
@@ -104,16 +104,16 @@ TEST_F(OptionsTest, ValidOptionOrderCreationSucceeds)
 
 TEST_F(OptionsTest, OptionOrderHasCorrectUnderlying)
 {
-    auto result = OptionOrder::create(1, Option::AAPL_MAR26_C, 5.50, 10, MarketSide::Bid, timeNow(),
-                                      150.0, OptionType::Call, 0.25);
+    auto result = OptionOrder::create(1, Option::AAPL_MAR26_C, 5.50, 10, MarketSide::Bid, 150.0,
+                                      OptionType::Call, 0.25);
     ASSERT_TRUE(result.has_value());
     EXPECT_EQ((*result)->underlyingEquity(), Equity::AAPL);
 }
 
 TEST_F(OptionsTest, NegativeOptionPriceFails)
 {
-    auto result = OptionOrder::create(1, Option::AAPL_MAR26_C, -5.50, 10, MarketSide::Bid,
-                                      timeNow(), 150.0, OptionType::Call, 0.25);
+    auto result = OptionOrder::create(1, Option::AAPL_MAR26_C, -5.50, 10, MarketSide::Bid, 150.0,
+                                      OptionType::Call, 0.25);
     ASSERT_FALSE(result.has_value());
     EXPECT_TRUE(result.error().find("Invalid price") != String::npos);
 }
@@ -121,23 +121,23 @@ TEST_F(OptionsTest, NegativeOptionPriceFails)
 TEST_F(OptionsTest, NegativeStrikeAllowed)
 {
     // Strike can technically be any value for flexibility
-    auto result = OptionOrder::create(1, Option::AAPL_MAR26_C, 5.50, 10, MarketSide::Bid, timeNow(),
-                                      -150.0, OptionType::Call, 0.25);
+    auto result = OptionOrder::create(1, Option::AAPL_MAR26_C, 5.50, 10, MarketSide::Bid, -150.0,
+                                      OptionType::Call, 0.25);
     // Should succeed - strike validation happens elsewhere
     EXPECT_TRUE(result.has_value());
 }
 
 TEST_F(OptionsTest, ZeroExpiryAllowed)
 {
-    auto result = OptionOrder::create(1, Option::AAPL_MAR26_C, 5.50, 10, MarketSide::Bid, timeNow(),
-                                      150.0, OptionType::Call, 0.0);
+    auto result = OptionOrder::create(1, Option::AAPL_MAR26_C, 5.50, 10, MarketSide::Bid, 150.0,
+                                      OptionType::Call, 0.0);
     EXPECT_TRUE(result.has_value());
 }
 
 TEST_F(OptionsTest, OptionOrderGreeksInitializeToZero)
 {
-    auto result = OptionOrder::create(1, Option::AAPL_MAR26_C, 5.50, 10, MarketSide::Bid, timeNow(),
-                                      150.0, OptionType::Call, 0.25);
+    auto result = OptionOrder::create(1, Option::AAPL_MAR26_C, 5.50, 10, MarketSide::Bid, 150.0,
+                                      OptionType::Call, 0.25);
     ASSERT_TRUE(result.has_value());
     // Greeks should be uninitialized/zero until setGreeks is called
     EXPECT_EQ((*result)->delta(), 0.0);
@@ -308,7 +308,7 @@ TEST_F(OptionsTest, ComputeGreeksForCallOption)
     equityData.updateVolatility(149.0);
 
     auto optionResult = OptionOrder::create(1, Option::AAPL_MAR26_C, 5.50, 10, MarketSide::Bid,
-                                            timeNow(), 150.0, OptionType::Call, 0.25);
+                                            150.0, OptionType::Call, 0.25);
     ASSERT_TRUE(optionResult.has_value());
 
     Greeks greeks = pricer->computeGreeks(**optionResult);
@@ -335,7 +335,7 @@ TEST_F(OptionsTest, ComputeGreeksForPutOption)
     equityData.updateVolatility(151.0);
 
     auto optionResult = OptionOrder::create(1, Option::AAPL_MAR26_P, 5.50, 10, MarketSide::Bid,
-                                            timeNow(), 150.0, OptionType::Put, 0.25);
+                                            150.0, OptionType::Put, 0.25);
     ASSERT_TRUE(optionResult.has_value());
 
     Greeks greeks = pricer->computeGreeks(**optionResult);
@@ -362,7 +362,7 @@ TEST_F(OptionsTest, ATMCallDeltaNearHalf)
     equityData.updateVolatility(151.0);
 
     auto optionResult = OptionOrder::create(1, Option::AAPL_MAR26_C, 5.50, 10, MarketSide::Bid,
-                                            timeNow(), 150.0, OptionType::Call, 0.25);
+                                            150.0, OptionType::Call, 0.25);
     ASSERT_TRUE(optionResult.has_value());
 
     Greeks greeks = pricer->computeGreeks(**optionResult);
@@ -379,13 +379,13 @@ TEST_F(OptionsTest, ITMCallDeltaHigherThanOTM)
     equityData.updateVolatility(151.0);
 
     // ITM Call
-    auto itmOption = OptionOrder::create(1, Option::AAPL_MAR26_C, 15.0, 10, MarketSide::Bid,
-                                         timeNow(), 140.0, OptionType::Call, 0.25);
+    auto itmOption = OptionOrder::create(1, Option::AAPL_MAR26_C, 15.0, 10, MarketSide::Bid, 140.0,
+                                         OptionType::Call, 0.25);
     ASSERT_TRUE(itmOption.has_value());
 
     // OTM Call
-    auto otmOption = OptionOrder::create(2, Option::AAPL_MAR26_C, 2.0, 10, MarketSide::Bid,
-                                         timeNow(), 160.0, OptionType::Call, 0.25);
+    auto otmOption = OptionOrder::create(2, Option::AAPL_MAR26_C, 2.0, 10, MarketSide::Bid, 160.0,
+                                         OptionType::Call, 0.25);
     ASSERT_TRUE(otmOption.has_value());
 
     Greeks itmGreeks = pricer->computeGreeks(**itmOption);
@@ -6,6 +6,11 @@
 #include <order_book.h>
 #include <pricer.h>
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 namespace solstice::matching
 {
 
@@ -54,6 +59,60 @@ TEST(OrchestratorTests, StartSucceeds)
     ASSERT_TRUE(result.has_value());
 }
 
+TEST(OrchestratorTests, StartSucceedsWithShardedMatching)
+{
+    auto config = *Config::instance();
+    config.ordersToGenerate(1000);
+    config.logLevel(LogLevel::ERROR);
+    config.shardedMatching(true);
+    config.matchingThreads(3);
+
+    std::optional<broadcaster::Broadcaster> broadcaster;
+    auto result = Orchestrator::start(config, broadcaster);
+    ASSERT_TRUE(result.has_value());
+}
+
+TEST(OrchestratorTests, StartSucceedsWithSharedQueue)
+{
+    auto config = *Config::instance();
+    config.ordersToGenerate(1000);
+    config.logLevel(LogLevel::ERROR);
+    config.shardedMatching(false);
+    config.matchingThreads(3);
+
+    std::optional<broadcaster::Broadcaster> broadcaster;
+    auto result = Orchestrator::start(config, broadcaster);
+    ASSERT_TRUE(result.has_value());
+}
+
+TEST(OrchestratorTests, StartSucceedsWithGeneratorPerShard)
+{
+    auto config = *Config::instance();
+    config.ordersToGenerate(1000);
+    config.logLevel(LogLevel::ERROR);
+    config.shardedMatching(true);
+    config.matchingThreads(3);
+    config.generatorThreads(3);
+
+    std::optional<broadcaster::Broadcaster> broadcaster;
+    auto result = Orchestrator::start(config, broadcaster);
+    ASSERT_TRUE(result.has_value());
+}
+
+TEST(OrchestratorTests, StartSucceedsWithGeneratorsFeedingSharedQueue)
+{
+    auto config = *Config::instance();
+    config.ordersToGenerate(1000);
+    config.logLevel(LogLevel::ERROR);
+    config.shardedMatching(false);
+    config.matchingThreads(2);
+    config.generatorThreads(3);
+
+    std::optional<broadcaster::Broadcaster> broadcaster;
+    auto result = Orchestrator::start(config, broadcaster);
+    ASSERT_TRUE(result.has_value());
+}
+
 TEST_F(OrchestratorFixture, ProcessOrderWithMatchSucceeds)
 {
     Orchestrator orch{config, orderBook, matcher, pricer, broadcaster};
@@ -89,9 +148,9 @@ TEST_F(OrchestratorFixture, ProcessOrderAddsToBook)
 
     orch.processOrder(*bidOrder);
 
-    auto deque = orderBook->getOrdersDequeAtPrice(*bidOrder);
-    ASSERT_TRUE(deque.has_value());
-    EXPECT_EQ(deque->get().size(), 1);
+    auto queue = orderBook->getOrdersQueueAtPrice(*bidOrder);
+    ASSERT_TRUE(queue.has_value());
+    EXPECT_EQ(queue->get().size(), 1);
 }
 
 TEST_F(OrchestratorFixture, ProcessOrderMarksFulfilledOnMatch)
@@ -110,4 +169,221 @@ TEST_F(OrchestratorFixture, ProcessOrderMarksFulfilledOnMatch)
     EXPECT_TRUE((*askOrder)->matched());
 }
 
+TEST_F(OrchestratorFixture, ProcessOrderRestsOnlyWhatIsLeft)
+{
+    Orchestrator orch{config, orderBook, matcher, pricer, broadcaster};
+
+    auto askOrder = *Order::create(1, Equity::AAPL, 100.0, 10.0, MarketSide::Ask);
+    orch.processOrder(askOrder);
+
+    // filled on arrival, so it was never added and never stamped by the book
+    auto filledOrder = *Order::create(2, Equity::AAPL, 100.0, 4.0, MarketSide::Bid);
+    EXPECT_TRUE(orch.processOrder(filledOrder));
+    EXPECT_EQ(filledOrder->bookSequence(), 0);
+
+    auto partOrder = *Order::create(3, Equity::AAPL, 100.0, 10.0, MarketSide::Bid);
+    EXPECT_FALSE(orch.processOrder(partOrder));
+    EXPECT_TRUE(orderBook->hasOrder(Equity::AAPL, 3));
+
+    std::array<DepthLevel, 1> levels;
+    ASSERT_EQ(orderBook->depth(Equity::AAPL, MarketSide::Bid, levels), 1);
+    EXPECT_EQ(levels[0].qnty, 4);
+    EXPECT_EQ(orderBook->depth(Equity::AAPL, MarketSide::Ask, levels), 0);
+}
+
+TEST_F(OrchestratorFixture, ProcessOrderNeverRestsImmediateOrders)
+{
+    Orchestrator orch{config, orderBook, matcher, pricer, broadcaster};
+
+    auto askOrder = *Order::create(1, Equity::AAPL, 100.0, 4.0, MarketSide::Ask);
+    orch.processOrder(askOrder);
+
+    auto iocOrder = *Order::create(2, Equity::AAPL, 100.0, 10.0, MarketSide::Bid);
+    iocOrder->timeInForce(TimeInForce::ImmediateOrCancel);
+    EXPECT_FALSE(orch.processOrder(iocOrder));
+    EXPECT_EQ(iocOrder->outstandingQnty(), 6);
+    EXPECT_FALSE(orderBook->hasOrder(Equity::AAPL, 2));
+
+    // with nothing left to take, a market order is dropped whole
+    auto marketOrder = *Order::create(3, Equity::AAPL, 100.0, 10.0, MarketSide::Bid);
+    marketOrder->priceType(PriceType::Market);
+    EXPECT_FALSE(orch.processOrder(marketOrder));
+    EXPECT_FALSE(orderBook->topOfBook(Equity::AAPL, MarketSide::Bid).has_value());
+    EXPECT_FALSE(orderBook->topOfBook(Equity::AAPL, MarketSide::Ask).has_value());
+}
+
+TEST_F(OrchestratorFixture, ProcessOrderOnlyRestsDuringAuction)
+{
+    Orchestrator orch{config, orderBook, matcher, pricer, broadcaster};
+    orch.addUnderlyingMutex(Equity::AAPL);
+
+    ASSERT_TRUE(orch.startAuction(Equity::AAPL).has_value());
+
+    auto askOrder = *Order::create(1, Equity::AAPL, 99.0, 10.0, MarketSide::Ask);
+    auto bidOrder = *Order::create(2, Equity::AAPL, 101.0, 6.0, MarketSide::Bid);
+    EXPECT_FALSE(orch.processOrder(askOrder));
+    EXPECT_FALSE(orch.processOrder(bidOrder));
+    EXPECT_TRUE(orderBook->hasOrder(Equity::AAPL, 2));
+
+    // an order that can't rest has nothing to trade with until the book uncrosses
+    auto iocOrder = *Order::create(3, Equity::AAPL, 101.0, 2.0, MarketSide::Bid);
+    iocOrder->timeInForce(TimeInForce::ImmediateOrCancel);
+    EXPECT_FALSE(orch.processOrder(iocOrder));
+    EXPECT_FALSE(orderBook->hasOrder(Equity::AAPL, 3));
+
+    auto result = orch.uncross(Equity::AAPL);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ((*result).qnty, 6);
+    EXPECT_TRUE(bidOrder->matched());
+    EXPECT_EQ(askOrder->outstandingQnty(), 4);
+
+    // continuous again, so the next order matches on arrival
+    auto nextOrder = *Order::create(4, Equity::AAPL, 99.0, 4.0, MarketSide::Bid);
+    EXPECT_TRUE(orch.processOrder(nextOrder));
+
+    EXPECT_FALSE(orch.startAuction(Equity::MSFT).has_value());
+}
+
+TEST_F(OrchestratorFixture, CancelOrderRemovesRestingOrder)
+{
+    Orchestrator orch{config, orderBook, matcher, pricer, broadcaster};
+    orch.addUnderlyingMutex(Equity::AAPL);
+
+    auto bidOrder = Order::create(1, Equity::AAPL, 100.0, 10.0, MarketSide::Bid);
+    ASSERT_TRUE(bidOrder.has_value());
+    orch.processOrder(*bidOrder);
+
+    auto cancelled = orch.cancelOrder(1);
+    ASSERT_TRUE(cancelled.has_value());
+    EXPECT_EQ((*cancelled)->uid(), 1);
+
+    // cancelled orders can no longer be matched against
+    auto askOrder = Order::create(2, Equity::AAPL, 100.0, 10.0, MarketSide::Ask);
+    ASSERT_TRUE(askOrder.has_value());
+    EXPECT_FALSE(orch.processOrder(*askOrder));
+    EXPECT_FALSE(orch.cancelOrder(1).has_value());
+}
+
+TEST_F(OrchestratorFixture, CancelOrderIsRefusedWhileShardsMatch)
+{
+    config.assetClass(AssetClass::Equity);
+    config.ordersToGenerate(200000);
+    config.logLevel(LogLevel::ERROR);
+    config.shardedMatching(true);
+    config.matchingThreads(2);
+
+    Orchestrator orch{config, orderBook, matcher, pricer, broadcaster};
+    orch.addUnderlyingMutex(Equity::AAPL);
+
+    std::atomic<bool> finished{false};
+    Resolution<std::pair<int, int>> produced = std::pair{0, 0};
+    std::thread run(
+        [&]
+        {
+            produced = orch.produceOrders();
+            finished.store(true);
+        });
+
+    while (!orch.shardsMatching() && !finished.load())
+    {
+        std::this_thread::yield();
+    }
+
+    // the AAPL shard's worker owns the book until the run ends
+    auto byUnderlying = orch.cancelOrder(Equity::AAPL, 1);
+    auto byUid = orch.cancelOrder(1);
+    run.join();
+
+    ASSERT_TRUE(produced.has_value()) << produced.error();
+    for (const auto& cancelled : {byUnderlying, byUid})
+    {
+        ASSERT_FALSE(cancelled.has_value());
+        EXPECT_NE(cancelled.error().find("while shards are matching"), String::npos);
+    }
+
+    EXPECT_FALSE(orch.shardsMatching());
+    auto after = orch.cancelOrder(Equity::AAPL, -1);
+    ASSERT_FALSE(after.has_value());
+    EXPECT_EQ(after.error().find("while shards are matching"), String::npos);
+}
+
+TEST_F(OrchestratorFixture, SubmitOrderShedsAboveHighWaterMark)
+{
+    config.shardedMatching(false);
+    config.queueHighWaterMark(4);
+    config.backpressurePolicy(BackpressurePolicy::Shed);
+
+    Orchestrator orch{config, orderBook, matcher, pricer, broadcaster};
+
+    int accepted = 0;
+    for (int uid = 0; uid < 6; uid++)
+    {
+        auto order = Order::create(uid, Equity::AAPL, 100.0, 10.0, MarketSide::Bid);
+        ASSERT_TRUE(order.has_value());
+        accepted += orch.submitOrder(*order);
+    }
+
+    EXPECT_EQ(accepted, 4);
+    EXPECT_EQ(orch.queueDepth(), 4);
+    EXPECT_EQ(orch.ingressStats().queued.load(), 4);
+    EXPECT_EQ(orch.ingressStats().shed.load(), 2);
+}
+
+TEST_F(OrchestratorFixture, SubmitOrderBlocksUntilBelowHighWaterMark)
+{
+    config.shardedMatching(false);
+    config.queueHighWaterMark(2);
+    config.backpressurePolicy(BackpressurePolicy::Block);
+
+    // the test pops straight from the ring without notifying, so the producer must not sleep
+    config.waitStrategy(WaitStrategy::SpinThenYield);
+
+    Orchestrator orch{config, orderBook, matcher, pricer, broadcaster};
+
+    for (int uid = 0; uid < 2; uid++)
+    {
+        ASSERT_TRUE(orch.submitOrder(*Order::create(uid, Equity::AAPL, 100.0, 10.0,
+                                                    MarketSide::Bid)));
+    }
+
+    std::atomic<bool> submitted{false};
+    std::thread producer(
+        [&]
+        {
+            orch.submitOrder(*Order::create(2, Equity::AAPL, 100.0, 10.0, MarketSide::Bid));
+            submitted.store(true);
+        });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(submitted.load());
+
+    // stands in for a worker draining the queue
+    OrderPtr order;
+    ASSERT_TRUE(orch.orderProcessQueue().tryPop(order));
+
+    producer.join();
+    EXPECT_TRUE(submitted.load());
+    EXPECT_EQ(orch.queueDepth(), 2);
+    EXPECT_EQ(orch.ingressStats().shed.load(), 0);
+    EXPECT_GT(orch.ingressStats().blockedNanos.load(), 0);
+}
+
+TEST_F(OrchestratorFixture, SubmitOrderStampsCyclesOnlyWhenMeasuringLatency)
+{
+    config.shardedMatching(false);
+
+    for (bool measureLatency : {false, true})
+    {
+        config.measureLatency(measureLatency);
+        Orchestrator orch{config, orderBook, matcher, pricer, broadcaster};
+
+        ASSERT_TRUE(
+            orch.submitOrder(*Order::create(1, Equity::AAPL, 100.0, 10.0, MarketSide::Bid)));
+
+        OrderPtr order;
+        ASSERT_TRUE(orch.orderProcessQueue().tryPop(order));
+        EXPECT_EQ(order->cyclesSubmitted() != 0, measureLatency);
+    }
+}
+
 }  // namespace solstice::matching
@@ -2,6 +2,7 @@
 #include <gtest/gtest.h>
 #include <market_side.h>
 #include <order.h>
+#include <ticks.h>
 
 namespace solstice
 {
@@ -48,6 +49,21 @@ TEST(OrderTests, OrderHasCorrectPrice)
     EXPECT_EQ((*result)->price(), 123.45);
 }
 
+TEST(OrderTests, OrderPriceIsHeldInTicks)
+{
+    auto result = Order::create(0, Equity::AAPL, 123.45, 10.0, MarketSide::Bid);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ((*result)->priceTicks(), 12345);
+}
+
+TEST(OrderTests, OrderPriceSnapsToTickGrid)
+{
+    auto result = Order::create(0, Equity::AAPL, 100.004, 10.0, MarketSide::Bid);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ((*result)->priceTicks(), toTicks(100.0, Equity::AAPL));
+    EXPECT_EQ((*result)->price(), 100.0);
+}
+
 TEST(OrderTests, OrderHasCorrectQuantity)
 {
     auto result = Order::create(0, Equity::AAPL, 100.0, 25.0, MarketSide::Bid);
@@ -96,12 +112,41 @@ TEST(OrderTests, CanMarkOrderAsComplete)
     EXPECT_TRUE((*result)->matched());
 }
 
-TEST(OrderTests, TimeOrderFulfilledFailsWhenNotComplete)
+TEST(OrderTests, BookSequenceUnsetBeforeEnteringABook)
 {
     auto result = Order::create(0, Equity::AAPL, 100.0, 10.0, MarketSide::Bid);
     ASSERT_TRUE(result.has_value());
-    auto timeResult = (*result)->timeOrderFulfilled();
-    ASSERT_FALSE(timeResult.has_value());
+    EXPECT_EQ((*result)->bookSequence(), 0);
+    EXPECT_EQ((*result)->cyclesSubmitted(), 0);
+}
+
+TEST(OrderTests, OnlyGoodTillCancelLimitOrdersRest)
+{
+    auto order = *Order::create(0, Equity::AAPL, 100.0, 10.0, MarketSide::Bid);
+    EXPECT_EQ(order->priceType(), PriceType::Limit);
+    EXPECT_EQ(order->timeInForce(), TimeInForce::GoodTillCancel);
+    EXPECT_TRUE(order->canRest());
+
+    order->timeInForce(TimeInForce::ImmediateOrCancel);
+    EXPECT_FALSE(order->canRest());
+
+    order->timeInForce(TimeInForce::GoodTillCancel);
+    order->priceType(PriceType::Market);
+    EXPECT_FALSE(order->canRest());
+}
+
+TEST(OrderTests, MarketOrdersTradeAtAnyPrice)
+{
+    auto bid = *Order::create(0, Equity::AAPL, 100.0, 10.0, MarketSide::Bid);
+    EXPECT_TRUE(bid->tradesAt(toTicks(99.0, Equity::AAPL)));
+    EXPECT_TRUE(bid->tradesAt(toTicks(100.0, Equity::AAPL)));
+    EXPECT_FALSE(bid->tradesAt(toTicks(101.0, Equity::AAPL)));
+
+    auto ask = *Order::create(1, Equity::AAPL, 100.0, 10.0, MarketSide::Ask);
+    EXPECT_FALSE(ask->tradesAt(toTicks(99.0, Equity::AAPL)));
+
+    bid->priceType(PriceType::Market);
+    EXPECT_TRUE(bid->tradesAt(toTicks(101.0, Equity::AAPL)));
 }
 
 TEST(OrderTests, MarketSideStringReturnsCorrectValue)
@@ -1,6 +1,11 @@
 #include <gtest/gtest.h>
+#include <options.h>
 #include <order.h>
 #include <order_book.h>
+#include <ticks.h>
+
+#include <array>
+#include <optional>
 
 namespace solstice::matching
 {
@@ -34,9 +39,9 @@ TEST_F(OrderBookFixture, AddOrderToBookSucceeds)
 
     orderBook->addOrderToBook(*order);
 
-    auto deque = orderBook->getOrdersDequeAtPrice(*order);
-    ASSERT_TRUE(deque.has_value());
-    EXPECT_EQ(deque->get().size(), 1);
+    auto queue = orderBook->getOrdersQueueAtPrice(*order);
+    ASSERT_TRUE(queue.has_value());
+    EXPECT_EQ(queue->get().size(), 1);
 }
 
 TEST_F(OrderBookFixture, AddMultipleOrdersAtSamePrice)
@@ -49,9 +54,9 @@ TEST_F(OrderBookFixture, AddMultipleOrdersAtSamePrice)
     orderBook->addOrderToBook(*order1);
     orderBook->addOrderToBook(*order2);
 
-    auto deque = orderBook->getOrdersDequeAtPrice(*order1);
-    ASSERT_TRUE(deque.has_value());
-    EXPECT_EQ(deque->get().size(), 2);
+    auto queue = orderBook->getOrdersQueueAtPrice(*order1);
+    ASSERT_TRUE(queue.has_value());
+    EXPECT_EQ(queue->get().size(), 2);
 }
 
 TEST_F(OrderBookFixture, AddOrdersAtDifferentPrices)
@@ -64,12 +69,12 @@ TEST_F(OrderBookFixture, AddOrdersAtDifferentPrices)
     orderBook->addOrderToBook(*order1);
     orderBook->addOrderToBook(*order2);
 
-    auto deque1 = orderBook->getOrdersDequeAtPrice(*order1);
-    auto deque2 = orderBook->getOrdersDequeAtPrice(*order2);
-    ASSERT_TRUE(deque1.has_value());
-    ASSERT_TRUE(deque2.has_value());
-    EXPECT_EQ(deque1->get().size(), 1);
-    EXPECT_EQ(deque2->get().size(), 1);
+    auto queue1 = orderBook->getOrdersQueueAtPrice(*order1);
+    auto queue2 = orderBook->getOrdersQueueAtPrice(*order2);
+    ASSERT_TRUE(queue1.has_value());
+    ASSERT_TRUE(queue2.has_value());
+    EXPECT_EQ(queue1->get().size(), 1);
+    EXPECT_EQ(queue2->get().size(), 1);
 }
 
 TEST_F(OrderBookFixture, GetBestPriceForBid)
@@ -87,7 +92,7 @@ TEST_F(OrderBookFixture, GetBestPriceForBid)
 
     auto bestPrice = orderBook->getBestPrice(*bidOrder);
     ASSERT_TRUE(bestPrice.has_value());
-    EXPECT_EQ(*bestPrice, 100.0);
+    EXPECT_EQ(*bestPrice, toTicks(100.0, Equity::AAPL));
 }
 
 TEST_F(OrderBookFixture, GetBestPriceForAsk)
@@ -105,7 +110,7 @@ TEST_F(OrderBookFixture, GetBestPriceForAsk)
 
     auto bestPrice = orderBook->getBestPrice(*askOrder);
     ASSERT_TRUE(bestPrice.has_value());
-    EXPECT_EQ(*bestPrice, 100.0);
+    EXPECT_EQ(*bestPrice, toTicks(100.0, Equity::AAPL));
 }
 
 TEST_F(OrderBookFixture, GetBestPriceFailsWhenNoOppositeOrders)
@@ -136,7 +141,7 @@ TEST_F(OrderBookFixture, MarkOrderAsFulfilledRemovesOrder)
     ASSERT_TRUE(order.has_value());
 
     orderBook->addOrderToBook(*order);
-    orderBook->markOrderAsFulfilled(*order, 100);
+    orderBook->markOrderAsFulfilled(*order, toTicks(100.0, Equity::AAPL));
 
     EXPECT_TRUE((*order)->matched());
 }
@@ -152,9 +157,97 @@ TEST_F(OrderBookFixture, MarkOrderAsFulfilledRemovesPriceWhenLastOrder)
 
     orderBook->markOrderAsFulfilled(*order, *bestPrice);
 
-    auto deque = orderBook->getOrdersDequeAtPrice(*order);
-    ASSERT_TRUE(deque.has_value());
-    EXPECT_TRUE(deque->get().empty());
+    // the emptied level is taken out of the book
+    EXPECT_FALSE(orderBook->getOrdersQueueAtPrice(*order).has_value());
+    EXPECT_FALSE(orderBook->topOfBook(Equity::AAPL, MarketSide::Bid).has_value());
+}
+
+TEST_F(OrderBookFixture, MarkOrderAsFulfilledAtBetterPriceRemovesFromOwnLevel)
+{
+    auto order = Order::create(1, Equity::AAPL, 105.0, 10.0, MarketSide::Bid);
+    ASSERT_TRUE(order.has_value());
+
+    orderBook->addOrderToBook(*order);
+    orderBook->markOrderAsFulfilled(*order, toTicks(100.0, Equity::AAPL));
+
+    EXPECT_FALSE(orderBook->getOrdersQueueAtPrice(*order).has_value());
+    EXPECT_EQ((*order)->price(), 100.0);
+}
+
+TEST_F(OrderBookFixture, EmptiedLevelsAreReusedForNewPrices)
+{
+    for (int uid = 1; uid <= 10; uid++)
+    {
+        orderBook->addOrderToBook(
+            *Order::create(uid, Equity::AAPL, 100.0 + uid, 10, MarketSide::Bid));
+    }
+
+    for (int uid = 1; uid <= 10; uid++)
+    {
+        ASSERT_TRUE(orderBook->cancelOrder(Equity::AAPL, uid).has_value());
+    }
+
+    const auto& book = orderBook->getActiveOrders(Equity::AAPL)->get();
+    EXPECT_TRUE(book.bids.empty());
+    EXPECT_TRUE(book.bidPrices.empty());
+    EXPECT_EQ(book.spareLevels.size(), 10);
+
+    // a new level on either side takes a spare rather than allocating
+    auto ask = *Order::create(11, Equity::AAPL, 200.0, 10, MarketSide::Ask);
+    orderBook->addOrderToBook(ask);
+
+    EXPECT_EQ(book.spareLevels.size(), 9);
+    EXPECT_EQ(orderBook->getOrdersQueueAtPrice(ask)->get().front()->uid(), 11);
+
+    const BookMemory memory = orderBook->bookMemory(Equity::AAPL);
+    EXPECT_EQ(memory.levels, 1);
+    EXPECT_EQ(memory.spareLevels, 9);
+    EXPECT_GT(memory.bytes, 0);
+}
+
+TEST_F(OrderBookFixture, DepthAggregatesEachLevelBestFirst)
+{
+    orderBook->addOrderToBook(*Order::create(1, Equity::AAPL, 99.0, 5, MarketSide::Bid));
+    orderBook->addOrderToBook(*Order::create(2, Equity::AAPL, 100.0, 10, MarketSide::Bid));
+    orderBook->addOrderToBook(*Order::create(3, Equity::AAPL, 100.0, 7, MarketSide::Bid));
+    orderBook->addOrderToBook(*Order::create(4, Equity::AAPL, 98.0, 1, MarketSide::Bid));
+    orderBook->addOrderToBook(*Order::create(5, Equity::AAPL, 101.0, 3, MarketSide::Ask));
+
+    std::array<DepthLevel, 2> levels;
+    ASSERT_EQ(orderBook->depth(Equity::AAPL, MarketSide::Bid, levels), 2);
+    EXPECT_EQ(levels[0].price, toTicks(100.0, Equity::AAPL));
+    EXPECT_EQ(levels[0].qnty, 17);
+    EXPECT_EQ(levels[0].orders, 2);
+    EXPECT_EQ(levels[1].price, toTicks(99.0, Equity::AAPL));
+    EXPECT_EQ(levels[1].qnty, 5);
+
+    ASSERT_TRUE(orderBook->cancelOrder(Equity::AAPL, 2).has_value());
+    ASSERT_EQ(orderBook->depth(Equity::AAPL, MarketSide::Bid, levels), 2);
+    EXPECT_EQ(levels[0].qnty, 7);
+    EXPECT_EQ(levels[0].orders, 1);
+
+    ASSERT_EQ(orderBook->depth(Equity::AAPL, MarketSide::Ask, levels), 1);
+    EXPECT_EQ(levels[0].qnty, 3);
+    EXPECT_EQ(orderBook->depth(Equity::MSFT, MarketSide::Ask, levels), 0);
+}
+
+TEST_F(OrderBookFixture, SpareLevelsAreCapped)
+{
+    const int orders = static_cast<int>(MAX_SPARE_LEVELS) * 2;
+    for (int uid = 1; uid <= orders; uid++)
+    {
+        orderBook->addOrderToBook(
+            *Order::create(uid, Equity::AAPL, 100.0 + uid, 10, MarketSide::Ask));
+    }
+
+    for (int uid = 1; uid <= orders; uid++)
+    {
+        ASSERT_TRUE(orderBook->cancelOrder(Equity::AAPL, uid).has_value());
+    }
+
+    const BookMemory memory = orderBook->bookMemory(Equity::AAPL);
+    EXPECT_EQ(memory.levels, 0);
+    EXPECT_EQ(memory.spareLevels, MAX_SPARE_LEVELS);
 }
 
 TEST_F(OrderBookFixture, OppositeMarketSidePriceLevelMapReturnsBidsForAsk)
@@ -166,7 +259,7 @@ TEST_F(OrderBookFixture, OppositeMarketSidePriceLevelMapReturnsBidsForAsk)
 
     orderBook->addOrderToBook(*bidOrder);
 
-    auto oppositeMap = orderBook->oppositeMarketSidePriceLevelMap(*askOrder);
+    auto& oppositeMap = orderBook->oppositeMarketSidePriceLevelMap(*askOrder);
     EXPECT_FALSE(oppositeMap.empty());
 }
 
@@ -177,7 +270,7 @@ TEST_F(OrderBookFixture, SameMarketSidePriceLevelMapReturnsBidsForBid)
 
     orderBook->addOrderToBook(*bidOrder);
 
-    auto sameMap = orderBook->sameMarketSidePriceLevelMap(*bidOrder);
+    auto& sameMap = orderBook->sameMarketSidePriceLevelMap(*bidOrder);
     EXPECT_FALSE(sameMap.empty());
 }
 
@@ -190,10 +283,11 @@ TEST_F(OrderBookFixture, GetPriceLevelOppositeOrdersSucceeds)
     auto askOrder = Order::create(2, Equity::AAPL, 100.0, 10.0, MarketSide::Ask);
     ASSERT_TRUE(askOrder.has_value());
 
-    auto resultRaw = orderBook->getPriceLevelOppositeOrders(*askOrder, 100.0);
+    auto resultRaw =
+        orderBook->getPriceLevelOppositeOrders(*askOrder, toTicks(100.0, Equity::AAPL));
     ASSERT_TRUE(resultRaw.has_value());
 
-    auto result = (*resultRaw).get();
+    auto& result = (*resultRaw).get();
     EXPECT_EQ(result.size(), 1);
 }
 
@@ -202,7 +296,7 @@ TEST_F(OrderBookFixture, GetPriceLevelOppositeOrdersFailsWhenNoOrders)
     auto askOrder = Order::create(1, Equity::AAPL, 100.0, 10.0, MarketSide::Ask);
     ASSERT_TRUE(askOrder.has_value());
 
-    auto result = orderBook->getPriceLevelOppositeOrders(*askOrder, 100.0);
+    auto result = orderBook->getPriceLevelOppositeOrders(*askOrder, toTicks(100.0, Equity::AAPL));
     ASSERT_FALSE(result.has_value());
 }
 
@@ -216,17 +310,324 @@ TEST_F(OrderBookFixture, MultipleUnderlyingsSupported)
     orderBook->addOrderToBook(*aaplOrder);
     orderBook->addOrderToBook(*msftOrder);
 
-    auto aaplDeque = orderBook->getOrdersDequeAtPrice(*aaplOrder);
-    auto msftDeque = orderBook->getOrdersDequeAtPrice(*msftOrder);
-    ASSERT_TRUE(aaplDeque.has_value());
-    ASSERT_TRUE(msftDeque.has_value());
-    EXPECT_EQ(aaplDeque->get().size(), 1);
-    EXPECT_EQ(msftDeque->get().size(), 1);
+    auto aaplQueue = orderBook->getOrdersQueueAtPrice(*aaplOrder);
+    auto msftQueue = orderBook->getOrdersQueueAtPrice(*msftOrder);
+    ASSERT_TRUE(aaplQueue.has_value());
+    ASSERT_TRUE(msftQueue.has_value());
+    EXPECT_EQ(aaplQueue->get().size(), 1);
+    EXPECT_EQ(msftQueue->get().size(), 1);
+}
+
+TEST_F(OrderBookFixture, AddOrderToBookStampsSequencePerUnderlying)
+{
+    auto aapl1 = *Order::create(1, Equity::AAPL, 100.0, 10.0, MarketSide::Bid);
+    auto aapl2 = *Order::create(2, Equity::AAPL, 101.0, 10.0, MarketSide::Ask);
+    auto msft = *Order::create(3, Equity::MSFT, 100.0, 10.0, MarketSide::Bid);
+
+    orderBook->addOrderToBook(aapl1);
+    orderBook->addOrderToBook(msft);
+    orderBook->addOrderToBook(aapl2);
+
+    EXPECT_EQ(aapl1->bookSequence(), 1);
+    EXPECT_EQ(aapl2->bookSequence(), 2);
+    EXPECT_EQ(msft->bookSequence(), 1);
+
+    // adding an order already resting keeps its place in the queue
+    orderBook->addOrderToBook(aapl1);
+    EXPECT_EQ(aapl1->bookSequence(), 1);
 }
 
-TEST_F(OrderBookFixture, TransactionsInitiallyEmpty)
+TEST_F(OrderBookFixture, UncrossTradesAtPriceExecutingMost)
 {
-    EXPECT_TRUE(orderBook->transactions().empty());
+    orderBook->startAuction(Equity::AAPL);
+    EXPECT_TRUE(orderBook->inAuction(Equity::AAPL));
+    EXPECT_FALSE(orderBook->inAuction(Equity::MSFT));
+
+    orderBook->addOrderToBook(*Order::create(1, Equity::AAPL, 101.0, 10, MarketSide::Bid));
+    orderBook->addOrderToBook(*Order::create(2, Equity::AAPL, 101.0, 5, MarketSide::Bid));
+    orderBook->addOrderToBook(*Order::create(3, Equity::AAPL, 99.0, 20, MarketSide::Bid));
+    orderBook->addOrderToBook(*Order::create(4, Equity::AAPL, 99.0, 8, MarketSide::Ask));
+    orderBook->addOrderToBook(*Order::create(5, Equity::AAPL, 100.0, 4, MarketSide::Ask));
+    orderBook->addOrderToBook(*Order::create(6, Equity::AAPL, 103.0, 10, MarketSide::Ask));
+
+    // 12 trades at 100 and at 101, with bids left over at both, so the price goes up to 101
+    std::vector<Fill> fills;
+    auto result = orderBook->uncross(Equity::AAPL, fills);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_FALSE(orderBook->inAuction(Equity::AAPL));
+
+    const Ticks price = toTicks(101.0, Equity::AAPL);
+    EXPECT_EQ((*result).price, price);
+    EXPECT_EQ((*result).qnty, 12);
+
+    // bids in time priority within their level, each against the best ask left
+    ASSERT_EQ(fills.size(), 3);
+    EXPECT_EQ(fills[0].incomingUid, 1);
+    EXPECT_EQ(fills[0].restingUid, 4);
+    EXPECT_EQ(fills[0].qnty, 8);
+    EXPECT_EQ(fills[1].incomingUid, 1);
+    EXPECT_EQ(fills[1].restingUid, 5);
+    EXPECT_EQ(fills[1].qnty, 2);
+    EXPECT_EQ(fills[2].incomingUid, 2);
+    EXPECT_EQ(fills[2].restingUid, 5);
+    EXPECT_EQ(fills[2].qnty, 2);
+    EXPECT_EQ(fills[2].incomingRemainingQnty, 3);
+    for (const Fill& fill : fills)
+    {
+        EXPECT_EQ(fill.price, price);
+    }
+    EXPECT_EQ(orderBook->tradeTape(Equity::AAPL)->get().size(), 3);
+
+    std::array<DepthLevel, 2> levels;
+    ASSERT_EQ(orderBook->depth(Equity::AAPL, MarketSide::Bid, levels), 2);
+    EXPECT_EQ(levels[0].price, price);
+    EXPECT_EQ(levels[0].qnty, 3);
+    EXPECT_EQ(levels[1].qnty, 20);
+    ASSERT_EQ(orderBook->depth(Equity::AAPL, MarketSide::Ask, levels), 1);
+    EXPECT_EQ(levels[0].price, toTicks(103.0, Equity::AAPL));
+
+    // nothing crosses any more
+    fills.clear();
+    result = orderBook->uncross(Equity::AAPL, fills);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_FALSE((*result).price.has_value());
+    EXPECT_TRUE(fills.empty());
+}
+
+TEST_F(OrderBookFixture, TradeTapeInitiallyEmpty)
+{
+    auto tape = orderBook->tradeTape(Equity::AAPL);
+    ASSERT_TRUE(tape.has_value());
+    EXPECT_TRUE(tape->get().empty());
+}
+
+TEST_F(OrderBookFixture, CancelOrderFromMiddleOfQueueKeepsTimePriority)
+{
+    auto order1 = Order::create(1, Equity::AAPL, 100.0, 10.0, MarketSide::Bid);
+    auto order2 = Order::create(2, Equity::AAPL, 100.0, 10.0, MarketSide::Bid);
+    auto order3 = Order::create(3, Equity::AAPL, 100.0, 10.0, MarketSide::Bid);
+    orderBook->addOrderToBook(*order1);
+    orderBook->addOrderToBook(*order2);
+    orderBook->addOrderToBook(*order3);
+
+    auto cancelled = orderBook->cancelOrder(Equity::AAPL, 2);
+    ASSERT_TRUE(cancelled.has_value());
+    EXPECT_EQ((*cancelled)->uid(), 2);
+    EXPECT_FALSE(orderBook->hasOrder(Equity::AAPL, 2));
+
+    auto queue = orderBook->getOrdersQueueAtPrice(*order1);
+    ASSERT_TRUE(queue.has_value());
+
+    std::vector<int> uids;
+    for (const auto& order : queue->get())
+    {
+        uids.push_back(order->uid());
+    }
+    EXPECT_EQ(uids, (std::vector<int>{1, 3}));
+}
+
+TEST_F(OrderBookFixture, CancelLastOrderAtPriceRemovesPrice)
+{
+    auto order1 = Order::create(1, Equity::AAPL, 100.0, 10.0, MarketSide::Ask);
+    auto order2 = Order::create(2, Equity::AAPL, 101.0, 10.0, MarketSide::Ask);
+    orderBook->addOrderToBook(*order1);
+    orderBook->addOrderToBook(*order2);
+
+    ASSERT_TRUE(orderBook->cancelOrder(1).has_value());
+
+    EXPECT_EQ(orderBook->topOfBook(Equity::AAPL, MarketSide::Ask), (*order2)->priceTicks());
+}
+
+TEST_F(OrderBookFixture, CancelUnknownOrderFails)
+{
+    auto order = Order::create(1, Equity::AAPL, 100.0, 10.0, MarketSide::Bid);
+    orderBook->addOrderToBook(*order);
+
+    EXPECT_FALSE(orderBook->cancelOrder(Equity::AAPL, 2).has_value());
+    EXPECT_FALSE(orderBook->cancelOrder(Equity::MSFT, 1).has_value());
+    EXPECT_FALSE(orderBook->cancelOrder(2).has_value());
+}
+
+TEST_F(OrderBookFixture, CancelFilledOrderFails)
+{
+    auto order = Order::create(1, Equity::AAPL, 100.0, 10.0, MarketSide::Bid);
+    orderBook->addOrderToBook(*order);
+    orderBook->markOrderAsFulfilled(*order, (*order)->priceTicks());
+
+    EXPECT_FALSE(orderBook->cancelOrder(1).has_value());
+}
+
+TEST_F(OrderBookFixture, CancelByUidFindsOrdersThroughTheUidIndex)
+{
+    orderBook->initialiseUnderlying(Option::AAPL_JUN26_C);
+
+    // the same uid resting for two underlyings, and an option resting in its series' book
+    orderBook->addOrderToBook(*Order::create(1, Equity::AAPL, 100.0, 10.0, MarketSide::Bid));
+    orderBook->addOrderToBook(*Order::create(1, Equity::MSFT, 200.0, 10.0, MarketSide::Ask));
+    orderBook->addOrderToBook(*OptionOrder::create(2, Option::AAPL_JUN26_C, 5.0, 10,
+                                                   MarketSide::Bid, 150.0, OptionType::Call, 0.5));
+
+    EXPECT_EQ(orderBook->underlyingOf(2), std::optional<Underlying>{Option::AAPL_JUN26_C});
+    auto option = orderBook->cancelOrder(2);
+    ASSERT_TRUE(option.has_value());
+    EXPECT_EQ((*option)->uid(), 2);
+    EXPECT_FALSE(orderBook->hasOrder(Option::AAPL_JUN26_C, 2));
+    EXPECT_FALSE(orderBook->underlyingOf(2).has_value());
+
+    // each cancel takes one of the two, and the index still finds the other
+    auto first = orderBook->cancelOrder(1);
+    ASSERT_TRUE(first.has_value());
+    auto second = orderBook->cancelOrder(1);
+    ASSERT_TRUE(second.has_value());
+    EXPECT_NE((*first)->underlying(), (*second)->underlying());
+    EXPECT_FALSE(orderBook->cancelOrder(1).has_value());
+
+    // filled orders leave the index too
+    auto filled = *Order::create(3, Equity::MSFT, 200.0, 10.0, MarketSide::Bid);
+    orderBook->addOrderToBook(filled);
+    EXPECT_EQ(orderBook->underlyingOf(3), std::optional<Underlying>{Equity::MSFT});
+    orderBook->markOrderAsFulfilled(filled, filled->priceTicks());
+    EXPECT_FALSE(orderBook->underlyingOf(3).has_value());
+}
+
+class LadderOrderBookFixture : public ::testing::Test
+{
+   protected:
+    std::shared_ptr<OrderBook> orderBook;
+
+    void SetUp() override
+    {
+        orderBook = std::make_shared<OrderBook>(BookBackend::Ladder);
+
+        std::vector<Equity> pool = {Equity::AAPL, Equity::MSFT};
+        d_underlyingsPool<Equity> = pool;
+        d_underlyingsPoolInitialised<Equity> = true;
+        orderBook->initialiseBookAtUnderlyings<Equity>();
+    }
+
+    void TearDown() override
+    {
+        d_underlyingsPool<Equity> = {};
+        d_underlyingsPoolInitialised<Equity> = false;
+    }
+};
+
+TEST_F(LadderOrderBookFixture, AddOrderToBookSucceeds)
+{
+    auto order = Order::create(1, Equity::AAPL, 100.0, 10.0, MarketSide::Bid);
+    ASSERT_TRUE(order.has_value());
+
+    orderBook->addOrderToBook(*order);
+
+    auto queue = orderBook->getOrdersQueueAtPrice(*order);
+    ASSERT_TRUE(queue.has_value());
+    EXPECT_EQ(queue->get().size(), 1);
+}
+
+TEST_F(LadderOrderBookFixture, GetBestPriceForBid)
+{
+    auto askOrder1 = Order::create(1, Equity::AAPL, 100.0, 10.0, MarketSide::Ask);
+    auto askOrder2 = Order::create(2, Equity::AAPL, 105.0, 10.0, MarketSide::Ask);
+    ASSERT_TRUE(askOrder1.has_value());
+    ASSERT_TRUE(askOrder2.has_value());
+
+    orderBook->addOrderToBook(*askOrder1);
+    orderBook->addOrderToBook(*askOrder2);
+
+    auto bidOrder = Order::create(3, Equity::AAPL, 102.0, 10.0, MarketSide::Bid);
+    ASSERT_TRUE(bidOrder.has_value());
+
+    auto bestPrice = orderBook->getBestPrice(*bidOrder);
+    ASSERT_TRUE(bestPrice.has_value());
+    EXPECT_EQ(*bestPrice, toTicks(100.0, Equity::AAPL));
+}
+
+TEST_F(LadderOrderBookFixture, GetBestPriceFailsWhenPriceOutOfRange)
+{
+    auto bidOrder1 = Order::create(1, Equity::AAPL, 95.0, 10.0, MarketSide::Bid);
+    ASSERT_TRUE(bidOrder1.has_value());
+    orderBook->addOrderToBook(*bidOrder1);
+
+    auto askOrder = Order::create(2, Equity::AAPL, 98.0, 10.0, MarketSide::Ask);
+    ASSERT_TRUE(askOrder.has_value());
+
+    auto bestPrice = orderBook->getBestPrice(*askOrder);
+    ASSERT_FALSE(bestPrice.has_value());
+}
+
+TEST_F(LadderOrderBookFixture, DepthAggregatesEachLevelBestFirst)
+{
+    orderBook->addOrderToBook(*Order::create(1, Equity::AAPL, 101.0, 5, MarketSide::Ask));
+    orderBook->addOrderToBook(*Order::create(2, Equity::AAPL, 100.0, 10, MarketSide::Ask));
+    orderBook->addOrderToBook(*Order::create(3, Equity::AAPL, 100.0, 7, MarketSide::Ask));
+    orderBook->addOrderToBook(*Order::create(4, Equity::AAPL, 102.0, 1, MarketSide::Ask));
+
+    std::array<DepthLevel, 2> levels;
+    ASSERT_EQ(orderBook->depth(Equity::AAPL, MarketSide::Ask, levels), 2);
+    EXPECT_EQ(levels[0].price, toTicks(100.0, Equity::AAPL));
+    EXPECT_EQ(levels[0].qnty, 17);
+    EXPECT_EQ(levels[0].orders, 2);
+    EXPECT_EQ(levels[1].price, toTicks(101.0, Equity::AAPL));
+    EXPECT_EQ(levels[1].qnty, 5);
+}
+
+TEST_F(LadderOrderBookFixture, UncrossTradesBetweenEquallyGoodPrices)
+{
+    orderBook->startAuction(Equity::AAPL);
+
+    orderBook->addOrderToBook(*Order::create(1, Equity::AAPL, 102.0, 10, MarketSide::Bid));
+    orderBook->addOrderToBook(*Order::create(2, Equity::AAPL, 101.0, 5, MarketSide::Bid));
+    orderBook->addOrderToBook(*Order::create(3, Equity::AAPL, 99.0, 20, MarketSide::Bid));
+    orderBook->addOrderToBook(*Order::create(4, Equity::AAPL, 99.0, 5, MarketSide::Ask));
+    orderBook->addOrderToBook(*Order::create(5, Equity::AAPL, 100.0, 10, MarketSide::Ask));
+    orderBook->addOrderToBook(*Order::create(6, Equity::AAPL, 103.0, 10, MarketSide::Ask));
+
+    // 15 trades at both 100 and 101 with nothing left over, so the price is halfway between
+    std::vector<Fill> fills;
+    auto result = orderBook->uncross(Equity::AAPL, fills);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ((*result).price, toTicks(100.5, Equity::AAPL));
+    EXPECT_EQ((*result).qnty, 15);
+    EXPECT_EQ(fills.size(), 3);
+
+    EXPECT_EQ(orderBook->topOfBook(Equity::AAPL, MarketSide::Bid), toTicks(99.0, Equity::AAPL));
+    EXPECT_EQ(orderBook->topOfBook(Equity::AAPL, MarketSide::Ask), toTicks(103.0, Equity::AAPL));
+    EXPECT_FALSE(orderBook->hasOrder(Equity::AAPL, 5));
+}
+
+TEST_F(LadderOrderBookFixture, MarkOrderAsFulfilledClearsTopOfBook)
+{
+    auto order = Order::create(1, Equity::AAPL, 100.0, 10.0, MarketSide::Bid);
+    ASSERT_TRUE(order.has_value());
+
+    orderBook->addOrderToBook(*order);
+    EXPECT_EQ(orderBook->topOfBook(Equity::AAPL, MarketSide::Bid), (*order)->priceTicks());
+
+    orderBook->markOrderAsFulfilled(*order, (*order)->priceTicks());
+
+    EXPECT_TRUE((*order)->matched());
+    EXPECT_FALSE(orderBook->topOfBook(Equity::AAPL, MarketSide::Bid).has_value());
+}
+
+TEST_F(LadderOrderBookFixture, GetPriceLevelOppositeOrdersFailsWhenNoOrders)
+{
+    auto askOrder = Order::create(1, Equity::AAPL, 100.0, 10.0, MarketSide::Ask);
+    ASSERT_TRUE(askOrder.has_value());
+
+    auto result = orderBook->getPriceLevelOppositeOrders(*askOrder, toTicks(100.0, Equity::AAPL));
+    ASSERT_FALSE(result.has_value());
+}
+
+TEST_F(LadderOrderBookFixture, CancelOrderReleasesLevel)
+{
+    auto order1 = Order::create(1, Equity::AAPL, 100.0, 10.0, MarketSide::Bid);
+    auto order2 = Order::create(2, Equity::AAPL, 99.0, 10.0, MarketSide::Bid);
+    orderBook->addOrderToBook(*order1);
+    orderBook->addOrderToBook(*order2);
+
+    ASSERT_TRUE(orderBook->cancelOrder(Equity::AAPL, 1).has_value());
+
+    EXPECT_EQ(orderBook->topOfBook(Equity::AAPL, MarketSide::Bid), (*order2)->priceTicks());
 }
 
 }  // namespace solstice::matching
@@ -0,0 +1,150 @@
+#include <broadcaster.h>
+#include <config.h>
+#include <fill.h>
+#include <gtest/gtest.h>
+#include <log_level.h>
+#include <matcher.h>
+#include <options.h>
+#include <orchestrator.h>
+#include <order.h>
+#include <order_book.h>
+#include <order_journal.h>
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+namespace solstice
+{
+
+namespace
+{
+
+String journalPath(const char* name)
+{
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+// matches every recorded order on a fresh book, returning each fill as it happened
+std::vector<std::tuple<int, int, Ticks, int>> replayFills(const OrderJournal& journal)
+{
+    auto orderBook = std::make_shared<matching::OrderBook>();
+    matching::Matcher matcher(orderBook);
+
+    std::vector<matching::Fill> fills;
+    std::vector<std::tuple<int, int, Ticks, int>> replayed;
+
+    for (const auto& record : journal.records)
+    {
+        auto order = record.toOrder();
+        EXPECT_TRUE(order.has_value());
+
+        orderBook->initialiseUnderlying(record.toUnderlying());
+        orderBook->addOrderToBook(*order);
+
+        fills.clear();
+        (void)matcher.matchOrder(*order, fills);
+
+        for (const auto& fill : fills)
+        {
+            replayed.emplace_back(fill.incomingUid, fill.restingUid, fill.price, fill.qnty);
+        }
+    }
+
+    return replayed;
+}
+
+}  // namespace
+
+TEST(OrderJournalTests, RecordsRoundTripThroughFile)
+{
+    const String path = journalPath("solstice_round_trip.journal");
+
+    auto equity = Order::create(1, Equity::MSFT, 101.25, 40, MarketSide::Ask);
+    auto option = OptionOrder::create(2, Option::AAPL_MAR26_C, 7.5, 3, MarketSide::Bid, 250.0,
+                                      OptionType::Call, 0.25);
+    ASSERT_TRUE(equity.has_value());
+    ASSERT_TRUE(option.has_value());
+
+    {
+        auto writer = OrderJournalWriter::open(path, 77);
+        ASSERT_TRUE(writer.has_value());
+
+        std::vector<std::shared_ptr<Order>> orders{*equity, *option};
+        (*writer)->append(orders);
+        ASSERT_TRUE((*writer)->flush().has_value());
+        EXPECT_EQ((*writer)->recorded(), 2);
+    }
+
+    auto journal = OrderJournal::load(path);
+    ASSERT_TRUE(journal.has_value());
+    EXPECT_EQ((*journal).header.randomSeed, 77);
+    ASSERT_EQ((*journal).records.size(), 2);
+
+    auto replayedEquity = (*journal).records[0].toOrder();
+    ASSERT_TRUE(replayedEquity.has_value());
+    EXPECT_EQ((*replayedEquity)->uid(), 1);
+    EXPECT_EQ((*replayedEquity)->underlying(), Underlying(Equity::MSFT));
+    EXPECT_EQ((*replayedEquity)->marketSide(), MarketSide::Ask);
+    EXPECT_EQ((*replayedEquity)->priceTicks(), (*equity)->priceTicks());
+    EXPECT_EQ((*replayedEquity)->qnty(), 40);
+
+    auto replayedOption = (*journal).records[1].toOrder();
+    ASSERT_TRUE(replayedOption.has_value());
+    const OptionTerms& terms = (*replayedOption)->optionTerms();
+    EXPECT_EQ((*replayedOption)->underlying(), Underlying(Option::AAPL_MAR26_C));
+    EXPECT_EQ(terms.underlyingEquity, Equity::AAPL);
+    EXPECT_EQ(terms.strike, 250.0);
+    EXPECT_EQ(terms.optionType, OptionType::Call);
+    EXPECT_EQ(terms.expiry, 0.25);
+
+    std::filesystem::remove(path);
+}
+
+TEST(OrderJournalTests, LoadRejectsFileThatIsNotAJournal)
+{
+    const String path = journalPath("solstice_not_a_journal.journal");
+    std::ofstream(path) << "not a journal";
+
+    EXPECT_FALSE(OrderJournal::load(path).has_value());
+    EXPECT_FALSE(OrderJournal::load(journalPath("solstice_missing.journal")).has_value());
+
+    std::filesystem::remove(path);
+}
+
+TEST(OrderJournalTests, RecordedRunReplaysIdentically)
+{
+    const String path = journalPath("solstice_recorded_run.journal");
+
+    auto config = *Config::instance();
+    config.ordersToGenerate(2000);
+    config.logLevel(LogLevel::ERROR);
+    config.journalPath(path);
+
+    std::optional<broadcaster::Broadcaster> broadcaster;
+    ASSERT_TRUE(matching::Orchestrator::start(config, broadcaster).has_value());
+
+    auto journal = OrderJournal::load(path);
+    ASSERT_TRUE(journal.has_value());
+    EXPECT_GE((*journal).records.size(), 2000);
+
+    const auto firstReplay = replayFills(*journal);
+    EXPECT_FALSE(firstReplay.empty());
+    EXPECT_EQ(replayFills(*journal), firstReplay);
+
+    config.journalPath("");
+    config.replayPath(path);
+
+    for (bool sharded : {false, true})
+    {
+        config.shardedMatching(sharded);
+        EXPECT_TRUE(matching::Orchestrator::start(config, broadcaster).has_value());
+    }
+
+    std::filesystem::remove(path);
+}
+
+}  // namespace solstice
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <options.h>
+#include <order.h>
+#include <order_pool.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace solstice
+{
+
+TEST(OrderPoolTests, ReleasedSlotIsReused)
+{
+    OrderPool& pool = OrderPool::local();
+
+    void* first = pool.allocate();
+    pool.deallocate(first);
+
+    EXPECT_EQ(pool.allocate(), first);
+}
+
+TEST(OrderPoolTests, SlotsReleasedOnOtherThreadAreReclaimed)
+{
+    OrderPool& pool = OrderPool::local();
+
+    void* slot = pool.allocate();
+    std::thread([&] { pool.deallocate(slot); }).join();
+
+    // remote frees are only reclaimed once the local free list is used up, which can hold at most
+    // every slot carved so far
+    const size_t carved = pool.slabCount() * ORDER_SLOTS_PER_SLAB;
+
+    std::vector<void*> allocated;
+    bool reclaimed = false;
+    while (!reclaimed && allocated.size() <= carved)
+    {
+        allocated.push_back(pool.allocate());
+        reclaimed = allocated.back() == slot;
+    }
+
+    for (void* allocation : allocated)
+    {
+        pool.deallocate(allocation);
+    }
+
+    EXPECT_TRUE(reclaimed);
+}
+
+TEST(OrderPoolTests, OrderIsRecycledOnceLastReferenceDrops)
+{
+    auto order = Order::create(1, Equity::AAPL, 100.0, 10, MarketSide::Bid);
+    ASSERT_TRUE(order.has_value());
+
+    const Order* address = (*order).get();
+    (*order).reset();
+
+    auto next = Order::create(2, Equity::AAPL, 101.0, 5, MarketSide::Ask);
+    ASSERT_TRUE(next.has_value());
+
+    EXPECT_EQ((*next).get(), address);
+    EXPECT_EQ((*next)->uid(), 2);
+    EXPECT_EQ((*next)->qnty(), 5);
+}
+
+TEST(OrderPoolTests, PooledOptionOrderKeepsOptionTerms)
+{
+    auto option = OptionOrder::create(1, Option::AAPL_JUN26_C, 5.0, 10, MarketSide::Bid, 100.0,
+                                      OptionType::Call, 0.5);
+    ASSERT_TRUE(option.has_value());
+
+    std::shared_ptr<Order> order = *option;
+
+    // the terms are read from the order itself, with no downcast
+    EXPECT_EQ(order->assetClass(), AssetClass::Option);
+    EXPECT_EQ(order->optionTerms().strike, 100.0);
+    EXPECT_EQ(order->optionTerms().underlyingEquity, Equity::AAPL);
+}
+
+TEST(OrderPoolTests, DisabledPoolFallsBackToHeap)
+{
+    OrderPool::enabled(false);
+
+    auto order = Order::create(1, Equity::AAPL, 100.0, 10, MarketSide::Bid);
+
+    OrderPool::enabled(true);
+
+    ASSERT_TRUE(order.has_value());
+    EXPECT_EQ((*order)->uid(), 1);
+}
+
+}  // namespace solstice
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <order.h>
+#include <order_queue.h>
+
+#include <vector>
+
+namespace solstice::matching
+{
+
+class OrderQueueFixture : public ::testing::Test
+{
+   protected:
+    OrderNodePool nodes;
+    std::vector<NodeHandle> handles;
+    OrderQueue queue;
+
+    void SetUp() override
+    {
+        for (int uid = 1; uid <= 3; uid++)
+        {
+            handles.push_back(
+                nodes.acquire(*Order::create(uid, Equity::AAPL, 100.0, 10, MarketSide::Bid)));
+            queue.push_back(nodes, handles.back());
+        }
+    }
+
+    std::vector<int> uids() const
+    {
+        std::vector<int> result;
+        for (const auto& order : queue)
+        {
+            result.push_back(order->uid());
+        }
+        return result;
+    }
+};
+
+TEST_F(OrderQueueFixture, PushBackKeepsArrivalOrder)
+{
+    EXPECT_EQ(queue.size(), 3);
+    EXPECT_EQ(queue.front()->uid(), 1);
+    EXPECT_EQ(uids(), (std::vector<int>{1, 2, 3}));
+}
+
+TEST_F(OrderQueueFixture, EraseFromMiddle)
+{
+    queue.erase(handles[1]);
+
+    EXPECT_EQ(queue.size(), 2);
+    EXPECT_EQ(uids(), (std::vector<int>{1, 3}));
+}
+
+TEST_F(OrderQueueFixture, EraseHeadAndTail)
+{
+    queue.erase(handles[0]);
+    queue.erase(handles[2]);
+
+    EXPECT_EQ(queue.front()->uid(), 2);
+    EXPECT_EQ(uids(), (std::vector<int>{2}));
+
+    queue.erase(handles[1]);
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.begin(), queue.end());
+}
+
+TEST_F(OrderQueueFixture, ErasedNodeCanBeRequeued)
+{
+    queue.erase(handles[0]);
+    queue.push_back(nodes, handles[0]);
+
+    EXPECT_EQ(uids(), (std::vector<int>{2, 3, 1}));
+}
+
+TEST_F(OrderQueueFixture, MoveTransfersOrders)
+{
+    OrderQueue moved = std::move(queue);
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(moved.size(), 3);
+    EXPECT_EQ(moved.front()->uid(), 1);
+}
+
+TEST_F(OrderQueueFixture, QuantityFollowsOrdersAndFills)
+{
+    EXPECT_EQ(queue.qnty(), 30);
+
+    // a fill is passed on as it is taken off the order
+    nodes[handles[0]].order->outstandingQnty(6);
+    queue.reduceQnty(4);
+    EXPECT_EQ(queue.qnty(), 26);
+
+    // an order leaving takes what it still has outstanding
+    queue.erase(handles[0]);
+    EXPECT_EQ(queue.qnty(), 20);
+
+    OrderQueue moved = std::move(queue);
+    EXPECT_EQ(moved.qnty(), 20);
+    EXPECT_EQ(queue.qnty(), 0);
+}
+
+TEST_F(OrderQueueFixture, ReleasedHandlesAreReused)
+{
+    queue.erase(handles[1]);
+    nodes.release(handles[1]);
+
+    EXPECT_EQ(nodes.size(), 2);
+
+    NodeHandle reused =
+        nodes.acquire(*Order::create(4, Equity::AAPL, 100.0, 10, MarketSide::Bid));
+
+    EXPECT_EQ(reused, handles[1]);
+    EXPECT_EQ(nodes.capacity(), 3);
+}
+
+}  // namespace solstice::matching
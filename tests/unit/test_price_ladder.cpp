@@ -0,0 +1,227 @@
+#include <gtest/gtest.h>
+#include <order.h>
+#include <order_queue.h>
+#include <price_ladder.h>
+#include <ticks.h>
+
+namespace solstice::matching
+{
+
+namespace
+{
+
+NodeHandle makeNode(OrderNodePool& nodes, int uid, double price, MarketSide side)
+{
+    return nodes.acquire(*Order::create(uid, Equity::AAPL, price, 10, side));
+}
+
+}  // namespace
+
+TEST(PriceLadderTests, EmptyLadderHasNoBest)
+{
+    PriceLadder ladder(MarketSide::Bid);
+
+    EXPECT_TRUE(ladder.empty());
+    EXPECT_FALSE(ladder.best().has_value());
+    EXPECT_EQ(ladder.capacity(), 0);
+}
+
+TEST(PriceLadderTests, BestBidIsHighestOccupiedLevel)
+{
+    PriceLadder ladder(MarketSide::Bid);
+    OrderNodePool nodes;
+
+    ladder.addOrder(nodes, makeNode(nodes, 1, 100.00, MarketSide::Bid));
+    ladder.addOrder(nodes, makeNode(nodes, 2, 100.05, MarketSide::Bid));
+    ladder.addOrder(nodes, makeNode(nodes, 3, 99.50, MarketSide::Bid));
+
+    ASSERT_TRUE(ladder.best().has_value());
+    EXPECT_EQ(*ladder.best(), toTicks(100.05, Equity::AAPL));
+    EXPECT_EQ(ladder.occupiedLevels(), 3);
+}
+
+TEST(PriceLadderTests, BestAskIsLowestOccupiedLevel)
+{
+    PriceLadder ladder(MarketSide::Ask);
+    OrderNodePool nodes;
+
+    ladder.addOrder(nodes, makeNode(nodes, 1, 100.00, MarketSide::Ask));
+    ladder.addOrder(nodes, makeNode(nodes, 2, 100.05, MarketSide::Ask));
+    ladder.addOrder(nodes, makeNode(nodes, 3, 99.50, MarketSide::Ask));
+
+    ASSERT_TRUE(ladder.best().has_value());
+    EXPECT_EQ(*ladder.best(), toTicks(99.50, Equity::AAPL));
+}
+
+TEST(PriceLadderTests, ReleasingLevelMovesBestToNextLevel)
+{
+    PriceLadder ladder(MarketSide::Ask);
+    OrderNodePool nodes;
+    NodeHandle node = makeNode(nodes, 1, 99.50, MarketSide::Ask);
+
+    ladder.addOrder(nodes, node);
+    ladder.addOrder(nodes, makeNode(nodes, 2, 101.00, MarketSide::Ask));
+
+    ladder.findLevel(nodes[node].order->priceTicks())->erase(node);
+    ladder.releaseLevelIfEmpty(nodes[node].order->priceTicks());
+
+    EXPECT_EQ(*ladder.best(), toTicks(101.00, Equity::AAPL));
+    EXPECT_EQ(ladder.occupiedLevels(), 1);
+}
+
+TEST(PriceLadderTests, ReleaseKeepsLevelWithRemainingOrders)
+{
+    PriceLadder ladder(MarketSide::Bid);
+    OrderNodePool nodes;
+    NodeHandle node = makeNode(nodes, 1, 100.00, MarketSide::Bid);
+
+    ladder.addOrder(nodes, node);
+    ladder.addOrder(nodes, makeNode(nodes, 2, 100.00, MarketSide::Bid));
+
+    ladder.findLevel(nodes[node].order->priceTicks())->erase(node);
+    ladder.releaseLevelIfEmpty(nodes[node].order->priceTicks());
+
+    EXPECT_EQ(*ladder.best(), nodes[node].order->priceTicks());
+}
+
+TEST(PriceLadderTests, FindLevelOutsideRangeReturnsNull)
+{
+    PriceLadder ladder(MarketSide::Bid, 64);
+    OrderNodePool nodes;
+    ladder.addOrder(nodes, makeNode(nodes, 1, 100.00, MarketSide::Bid));
+
+    EXPECT_EQ(ladder.findLevel(toTicks(500.00, Equity::AAPL)), nullptr);
+}
+
+TEST(PriceLadderTests, GrowsToFitPricesOutsideWindow)
+{
+    PriceLadder ladder(MarketSide::Bid, 64);
+    OrderNodePool nodes;
+
+    ladder.addOrder(nodes, makeNode(nodes, 1, 100.00, MarketSide::Bid));
+    ladder.addOrder(nodes, makeNode(nodes, 2, 150.00, MarketSide::Bid));
+    ladder.addOrder(nodes, makeNode(nodes, 3, 20.00, MarketSide::Bid));
+
+    EXPECT_GE(ladder.capacity(), 13001);
+    EXPECT_EQ(ladder.occupiedLevels(), 3);
+    EXPECT_EQ(*ladder.best(), toTicks(150.00, Equity::AAPL));
+    EXPECT_EQ(ladder.findLevel(toTicks(100.00, Equity::AAPL))->size(), 1);
+    EXPECT_EQ(ladder.findLevel(toTicks(20.00, Equity::AAPL))->size(), 1);
+}
+
+TEST(PriceLadderTests, ExtremePriceRestsInOverflowWithoutGrowingWindow)
+{
+    PriceLadder ladder(MarketSide::Ask, 64, 1024);
+    OrderNodePool nodes;
+    NodeHandle far = makeNode(nodes, 3, 1000000.00, MarketSide::Ask);
+
+    ladder.addOrder(nodes, makeNode(nodes, 1, 100.00, MarketSide::Ask));
+    ladder.addOrder(nodes, makeNode(nodes, 2, 101.00, MarketSide::Ask));
+    ladder.addOrder(nodes, far);
+    ladder.addOrder(nodes, makeNode(nodes, 4, 1000000.00, MarketSide::Ask));
+
+    EXPECT_LE(ladder.capacity(), 1024);
+    EXPECT_EQ(ladder.overflowLevels(), 1);
+    EXPECT_EQ(ladder.occupiedLevels(), 3);
+    EXPECT_EQ(*ladder.best(), toTicks(100.00, Equity::AAPL));
+
+    const Ticks farPrice = nodes[far].order->priceTicks();
+    ASSERT_NE(ladder.findLevel(farPrice), nullptr);
+    EXPECT_EQ(ladder.findLevel(farPrice)->size(), 2);
+
+    std::vector<Ticks> visited;
+    ladder.forEachLevel([&](Ticks price, const OrderQueue&) { visited.push_back(price); });
+    ASSERT_EQ(visited.size(), 3);
+    EXPECT_EQ(visited[0], toTicks(100.00, Equity::AAPL));
+    EXPECT_EQ(visited[1], toTicks(101.00, Equity::AAPL));
+    EXPECT_EQ(visited[2], farPrice);
+}
+
+TEST(PriceLadderTests, OverflowLevelIsBestOnceTheWindowEmpties)
+{
+    PriceLadder ladder(MarketSide::Bid, 64, 1024);
+    OrderNodePool nodes;
+    NodeHandle near = makeNode(nodes, 1, 100.00, MarketSide::Bid);
+    NodeHandle far = makeNode(nodes, 2, 0.01, MarketSide::Bid);
+
+    ladder.addOrder(nodes, near);
+    ladder.addOrder(nodes, far);
+    EXPECT_EQ(ladder.overflowLevels(), 1);
+
+    ladder.findLevel(nodes[near].order->priceTicks())->erase(near);
+    ladder.releaseLevelIfEmpty(nodes[near].order->priceTicks());
+    EXPECT_EQ(*ladder.best(), nodes[far].order->priceTicks());
+
+    // a price the window now covers still finds the order resting in the overflow
+    ladder.addOrder(nodes, makeNode(nodes, 3, 0.02, MarketSide::Bid));
+    EXPECT_EQ(*ladder.best(), toTicks(0.02, Equity::AAPL));
+    EXPECT_EQ(ladder.findLevel(nodes[far].order->priceTicks())->size(), 1);
+
+    ladder.findLevel(nodes[far].order->priceTicks())->erase(far);
+    ladder.releaseLevelIfEmpty(nodes[far].order->priceTicks());
+    EXPECT_EQ(ladder.overflowLevels(), 0);
+    EXPECT_EQ(ladder.occupiedLevels(), 1);
+    EXPECT_FALSE(ladder.empty());
+}
+
+TEST(PriceLadderTests, RecentresWhenEmpty)
+{
+    PriceLadder ladder(MarketSide::Ask, 64);
+    OrderNodePool nodes;
+    NodeHandle node = makeNode(nodes, 1, 100.00, MarketSide::Ask);
+
+    ladder.addOrder(nodes, node);
+    ladder.findLevel(nodes[node].order->priceTicks())->erase(node);
+    ladder.releaseLevelIfEmpty(nodes[node].order->priceTicks());
+
+    ladder.addOrder(nodes, makeNode(nodes, 2, 300.00, MarketSide::Ask));
+
+    EXPECT_EQ(ladder.capacity(), 64);
+    EXPECT_EQ(*ladder.best(), toTicks(300.00, Equity::AAPL));
+}
+
+TEST(PriceLadderTests, ShrinksBackWhenRecentredEmpty)
+{
+    PriceLadder ladder(MarketSide::Bid, 64);
+    OrderNodePool nodes;
+    NodeHandle low = makeNode(nodes, 1, 100.00, MarketSide::Bid);
+    NodeHandle high = makeNode(nodes, 2, 150.00, MarketSide::Bid);
+
+    ladder.addOrder(nodes, low);
+    ladder.addOrder(nodes, high);
+    const size_t grownBytes = ladder.bytes();
+    ASSERT_GT(ladder.capacity(), 64);
+
+    for (NodeHandle node : {low, high})
+    {
+        ladder.findLevel(nodes[node].order->priceTicks())->erase(node);
+        ladder.releaseLevelIfEmpty(nodes[node].order->priceTicks());
+    }
+
+    ladder.addOrder(nodes, makeNode(nodes, 3, 300.00, MarketSide::Bid));
+
+    EXPECT_EQ(ladder.capacity(), 64);
+    EXPECT_LT(ladder.bytes(), grownBytes);
+    EXPECT_EQ(*ladder.best(), toTicks(300.00, Equity::AAPL));
+}
+
+TEST(PriceLadderTests, ForEachLevelVisitsBestFirst)
+{
+    PriceLadder ladder(MarketSide::Bid);
+    OrderNodePool nodes;
+
+    ladder.addOrder(nodes, makeNode(nodes, 1, 99.00, MarketSide::Bid));
+    ladder.addOrder(nodes, makeNode(nodes, 2, 101.00, MarketSide::Bid));
+    ladder.addOrder(nodes, makeNode(nodes, 3, 100.00, MarketSide::Bid));
+
+    std::vector<Ticks> visited;
+    ladder.forEachLevel([&](Ticks price, const OrderQueue&)
+                        { visited.push_back(price); });
+
+    ASSERT_EQ(visited.size(), 3);
+    EXPECT_EQ(visited[0], toTicks(101.00, Equity::AAPL));
+    EXPECT_EQ(visited[1], toTicks(100.00, Equity::AAPL));
+    EXPECT_EQ(visited[2], toTicks(99.00, Equity::AAPL));
+}
+
+}  // namespace solstice::matching
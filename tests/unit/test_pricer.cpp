@@ -539,7 +539,7 @@ TEST_F(BlackScholesTest, CallDeltaBoundsCheck)
     for (double strike : strikes)
     {
         auto optionResult = OptionOrder::create(1, Option::AAPL_MAR26_C, 10.0, 10, MarketSide::Bid,
-                                                timeNow(), strike, OptionType::Call, 0.5);
+                                                strike, OptionType::Call, 0.5);
         ASSERT_TRUE(optionResult.has_value());
 
         Greeks greeks = pricer->computeGreeks(**optionResult);
@@ -565,7 +565,7 @@ TEST_F(BlackScholesTest, PutDeltaBoundsCheck)
     for (double strike : strikes)
     {
         auto optionResult = OptionOrder::create(1, Option::AAPL_MAR26_P, 10.0, 10, MarketSide::Bid,
-                                                timeNow(), strike, OptionType::Put, 0.5);
+                                                strike, OptionType::Put, 0.5);
         ASSERT_TRUE(optionResult.has_value());
 
         Greeks greeks = pricer->computeGreeks(**optionResult);
@@ -592,14 +592,14 @@ TEST_F(BlackScholesTest, GammaIsAlwaysPositive)
     {
         // Test call
         auto callOption = OptionOrder::create(1, Option::AAPL_MAR26_C, 10.0, 10, MarketSide::Bid,
-                                              timeNow(), strike, OptionType::Call, 0.5);
+                                              strike, OptionType::Call, 0.5);
         ASSERT_TRUE(callOption.has_value());
         Greeks callGreeks = pricer->computeGreeks(**callOption);
         EXPECT_GT(callGreeks.gamma(), 0.0) << "Call gamma should be positive";
 
         // Test put
         auto putOption = OptionOrder::create(2, Option::AAPL_MAR26_P, 10.0, 10, MarketSide::Bid,
-                                             timeNow(), strike, OptionType::Put, 0.5);
+                                             strike, OptionType::Put, 0.5);
         ASSERT_TRUE(putOption.has_value());
         Greeks putGreeks = pricer->computeGreeks(**putOption);
         EXPECT_GT(putGreeks.gamma(), 0.0) << "Put gamma should be positive";
@@ -623,14 +623,14 @@ TEST_F(BlackScholesTest, VegaIsAlwaysPositive)
     {
         // Test call
         auto callOption = OptionOrder::create(1, Option::AAPL_MAR26_C, 10.0, 10, MarketSide::Bid,
-                                              timeNow(), strike, OptionType::Call, 0.5);
+                                              strike, OptionType::Call, 0.5);
         ASSERT_TRUE(callOption.has_value());
         Greeks callGreeks = pricer->computeGreeks(**callOption);
         EXPECT_GT(callGreeks.vega(), 0.0) << "Call vega should be positive";
 
         // Test put
         auto putOption = OptionOrder::create(2, Option::AAPL_MAR26_P, 10.0, 10, MarketSide::Bid,
-                                             timeNow(), strike, OptionType::Put, 0.5);
+                                             strike, OptionType::Put, 0.5);
         ASSERT_TRUE(putOption.has_value());
         Greeks putGreeks = pricer->computeGreeks(**putOption);
         EXPECT_GT(putGreeks.vega(), 0.0) << "Put vega should be positive";
@@ -649,15 +649,15 @@ TEST_F(BlackScholesTest, ThetaIsNegativeForLongOptions)
     }
 
     // Test call
-    auto callOption = OptionOrder::create(1, Option::AAPL_MAR26_C, 10.0, 10, MarketSide::Bid,
-                                          timeNow(), 150.0, OptionType::Call, 0.5);
+    auto callOption = OptionOrder::create(1, Option::AAPL_MAR26_C, 10.0, 10, MarketSide::Bid, 150.0,
+                                          OptionType::Call, 0.5);
     ASSERT_TRUE(callOption.has_value());
     Greeks callGreeks = pricer->computeGreeks(**callOption);
     EXPECT_LT(callGreeks.theta(), 0.0) << "Call theta should be negative (time decay)";
 
     // Test put
-    auto putOption = OptionOrder::create(2, Option::AAPL_MAR26_P, 10.0, 10, MarketSide::Bid,
-                                         timeNow(), 150.0, OptionType::Put, 0.5);
+    auto putOption = OptionOrder::create(2, Option::AAPL_MAR26_P, 10.0, 10, MarketSide::Bid, 150.0,
+                                         OptionType::Put, 0.5);
     ASSERT_TRUE(putOption.has_value());
     Greeks putGreeks = pricer->computeGreeks(**putOption);
     EXPECT_LT(putGreeks.theta(), 0.0) << "Put theta should be negative (time decay)";
@@ -675,20 +675,20 @@ TEST_F(BlackScholesTest, ATMOptionsHaveMaxGamma)
     }
 
     // ATM
-    auto atmOption = OptionOrder::create(1, Option::AAPL_MAR26_C, 10.0, 10, MarketSide::Bid,
-                                         timeNow(), 150.0, OptionType::Call, 0.5);
+    auto atmOption = OptionOrder::create(1, Option::AAPL_MAR26_C, 10.0, 10, MarketSide::Bid, 150.0,
+                                         OptionType::Call, 0.5);
     ASSERT_TRUE(atmOption.has_value());
     Greeks atmGreeks = pricer->computeGreeks(**atmOption);
 
     // ITM
-    auto itmOption = OptionOrder::create(2, Option::AAPL_MAR26_C, 10.0, 10, MarketSide::Bid,
-                                         timeNow(), 130.0, OptionType::Call, 0.5);
+    auto itmOption = OptionOrder::create(2, Option::AAPL_MAR26_C, 10.0, 10, MarketSide::Bid, 130.0,
+                                         OptionType::Call, 0.5);
     ASSERT_TRUE(itmOption.has_value());
     Greeks itmGreeks = pricer->computeGreeks(**itmOption);
 
     // OTM
-    auto otmOption = OptionOrder::create(3, Option::AAPL_MAR26_C, 10.0, 10, MarketSide::Bid,
-                                         timeNow(), 170.0, OptionType::Call, 0.5);
+    auto otmOption = OptionOrder::create(3, Option::AAPL_MAR26_C, 10.0, 10, MarketSide::Bid, 170.0,
+                                         OptionType::Call, 0.5);
     ASSERT_TRUE(otmOption.has_value());
     Greeks otmGreeks = pricer->computeGreeks(**otmOption);
 
@@ -714,7 +714,7 @@ TEST_F(BlackScholesTest, DeltaIncreasesWithMoneyness)
     for (double strike : strikes)
     {
         auto option = OptionOrder::create(1, Option::AAPL_MAR26_C, 10.0, 10, MarketSide::Bid,
-                                          timeNow(), strike, OptionType::Call, 0.5);
+                                          strike, OptionType::Call, 0.5);
         ASSERT_TRUE(option.has_value());
 
         Greeks greeks = pricer->computeGreeks(**option);
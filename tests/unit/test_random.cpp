@@ -0,0 +1,126 @@
+#include <get_random.h>
+#include <gtest/gtest.h>
+#include <random_stream.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+namespace solstice
+{
+
+namespace
+{
+
+std::vector<uint64_t> drawStream(uint64_t seed, uint64_t stream, size_t count)
+{
+    Xoshiro256pp engine;
+    engine.reseed(seed, stream);
+
+    std::vector<uint64_t> draws(count);
+    std::generate(draws.begin(), draws.end(), engine);
+    return draws;
+}
+
+}  // namespace
+
+TEST(RandomStreamTests, SameSeedAndStreamRepeatSequence)
+{
+    EXPECT_EQ(drawStream(42, 3, 64), drawStream(42, 3, 64));
+}
+
+TEST(RandomStreamTests, StreamsOfOneSeedDiffer)
+{
+    EXPECT_NE(drawStream(42, 0, 64), drawStream(42, 1, 64));
+    EXPECT_NE(drawStream(42, 0, 64), drawStream(43, 0, 64));
+}
+
+TEST(RandomStreamTests, UniformIntStaysWithinBounds)
+{
+    Xoshiro256pp engine(7);
+    std::array<int, 5> counts{};
+
+    for (int i = 0; i < 10000; i++)
+    {
+        const int64_t value = engine.uniformInt(-2, 2);
+        ASSERT_GE(value, -2);
+        ASSERT_LE(value, 2);
+        counts[value + 2]++;
+    }
+
+    for (int count : counts)
+    {
+        EXPECT_GT(count, 1500);
+    }
+}
+
+TEST(RandomStreamTests, BoundThreadReplaysItsStream)
+{
+    RandomStream::seed(1234);
+
+    auto drawOnThread = []
+    {
+        std::vector<int> draws(32);
+        std::thread thread(
+            [&]
+            {
+                RandomStream::bind(5);
+                for (int& draw : draws)
+                {
+                    draw = Random::getRandomInt(0, 1000);
+                }
+            });
+        thread.join();
+        return draws;
+    };
+
+    EXPECT_EQ(drawOnThread(), drawOnThread());
+}
+
+TEST(RandomStreamTests, ReseedingRestartsBoundStream)
+{
+    RandomStream::seed(99);
+    RandomStream::bind(2);
+    const double first = Random::getRandomDouble(0, 1000);
+
+    RandomStream::seed(99);
+    EXPECT_EQ(Random::getRandomDouble(0, 1000), first);
+}
+
+TEST(RandomTests, FillUniformStaysWithinRange)
+{
+    std::vector<double> values(1000);
+    Random::fillUniform(values, 5.0, 10.0);
+
+    for (double value : values)
+    {
+        ASSERT_GE(value, 5.0);
+        ASSERT_LT(value, 10.0);
+    }
+}
+
+TEST(RandomTests, FillNormalMatchesMeanAndDeviation)
+{
+    // odd length so the unpaired final value is filled too
+    std::vector<double> values(20001, std::nan(""));
+    Random::fillNormal(values, 3.0, 2.0);
+
+    const double mean = std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+
+    double variance = 0.0;
+    for (double value : values)
+    {
+        variance += (value - mean) * (value - mean);
+    }
+    variance /= values.size();
+
+    EXPECT_NEAR(mean, 3.0, 0.1);
+    EXPECT_NEAR(std::sqrt(variance), 2.0, 0.1);
+    EXPECT_FALSE(std::isnan(values.back()));
+}
+
+}  // namespace solstice
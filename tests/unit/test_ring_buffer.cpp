@@ -0,0 +1,248 @@
+#include <gtest/gtest.h>
+#include <mpmc_ring.h>
+#include <ring_waiter.h>
+#include <spsc_ring.h>
+#include <wait_strategy.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace solstice
+{
+
+TEST(SpscRingTests, CapacityRoundsUpToPowerOfTwo)
+{
+    SpscRing<int> ring(5);
+    EXPECT_EQ(ring.capacity(), 8);
+}
+
+TEST(SpscRingTests, PopsInPushOrder)
+{
+    SpscRing<int> ring(4);
+
+    ASSERT_TRUE(ring.tryPush(1));
+    ASSERT_TRUE(ring.tryPush(2));
+    ASSERT_TRUE(ring.tryPush(3));
+    EXPECT_EQ(ring.size(), 3);
+
+    int value = 0;
+    ASSERT_TRUE(ring.tryPop(value));
+    EXPECT_EQ(value, 1);
+    ASSERT_TRUE(ring.tryPop(value));
+    EXPECT_EQ(value, 2);
+    ASSERT_TRUE(ring.tryPop(value));
+    EXPECT_EQ(value, 3);
+    EXPECT_FALSE(ring.tryPop(value));
+}
+
+TEST(SpscRingTests, PushFailsWhenFullWithoutConsumingValue)
+{
+    SpscRing<std::shared_ptr<int>> ring(2);
+
+    ASSERT_TRUE(ring.tryPush(std::make_shared<int>(1)));
+    ASSERT_TRUE(ring.tryPush(std::make_shared<int>(2)));
+
+    auto extra = std::make_shared<int>(3);
+    EXPECT_FALSE(ring.tryPush(std::move(extra)));
+    ASSERT_NE(extra, nullptr);
+    EXPECT_EQ(*extra, 3);
+}
+
+TEST(SpscRingTests, PopBatchDrainsUpToMaxCount)
+{
+    SpscRing<int> ring(8);
+    for (int i = 0; i < 6; i++)
+    {
+        ASSERT_TRUE(ring.tryPush(i));
+    }
+
+    std::array<int, 4> batch{};
+    ASSERT_EQ(ring.popBatch(batch.data(), batch.size()), 4);
+    EXPECT_EQ(batch, (std::array<int, 4>{0, 1, 2, 3}));
+
+    ASSERT_EQ(ring.popBatch(batch.data(), batch.size()), 2);
+    EXPECT_EQ(batch[0], 4);
+    EXPECT_EQ(batch[1], 5);
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(SpscRingTests, PoppedValuesAreReleasedFromRing)
+{
+    SpscRing<std::shared_ptr<int>> ring(2);
+    auto value = std::make_shared<int>(1);
+
+    ASSERT_TRUE(ring.tryPush(value));
+    EXPECT_EQ(value.use_count(), 2);
+
+    std::shared_ptr<int> popped;
+    ASSERT_TRUE(ring.tryPop(popped));
+    popped.reset();
+    EXPECT_EQ(value.use_count(), 1);
+}
+
+TEST(SpscRingTests, TransfersAcrossThreadsInOrder)
+{
+    constexpr int COUNT = 100000;
+    SpscRing<int> ring(64);
+
+    std::thread producer(
+        [&]
+        {
+            for (int i = 0; i < COUNT; i++)
+            {
+                while (!ring.tryPush(i))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+    std::array<int, 16> batch{};
+    int expected = 0;
+    bool inOrder = true;
+
+    while (expected < COUNT)
+    {
+        size_t count = ring.popBatch(batch.data(), batch.size());
+        for (size_t i = 0; i < count; i++)
+        {
+            inOrder = inOrder && batch[i] == expected;
+            expected++;
+        }
+        if (count == 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+    EXPECT_TRUE(inOrder);
+}
+
+TEST(MpmcRingTests, PopsInPushOrderAndReportsFull)
+{
+    MpmcRing<int> ring(2);
+
+    ASSERT_TRUE(ring.tryPush(1));
+    ASSERT_TRUE(ring.tryPush(2));
+    EXPECT_FALSE(ring.tryPush(3));
+
+    int value = 0;
+    ASSERT_TRUE(ring.tryPop(value));
+    EXPECT_EQ(value, 1);
+    ASSERT_TRUE(ring.tryPush(3));
+
+    std::array<int, 4> batch{};
+    ASSERT_EQ(ring.popBatch(batch.data(), batch.size()), 2);
+    EXPECT_EQ(batch[0], 2);
+    EXPECT_EQ(batch[1], 3);
+    EXPECT_FALSE(ring.tryPop(value));
+}
+
+TEST(MpmcRingTests, DeliversEveryValueOnceAcrossThreads)
+{
+    constexpr int PRODUCERS = 2;
+    constexpr int CONSUMERS = 3;
+    constexpr int PER_PRODUCER = 50000;
+    constexpr int TOTAL = PRODUCERS * PER_PRODUCER;
+
+    MpmcRing<int> ring(128);
+    std::vector<std::atomic<int>> seen(TOTAL);
+    std::atomic<int> consumed{0};
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < PRODUCERS; p++)
+    {
+        threads.emplace_back(
+            [&, p]
+            {
+                for (int i = 0; i < PER_PRODUCER; i++)
+                {
+                    while (!ring.tryPush(p * PER_PRODUCER + i))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+    }
+
+    for (int c = 0; c < CONSUMERS; c++)
+    {
+        threads.emplace_back(
+            [&]
+            {
+                std::array<int, 8> batch{};
+                while (consumed.load() < TOTAL)
+                {
+                    size_t count = ring.popBatch(batch.data(), batch.size());
+                    for (size_t i = 0; i < count; i++)
+                    {
+                        seen[batch[i]]++;
+                    }
+                    consumed += count;
+                    if (count == 0)
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (int i = 0; i < TOTAL; i++)
+    {
+        ASSERT_EQ(seen[i].load(), 1) << "value " << i;
+    }
+}
+
+class RingWaiterTests : public ::testing::TestWithParam<WaitStrategy>
+{
+};
+
+TEST_P(RingWaiterTests, WaiterWakesOnceValueIsPushed)
+{
+    SpscRing<int> ring(4);
+    RingWaiter waiter(GetParam());
+
+    int value = 0;
+    std::thread consumer([&] { waiter.waitUntil([&] { return ring.tryPop(value); }); });
+
+    // give the consumer time to reach the waiting stage for the strategy under test
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    ASSERT_TRUE(ring.tryPush(7));
+    waiter.notify();
+
+    consumer.join();
+    EXPECT_EQ(value, 7);
+}
+
+TEST_P(RingWaiterTests, NotifyAllReleasesWaiterOnShutdown)
+{
+    std::atomic<bool> done{false};
+    RingWaiter waiter(GetParam());
+
+    std::thread consumer([&] { waiter.waitUntil([&] { return done.load(); }); });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    done.store(true);
+    waiter.notifyAll();
+
+    consumer.join();
+    SUCCEED();
+}
+
+INSTANTIATE_TEST_SUITE_P(WaitStrategies, RingWaiterTests,
+                         ::testing::Values(WaitStrategy::BusySpin, WaitStrategy::SpinThenYield,
+                                           WaitStrategy::Blocking));
+
+}  // namespace solstice
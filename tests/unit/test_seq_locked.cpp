@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <seq_locked.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace solstice
+{
+
+namespace
+{
+
+// both halves are always written together, so a torn read shows up as a mismatch
+struct Pair
+{
+    Pair(long first, long second) : first(first), second(second) {}
+
+    long first;
+    long second;
+};
+
+}  // namespace
+
+TEST(SeqLockedTests, ReadReturnsLastWrite)
+{
+    SeqLocked<Pair> pair(1, 2);
+
+    pair.write(
+        [](Pair& value)
+        {
+            value.first = 3;
+            value.second = 4;
+        });
+
+    const Pair snapshot = pair.read();
+    EXPECT_EQ(snapshot.first, 3);
+    EXPECT_EQ(snapshot.second, 4);
+}
+
+TEST(SeqLockedTests, WriteReturnsResultOfFunc)
+{
+    SeqLocked<Pair> pair(1, 2);
+
+    const Pair written = pair.write(
+        [](Pair& value)
+        {
+            value.first++;
+            return value;
+        });
+
+    EXPECT_EQ(written.first, 2);
+    EXPECT_EQ(pair.value().first, 2);
+}
+
+TEST(SeqLockedTests, ReadersNeverSeeTornWrites)
+{
+    constexpr int WRITES_PER_WRITER = 20000;
+    constexpr int WRITERS = 2;
+    constexpr int READERS = 2;
+
+    SeqLocked<Pair> pair(0, 0);
+    std::atomic<bool> writing{true};
+    std::atomic<int> torn{0};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < READERS; r++)
+    {
+        readers.emplace_back(
+            [&]
+            {
+                while (writing.load())
+                {
+                    const Pair snapshot = pair.read();
+                    if (snapshot.first != -snapshot.second)
+                    {
+                        torn++;
+                    }
+                }
+            });
+    }
+
+    std::vector<std::thread> writers;
+    for (int w = 0; w < WRITERS; w++)
+    {
+        writers.emplace_back(
+            [&]
+            {
+                for (int i = 0; i < WRITES_PER_WRITER; i++)
+                {
+                    pair.write(
+                        [](Pair& value)
+                        {
+                            value.first++;
+                            value.second = -value.first;
+                        });
+                }
+            });
+    }
+
+    for (auto& writer : writers)
+    {
+        writer.join();
+    }
+    writing.store(false);
+
+    for (auto& reader : readers)
+    {
+        reader.join();
+    }
+
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_EQ(pair.read().first, WRITERS * WRITES_PER_WRITER);
+}
+
+}  // namespace solstice
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include <ticks.h>
+#include <trade_tape.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace solstice::matching
+{
+
+namespace
+{
+
+// sequences go up in twos so since() has to search rather than index
+void appendTrades(TradeTape& tape, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        const int uid = static_cast<int>(i);
+        tape.append(2 * (i + 1), 1000 + static_cast<Ticks>(i), uid % 7 + 1, uid, uid + 1);
+    }
+}
+
+}  // namespace
+
+TEST(TradeTapeTests, NewTapeIsEmpty)
+{
+    TradeTape tape(Equity::AAPL);
+
+    EXPECT_TRUE(tape.empty());
+    EXPECT_FALSE(tape.lastTrade().has_value());
+    EXPECT_TRUE(tape.all().empty());
+    EXPECT_TRUE(tape.last(5).empty());
+    EXPECT_TRUE(tape.since(0).empty());
+}
+
+TEST(TradeTapeTests, AppendedTradesReadBackAcrossSegments)
+{
+    TradeTape tape(Equity::MSFT);
+    const size_t count = TRADE_TAPE_FIRST_SEGMENT * 5 + 3;
+    appendTrades(tape, count);
+
+    ASSERT_EQ(tape.size(), count);
+
+    const TradeRange all = tape.all();
+    for (size_t i : {size_t{0}, TRADE_TAPE_FIRST_SEGMENT - 1, TRADE_TAPE_FIRST_SEGMENT,
+                     TRADE_TAPE_FIRST_SEGMENT * 3, count - 1})
+    {
+        const Transaction trade = all[i];
+        EXPECT_EQ(trade.sequence(), 2 * (i + 1));
+        EXPECT_EQ(trade.priceTicks(), 1000 + static_cast<Ticks>(i));
+        EXPECT_EQ(trade.bidUid(), static_cast<int>(i));
+        EXPECT_EQ(trade.askUid(), static_cast<int>(i) + 1);
+        EXPECT_EQ(trade.underlying(), Underlying{Equity::MSFT});
+    }
+
+    ASSERT_TRUE(tape.lastTrade().has_value());
+    EXPECT_EQ(tape.lastTrade()->sequence(), 2 * count);
+}
+
+TEST(TradeTapeTests, ColumnsCoverTheRangeInOrder)
+{
+    TradeTape tape(Equity::AAPL);
+    appendTrades(tape, TRADE_TAPE_FIRST_SEGMENT * 4);
+
+    // starts part way through the first segment and ends part way through the third
+    const TradeRange range = tape.since(2 * (TRADE_TAPE_FIRST_SEGMENT - 10));
+    const TradeRange tail(tape, TRADE_TAPE_FIRST_SEGMENT - 10, TRADE_TAPE_FIRST_SEGMENT * 3 + 5);
+
+    for (const TradeRange& trades : {range, tail})
+    {
+        size_t runs = 0;
+        size_t seen = 0;
+        uint64_t previous = 0;
+
+        trades.forEachColumns(
+            [&](const TradeColumns& columns)
+            {
+                runs++;
+                for (size_t i = 0; i < columns.size(); i++)
+                {
+                    EXPECT_GT(columns.sequence[i], previous);
+                    previous = columns.sequence[i];
+                    EXPECT_EQ(columns.price[i], 1000 + static_cast<Ticks>(columns.bidUid[i]));
+                }
+                seen += columns.size();
+            });
+
+        EXPECT_EQ(seen, trades.size());
+        EXPECT_EQ(runs, 3);
+        EXPECT_EQ(trades[0].bidUid(), static_cast<int>(TRADE_TAPE_FIRST_SEGMENT - 10));
+    }
+}
+
+TEST(TradeTapeTests, LastAndSinceSelectTheLatestTrades)
+{
+    TradeTape tape(Equity::AAPL);
+    appendTrades(tape, 100);
+
+    const TradeRange last = tape.last(10);
+    ASSERT_EQ(last.size(), 10);
+    EXPECT_EQ(last[0].sequence(), 182);
+    EXPECT_EQ(last[9].sequence(), 200);
+    EXPECT_EQ(tape.last(1000).size(), 100);
+
+    // trades numbered after the sequence, whether or not the sequence itself is on the tape
+    EXPECT_EQ(tape.since(0).size(), 100);
+    EXPECT_EQ(tape.since(180).size(), 10);
+    EXPECT_EQ(tape.since(181).size(), 10);
+    EXPECT_EQ(tape.since(181)[0].sequence(), 182);
+    EXPECT_TRUE(tape.since(200).empty());
+}
+
+TEST(TradeTapeTests, ReaderSeesOnlyCompleteTradesWhileAppending)
+{
+    TradeTape tape(Equity::AAPL);
+    const size_t count = TRADE_TAPE_FIRST_SEGMENT * 16;
+    std::atomic<bool> done{false};
+
+    std::thread reader(
+        [&]
+        {
+            while (!done.load())
+            {
+                if (auto trade = tape.lastTrade())
+                {
+                    const size_t i = trade->sequence() / 2 - 1;
+                    ASSERT_EQ(trade->priceTicks(), 1000 + static_cast<Ticks>(i));
+                    ASSERT_EQ(trade->askUid(), static_cast<int>(i) + 1);
+                }
+            }
+        });
+
+    appendTrades(tape, count);
+    done.store(true);
+    reader.join();
+
+    EXPECT_EQ(tape.size(), count);
+}
+
+}  // namespace solstice::matching
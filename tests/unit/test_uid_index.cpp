@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#include <uid_index.h>
+
+namespace solstice::matching
+{
+
+TEST(UidIndexTests, FindsEveryOrderAddedUntilItIsRemoved)
+{
+    UidIndex index;
+
+    // enough to grow every stripe several times over
+    for (int uid = 0; uid < 20000; uid++)
+    {
+        index.add(uid, 3, static_cast<NodeHandle>(uid * 2));
+    }
+    EXPECT_EQ(index.size(), 20000u);
+
+    for (int uid = 0; uid < 20000; uid += 2)
+    {
+        index.remove(uid, 3);
+    }
+    EXPECT_EQ(index.size(), 10000u);
+
+    for (int uid = 0; uid < 20000; uid++)
+    {
+        auto entry = index.find(uid);
+        ASSERT_EQ(entry.has_value(), uid % 2 == 1) << uid;
+        if (entry)
+        {
+            EXPECT_EQ(entry->instrument, 3u);
+            EXPECT_EQ(entry->handle, static_cast<NodeHandle>(uid * 2));
+        }
+    }
+    EXPECT_FALSE(index.find(-1).has_value());
+}
+
+TEST(UidIndexTests, KeepsAnEntryPerInstrumentForARepeatedUid)
+{
+    UidIndex index;
+    index.add(7, 1, 10);
+    index.add(7, 2, 20);
+
+    // removing one instrument's entry leaves the other's
+    index.remove(7, 1);
+    auto entry = index.find(7);
+    ASSERT_TRUE(entry.has_value());
+    EXPECT_EQ(entry->instrument, 2u);
+    EXPECT_EQ(entry->handle, 20u);
+
+    // a uid the instrument has no entry for changes nothing
+    index.remove(7, 1);
+    EXPECT_EQ(index.size(), 1u);
+
+    index.remove(7, 2);
+    EXPECT_FALSE(index.find(7).has_value());
+    EXPECT_EQ(index.size(), 0u);
+}
+
+}  // namespace solstice::matching